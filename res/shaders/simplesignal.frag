@@ -0,0 +1,61 @@
+#version 120
+
+uniform vec2 framebufferSize;
+uniform vec4 axesColor;
+uniform vec4 signalColor;
+
+uniform int waveformLength;
+uniform int textureSize;
+uniform int textureStride;
+
+uniform float allGain;
+uniform float firstVisualIndex;
+uniform float lastVisualIndex;
+
+uniform sampler2D waveformDataTexture;
+
+vec4 getWaveformData(float index) {
+    vec2 uv_data;
+    uv_data.y = floor(index / float(textureStride));
+    uv_data.x = floor(index - uv_data.y * float(textureStride));
+    // Divide again to convert to normalized UV coordinates.
+    return texture2D(waveformDataTexture, uv_data / float(textureStride));
+}
+
+void main(void) {
+    vec2 uv = gl_TexCoord[0].st;
+    vec4 pixel = gl_FragCoord;
+
+    float new_currentIndex = floor(firstVisualIndex + uv.x *
+                                   (lastVisualIndex - firstVisualIndex)) * 2;
+
+    // Texture coordinates put (0,0) at the bottom left, so show the right
+    // channel if we are in the bottom half.
+    if (uv.y < 0.5) {
+        new_currentIndex += 1;
+    }
+
+    vec4 outputColor = vec4(0.0, 0.0, 0.0, 0.0);
+    bool signalShowing = false;
+    if (new_currentIndex >= 0 && new_currentIndex <= waveformLength - 1) {
+      // The unfiltered signal is stored in the alpha channel.
+      float signal = getWaveformData(new_currentIndex).w * allGain;
+
+      // Represents the [-1, 1] distance of this pixel.
+      float ourDistance = abs((uv.y - 0.5) * 2.0);
+      signalShowing = signal - ourDistance >= 0.0;
+    }
+
+    // Draw the axes color as the lowest item on the screen.
+    if (abs(framebufferSize.y / 2 - pixel.y) <= 4) {
+      outputColor.xyz = mix(outputColor.xyz, axesColor.xyz, axesColor.w);
+      outputColor.w = 1.0;
+    }
+
+    if (signalShowing) {
+      outputColor.xyz = mix(outputColor.xyz, signalColor.xyz, 0.9);
+      outputColor.w = 1.0;
+    }
+
+    gl_FragColor = outputColor;
+}
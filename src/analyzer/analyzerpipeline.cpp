@@ -0,0 +1,166 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include <cstring>
+
+#include "analyzer/constants.h"
+#include "util/assert.h"
+#include "util/tracing.h"
+
+AnalyzerPipeline::Lane::Lane(
+        AnalyzerPipeline* pPipeline,
+        AnalyzerWithState* pAnalyzer)
+        : m_pPipeline(pPipeline),
+          m_pAnalyzer(pAnalyzer),
+          m_readCount(0),
+          m_scheduled(false) {
+    // The same lane is started repeatedly
+    setAutoDelete(false);
+}
+
+void AnalyzerPipeline::Lane::run() {
+    // Runs on a pooled thread that might have been registered before
+    mixxx::Tracing::registerCurrentThread("AnalyzerPipeline");
+    // The threads of the pool are shared and have been started with
+    // the priority of whichever thread needed them first
+    const auto threadPriority = m_pPipeline->m_threadPriority;
+    if (threadPriority != QThread::InheritPriority &&
+            QThread::currentThread()->priority() != threadPriority) {
+        QThread::currentThread()->setPriority(threadPriority);
+    }
+    m_pPipeline->processLane(this);
+}
+
+AnalyzerPipeline::AnalyzerPipeline(
+        std::shared_ptr<QThreadPool> pThreadPool,
+        int chunkCount,
+        QThread::Priority threadPriority)
+        : m_pThreadPool(std::move(pThreadPool)),
+          m_threadPriority(threadPriority),
+          m_chunkCount(chunkCount),
+          m_samplesPerChunk(mixxx::kAnalysisSamplesPerChunk),
+          m_sampleBuffer(m_samplesPerChunk * chunkCount),
+          m_chunks(std::make_unique<Chunk[]>(chunkCount)),
+          m_writeCount(0),
+          m_freeChunks(chunkCount),
+          m_writableChunkAcquired(false),
+          m_startedTasks(0),
+          m_cancelled(false) {
+    DEBUG_ASSERT(m_pThreadPool);
+    DEBUG_ASSERT(m_chunkCount > 0);
+}
+
+AnalyzerPipeline::~AnalyzerPipeline() {
+    VERIFY_OR_DEBUG_ASSERT(m_lanes.empty()) {
+        finish(true);
+    }
+}
+
+void AnalyzerPipeline::start(std::vector<AnalyzerWithState>* pAnalyzers) {
+    DEBUG_ASSERT(pAnalyzers);
+    DEBUG_ASSERT(m_lanes.empty());
+    DEBUG_ASSERT(m_startedTasks == 0);
+    m_cancelled.store(false);
+    const auto writeCount = m_writeCount.load();
+    for (auto& analyzer : *pAnalyzers) {
+        if (!analyzer.isActive()) {
+            continue;
+        }
+        auto pLane = std::make_unique<Lane>(this, &analyzer);
+        pLane->m_readCount = writeCount;
+        m_lanes.push_back(std::move(pLane));
+    }
+}
+
+mixxx::SampleBuffer::WritableSlice AnalyzerPipeline::writableChunk() {
+    if (!m_writableChunkAcquired) {
+        m_freeChunks.acquire();
+        m_writableChunkAcquired = true;
+    }
+    const auto index = static_cast<SINT>(m_writeCount.load() % m_chunkCount);
+    return mixxx::SampleBuffer::WritableSlice(
+            m_sampleBuffer,
+            index * m_samplesPerChunk,
+            m_samplesPerChunk);
+}
+
+void AnalyzerPipeline::publishChunk(const CSAMPLE* pSamples, SINT sampleCount) {
+    DEBUG_ASSERT(m_writableChunkAcquired);
+    VERIFY_OR_DEBUG_ASSERT(sampleCount <= m_samplesPerChunk) {
+        sampleCount = m_samplesPerChunk;
+    }
+    if (sampleCount <= 0 || m_lanes.empty()) {
+        // Keep the chunk for writing
+        return;
+    }
+    const auto writeCount = m_writeCount.load();
+    CSAMPLE* pChunkSamples = m_sampleBuffer.data(
+            static_cast<SINT>(writeCount % m_chunkCount) * m_samplesPerChunk);
+    if (pSamples != pChunkSamples) {
+        // The samples might overlap with the chunk
+        std::memmove(pChunkSamples, pSamples, sampleCount * sizeof(CSAMPLE));
+    }
+    Chunk& chunk = chunkAt(writeCount);
+    chunk.sampleCount = sampleCount;
+    chunk.pendingLanes.store(static_cast<int>(m_lanes.size()));
+    m_writableChunkAcquired = false;
+    m_writeCount.store(writeCount + 1);
+    for (const auto& pLane : m_lanes) {
+        // A lane that is still running will pick up the new chunk
+        if (!pLane->m_scheduled.exchange(true)) {
+            ++m_startedTasks;
+            m_pThreadPool->start(pLane.get());
+        }
+    }
+}
+
+void AnalyzerPipeline::finish(bool cancelled) {
+    if (cancelled) {
+        m_cancelled.store(true);
+    }
+    if (m_writableChunkAcquired) {
+        m_freeChunks.release();
+        m_writableChunkAcquired = false;
+    }
+    m_finishedTasks.acquire(m_startedTasks);
+    m_startedTasks = 0;
+    DEBUG_ASSERT(m_freeChunks.available() == m_chunkCount);
+    m_lanes.clear();
+}
+
+void AnalyzerPipeline::processLane(Lane* pLane) {
+    mixxx::ScopedTrace trace("AnalyzerPipeline::processLane");
+    // Only a single task processes the chunks of a lane at any time. A
+    // new task is started as soon as m_scheduled has been reset, while
+    // the previous task might still be about to return. The read count
+    // must not be accessed after resetting the flag.
+    auto readCount = pLane->m_readCount;
+    while (true) {
+        const auto writeCount = m_writeCount.load();
+        while (readCount < writeCount) {
+            Chunk& chunk = chunkAt(readCount);
+            if (!m_cancelled.load(std::memory_order_relaxed)) {
+                pLane->m_pAnalyzer->processSamples(
+                        chunkSamples(readCount),
+                        chunk.sampleCount);
+            }
+            ++readCount;
+            releaseChunk(&chunk);
+        }
+        pLane->m_readCount = readCount;
+        pLane->m_scheduled.store(false);
+        // Another chunk might have been published after loading the
+        // write count and before resetting the flag without starting
+        // a new task.
+        if (readCount == m_writeCount.load() ||
+                pLane->m_scheduled.exchange(true)) {
+            break;
+        }
+    }
+    m_finishedTasks.release();
+}
+
+void AnalyzerPipeline::releaseChunk(Chunk* pChunk) {
+    if (pChunk->pendingLanes.fetch_sub(1) == 1) {
+        m_freeChunks.release();
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "analyzer/analyzer.h"
+#include "util/samplebuffer.h"
+
+/// AnalyzerPipeline decouples decoding of a track from the analyzers
+/// that process the decoded audio data.
+///
+/// The decoding thread writes chunks of decoded samples into a ring
+/// of fixed size. Each active analyzer consumes all chunks in order
+/// from its own read position, but independent of the other analyzers
+/// on the threads of a shared QThreadPool. A chunk is reused as soon as
+/// all analyzers have processed it. The decoding thread only blocks
+/// if the slowest analyzer falls behind by the whole ring.
+///
+/// The tasks that run the analyzers never block. They process all
+/// chunks that are available and then return their thread to the pool,
+/// i.e. multiple pipelines may share a pool with fewer threads than
+/// analyzers without deadlocking.
+///
+/// All public functions must be called from the decoding thread.
+class AnalyzerPipeline final {
+  public:
+    /// The analyzers run with the given priority, independent of the
+    /// priority of the pooled threads when they are started by the pool.
+    AnalyzerPipeline(
+            std::shared_ptr<QThreadPool> pThreadPool,
+            int chunkCount,
+            QThread::Priority threadPriority = QThread::InheritPriority);
+    ~AnalyzerPipeline();
+
+    /// Starts to feed all active analyzers with the chunks that
+    /// are published afterwards. The analyzers must stay untouched
+    /// by the caller until finish() returns.
+    void start(std::vector<AnalyzerWithState>* pAnalyzers);
+
+    /// Blocks until the next chunk is available for writing and returns
+    /// it. Calling this function again without publishing the chunk
+    /// returns the same chunk.
+    mixxx::SampleBuffer::WritableSlice writableChunk();
+
+    /// Passes the given samples to all analyzers. The samples are
+    /// expected to be located in the chunk that has been returned by
+    /// writableChunk() and are copied into it otherwise.
+    void publishChunk(const CSAMPLE* pSamples, SINT sampleCount);
+
+    /// Blocks until all published chunks have been processed by all
+    /// analyzers. If cancelled the remaining chunks are skipped.
+    void finish(bool cancelled = false);
+
+  private:
+    class Lane final : public QRunnable {
+      public:
+        Lane(AnalyzerPipeline* pPipeline,
+                AnalyzerWithState* pAnalyzer);
+
+        void run() override;
+
+        AnalyzerPipeline* const m_pPipeline;
+        AnalyzerWithState* const m_pAnalyzer;
+        // Only accessed by the task that is currently running
+        std::uint64_t m_readCount;
+        std::atomic<bool> m_scheduled;
+    };
+
+    struct Chunk {
+        SINT sampleCount = 0;
+        // The number of lanes that still need to process this chunk
+        std::atomic<int> pendingLanes{0};
+    };
+
+    void processLane(Lane* pLane);
+
+    void releaseChunk(Chunk* pChunk);
+
+    Chunk& chunkAt(std::uint64_t count) {
+        return m_chunks[count % m_chunkCount];
+    }
+
+    const CSAMPLE* chunkSamples(std::uint64_t count) const {
+        return m_sampleBuffer.data(
+                static_cast<SINT>(count % m_chunkCount) * m_samplesPerChunk);
+    }
+
+    const std::shared_ptr<QThreadPool> m_pThreadPool;
+    const QThread::Priority m_threadPriority;
+    const int m_chunkCount;
+    const SINT m_samplesPerChunk;
+
+    mixxx::SampleBuffer m_sampleBuffer;
+    std::unique_ptr<Chunk[]> m_chunks;
+
+    std::vector<std::unique_ptr<Lane>> m_lanes;
+
+    // The number of chunks that have been published
+    std::atomic<std::uint64_t> m_writeCount;
+    QSemaphore m_freeChunks;
+    bool m_writableChunkAcquired;
+
+    // Tasks are only started by the decoding thread
+    int m_startedTasks;
+    QSemaphore m_finishedTasks;
+
+    std::atomic<bool> m_cancelled;
+};
@@ -1,5 +1,6 @@
 #include "analyzer/analyzerthread.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include "analyzer/analyzerbeats.h"
@@ -19,6 +20,7 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/logger.h"
 #include "util/timer.h"
+#include "util/tracing.h"
 
 namespace {
 
@@ -36,6 +38,16 @@ mixxx::Logger kLogger("AnalyzerThread");
 // continuous feedback.
 const mixxx::Duration kBusyProgressInhibitDuration = mixxx::Duration::fromMillis(60);
 
+// The number of decoded chunks the slowest analyzer may fall behind
+// while running the analyzers concurrently, ~3 seconds at 44.1 kHz.
+constexpr int kPipelineChunkCount = 32;
+
+QThread::Priority threadPriority(AnalyzerModeFlags modeFlags) {
+    return modeFlags & AnalyzerModeFlags::LowPriority
+            ? QThread::LowPriority
+            : QThread::InheritPriority;
+}
+
 void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     if (plainPtr) {
         plainPtr->deleteAfterFinished();
@@ -62,12 +74,14 @@ AnalyzerThread::Pointer AnalyzerThread::createInstance(
         int id,
         mixxx::DbConnectionPoolPtr dbConnectionPool,
         UserSettingsPointer pConfig,
-        AnalyzerModeFlags modeFlags) {
+        AnalyzerModeFlags modeFlags,
+        std::shared_ptr<QThreadPool> pAnalyzerThreadPool) {
     return Pointer(new AnalyzerThread(
                            id,
                            dbConnectionPool,
                            pConfig,
-                           modeFlags),
+                           modeFlags,
+                           std::move(pAnalyzerThreadPool)),
             deleteAnalyzerThread);
 }
 
@@ -75,21 +89,29 @@ AnalyzerThread::AnalyzerThread(
         int id,
         mixxx::DbConnectionPoolPtr dbConnectionPool,
         UserSettingsPointer pConfig,
-        AnalyzerModeFlags modeFlags)
+        AnalyzerModeFlags modeFlags,
+        std::shared_ptr<QThreadPool> pAnalyzerThreadPool)
         : WorkerThread(
             QString("AnalyzerThread %1").arg(id),
-            (modeFlags & AnalyzerModeFlags::LowPriority ? QThread::LowPriority : QThread::InheritPriority)),
+            threadPriority(modeFlags)),
           m_id(id),
           m_dbConnectionPool(std::move(dbConnectionPool)),
           m_pConfig(pConfig),
           m_modeFlags(modeFlags),
           m_nextTrack(2), // minimum capacity
           m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk),
+          m_pPipeline(pAnalyzerThreadPool
+                          ? std::make_unique<AnalyzerPipeline>(
+                                    std::move(pAnalyzerThreadPool),
+                                    kPipelineChunkCount,
+                                    threadPriority(modeFlags))
+                          : nullptr),
           m_emittedState(AnalyzerThreadState::Void) {
     std::call_once(registerMetaTypesOnceFlag, registerMetaTypesOnce);
 }
 
 void AnalyzerThread::doRun() {
+    mixxx::Tracing::registerCurrentThread("AnalyzerThread");
     std::unique_ptr<AnalysisDao> pAnalysisDao;
     // The thread-local database connection  must not be closed
     // before returning from this function.
@@ -152,8 +174,14 @@ void AnalyzerThread::doRun() {
         }
 
         if (processTrack) {
-            const auto analysisResult = analyzeAudioSource(audioSource);
+            const bool pipelined = startPipeline();
+            const auto analysisResult = analyzeAudioSource(audioSource, pipelined);
             DEBUG_ASSERT(analysisResult != AnalysisResult::Pending);
+            if (pipelined) {
+                // All analyzers must have processed the remaining chunks
+                // before they could be finished or cancelled
+                m_pPipeline->finish(analysisResult != AnalysisResult::Finished);
+            }
             if (analysisResult == AnalysisResult::Finished) {
                 // The analysis has been finished, and is either complete without
                 // any errors or partial if it has been aborted due to a corrupt
@@ -218,9 +246,30 @@ WorkerThread::TryFetchWorkItemsResult AnalyzerThread::tryFetchWorkItems() {
     }
 }
 
+bool AnalyzerThread::startPipeline() {
+    if (!m_pPipeline) {
+        return false;
+    }
+    const auto activeAnalyzers = std::count_if(
+            m_analyzers.begin(),
+            m_analyzers.end(),
+            [](const AnalyzerWithState& analyzer) {
+                return analyzer.isActive();
+            });
+    // Processing a single analyzer on a different thread
+    // would only add overhead
+    if (activeAnalyzers < 2) {
+        return false;
+    }
+    m_pPipeline->start(&m_analyzers);
+    return true;
+}
+
 AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
-        const mixxx::AudioSourcePointer& audioSource) {
+        const mixxx::AudioSourcePointer& audioSource,
+        bool pipelined) {
     DEBUG_ASSERT(m_currentTrack.has_value());
+    DEBUG_ASSERT(!pipelined || m_pPipeline);
 
     mixxx::AudioSourceStereoProxy audioSourceProxy(
             audioSource,
@@ -240,6 +289,7 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
         }
 
         // 1st step: Decode next chunk of audio data
+        mixxx::ScopedTrace trace("AnalyzerThread::analyzeAudioSource chunk");
 
         // Split the range for the next chunk from the remaining (= to-be-analyzed) frames
         auto chunkFrameRange =
@@ -247,12 +297,16 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
                         math_min(mixxx::kAnalysisFramesPerChunk, remainingFrameRange.length()));
         DEBUG_ASSERT(!chunkFrameRange.empty());
 
-        // Request the next chunk of audio data
+        // Request the next chunk of audio data. The pipeline decodes
+        // directly into the buffer that is shared with the analyzers.
         const auto readableSampleFrames =
                 audioSourceProxy.readSampleFrames(
                         mixxx::WritableSampleFrames(
                                 chunkFrameRange,
-                                mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+                                pipelined
+                                        ? m_pPipeline->writableChunk()
+                                        : mixxx::SampleBuffer::WritableSlice(
+                                                  m_sampleBuffer)));
         // The returned range fits into the requested range
         DEBUG_ASSERT(readableSampleFrames.frameIndexRange().isSubrangeOf(chunkFrameRange));
 
@@ -297,10 +351,16 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
 
         // 2nd: step: Analyze chunk of decoded audio data
         if (!readableSampleFrames.frameIndexRange().empty()) {
-            for (auto&& analyzer : m_analyzers) {
-                analyzer.processSamples(
+            if (pipelined) {
+                m_pPipeline->publishChunk(
                         readableSampleFrames.readableData(),
                         readableSampleFrames.readableLength());
+            } else {
+                for (auto&& analyzer : m_analyzers) {
+                    analyzer.processSamples(
+                            readableSampleFrames.readableData(),
+                            readableSampleFrames.readableLength());
+                }
             }
         }
 
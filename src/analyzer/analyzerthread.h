@@ -1,9 +1,12 @@
 #pragma once
 
+#include <QThreadPool>
+#include <memory>
 #include <optional>
 #include <vector>
 
 #include "analyzer/analyzer.h"
+#include "analyzer/analyzerpipeline.h"
 #include "analyzer/analyzerprogress.h"
 #include "analyzer/analyzertrack.h"
 #include "preferences/usersettings.h"
@@ -59,13 +62,15 @@ class AnalyzerThread : public WorkerThread {
             int id,
             mixxx::DbConnectionPoolPtr dbConnectionPool,
             UserSettingsPointer pConfig,
-            AnalyzerModeFlags modeFlags);
+            AnalyzerModeFlags modeFlags,
+            std::shared_ptr<QThreadPool> pAnalyzerThreadPool = nullptr);
 
     /*private*/ AnalyzerThread(
             int id,
             mixxx::DbConnectionPoolPtr dbConnectionPool,
             UserSettingsPointer pConfig,
-            AnalyzerModeFlags modeFlags);
+            AnalyzerModeFlags modeFlags,
+            std::shared_ptr<QThreadPool> pAnalyzerThreadPool = nullptr);
     ~AnalyzerThread() override = default;
 
     int id() const {
@@ -120,6 +125,10 @@ class AnalyzerThread : public WorkerThread {
 
     mixxx::SampleBuffer m_sampleBuffer;
 
+    // Runs the analyzers concurrently while decoding if a thread pool
+    // has been provided, otherwise nullptr.
+    const std::unique_ptr<AnalyzerPipeline> m_pPipeline;
+
     std::optional<AnalyzerTrack> m_currentTrack;
 
     AnalyzerThreadState m_emittedState;
@@ -132,7 +141,11 @@ class AnalyzerThread : public WorkerThread {
         Cancelled,
     };
     AnalysisResult analyzeAudioSource(
-            const mixxx::AudioSourcePointer& audioSource);
+            const mixxx::AudioSourcePointer& audioSource,
+            bool pipelined);
+
+    // Starts the pipeline if multiple analyzers are active
+    bool startPipeline();
 
     // Blocks the worker thread until a next track becomes available
     TrackPointer receiveNextTrack();
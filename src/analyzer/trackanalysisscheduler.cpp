@@ -1,11 +1,14 @@
 #include "analyzer/trackanalysisscheduler.h"
 
+#include <QThreadPool>
+
 #include "analyzer/analyzerscheduledtrack.h"
 #include "analyzer/analyzertrack.h"
 #include "moc_trackanalysisscheduler.cpp"
 #include "track/track.h"
 #include "track/trackid.h"
 #include "util/logger.h"
+#include "util/math.h"
 
 namespace {
 
@@ -16,6 +19,9 @@ constexpr QThread::Priority kWorkerThreadPriority = QThread::LowPriority;
 // Maximum frequency of progress updates
 constexpr std::chrono::milliseconds kProgressInhibitDuration(100);
 
+const ConfigKey kPipelinedAnalysisConfigKey =
+        ConfigKey(QStringLiteral("[Library]"), QStringLiteral("PipelinedAnalysis"));
+
 void deleteTrackAnalysisScheduler(TrackAnalysisScheduler* plainPtr) {
     if (plainPtr) {
         // Trigger stop
@@ -71,6 +77,20 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
                 << "worker threads. Priority: "
                 << (modeFlags & AnalyzerModeFlags::LowPriority ? "low" : "normal");
     }
+    // The worker threads only decode the tracks while the analyzers of
+    // all tracks are run by a shared thread pool. Many tracks that are
+    // analyzed in parallel compete for the threads of the pool while
+    // the analyzers of the last few tracks still occupy all cores.
+    std::shared_ptr<QThreadPool> pAnalyzerThreadPool;
+    if (pConfig->getValue<bool>(kPipelinedAnalysisConfigKey, true)) {
+        pAnalyzerThreadPool = std::make_shared<QThreadPool>();
+        pAnalyzerThreadPool->setMaxThreadCount(
+                math_max(numWorkerThreads, QThread::idealThreadCount()));
+        kLogger.debug()
+                << "Running analyzers on"
+                << pAnalyzerThreadPool->maxThreadCount()
+                << "pooled threads";
+    }
     // 1st pass: Create worker threads
     m_workers.reserve(numWorkerThreads);
     for (int threadId = 0; threadId < numWorkerThreads; ++threadId) {
@@ -78,7 +98,8 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
                 threadId,
                 pDbConnectionPool,
                 pConfig,
-                modeFlags));
+                modeFlags,
+                pAnalyzerThreadPool));
         connect(m_workers.back().thread(),
                 &AnalyzerThread::progress,
                 this,
@@ -1,5 +1,10 @@
 #include "control/control.h"
 
+#include <array>
+#include <atomic>
+#include <queue>
+#include <thread>
+
 #include "control/controlobject.h"
 #include "moc_control.cpp"
 #include "util/stat.h"
@@ -13,17 +18,148 @@ namespace {
 /// configuration object would be arduous.
 UserSettingsPointer s_pUserConfig;
 
-/// Mutex guarding access to s_qCOHash and s_qCOAliasHash.
-MMutex s_qCOHashMutex;
+/// The registry of control handles is split into shards with separate
+/// mutexes. Thousands of ControlProxy instances are created while loading a
+/// skin or a controller mapping, and lookups of different keys from
+/// different threads should not contend for a single lock.
+constexpr uint kNumRegistryShards = 64;
+
+struct RegistryShard {
+    MMutex mutex;
+    /// Hash of the handles of all ControlDoublePrivate instantiations and
+    /// their aliases.
+    QHash<ConfigKey, ControlHandle> handles GUARDED_BY(mutex);
+};
 
-/// Hash of ControlDoublePrivate instantiations.
-QHash<ConfigKey, QWeakPointer<ControlDoublePrivate>> s_qCOHash
-        GUARDED_BY(s_qCOHashMutex);
+std::array<RegistryShard, kNumRegistryShards> s_registryShards;
+
+RegistryShard& registryShard(const ConfigKey& key) {
+    return s_registryShards[qHash(key) % kNumRegistryShards];
+}
+
+/// The controls are stored by handle in chunks of slots that are allocated
+/// on demand and never moved or freed. The slot of a destroyed control is
+/// reused by a later control. A handle contains the slot index and the
+/// generation of the slot, so that a stale handle of a destroyed control
+/// does not resolve to the new occupant of the slot. The generation wraps
+/// around after kControlSlotGenerationMask + 1 reuses of the same slot.
+constexpr int kControlSlotIndexBits = 20;
+constexpr int kMaxControlSlots = 1 << kControlSlotIndexBits;
+constexpr int kControlSlotGenerationMask = (1 << (31 - kControlSlotIndexBits)) - 1;
+constexpr int kControlSlotChunkSizeBits = 10;
+constexpr int kControlSlotChunkSize = 1 << kControlSlotChunkSizeBits;
+constexpr int kMaxControlSlotChunks = kMaxControlSlots / kControlSlotChunkSize;
+constexpr int kFreeControlSlot = -1;
+
+/// Handles are resolved without locking. A reader announces itself by
+/// incrementing numReaders before it checks the generation. Before the
+/// weak pointer of a destroyed control is cleared, its slot is marked as
+/// free and the releasing thread waits until all readers have left. Readers
+/// never wait.
+struct ControlSlot {
+    /// The generation of the current control or kFreeControlSlot
+    std::atomic<int> generation{kFreeControlSlot};
+    std::atomic<int> numReaders{0};
+    /// Only modified while the slot is free and not read
+    QWeakPointer<ControlDoublePrivate> pControl;
+    /// Guarded by s_controlSlotMutex
+    int nextGeneration = 0;
+};
+
+using ControlSlotChunk = std::array<ControlSlot, kControlSlotChunkSize>;
+
+std::atomic<ControlSlotChunk*> s_controlSlotChunks[kMaxControlSlotChunks];
+
+/// Mutex guarding the allocation and release of control slots.
+MMutex s_controlSlotMutex;
+
+int s_numControlSlots GUARDED_BY(s_controlSlotMutex) = 0;
+
+/// Indices of released slots. Slots are reused in FIFO order to delay the
+/// wraparound of their generation.
+std::queue<int> s_freeControlSlots GUARDED_BY(s_controlSlotMutex);
+
+ControlSlot* controlSlot(int index) {
+    ControlSlotChunk* pChunk =
+            s_controlSlotChunks[index >> kControlSlotChunkSizeBits].load(
+                    std::memory_order_acquire);
+    if (!pChunk) {
+        return nullptr;
+    }
+    return &(*pChunk)[index & (kControlSlotChunkSize - 1)];
+}
+
+/// Returns the handle of the new slot or -1 if all slots are exhausted
+int insertControlSlot(const QSharedPointer<ControlDoublePrivate>& pControl) {
+    const MMutexLocker locker(&s_controlSlotMutex);
+    int index;
+    if (!s_freeControlSlots.empty()) {
+        index = s_freeControlSlots.front();
+        s_freeControlSlots.pop();
+    } else {
+        index = s_numControlSlots;
+        VERIFY_OR_DEBUG_ASSERT(index < kMaxControlSlots) {
+            return -1;
+        }
+        const int chunkIndex = index >> kControlSlotChunkSizeBits;
+        if (!s_controlSlotChunks[chunkIndex].load(std::memory_order_relaxed)) {
+            s_controlSlotChunks[chunkIndex].store(
+                    new ControlSlotChunk(), std::memory_order_release);
+        }
+        s_numControlSlots = index + 1;
+    }
+    ControlSlot* pSlot = controlSlot(index);
+    const int generation = pSlot->nextGeneration;
+    pSlot->nextGeneration = (generation + 1) & kControlSlotGenerationMask;
+    pSlot->pControl = pControl;
+    pSlot->generation.store(generation, std::memory_order_release);
+    return (generation << kControlSlotIndexBits) | index;
+}
+
+void releaseControlSlot(int handle) {
+    const int index = handle & (kMaxControlSlots - 1);
+    const MMutexLocker locker(&s_controlSlotMutex);
+    ControlSlot* pSlot = controlSlot(index);
+    VERIFY_OR_DEBUG_ASSERT(pSlot) {
+        return;
+    }
+    pSlot->generation.store(kFreeControlSlot);
+    while (pSlot->numReaders.load() > 0) {
+        // A reader only holds the slot while it upgrades the weak pointer
+        std::this_thread::yield();
+    }
+    // Release the reference count block of the destroyed control
+    pSlot->pControl.clear();
+    s_freeControlSlots.push(index);
+}
+
+QSharedPointer<ControlDoublePrivate> lookupControlSlot(int handle) {
+    if (handle < 0) {
+        return nullptr;
+    }
+    ControlSlot* pSlot = controlSlot(handle & (kMaxControlSlots - 1));
+    if (!pSlot) {
+        return nullptr;
+    }
+    QSharedPointer<ControlDoublePrivate> pControl;
+    pSlot->numReaders.fetch_add(1);
+    if (pSlot->generation.load() == handle >> kControlSlotIndexBits) {
+        pControl = pSlot->pControl.toStrongRef();
+    }
+    pSlot->numReaders.fetch_sub(1, std::memory_order_release);
+    return pControl;
+}
+
+/// Mutex guarding access to s_qCOAliasHash.
+MMutex s_qCOAliasHashMutex;
 
 /// Hash of aliases between ConfigKeys. Solely used for looking up the first
 /// alias associated with a key.
 QHash<ConfigKey, ConfigKey> s_qCOAliasHash
-        GUARDED_BY(s_qCOHashMutex);
+        GUARDED_BY(s_qCOAliasHashMutex);
+
+/// Mutex guarding the creation of the default control.
+MMutex s_defaultCOMutex;
 
 /// is used instead of a nullptr, helps to omit null checks everywhere
 QWeakPointer<ControlDoublePrivate> s_pDefaultCO;
@@ -84,10 +220,19 @@ void ControlDoublePrivate::initialize(double defaultValue) {
 }
 
 ControlDoublePrivate::~ControlDoublePrivate() {
-    s_qCOHashMutex.lock();
-    //qDebug() << "ControlDoublePrivate::s_qCOHash.remove(" << m_key.group << "," << m_key.item << ")";
-    s_qCOHash.remove(m_key);
-    s_qCOHashMutex.unlock();
+    if (m_handle.valid()) {
+        {
+            RegistryShard& shard = registryShard(m_key);
+            const MMutexLocker locker(&shard.mutex);
+            // The weak pointer expires before the destructor is invoked, so a
+            // new control with the same key might already have been registered.
+            const auto it = shard.handles.constFind(m_key);
+            if (it != shard.handles.constEnd() && it.value() == m_handle) {
+                shard.handles.erase(it);
+            }
+        }
+        releaseControlSlot(m_handle.handle());
+    }
 
     if (m_bPersistInConfiguration) {
         UserSettingsPointer pConfig = s_pUserConfig;
@@ -106,22 +251,28 @@ void ControlDoublePrivate::setUserConfig(const UserSettingsPointer& pConfig) {
 
 // static
 void ControlDoublePrivate::insertAlias(const ConfigKey& alias, const ConfigKey& key) {
-    MMutexLocker locker(&s_qCOHashMutex);
-
-    auto it = s_qCOHash.constFind(key);
-    VERIFY_OR_DEBUG_ASSERT(it != s_qCOHash.constEnd()) {
+    ControlHandle handle;
+    {
+        RegistryShard& shard = registryShard(key);
+        const MMutexLocker locker(&shard.mutex);
+        handle = shard.handles.value(key);
+    }
+    VERIFY_OR_DEBUG_ASSERT(handle.valid()) {
         qWarning() << "cannot create alias for null control" << key;
         return;
     }
-
-    QSharedPointer<ControlDoublePrivate> pControl = it.value();
-    VERIFY_OR_DEBUG_ASSERT(!pControl.isNull()) {
+    VERIFY_OR_DEBUG_ASSERT(!lookupControlSlot(handle.handle()).isNull()) {
         qWarning() << "cannot create alias for expired control" << key;
         return;
     }
 
-    s_qCOAliasHash.insert(key, alias);
-    s_qCOHash.insert(alias, pControl);
+    {
+        const MMutexLocker locker(&s_qCOAliasHashMutex);
+        s_qCOAliasHash.insert(key, alias);
+    }
+    RegistryShard& aliasShard = registryShard(alias);
+    const MMutexLocker locker(&aliasShard.mutex);
+    aliasShard.handles.insert(alias, handle);
 }
 
 // static
@@ -142,12 +293,16 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
         return nullptr;
     }
 
+    RegistryShard& shard = registryShard(key);
+    // Declared outside of the locked scope, because the destructor locks
+    // the shard if this happens to be the last reference.
+    QSharedPointer<ControlDoublePrivate> pControl;
     // Scope for MMutexLocker.
     {
-        const MMutexLocker locker(&s_qCOHashMutex);
-        const auto it = s_qCOHash.find(key);
-        if (it != s_qCOHash.end()) {
-            auto pControl = it.value().lock();
+        const MMutexLocker locker(&shard.mutex);
+        const auto it = shard.handles.find(key);
+        if (it != shard.handles.end()) {
+            pControl = lookupControlSlot(it.value().handle());
             if (pControl) {
                 // Control object already exists
                 if (pCreatorCO) {
@@ -161,22 +316,25 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
                 return pControl;
             } else {
                 // The weak pointer has become invalid and can be cleaned up
-                s_qCOHash.erase(it);
+                shard.handles.erase(it);
             }
         }
     }
 
     if (pCreatorCO) {
-        auto pControl = QSharedPointer<ControlDoublePrivate>(
+        pControl = QSharedPointer<ControlDoublePrivate>(
                 new ControlDoublePrivate(key,
                         pCreatorCO,
                         bIgnoreNops,
                         bTrack,
                         bPersist,
                         defaultValue));
-        const MMutexLocker locker(&s_qCOHashMutex);
-        //qDebug() << "ControlDoublePrivate::s_qCOHash.insert(" << key.group << "," << key.item << ")";
-        s_qCOHash.insert(key, pControl);
+        pControl->m_handle = ControlHandle(insertControlSlot(pControl));
+        if (pControl->m_handle.valid()) {
+            const MMutexLocker locker(&shard.mutex);
+            //qDebug() << "ControlDoublePrivate::getControl insert(" << key.group << "," << key.item << ")";
+            shard.handles.insert(key, pControl->m_handle);
+        }
         return pControl;
     }
 
@@ -188,6 +346,12 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
     return nullptr;
 }
 
+// static
+QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
+        ControlHandle handle) {
+    return lookupControlSlot(handle.handle());
+}
+
 //static
 QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getDefaultControl() {
     auto defaultCO = s_pDefaultCO.lock();
@@ -195,7 +359,7 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getDefaultControl() {
         // Try again with the mutex locked to protect against creating two
         // ControlDoublePrivateConst objects. Access to s_defaultCO itself is
         // thread save.
-        MMutexLocker locker(&s_qCOHashMutex);
+        MMutexLocker locker(&s_defaultCOMutex);
         defaultCO = s_pDefaultCO.lock();
         if (!defaultCO) {
             defaultCO = QSharedPointer<ControlDoublePrivate>(new ControlDoublePrivateConst());
@@ -208,15 +372,18 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getDefaultControl() {
 // static
 QList<QSharedPointer<ControlDoublePrivate>> ControlDoublePrivate::getAllInstances() {
     QList<QSharedPointer<ControlDoublePrivate>> result;
-    MMutexLocker locker(&s_qCOHashMutex);
-    result.reserve(s_qCOHash.size());
-    for (auto it = s_qCOHash.begin(); it != s_qCOHash.end(); ++it) {
-        auto pControl = it.value().lock();
-        if (pControl) {
-            result.append(std::move(pControl));
-        } else {
-            // The weak pointer has become invalid and can be cleaned up
-            s_qCOHash.erase(it);
+    for (auto& shard : s_registryShards) {
+        MMutexLocker locker(&shard.mutex);
+        result.reserve(result.size() + shard.handles.size());
+        for (auto it = shard.handles.begin(); it != shard.handles.end();) {
+            auto pControl = lookupControlSlot(it.value().handle());
+            if (pControl) {
+                result.append(std::move(pControl));
+                ++it;
+            } else {
+                // The weak pointer has become invalid and can be cleaned up
+                it = shard.handles.erase(it);
+            }
         }
     }
     return result;
@@ -225,21 +392,23 @@ QList<QSharedPointer<ControlDoublePrivate>> ControlDoublePrivate::getAllInstance
 // static
 QList<QSharedPointer<ControlDoublePrivate>> ControlDoublePrivate::takeAllInstances() {
     QList<QSharedPointer<ControlDoublePrivate>> result;
-    MMutexLocker locker(&s_qCOHashMutex);
-    result.reserve(s_qCOHash.size());
-    for (auto it = s_qCOHash.begin(); it != s_qCOHash.end(); ++it) {
-        auto pControl = it.value().lock();
-        if (pControl) {
-            result.append(std::move(pControl));
+    for (auto& shard : s_registryShards) {
+        MMutexLocker locker(&shard.mutex);
+        result.reserve(result.size() + shard.handles.size());
+        for (auto it = shard.handles.begin(); it != shard.handles.end(); ++it) {
+            auto pControl = lookupControlSlot(it.value().handle());
+            if (pControl) {
+                result.append(std::move(pControl));
+            }
         }
+        shard.handles.clear();
     }
-    s_qCOHash.clear();
     return result;
 }
 
 //static
 QHash<ConfigKey, ConfigKey> ControlDoublePrivate::getControlAliases() {
-    MMutexLocker locker(&s_qCOHashMutex);
+    MMutexLocker locker(&s_qCOAliasHashMutex);
     // lock thread-unsafe copy constructors of QHash
     return s_qCOAliasHash;
 }
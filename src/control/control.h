@@ -7,6 +7,7 @@
 #include <QString>
 
 #include "control/controlbehavior.h"
+#include "control/controlhandle.h"
 #include "control/controlvalue.h"
 #include "preferences/usersettings.h"
 #include "util/mutex.h"
@@ -55,6 +56,9 @@ class ControlDoublePrivate : public QObject {
             bool bTrack = false,
             bool bPersist = false,
             double defaultValue = 0.0);
+    /// Resolves a handle that has been obtained from handle(). Lock-free.
+    /// Returns nullptr if the control has been destroyed.
+    static QSharedPointer<ControlDoublePrivate> getControl(ControlHandle handle);
     static QSharedPointer<ControlDoublePrivate> getDefaultControl();
 
     // Returns a list of all existing instances.
@@ -133,6 +137,11 @@ class ControlDoublePrivate : public QObject {
         return m_key;
     }
 
+    /// The handle is invalid for the default control
+    ControlHandle handle() const {
+        return m_handle;
+    }
+
     // Connects a slot to the ValueChange request for CO validation. All change
     // requests issued by set are routed though the connected slot. This can
     // decide with its own thread safe solution if the requested value can be
@@ -174,6 +183,7 @@ class ControlDoublePrivate : public QObject {
     virtual void setInner(double value, QObject* pSender);
 
     const ConfigKey m_key;
+    ControlHandle m_handle;
 
     QAtomicPointer<ControlObject> m_pCreatorCO;
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QDebug>
+#include <QHash>
+
+#include "util/compatibility/qhash.h"
+
+/// A compact integer that refers to a ControlDoublePrivate instance.
+///
+/// Looking up a control by its ConfigKey hashes and compares two QStrings.
+/// Code that needs to access a control repeatedly can resolve the key once
+/// with ControlDoublePrivate::getControl() and then access the control via
+/// its handle. Resolving a handle is lock-free and costs an array access.
+///
+/// The storage of a destroyed control is reused, but its handle is not: the
+/// handle also contains a generation counter. If the control has been
+/// destroyed, resolving its handle returns nullptr, even if a new control
+/// has been created for the same key in the meantime.
+class ControlHandle {
+  public:
+    ControlHandle()
+            : m_iHandle(-1) {
+    }
+
+    bool valid() const {
+        return m_iHandle >= 0;
+    }
+
+    int handle() const {
+        return m_iHandle;
+    }
+
+  private:
+    explicit ControlHandle(int iHandle)
+            : m_iHandle(iHandle) {
+    }
+
+    int m_iHandle;
+
+    friend class ControlDoublePrivate;
+};
+
+inline bool operator==(const ControlHandle& h1, const ControlHandle& h2) {
+    return h1.handle() == h2.handle();
+}
+
+inline bool operator!=(const ControlHandle& h1, const ControlHandle& h2) {
+    return h1.handle() != h2.handle();
+}
+
+inline QDebug operator<<(QDebug stream, const ControlHandle& h) {
+    stream << "ControlHandle(" << h.handle() << ")";
+    return stream;
+}
+
+inline qhash_seed_t qHash(
+        const ControlHandle& handle,
+        qhash_seed_t seed = 0) {
+    return qHash(handle.handle(), seed);
+}
@@ -67,6 +67,15 @@ ControlObject* ControlObject::getControl(const ConfigKey& key, ControlFlags flag
     return nullptr;
 }
 
+// static
+ControlObject* ControlObject::getControl(ControlHandle handle) {
+    QSharedPointer<ControlDoublePrivate> pCDP = ControlDoublePrivate::getControl(handle);
+    if (pCDP) {
+        return pCDP->getCreatorCO();
+    }
+    return nullptr;
+}
+
 void ControlObject::setValueFromMidi(MidiOpCode o, double v) {
     m_pControl->setValueFromMidi(o, v);
 }
@@ -81,6 +90,12 @@ double ControlObject::get(const ConfigKey& key) {
     return pCop ? pCop->get() : 0.0;
 }
 
+// static
+double ControlObject::get(ControlHandle handle) {
+    QSharedPointer<ControlDoublePrivate> pCop = ControlDoublePrivate::getControl(handle);
+    return pCop ? pCop->get() : 0.0;
+}
+
 double ControlObject::getParameter() const {
     return m_pControl->getParameter();
 }
@@ -109,6 +124,14 @@ void ControlObject::set(const ConfigKey& key, const double& value) {
     }
 }
 
+// static
+void ControlObject::set(ControlHandle handle, const double& value) {
+    QSharedPointer<ControlDoublePrivate> pCop = ControlDoublePrivate::getControl(handle);
+    if (pCop) {
+        pCop->set(value, nullptr);
+    }
+}
+
 void ControlObject::setReadOnly() {
     connectValueChangeRequest(this, &ControlObject::readOnlyHandler,
                               Qt::DirectConnection);
@@ -32,6 +32,9 @@ class ControlObject : public QObject {
         ConfigKey key(group, item);
         return getControl(key, flags);
     }
+    // Returns a pointer to the ControlObject matching the given handle
+    // without looking up the key
+    static ControlObject* getControl(ControlHandle handle);
 
     QString name() const {
         return m_pControl ?  m_pControl->name() : QString();
@@ -58,6 +61,11 @@ class ControlObject : public QObject {
         return m_key;
     }
 
+    // Return the handle of the object for repeated lookups
+    inline ControlHandle getHandle() const {
+        return m_pControl ? m_pControl->handle() : ControlHandle();
+    }
+
     // Returns the value of the ControlObject
     inline double get() const {
         return m_pControl ? m_pControl->get() : 0.0;
@@ -70,6 +78,7 @@ class ControlObject : public QObject {
 
     // Instantly returns the value of the ControlObject
     static double get(const ConfigKey& key);
+    static double get(ControlHandle handle);
 
     /// Returns the boolean interpretation of the ControlObject's value.
     static bool toBool(const ConfigKey& key) {
@@ -98,6 +107,7 @@ class ControlObject : public QObject {
 
     // Instantly sets the value of the ControlObject
     static void set(const ConfigKey& key, const double& value);
+    static void set(ControlHandle handle, const double& value);
 
     // Sets the default value
     inline void reset() {
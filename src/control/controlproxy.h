@@ -29,6 +29,10 @@ class ControlProxy : public QObject {
 
     const ConfigKey& getKey() const;
 
+    ControlHandle getHandle() const {
+        return m_pControl->handle();
+    }
+
     template<typename Receiver, typename Slot>
     bool connectValueChanged(Receiver receiver,
             Slot func,
@@ -8,6 +8,8 @@
 #include "controllers/defs_controllers.h"
 #include "moc_controller.cpp"
 #include "util/screensaver.h"
+#include "util/stat.h"
+#include "util/time.h"
 
 namespace {
 QString loggingCategoryPrefix(const QString& deviceName) {
@@ -25,7 +27,8 @@ Controller::Controller(const QString& deviceName)
           m_bIsOutputDevice(false),
           m_bIsInputDevice(false),
           m_bIsOpen(false),
-          m_bLearning(false) {
+          m_bLearning(false),
+          m_inputLatencyStatKey(QStringLiteral("Controller input latency ") + deviceName) {
     m_userActivityInhibitTimer.start();
 }
 
@@ -114,6 +117,16 @@ void Controller::triggerActivity()
         m_userActivityInhibitTimer.start();
     }
 }
+
+void Controller::trackInputLatency(mixxx::Duration readTime) {
+    const mixxx::Duration latency = mixxx::Time::elapsed() - readTime;
+    Stat::track(m_inputLatencyStatKey,
+            Stat::DURATION_NANOSEC,
+            Stat::experimentFlags(Stat::COUNT | Stat::AVERAGE |
+                    Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX),
+            latency.toIntegerNanos());
+}
+
 void Controller::receive(const QByteArray& data, mixxx::Duration timestamp) {
     if (!m_pScriptEngineLegacy) {
         //qWarning() << "Controller::receive called with no active engine!";
@@ -117,6 +117,12 @@ class Controller : public QObject {
     // To be called when receiving events
     void triggerActivity();
 
+    /// Reports the time since an input message has been read from the device
+    /// by the StatsManager. To be called after the message has been processed
+    /// by the mapping, i.e. after the control values have been changed.
+    /// The read time must be obtained from mixxx::Time::elapsed().
+    void trackInputLatency(mixxx::Duration readTime);
+
     inline ControllerScriptEngineLegacy* getScriptEngine() const {
         return m_pScriptEngineLegacy;
     }
@@ -167,6 +173,7 @@ class Controller : public QObject {
     bool m_bIsOpen;
     bool m_bLearning;
     QElapsedTimer m_userActivityInhibitTimer;
+    const QString m_inputLatencyStatKey;
 
     friend class ControllerJSProxy;
     // accesses lots of our stuff, but in the same thread
@@ -10,6 +10,7 @@
 #include "util/cmdlineargs.h"
 #include "util/compatibility/qmutex.h"
 #include "util/time.h"
+#include "util/timer.h"
 #include "util/trace.h"
 #ifdef __HSS1394__
 #include "controllers/midi/hss1394enumerator.h"
@@ -25,7 +26,8 @@
 
 // http://developer.qt.nokia.com/wiki/Threads_Events_QObjects
 
-// Poll every 1ms (where possible) for good controller response
+// Poll every 1ms (where possible) for good controller response. Only used
+// for devices that do not read their input on a dedicated thread.
 #ifdef __LINUX__
 // Many Linux distros ship with the system tick set to 250Hz so 1ms timer
 // reportedly causes CPU hosage. See Bug #990992 rryan 6/2012
@@ -103,6 +105,11 @@ ControllerManager::ControllerManager(UserSettingsPointer pConfig)
 
     m_pThread = new QThread;
     m_pThread->setObjectName("Controller");
+    connect(m_pThread,
+            &QThread::started,
+            [] {
+                mixxx::Tracing::registerCurrentThread("Controller");
+            });
 
     // Moves all children (including the poll timer) to m_pThread
     moveToThread(m_pThread);
@@ -291,6 +298,7 @@ void ControllerManager::slotSetUpDevices() {
             qWarning() << "There was a problem opening" << name;
             continue;
         }
+        ScopedTimer timer("ControllerManager::applyMapping %1", name);
         pController->applyMapping();
     }
 
@@ -383,7 +391,11 @@ void ControllerManager::openController(Controller* pController) {
     // If successfully opened the device, apply the mapping and save the
     // preference setting.
     if (result == 0) {
-        pController->applyMapping();
+        {
+            ScopedTimer timer("ControllerManager::applyMapping %1",
+                    pController->getName());
+            pController->applyMapping();
+        }
 
         // Update configuration to reflect controller is enabled.
         m_pConfig->setValue(
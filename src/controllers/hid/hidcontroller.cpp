@@ -111,7 +111,7 @@ int HidController::open() {
     connect(m_pHidIoThread.get(),
             &HidIoThread::receive,
             this,
-            &HidController::receive,
+            &HidController::receiveInputReport,
             Qt::QueuedConnection);
 
     // Controller input needs to be prioritized since it can affect the
@@ -197,6 +197,12 @@ int HidController::close() {
     return 0;
 }
 
+void HidController::receiveInputReport(const QByteArray& data, mixxx::Duration timestamp) {
+    // The timestamp of the HidIoThread is taken from mixxx::Time
+    receive(data, timestamp);
+    trackInputLatency(timestamp);
+}
+
 /// This function is only for class compatibility with the (midi)controller
 /// and will not do the same as for MIDI devices,
 /// because sending of raw bytes is not a supported HIDAPI feature.
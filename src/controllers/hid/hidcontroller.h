@@ -36,6 +36,9 @@ class HidController final : public Controller {
     int open() override;
     int close() override;
 
+    /// Processes an InputReport that has been read by the HidIoThread
+    void receiveInputReport(const QByteArray& data, mixxx::Duration timestamp);
+
   private:
     // For devices which only support a single report, reportID must be set to
     // 0x0.
@@ -57,6 +57,7 @@ HidIoThread::~HidIoThread() {
 }
 
 void HidIoThread::run() {
+    mixxx::Tracing::registerCurrentThread("HidIoThread");
     const QSemaphoreReleaser releaser(m_runLoopSemaphore);
     m_runLoopSemaphore.acquire();
     while (!testAndSetThreadState(HidIoThreadState::StopRequested, HidIoThreadState::Stopped)) {
@@ -93,6 +93,8 @@ LegacyMidiControllerMappingFileHandler::load(const QDomElement& root,
                 options.setFlag(MidiOption::SoftTakeover);
             } else if (strMidiOption == QLatin1String("script-binding")) {
                 options.setFlag(MidiOption::Script);
+            } else if (strMidiOption == QLatin1String("batch")) {
+                options.setFlag(MidiOption::Batch);
             } else if (strMidiOption == QLatin1String("fourteen-bit-msb")) {
                 options.setFlag(MidiOption::FourteenBitMSB);
             } else if (strMidiOption == QLatin1String("fourteen-bit-lsb")) {
@@ -350,6 +352,10 @@ QDomElement LegacyMidiControllerMappingFileHandler::inputMappingToXML(
             QDomElement singleOption = doc->createElement("script-binding");
             optionsNode.appendChild(singleOption);
         }
+        if (mapping.options.testFlag(MidiOption::Batch)) {
+            QDomElement singleOption = doc->createElement("batch");
+            optionsNode.appendChild(singleOption);
+        }
         if (mapping.options.testFlag(MidiOption::FourteenBitMSB)) {
             QDomElement singleOption = doc->createElement("fourteen-bit-msb");
             optionsNode.appendChild(singleOption);
@@ -11,7 +11,8 @@
 #include "util/screensaver.h"
 
 MidiController::MidiController(const QString& deviceName)
-        : Controller(deviceName) {
+        : Controller(deviceName),
+          m_inputBatchActive(false) {
     setDeviceCategory(tr("MIDI Controller"));
 }
 
@@ -41,6 +42,8 @@ std::shared_ptr<LegacyControllerMapping> MidiController::cloneMapping() {
 }
 
 int MidiController::close() {
+    m_inputBatchActive = false;
+    m_pendingScriptCall.values.clear();
     destroyOutputHandlers();
     return 0;
 }
@@ -256,6 +259,41 @@ void MidiController::receivedShortMessage(unsigned char status,
     }
 }
 
+void MidiController::beginInputBatch() {
+    DEBUG_ASSERT(!m_inputBatchActive);
+    m_inputBatchActive = true;
+}
+
+void MidiController::endInputBatch() {
+    flushPendingScriptCall();
+    m_inputBatchActive = false;
+}
+
+void MidiController::flushPendingScriptCall() {
+    if (m_pendingScriptCall.values.isEmpty()) {
+        return;
+    }
+    ControllerScriptEngineLegacy* pEngine = getScriptEngine();
+    if (pEngine != nullptr) {
+        const MidiInputMapping& mapping = m_pendingScriptCall.mapping;
+        QJSValue function = pEngine->wrapFunctionCode(mapping.control.item, 6);
+        const auto args = QJSValueList{
+                MidiUtils::channelFromStatus(m_pendingScriptCall.status),
+                m_pendingScriptCall.control,
+                m_pendingScriptCall.values.last(),
+                m_pendingScriptCall.status,
+                mapping.control.group,
+                pEngine->newValueArray(m_pendingScriptCall.values),
+        };
+        if (!pEngine->executeFunction(function, args)) {
+            qCWarning(m_logBase) << "MidiController: Invalid script function"
+                                 << mapping.control.item;
+        }
+    }
+    // Keep the capacity for the next batch
+    m_pendingScriptCall.values.resize(0);
+}
+
 void MidiController::processInputMapping(const MidiInputMapping& mapping,
                                          unsigned char status,
                                          unsigned char control,
@@ -265,6 +303,27 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
     unsigned char channel = MidiUtils::channelFromStatus(status);
     MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
 
+    if (!m_pendingScriptCall.values.isEmpty() &&
+            !(m_pendingScriptCall.mapping == mapping)) {
+        // Preserve the order of messages for different mappings
+        flushPendingScriptCall();
+    }
+
+    if (mapping.options.testFlag(MidiOption::Script) &&
+            mapping.options.testFlag(MidiOption::Batch)) {
+        if (m_pendingScriptCall.values.isEmpty()) {
+            m_pendingScriptCall.mapping = mapping;
+            m_pendingScriptCall.status = status;
+            m_pendingScriptCall.control = control;
+        }
+        m_pendingScriptCall.values.append(value);
+        if (!m_inputBatchActive) {
+            // The script function receives an array with a single value
+            flushPendingScriptCall();
+        }
+        return;
+    }
+
     if (mapping.options.testFlag(MidiOption::Script)) {
         ControllerScriptEngineLegacy* pEngine = getScriptEngine();
         if (pEngine == nullptr) {
@@ -522,6 +581,7 @@ void MidiController::receive(const QByteArray& data, mixxx::Duration timestamp)
 void MidiController::processInputMapping(const MidiInputMapping& mapping,
                                          const QByteArray& data,
                                          mixxx::Duration timestamp) {
+    flushPendingScriptCall();
     // Custom script handler
     if (mapping.options.testFlag(MidiOption::Script)) {
         ControllerScriptEngineLegacy* pEngine = getScriptEngine();
@@ -53,6 +53,13 @@ class MidiController : public Controller {
         send(data);
     }
 
+    /// Subclasses that receive messages in bursts enclose their processing
+    /// with these calls. Consecutive messages for the same MidiOption::Batch
+    /// script mapping are then passed to the script function in a single
+    /// call instead of one call per message.
+    void beginInputBatch();
+    void endInputBatch();
+
   protected slots:
     virtual void receivedShortMessage(
             unsigned char status,
@@ -82,6 +89,9 @@ class MidiController : public Controller {
             const QByteArray& data,
             mixxx::Duration timestamp);
 
+    /// Invokes the script function of the pending batch, if any
+    void flushPendingScriptCall();
+
     double computeValue(MidiOptions options, double _prevmidivalue, double _newmidivalue);
     void createOutputHandlers();
     void updateAllOutputs();
@@ -93,6 +103,17 @@ class MidiController : public Controller {
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char>> m_fourteen_bit_queued_mappings;
 
+    bool m_inputBatchActive;
+    /// Values of consecutive messages for a MidiOption::Batch mapping that
+    /// have not been passed to the script function yet
+    struct PendingScriptCall {
+        MidiInputMapping mapping;
+        unsigned char status;
+        unsigned char control;
+        QVector<unsigned char> values;
+    };
+    PendingScriptCall m_pendingScriptCall;
+
     // So it can access sendShortMsg()
     friend class MidiOutputHandler;
     friend class MidiControllerTest;
@@ -126,6 +126,10 @@ enum class MidiOption : uint16_t {
     FourteenBitMSB = 0x2000,
     /// Generic Hercules Range Correction (0x01 -> +5; 0x7f -> -5)
     HercJogFast = 0x4000,
+    /// Coalesces consecutive messages of a burst into a single invocation
+    /// of the script function, which receives all values as an additional
+    /// array argument
+    Batch = 0x8000,
 };
 Q_DECLARE_FLAGS(MidiOptions, MidiOption);
 Q_DECLARE_OPERATORS_FOR_FLAGS(MidiOptions);
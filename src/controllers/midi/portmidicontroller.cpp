@@ -20,6 +20,7 @@ PortMidiController::PortMidiController(const PmDeviceInfo* inputDeviceInfo,
           m_bInSysex(false) {
     for (int k = 0; k < MIXXX_PORTMIDI_BUFFER_LEN; ++k) {
         m_midiBuffer[k] = {0, 0};
+        m_inputEvents[k] = {{0, 0}, mixxx::Duration()};
     }
 
     // Note: We prepend the input stream's index to the device's name to prevent
@@ -81,6 +82,20 @@ int PortMidiController::open() {
 
     setOpen(true);
     startEngine();
+
+    if (m_pInputDevice && m_pInputDevice->isOpen()) {
+        m_pInputThread = std::make_unique<PortMidiInputThread>(
+                m_pInputDevice.data(), m_logInput);
+        m_pInputThread->setObjectName(QStringLiteral("PortMidiInputThread ") + getName());
+        connect(m_pInputThread.get(),
+                &PortMidiInputThread::eventsAvailable,
+                this,
+                &PortMidiController::processInputEvents,
+                Qt::QueuedConnection);
+        // Controller input needs to be prioritized since it can affect the
+        // audio directly, like when scratching
+        m_pInputThread->start(QThread::HighPriority);
+    }
     return 0;
 }
 
@@ -90,6 +105,12 @@ int PortMidiController::close() {
         return -1;
     }
 
+    if (m_pInputThread) {
+        // Pending messages are discarded
+        m_pInputThread->stop();
+        m_pInputThread.reset();
+    }
+
     stopEngine();
     MidiController::close();
 
@@ -131,64 +152,89 @@ bool PortMidiController::poll() {
     }
 
     for (int i = 0; i < numEvents; i++) {
-        unsigned char status = Pm_MessageStatus(m_midiBuffer[i].message);
-        mixxx::Duration timestamp = mixxx::Duration::fromMillis(m_midiBuffer[i].timestamp);
+        processEvent(m_midiBuffer[i]);
+    }
+    return numEvents > 0;
+}
 
-        if ((status & 0xF8) == 0xF8) {
-            // Handle real-time MIDI messages at any time
-            receivedShortMessage(status, 0, 0, timestamp);
-            continue;
+void PortMidiController::processInputEvents() {
+    if (!m_pInputThread) {
+        // Queued signal after closing the device
+        return;
+    }
+    int numEvents;
+    while ((numEvents = m_pInputThread->takeEvents(
+                    m_inputEvents, MIXXX_PORTMIDI_BUFFER_LEN)) > 0) {
+        beginInputBatch();
+        for (int i = 0; i < numEvents; i++) {
+            processEvent(m_inputEvents[i].event);
+        }
+        endInputBatch();
+        // The latency includes the batched script call, which is only
+        // invoked when the batch ends
+        for (int i = 0; i < numEvents; i++) {
+            trackInputLatency(m_inputEvents[i].readTime);
         }
+    }
+}
 
-        reprocessMessage:
-
-        if (!m_bInSysex) {
-            if (status == 0xF0) {
-                m_bInSysex = true;
-                status = 0;
-            } else {
-                //unsigned char channel = status & 0x0F;
-                unsigned char note = Pm_MessageData1(m_midiBuffer[i].message);
-                unsigned char velocity = Pm_MessageData2(m_midiBuffer[i].message);
-                receivedShortMessage(status, note, velocity, timestamp);
-            }
+void PortMidiController::processEvent(const PmEvent& event) {
+    unsigned char status = Pm_MessageStatus(event.message);
+    mixxx::Duration timestamp = mixxx::Duration::fromMillis(event.timestamp);
+
+    if ((status & 0xF8) == 0xF8) {
+        // Handle real-time MIDI messages at any time
+        receivedShortMessage(status, 0, 0, timestamp);
+        return;
+    }
+
+    reprocessMessage:
+
+    if (!m_bInSysex) {
+        if (status == 0xF0) {
+            m_bInSysex = true;
+            status = 0;
+        } else {
+            //unsigned char channel = status & 0x0F;
+            unsigned char note = Pm_MessageData1(event.message);
+            unsigned char velocity = Pm_MessageData2(event.message);
+            receivedShortMessage(status, note, velocity, timestamp);
         }
+    }
 
-        if (m_bInSysex) {
-            // Abort (drop) the current System Exclusive message if a
-            //  non-realtime status byte was received
-            if (status > 0x7F && status < 0xF7) {
-                m_bInSysex = false;
-                m_cReceiveMsg_index = 0;
-                qCWarning(m_logInput) << "Buggy MIDI device: SysEx interrupted!";
-                goto reprocessMessage;    // Don't lose the new message
-            }
+    if (m_bInSysex) {
+        // Abort (drop) the current System Exclusive message if a
+        //  non-realtime status byte was received
+        if (status > 0x7F && status < 0xF7) {
+            m_bInSysex = false;
+            m_cReceiveMsg_index = 0;
+            qCWarning(m_logInput) << "Buggy MIDI device: SysEx interrupted!";
+            goto reprocessMessage;    // Don't lose the new message
+        }
 
-            // Collect bytes from PmMessage
-            uint8_t data = 0;
-            for (int shift = 0; shift < 32 &&
-                    (data != MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive));
-                    shift += 8) {
-                // TODO(rryan): This prevents buffer overflow if the sysex is
-                // larger than 1024 bytes. I don't want to radically change
-                // anything before the 2.0 release so this will do for now.
-                data = (m_midiBuffer[i].message >> shift) & 0xFF;
-                if (m_cReceiveMsg_index < MIXXX_SYSEX_BUFFER_LEN) {
-                    m_cReceiveMsg[m_cReceiveMsg_index++] = data;
-                }
+        // Collect bytes from PmMessage
+        uint8_t data = 0;
+        for (int shift = 0; shift < 32 &&
+                (data != MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive));
+                shift += 8) {
+            // TODO(rryan): This prevents buffer overflow if the sysex is
+            // larger than 1024 bytes. I don't want to radically change
+            // anything before the 2.0 release so this will do for now.
+            data = (event.message >> shift) & 0xFF;
+            if (m_cReceiveMsg_index < MIXXX_SYSEX_BUFFER_LEN) {
+                m_cReceiveMsg[m_cReceiveMsg_index++] = data;
             }
+        }
 
-            // End System Exclusive message if the EOX byte was received
-            if (data == MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive)) {
-                m_bInSysex = false;
-                const char* buffer = reinterpret_cast<const char*>(m_cReceiveMsg);
-                receive(QByteArray::fromRawData(buffer, m_cReceiveMsg_index),
-                        timestamp);
-                m_cReceiveMsg_index = 0;
-            }
+        // End System Exclusive message if the EOX byte was received
+        if (data == MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive)) {
+            m_bInSysex = false;
+            const char* buffer = reinterpret_cast<const char*>(m_cReceiveMsg);
+            receive(QByteArray::fromRawData(buffer, m_cReceiveMsg_index),
+                    timestamp);
+            m_cReceiveMsg_index = 0;
         }
     }
-    return numEvents > 0;
 }
 
 void PortMidiController::sendShortMsg(unsigned char status, unsigned char byte1,
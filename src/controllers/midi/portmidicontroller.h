@@ -3,9 +3,11 @@
 #include <portmidi.h>
 
 #include <QScopedPointer>
+#include <memory>
 
 #include "controllers/midi/midicontroller.h"
 #include "controllers/midi/portmididevice.h"
+#include "controllers/midi/portmidiinputthread.h"
 
 // Note:
 // A standard Midi device runs at 31.25 kbps, with 10 bits / byte
@@ -46,6 +48,9 @@
 /// physical device as two separate half-duplex devices. In this class, we wrap
 /// those together into a single device, which is why the constructor takes
 /// both arguments pertaining to both input and output "devices".
+///
+/// The input is read by a PortMidiInputThread and processed as soon as
+/// it has been received instead of being polled by the ControllerManager.
 class PortMidiController : public MidiController {
     Q_OBJECT
   public:
@@ -60,6 +65,11 @@ class PortMidiController : public MidiController {
     int close() override;
     bool poll() override;
 
+    /// Processes the messages that have been read by the input thread.
+    /// Each read of up to MIXXX_PORTMIDI_BUFFER_LEN messages is an input
+    /// batch.
+    void processInputEvents();
+
   protected:
     // MockPortMidiController needs this to not be private.
     void sendShortMsg(unsigned char status, unsigned char byte1,
@@ -70,9 +80,7 @@ class PortMidiController : public MidiController {
     // 0xf7.
     void sendBytes(const QByteArray& data) override;
 
-    bool isPolling() const override {
-        return true;
-    }
+    void processEvent(const PmEvent& event);
 
     // For testing only so that test fixtures can install mock PortMidiDevices.
     void setPortMidiInputDevice(PortMidiDevice* device) {
@@ -84,8 +92,10 @@ class PortMidiController : public MidiController {
 
     QScopedPointer<PortMidiDevice> m_pInputDevice;
     QScopedPointer<PortMidiDevice> m_pOutputDevice;
+    std::unique_ptr<PortMidiInputThread> m_pInputThread;
 
     PmEvent m_midiBuffer[MIXXX_PORTMIDI_BUFFER_LEN];
+    PortMidiInputEvent m_inputEvents[MIXXX_PORTMIDI_BUFFER_LEN];
 
     // Storage for SysEx messages
     unsigned char m_cReceiveMsg[MIXXX_SYSEX_BUFFER_LEN];
@@ -2,6 +2,8 @@
 
 #include <portmidi.h>
 
+#include "util/compatibility/qmutex.h"
+
 class PortMidiDevice {
   public:
     PortMidiDevice(const PmDeviceInfo* deviceInfo,
@@ -27,6 +29,8 @@ class PortMidiDevice {
     }
 
     virtual PmError openInput(int32_t bufferSize) {
+        const auto locker = lockMutex(&m_mutex);
+        const auto globalLocker = lockMutex(&s_globalMutex);
         return Pm_OpenInput(&m_pStream, m_deviceIndex,
                             NULL, // no drive hacks
                             bufferSize,
@@ -35,6 +39,8 @@ class PortMidiDevice {
     }
 
     virtual PmError openOutput() {
+        const auto locker = lockMutex(&m_mutex);
+        const auto globalLocker = lockMutex(&s_globalMutex);
         return Pm_OpenOutput(&m_pStream,
                              m_deviceIndex,
                              NULL, // No driver hacks
@@ -45,28 +51,62 @@ class PortMidiDevice {
     }
 
     virtual PmError close() {
+        const auto locker = lockMutex(&m_mutex);
+        const auto globalLocker = lockMutex(&s_globalMutex);
         PmError err = Pm_Close(m_pStream);
         m_pStream = NULL;
         return err;
     }
 
     virtual PmError poll() {
+        const auto locker = lockMutex(&m_mutex);
+        const auto ioLocker = lockMutex(sharedIoMutex());
         return Pm_Poll(m_pStream);
     }
 
     virtual int read(PmEvent* buffer, int32_t length) {
+        const auto locker = lockMutex(&m_mutex);
+        const auto ioLocker = lockMutex(sharedIoMutex());
         return Pm_Read(m_pStream, buffer, length);
     }
 
     virtual PmError writeShort(int32_t message) {
+        const auto locker = lockMutex(&m_mutex);
+        const auto ioLocker = lockMutex(sharedIoMutex());
         return Pm_WriteShort(m_pStream, 0, message);
     }
 
     virtual PmError writeSysEx(unsigned char* message) {
+        const auto locker = lockMutex(&m_mutex);
+        const auto ioLocker = lockMutex(sharedIoMutex());
         return Pm_WriteSysEx(m_pStream, 0, message);
     }
 
   private:
+    // Returns the mutex that serializes I/O on streams of different
+    // devices or nullptr if the backend does not need it.
+    static QMutex* sharedIoMutex() {
+#ifdef __LINUX__
+        // The ALSA backend of PortMidi uses a single sequencer handle for
+        // all streams. Pm_Poll()/Pm_Read() dispatch the input of all
+        // devices from it and Pm_Write*() send through it.
+        return &s_globalMutex;
+#else
+        // CoreMIDI and WinMM use separate queues for each stream.
+        return nullptr;
+#endif
+    }
+
+    // The input of a device is read by a PortMidiInputThread while the
+    // output is sent from the controller thread. Each device has its own
+    // mutex that protects its stream, so devices don't block each other.
+    // The global mutex is additionally locked for the calls that modify
+    // the shared state of PortMidi: Pm_OpenInput(), Pm_OpenOutput() and
+    // Pm_Close() update the global descriptor table. See sharedIoMutex()
+    // for stream I/O. The device mutex is always locked first.
+    QMutex m_mutex;
+    static inline QMutex s_globalMutex;
+
     const PmDeviceInfo* m_pDeviceInfo;
     int m_deviceIndex;
     PortMidiStream* m_pStream;
@@ -0,0 +1,115 @@
+#include "controllers/midi/portmidiinputthread.h"
+
+#include "controllers/midi/portmididevice.h"
+#include "moc_portmidiinputthread.cpp"
+#include "util/assert.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+namespace {
+
+// PortMidi does not provide a blocking read, so the device is polled.
+// While the user interacts with the controller messages arrive in bursts,
+// e.g. ~1000 messages per second when scratching, see portmidicontroller.h.
+// The run loop polls frequently shortly after a message has been received
+// to keep the latency low and backs off to a longer sleep time when the
+// device is idle to not waste CPU time. The idle sleep time is the upper
+// bound of the latency of the first message after a pause and must not
+// exceed the interval of the former poll timer (1 ms, 5 ms on Linux).
+constexpr unsigned long kSleepTimeWhenActiveMicros = 250;
+#ifdef __LINUX__
+constexpr unsigned long kSleepTimeWhenIdleMicros = 4000;
+#else
+constexpr unsigned long kSleepTimeWhenIdleMicros = 1000;
+#endif
+constexpr mixxx::Duration kActiveTimeout = mixxx::Duration::fromMillis(200);
+
+// The messages of ~1.3 s of a 3x speed MIDI device
+constexpr int kFifoSize = 4096;
+
+} // namespace
+
+PortMidiInputThread::PortMidiInputThread(PortMidiDevice* pDevice,
+        const RuntimeLoggingCategory& logInput)
+        : m_pDevice(pDevice),
+          m_logInput(logInput),
+          m_events(kFifoSize),
+          m_stop(false),
+          m_eventsSignaled(false),
+          m_pollFailed(false),
+          m_overflowed(false) {
+    DEBUG_ASSERT(m_pDevice);
+}
+
+PortMidiInputThread::~PortMidiInputThread() {
+    stop();
+}
+
+void PortMidiInputThread::stop() {
+    m_stop.store(true);
+    wait();
+}
+
+int PortMidiInputThread::takeEvents(PortMidiInputEvent* pEvents, int maxCount) {
+    // Reset before reading to not miss any messages that are written
+    // concurrently
+    m_eventsSignaled.store(false);
+    return m_events.read(pEvents, maxCount);
+}
+
+void PortMidiInputThread::run() {
+    mixxx::Tracing::registerCurrentThread("PortMidiInputThread");
+    // Start idle until the first message arrives
+    mixxx::Duration lastEventTime = mixxx::Time::elapsed() - kActiveTimeout;
+    while (!m_stop.load()) {
+        const PmError result = m_pDevice->poll();
+        if (result == pmGotData) {
+            m_pollFailed = false;
+            readEvents();
+            lastEventTime = mixxx::Time::elapsed();
+            continue;
+        }
+        if (result < 0 && !m_pollFailed) {
+            // Only warn once about a permanent error
+            qCWarning(m_logInput) << "PortMidi error:" << Pm_GetErrorText(result);
+            m_pollFailed = true;
+        }
+        if (mixxx::Time::elapsed() - lastEventTime < kActiveTimeout) {
+            usleep(kSleepTimeWhenActiveMicros);
+        } else {
+            usleep(kSleepTimeWhenIdleMicros);
+        }
+    }
+}
+
+void PortMidiInputThread::readEvents() {
+    Trace trace("PortMidiInputThread readEvents");
+    const int numEvents = m_pDevice->read(m_midiBuffer, kReadBufferSize);
+    if (numEvents < 0) {
+        qCWarning(m_logInput) << "PortMidi error:"
+                              << Pm_GetErrorText(static_cast<PmError>(numEvents));
+        return;
+    }
+    if (numEvents == 0) {
+        return;
+    }
+
+    const auto readTime = mixxx::Time::elapsed();
+    for (int i = 0; i < numEvents; ++i) {
+        m_readEvents[i] = PortMidiInputEvent{m_midiBuffer[i], readTime};
+    }
+    const int written = m_events.write(m_readEvents, numEvents);
+    if (written < numEvents) {
+        if (!m_overflowed) {
+            qCWarning(m_logInput) << "Dropped" << numEvents - written
+                                  << "MIDI messages, because they are not processed in time";
+            m_overflowed = true;
+        }
+    } else {
+        m_overflowed = false;
+    }
+
+    if (!m_eventsSignaled.exchange(true)) {
+        emit eventsAvailable();
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <portmidi.h>
+
+#include <QThread>
+#include <atomic>
+
+#include "util/duration.h"
+#include "util/fifo.h"
+#include "util/runtimeloggingcategory.h"
+
+class PortMidiDevice;
+
+/// A MIDI message with the time when it has been read from the device
+struct PortMidiInputEvent {
+    PmEvent event;
+    /// From mixxx::Time::elapsed()
+    mixxx::Duration readTime;
+};
+
+/// Reads the input of a PortMidi device on a dedicated thread, so the
+/// controller thread is only woken up when messages have been received
+/// instead of polling all devices periodically.
+///
+/// PortMidi does not provide a blocking read, so the device is polled in
+/// a loop. The loop polls frequently while messages are arriving and
+/// sleeps for several milliseconds while the device is idle. The messages
+/// are passed to the controller thread through a lock-free FIFO.
+class PortMidiInputThread : public QThread {
+    Q_OBJECT
+  public:
+    PortMidiInputThread(PortMidiDevice* pDevice,
+            const RuntimeLoggingCategory& logInput);
+    ~PortMidiInputThread() override;
+
+    /// Stops reading and waits until the thread has finished
+    void stop();
+
+    /// Takes up to maxCount messages that have been read by the thread.
+    /// Must be invoked until no more messages are returned after
+    /// eventsAvailable() has been emitted. Must only be invoked from
+    /// a single thread.
+    int takeEvents(PortMidiInputEvent* pEvents, int maxCount);
+
+  signals:
+    /// Emitted when messages are available after all previous
+    /// messages have been taken.
+    void eventsAvailable();
+
+  protected:
+    void run() override;
+
+  private:
+    static constexpr int kReadBufferSize = 64;
+
+    void readEvents();
+
+    PortMidiDevice* const m_pDevice;
+    const RuntimeLoggingCategory m_logInput;
+
+    FIFO<PortMidiInputEvent> m_events;
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_eventsSignaled;
+    // Only accessed by the thread
+    bool m_pollFailed;
+    bool m_overflowed;
+    PmEvent m_midiBuffer[kReadBufferSize];
+    PortMidiInputEvent m_readEvents[kReadBufferSize];
+};
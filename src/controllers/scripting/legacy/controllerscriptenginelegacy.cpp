@@ -67,7 +67,9 @@ QJSValue ControllerScriptEngineLegacy::wrapFunctionCode(
 
     QJSValue wrappedFunction;
 
-    const auto it = m_scriptWrappedFunctionCache.constFind(codeSnippet);
+    // The same snippet might be wrapped with a different number of arguments
+    const auto cacheKey = qMakePair(codeSnippet, numberOfArgs);
+    const auto it = m_scriptWrappedFunctionCache.constFind(cacheKey);
     if (it != m_scriptWrappedFunctionCache.constEnd()) {
         wrappedFunction = it.value();
     } else {
@@ -85,11 +87,23 @@ QJSValue ControllerScriptEngineLegacy::wrapFunctionCode(
         if (wrappedFunction.isError()) {
             showScriptExceptionDialog(wrappedFunction);
         }
-        m_scriptWrappedFunctionCache[codeSnippet] = wrappedFunction;
+        m_scriptWrappedFunctionCache[cacheKey] = wrappedFunction;
     }
     return wrappedFunction;
 }
 
+QJSValue ControllerScriptEngineLegacy::newValueArray(
+        const QVector<unsigned char>& values) {
+    if (!m_pJSEngine) {
+        return QJSValue();
+    }
+    QJSValue array = m_pJSEngine->newArray(static_cast<uint>(values.size()));
+    for (int i = 0; i < values.size(); ++i) {
+        array.setProperty(static_cast<quint32>(i), values[i]);
+    }
+    return array;
+}
+
 void ControllerScriptEngineLegacy::setScriptFiles(
         const QList<LegacyControllerMapping::ScriptFileInfo>& scripts) {
     const QStringList paths = m_fileWatcher.files();
@@ -26,6 +26,10 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
     /// and ensures the function is executed with the correct 'this' object.
     QJSValue wrapFunctionCode(const QString& codeSnippet, int numberOfArgs);
 
+    /// Creates a JS array with the values of a burst of MIDI messages that
+    /// are passed to a script function in a single call.
+    QJSValue newValueArray(const QVector<unsigned char>& values);
+
   public slots:
     void setScriptFiles(const QList<LegacyControllerMapping::ScriptFileInfo>& scripts);
 
@@ -42,7 +46,7 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
     QJSValue m_makeArrayBufferWrapperFunction;
     QList<QString> m_scriptFunctionPrefixes;
     QList<QJSValue> m_incomingDataFunctions;
-    QHash<QString, QJSValue> m_scriptWrappedFunctionCache;
+    QHash<QPair<QString, int>, QJSValue> m_scriptWrappedFunctionCache;
     QList<LegacyControllerMapping::ScriptFileInfo> m_scriptFiles;
 
     QFileSystemWatcher m_fileWatcher;
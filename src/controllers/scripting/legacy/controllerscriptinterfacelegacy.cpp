@@ -76,35 +76,47 @@ ControllerScriptInterfaceLegacy::~ControllerScriptInterfaceLegacy() {
     }
 
     // Free all the ControlObjectScripts
-    {
-        auto it = m_controlCache.begin();
-        while (it != m_controlCache.end()) {
-            qCDebug(m_logger)
-                    << "Deleting ControlObjectScript"
-                    << it.key().group
-                    << it.key().item;
-            delete it.value();
-            // Advance iterator
-            it = m_controlCache.erase(it);
-        }
-    }
+    for (ControlObjectScript* coScript : m_controls) {
+        qCDebug(m_logger)
+                << "Deleting ControlObjectScript"
+                << coScript->getKey().group
+                << coScript->getKey().item;
+        delete coScript;
+    }
+    m_controls.clear();
+    m_controlHandles.clear();
 }
 
 ControlObjectScript* ControllerScriptInterfaceLegacy::getControlObjectScript(
         const QString& group, const QString& name) {
-    ConfigKey key = ConfigKey(group, name);
-    ControlObjectScript* coScript = m_controlCache.value(key, nullptr);
-    if (coScript == nullptr) {
-        // create COT
-        coScript = new ControlObjectScript(key, m_logger, this);
-        if (coScript->valid()) {
-            m_controlCache.insert(key, coScript);
-        } else {
-            delete coScript;
-            coScript = nullptr;
-        }
+    return getControlObjectScriptByHandle(getControlHandle(group, name));
+}
+
+ControlObjectScript* ControllerScriptInterfaceLegacy::getControlObjectScriptByHandle(
+        int handle) {
+    if (handle < 0 || handle >= static_cast<int>(m_controls.size())) {
+        return nullptr;
     }
-    return coScript;
+    return m_controls[handle];
+}
+
+int ControllerScriptInterfaceLegacy::getControlHandle(
+        const QString& group, const QString& name) {
+    ConfigKey key = ConfigKey(group, name);
+    const auto it = m_controlHandles.constFind(key);
+    if (it != m_controlHandles.constEnd()) {
+        return it.value();
+    }
+    // create COT
+    auto* coScript = new ControlObjectScript(key, m_logger, this);
+    if (!coScript->valid()) {
+        delete coScript;
+        return -1;
+    }
+    const int handle = static_cast<int>(m_controls.size());
+    m_controls.push_back(coScript);
+    m_controlHandles.insert(key, handle);
+    return handle;
 }
 
 double ControllerScriptInterfaceLegacy::getValue(const QString& group, const QString& name) {
@@ -126,15 +138,19 @@ void ControllerScriptInterfaceLegacy::setValue(
     }
 
     ControlObjectScript* coScript = getControlObjectScript(group, name);
-
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(
-                coScript->getKey(), ControlFlag::AllowMissingOrInvalid);
-        if (pControl &&
-                !m_st.ignore(
-                        pControl, coScript->getParameterForValue(newValue))) {
-            coScript->set(newValue);
-        }
+        setValueInternal(coScript, newValue);
+    }
+}
+
+void ControllerScriptInterfaceLegacy::setValueInternal(
+        ControlObjectScript* coScript, double newValue) {
+    // Skip looking up the key on every call
+    ControlObject* pControl = ControlObject::getControl(coScript->getHandle());
+    if (pControl &&
+            !m_st.ignore(
+                    pControl, coScript->getParameterForValue(newValue))) {
+        coScript->set(newValue);
     }
 }
 
@@ -157,13 +173,16 @@ void ControllerScriptInterfaceLegacy::setParameter(
     }
 
     ControlObjectScript* coScript = getControlObjectScript(group, name);
-
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(
-                coScript->getKey(), ControlFlag::AllowMissingOrInvalid);
-        if (pControl && !m_st.ignore(pControl, newParameter)) {
-            coScript->setParameter(newParameter);
-        }
+        setParameterInternal(coScript, newParameter);
+    }
+}
+
+void ControllerScriptInterfaceLegacy::setParameterInternal(
+        ControlObjectScript* coScript, double newParameter) {
+    ControlObject* pControl = ControlObject::getControl(coScript->getHandle());
+    if (pControl && !m_st.ignore(pControl, newParameter)) {
+        coScript->setParameter(newParameter);
     }
 }
 
@@ -218,6 +237,56 @@ double ControllerScriptInterfaceLegacy::getDefaultParameter(
     return coScript->getParameterForValue(coScript->getDefault());
 }
 
+double ControllerScriptInterfaceLegacy::getValueByHandle(int handle) {
+    ControlObjectScript* coScript = getControlObjectScriptByHandle(handle);
+    if (coScript == nullptr) {
+        qCWarning(m_logger) << "Invalid control handle" << handle
+                            << ", returning 0.0";
+        return 0.0;
+    }
+    return coScript->get();
+}
+
+void ControllerScriptInterfaceLegacy::setValueByHandle(int handle, double newValue) {
+    ControlObjectScript* coScript = getControlObjectScriptByHandle(handle);
+    if (coScript == nullptr) {
+        qCWarning(m_logger) << "Invalid control handle" << handle << ", ignoring.";
+        return;
+    }
+    if (util_isnan(newValue)) {
+        qCWarning(m_logger) << "script setting [" << coScript->getKey().group
+                            << "," << coScript->getKey().item
+                            << "] to NotANumber, ignoring.";
+        return;
+    }
+    setValueInternal(coScript, newValue);
+}
+
+double ControllerScriptInterfaceLegacy::getParameterByHandle(int handle) {
+    ControlObjectScript* coScript = getControlObjectScriptByHandle(handle);
+    if (coScript == nullptr) {
+        qCWarning(m_logger) << "Invalid control handle" << handle
+                            << ", returning 0.0";
+        return 0.0;
+    }
+    return coScript->getParameter();
+}
+
+void ControllerScriptInterfaceLegacy::setParameterByHandle(int handle, double newParameter) {
+    ControlObjectScript* coScript = getControlObjectScriptByHandle(handle);
+    if (coScript == nullptr) {
+        qCWarning(m_logger) << "Invalid control handle" << handle << ", ignoring.";
+        return;
+    }
+    if (util_isnan(newParameter)) {
+        qCWarning(m_logger) << "script setting [" << coScript->getKey().group
+                            << "," << coScript->getKey().item
+                            << "] to NotANumber, ignoring.";
+        return;
+    }
+    setParameterInternal(coScript, newParameter);
+}
+
 QJSValue ControllerScriptInterfaceLegacy::makeConnection(
         const QString& group, const QString& name, const QJSValue& callback) {
     return ControllerScriptInterfaceLegacy::makeConnectionInternal(group, name, callback, false);
@@ -2,6 +2,7 @@
 
 #include <QJSValue>
 #include <QObject>
+#include <vector>
 
 #include "controllers/softtakeover.h"
 #include "util/alphabetafilter.h"
@@ -31,6 +32,15 @@ class ControllerScriptInterfaceLegacy : public QObject {
     Q_INVOKABLE void reset(const QString& group, const QString& name);
     Q_INVOKABLE double getDefaultValue(const QString& group, const QString& name);
     Q_INVOKABLE double getDefaultParameter(const QString& group, const QString& name);
+    /// Resolves a control once into a handle for the *ByHandle() functions,
+    /// which skip the lookup by group and name on every call. Intended for
+    /// handlers that receive hundreds of messages per second like jog wheels.
+    /// Returns -1 if the control does not exist.
+    Q_INVOKABLE int getControlHandle(const QString& group, const QString& name);
+    Q_INVOKABLE double getValueByHandle(int handle);
+    Q_INVOKABLE void setValueByHandle(int handle, double newValue);
+    Q_INVOKABLE double getParameterByHandle(int handle);
+    Q_INVOKABLE void setParameterByHandle(int handle, double newParameter);
     Q_INVOKABLE QJSValue makeConnection(const QString& group,
             const QString& name,
             const QJSValue& callback);
@@ -80,8 +90,14 @@ class ControllerScriptInterfaceLegacy : public QObject {
             const QString& name,
             const QJSValue& callback,
             bool skipSuperseded = false);
-    QHash<ConfigKey, ControlObjectScript*> m_controlCache;
+    /// Maps the keys of all controls accessed by the script to their
+    /// handles, i.e. the index into m_controls
+    QHash<ConfigKey, int> m_controlHandles;
+    std::vector<ControlObjectScript*> m_controls;
     ControlObjectScript* getControlObjectScript(const QString& group, const QString& name);
+    ControlObjectScript* getControlObjectScriptByHandle(int handle);
+    void setValueInternal(ControlObjectScript* coScript, double newValue);
+    void setParameterInternal(ControlObjectScript* coScript, double newParameter);
 
     SoftTakeoverCtrl m_st;
 
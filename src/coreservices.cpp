@@ -35,6 +35,7 @@
 #include "util/screensavermanager.h"
 #include "util/statsmanager.h"
 #include "util/time.h"
+#include "util/tracing.h"
 #include "util/translations.h"
 #include "util/versionstore.h"
 #include "vinylcontrol/vinylcontrolmanager.h"
@@ -120,6 +121,10 @@ CoreServices::CoreServices(const CmdlineArgs& args, QApplication* pApp)
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::createInstance();
     }
+    if (m_cmdlineArgs.getTimelineEnabled()) {
+        mixxx::Tracing::enable();
+        mixxx::Tracing::registerCurrentThread("Main");
+    }
     mixxx::Translations::initializeTranslations(
             m_pSettingsManager->settings(), pApp, m_cmdlineArgs.getLocale());
     initializeKeyboard();
@@ -139,6 +144,12 @@ CoreServices::~CoreServices() {
         StatsManager::destroy();
     }
 
+    if (m_cmdlineArgs.getTimelineEnabled()) {
+        // All traced threads have been stopped at this point
+        mixxx::Tracing::disable();
+        mixxx::Tracing::writeChromeTrace(m_cmdlineArgs.getTimelinePath());
+    }
+
     // HACK: Save config again. We saved it once before doing some dangerous
     // stuff. We only really want to save it here, but the first one was just
     // a precaution. The earlier one can be removed when stuff is more stable
@@ -331,7 +342,8 @@ void CoreServices::initialize(QApplication* pApp) {
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
 
     emit initializationProgressUpdate(50, tr("library"));
-    CoverArtCache::createInstance();
+    CoverArtCache::createInstance()->setDiskCacheDirectory(
+            QDir(pConfig->getSettingsPath()).filePath("coverartcache"));
 
     m_pTrackCollectionManager = std::make_shared<TrackCollectionManager>(
             this,
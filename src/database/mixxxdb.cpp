@@ -1,6 +1,8 @@
 #include "database/mixxxdb.h"
 
 #include <QDir>
+#include <QFileInfo>
+#include <QStorageInfo>
 
 #include "database/schemamanager.h"
 #include "moc_mixxxdb.cpp"
@@ -30,6 +32,28 @@ const QString kUserName = QStringLiteral("mixxx");
 
 const QString kPassword = QStringLiteral("mixxx");
 
+const ConfigKey kWriteAheadLogConfigKey =
+        ConfigKey(QStringLiteral("[Library]"), QStringLiteral("WriteAheadLog"));
+
+// SQLite requires shared memory for the write-ahead log, which does
+// not work for files on network file systems.
+// https://www.sqlite.org/wal.html
+bool isOnNetworkFileSystem(const QString& absFilePath) {
+    if (absFilePath.startsWith(QStringLiteral("//"))) {
+        // UNC path on Windows
+        return true;
+    }
+    const QByteArray fileSystemType =
+            QStorageInfo(QFileInfo(absFilePath).absolutePath()).fileSystemType().toLower();
+    return fileSystemType.startsWith("nfs") ||
+            fileSystemType.startsWith("cifs") ||
+            fileSystemType.startsWith("smb") ||
+            fileSystemType == "9p" ||
+            fileSystemType == "afpfs" ||
+            fileSystemType == "davfs" ||
+            fileSystemType == "fuse.sshfs";
+}
+
 // The connection parameters for the main Mixxx DB
 mixxx::DbConnection::Params dbConnectionParams(
         const UserSettingsPointer& pConfig,
@@ -55,6 +79,15 @@ mixxx::DbConnection::Params dbConnectionParams(
     // https://www.sqlite.org/inmemorydb.html
     if (inMemoryConnection) {
         params.filePath += QStringLiteral("?mode=memory&cache=shared");
+    } else if (!pConfig->getValue<bool>(kWriteAheadLogConfigKey, true)) {
+        kLogger.info()
+                << "Write-ahead log of the database is disabled";
+    } else if (isOnNetworkFileSystem(absFilePath)) {
+        kLogger.warning()
+                << "Not using a write-ahead log for the database on a network file system"
+                << absFilePath;
+    } else {
+        params.writeAheadLog = true;
     }
     params.userName = kUserName;
     params.password = kPassword;
@@ -4,11 +4,12 @@
 #include <QtDebug>
 
 #include "control/controlobject.h"
+#include "engine/cachingreader/sharedchunkcache.h"
+#include "mixer/playermanager.h"
 #include "moc_cachingreader.cpp"
 #include "track/track.h"
 #include "util/assert.h"
 #include "util/compatibility/qatomic.h"
-#include "util/counter.h"
 #include "util/logger.h"
 #include "util/math.h"
 #include "util/sample.h"
@@ -33,50 +34,197 @@ constexpr SINT kDefaultHintFrames = 1024;
 // CachingReader must be multiplied by the number of decks to calculate
 // the total amount!
 //
+// The number of chunks can be configured for each type of deck, see
+// configuredNumberOfCachedChunks().
+//
 // NOTE(uklotzde, 2019-09-05): Reduce this number to just few chunks
-// (kNumberOfCachedChunksInMemory = 1, 2, 3, ...) for testing purposes
-// to verify that the MRU/LRU cache works as expected. Even though
-// massive drop outs are expected to occur Mixxx should run reliably!
-constexpr SINT kNumberOfCachedChunksInMemory = 80;
+// (1, 2, 3, ...) for testing purposes to verify that the MRU/LRU cache
+// works as expected. Even though massive drop outs are expected to occur
+// Mixxx should run reliably!
+constexpr SINT kDefaultNumberOfCachedChunksInMemory = 80;
+
+// A single chunk is needed for reading and at least another one for
+// prefetching the following chunk.
+constexpr SINT kMinNumberOfCachedChunksInMemory = 2;
+
+// 1024 chunks -> 64 MB. The back channel FIFO from the worker is allocated
+// for this number of chunks to allow changing the capacity at runtime.
+constexpr SINT kMaxNumberOfCachedChunksInMemory = 1024;
+
+// All priorities of Hint::priority() in ascending order
+constexpr int kHintPriorities[] = {1, 2, 10, 20};
+
+// Each preloaded track that is no longer needed is handed back to the
+// worker, which deletes them whenever it wakes up.
+constexpr int kRetiredPreloadedTrackFIFOSize = 8;
+
+constexpr int kDefaultMaxPreloadMegabytes = 512;
+
+// 256 chunks -> 16 MB for all decks together, see SharedChunkCache
+constexpr SINT kDefaultNumberOfSharedChunks = 256;
+
+const QString kConfigGroup = QStringLiteral("[Master]");
+
+const ConfigKey kDeckChunksConfigKey =
+        ConfigKey(kConfigGroup, QStringLiteral("cached_chunks_deck"));
+const ConfigKey kSamplerChunksConfigKey =
+        ConfigKey(kConfigGroup, QStringLiteral("cached_chunks_sampler"));
+const ConfigKey kPreviewDeckChunksConfigKey =
+        ConfigKey(kConfigGroup, QStringLiteral("cached_chunks_preview_deck"));
+
+const ConfigKey kSharedChunksConfigKey =
+        ConfigKey(kConfigGroup, QStringLiteral("cached_chunks_shared"));
+
+const ConfigKey kTrackPreloadConfigKey =
+        ConfigKey(kConfigGroup, QStringLiteral("track_preload"));
+const ConfigKey kTrackPreloadMaxMegabytesConfigKey =
+        ConfigKey(kConfigGroup, QStringLiteral("track_preload_max_mb"));
+
+SINT clampNumberOfCachedChunks(SINT numChunks) {
+    return math_clamp(numChunks,
+            kMinNumberOfCachedChunksInMemory,
+            kMaxNumberOfCachedChunksInMemory);
+}
+
+SINT configuredNumberOfCachedChunks(
+        const UserSettingsPointer& pConfig, const QString& group) {
+    if (!pConfig) {
+        return kDefaultNumberOfCachedChunksInMemory;
+    }
+    // Samplers usually play short sounds and the preview deck is not
+    // used for mixing, so they may use smaller caches than the decks.
+    const ConfigKey& configKey = PlayerManager::isSamplerGroup(group)
+            ? kSamplerChunksConfigKey
+            : (PlayerManager::isPreviewDeckGroup(group)
+                              ? kPreviewDeckChunksConfigKey
+                              : kDeckChunksConfigKey);
+    return clampNumberOfCachedChunks(pConfig->getValue<int>(configKey,
+            static_cast<int>(kDefaultNumberOfCachedChunksInMemory)));
+}
+
+// Returns 0 if decoded chunks should not be shared between decks
+SINT configuredNumberOfSharedChunks(const UserSettingsPointer& pConfig) {
+    if (!pConfig) {
+        return kDefaultNumberOfSharedChunks;
+    }
+    return math_max(pConfig->getValue<int>(kSharedChunksConfigKey,
+                            static_cast<int>(kDefaultNumberOfSharedChunks)),
+            0);
+}
+
+// Returns 0 if tracks should not be preloaded
+SINT configuredMaxPreloadFrames(
+        const UserSettingsPointer& pConfig, const QString& group) {
+    if (!pConfig ||
+            !PlayerManager::isDeckGroup(group) ||
+            !pConfig->getValue<bool>(kTrackPreloadConfigKey, false)) {
+        return 0;
+    }
+    const SINT maxBytes = static_cast<SINT>(pConfig->getValue<int>(
+                                  kTrackPreloadMaxMegabytesConfigKey,
+                                  kDefaultMaxPreloadMegabytes)) *
+            1024 * 1024;
+    return CachingReaderChunk::samples2frames(maxBytes / sizeof(CSAMPLE));
+}
 
 } // anonymous namespace
 
+// static
+int Hint::priority(Type type) {
+    switch (type) {
+    case Type::SlipPosition:
+    case Type::CurrentPosition:
+        return 1;
+    case Type::LoopStartEnabled:
+        return 2;
+    case Type::MainCue:
+    case Type::HotCue:
+    case Type::LoopEndEnabled:
+    case Type::LoopStart:
+        return 10;
+    case Type::FirstSound:
+    case Type::IntroStart:
+    case Type::IntroEnd:
+    case Type::OutroStart:
+        break;
+    }
+    return 20;
+}
+
+CachingReaderChunkStorage::CachingReaderChunkStorage(SINT numChunks)
+        : sampleBuffer(CachingReaderChunk::kSamples * numChunks),
+          allocatedChunks(numChunks) {
+    chunks.reserve(numChunks);
+    freeChunks.reserve(numChunks);
+    // Divide up the allocated raw memory buffer into total_chunks
+    // chunks. Initialize each chunk to hold nothing and add it to the free
+    // list.
+    for (SINT i = 0; i < numChunks; ++i) {
+        CachingReaderChunkForOwner* c =
+                new CachingReaderChunkForOwner(
+                        mixxx::SampleBuffer::WritableSlice(
+                                sampleBuffer,
+                                CachingReaderChunk::kSamples * i,
+                                CachingReaderChunk::kSamples));
+        chunks.push_back(c);
+        freeChunks.push_back(c);
+    }
+}
+
+CachingReaderChunkStorage::~CachingReaderChunkStorage() {
+    qDeleteAll(chunks);
+}
+
 CachingReader::CachingReader(const QString& group,
         UserSettingsPointer config)
         : m_pConfig(config),
           // Limit the number of in-flight requests to the worker. This should
           // prevent to overload the worker when it is not able to fetch those
-          // requests from the FIFO timely. Otherwise outdated requests pile up
-          // in the FIFO and it would take a long time to process them, just to
-          // discard the results that most likely have already become obsolete.
-          // TODO(XXX): Ideally the request FIFO would be implemented as a ring
-          // buffer, where new requests replace old requests when full. Those
-          // old requests need to be returned immediately to the CachingReader
-          // that must take ownership and free them!!!
-          m_chunkReadRequestFIFO(kNumberOfCachedChunksInMemory / 4),
-          // The capacity of the back channel must be equal to the number of
+          // requests from the FIFO timely. The worker reads pending requests
+          // by priority and discards outdated requests without reading them,
+          // see CachingReaderWorker::takeNextReadRequest().
+          // The limit is derived from the initial capacity and is not
+          // adjusted when changing the capacity later.
+          m_chunkReadRequestFIFO(static_cast<int>(
+                  configuredNumberOfCachedChunks(config, group) / 4)),
+          // The capacity of the back channel must be at least the number of
           // allocated chunks, because the worker use writeBlocking(). Otherwise
           // the worker could get stuck in a hot loop!!!
-          m_readerStatusUpdateFIFO(kNumberOfCachedChunksInMemory),
+          m_readerStatusUpdateFIFO(kMaxNumberOfCachedChunksInMemory),
+          m_retiredPreloadedTrackFIFO(kRetiredPreloadedTrackFIFOSize),
           m_state(STATE_IDLE),
+          m_pChunkStorage(std::make_unique<CachingReaderChunkStorage>(
+                  configuredNumberOfCachedChunks(config, group))),
+          m_pPendingChunkStorage(nullptr),
+          m_pRetiredChunkStorage(nullptr),
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
-          m_sampleBuffer(CachingReaderChunk::kSamples * kNumberOfCachedChunksInMemory),
-          m_worker(group, &m_chunkReadRequestFIFO, &m_readerStatusUpdateFIFO) {
-    m_allocatedCachingReaderChunks.reserve(kNumberOfCachedChunksInMemory);
-    // Divide up the allocated raw memory buffer into total_chunks
-    // chunks. Initialize each chunk to hold nothing and add it to the free
-    // list.
-    for (SINT i = 0; i < kNumberOfCachedChunksInMemory; ++i) {
-        CachingReaderChunkForOwner* c =
-                new CachingReaderChunkForOwner(
-                        mixxx::SampleBuffer::WritableSlice(
-                                m_sampleBuffer,
-                                CachingReaderChunk::kSamples * i,
-                                CachingReaderChunk::kSamples));
-        m_chunks.push_back(c);
-        m_freeChunks.push_back(c);
-    }
+          m_hintGeneration(0),
+          m_numCacheHits(0),
+          m_numCacheMisses(0),
+          m_numEvictions(0),
+          m_cacheHitCounter(QStringLiteral("CachingReader %1 cache hits").arg(group)),
+          m_cacheMissCounter(QStringLiteral("CachingReader %1 cache misses").arg(group)),
+          m_evictionCounter(QStringLiteral("CachingReader %1 evictions").arg(group)),
+          m_pPreloadedTrack(nullptr),
+          m_worker(group,
+                  &m_chunkReadRequestFIFO,
+                  &m_readerStatusUpdateFIFO,
+                  &m_retiredPreloadedTrackFIFO,
+                  &m_pRetiredChunkStorage,
+                  configuredMaxPreloadFrames(config, group)),
+          m_pChunkCapacity(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("cached_chunks")))) {
+    // The capacity is shared by all readers that apply the same configuration
+    SharedChunkCache::instance().setCapacity(
+            static_cast<int>(configuredNumberOfSharedChunks(config)));
+
+    // The request handler allocates the memory for the new capacity. It
+    // is invoked on the thread of the reader if the request is issued by
+    // another thread, i.e. never on the engine thread.
+    m_pChunkCapacity->set(static_cast<double>(chunkCapacity()));
+    m_pChunkCapacity->connectValueChangeRequest(this,
+            &CachingReader::slotChunkCapacityChangeRequest);
 
     // Forward signals from worker
     connect(&m_worker, &CachingReaderWorker::trackLoading,
@@ -94,7 +242,96 @@ CachingReader::CachingReader(const QString& group,
 
 CachingReader::~CachingReader() {
     m_worker.quitWait();
-    qDeleteAll(m_chunks);
+    // The worker has stopped and will not delete any more preloaded tracks
+    delete m_pPreloadedTrack;
+    ReaderStatusUpdate update;
+    while (m_readerStatusUpdateFIFO.read(&update, 1) == 1) {
+        delete update.takePreloadedTrack();
+    }
+    PreloadedTrack* pPreloadedTrack;
+    while (m_retiredPreloadedTrackFIFO.read(&pPreloadedTrack, 1) == 1) {
+        delete pPreloadedTrack;
+    }
+    delete m_pPendingChunkStorage.exchange(nullptr);
+    delete m_pRetiredChunkStorage.exchange(nullptr);
+}
+
+void CachingReader::slotChunkCapacityChangeRequest(double value) {
+    const SINT numChunks = clampNumberOfCachedChunks(static_cast<SINT>(value));
+    setChunkCapacity(numChunks);
+    m_pChunkCapacity->setAndConfirm(static_cast<double>(numChunks));
+}
+
+void CachingReader::setChunkCapacity(SINT numChunks) {
+    auto* pStorage = new CachingReaderChunkStorage(clampNumberOfCachedChunks(numChunks));
+    // Replace a pending storage that has not been applied yet
+    delete m_pPendingChunkStorage.exchange(pStorage, std::memory_order_acq_rel);
+}
+
+bool CachingReader::applyPendingChunkCapacity() {
+    if (!m_pPendingChunkStorage.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (m_pRetiredChunkStorage.load(std::memory_order_relaxed)) {
+        // The previously replaced storage has not been deleted yet
+        return false;
+    }
+    for (const auto* pChunk : m_pChunkStorage->chunks) {
+        if (pChunk->getState() == CachingReaderChunkForOwner::READ_PENDING) {
+            // The worker still owns this chunk
+            return false;
+        }
+    }
+    CachingReaderChunkStorage* pStorage = m_pPendingChunkStorage.exchange(
+            nullptr, std::memory_order_acq_rel);
+    if (!pStorage) {
+        return false;
+    }
+    if (kLogger.debugEnabled()) {
+        kLogger.debug()
+                << "Changing the number of cached chunks from"
+                << m_pChunkStorage->chunks.size()
+                << "to"
+                << pStorage->chunks.size();
+    }
+    m_mruCachingReaderChunk = nullptr;
+    m_lruCachingReaderChunk = nullptr;
+    m_pRetiredChunkStorage.store(
+            m_pChunkStorage.release(), std::memory_order_release);
+    m_pChunkStorage.reset(pStorage);
+    // The worker deletes the replaced storage
+    m_worker.workReady();
+    return true;
+}
+
+void CachingReader::reportStats() {
+    if (m_numCacheHits > 0) {
+        m_cacheHitCounter += m_numCacheHits;
+        m_numCacheHits = 0;
+    }
+    if (m_numCacheMisses > 0) {
+        m_cacheMissCounter += m_numCacheMisses;
+        m_numCacheMisses = 0;
+    }
+    if (m_numEvictions > 0) {
+        m_evictionCounter += m_numEvictions;
+        m_numEvictions = 0;
+    }
+}
+
+void CachingReader::retirePreloadedTrack(PreloadedTrack* pPreloadedTrack) {
+    if (!pPreloadedTrack) {
+        return;
+    }
+    VERIFY_OR_DEBUG_ASSERT(m_retiredPreloadedTrackFIFO.write(&pPreloadedTrack, 1) == 1) {
+        // Should never happen, because the worker frees the FIFO before
+        // loading the next track
+        delete pPreloadedTrack;
+        return;
+    }
+    // Free the memory immediately instead of the next time the worker
+    // happens to wake up
+    m_worker.workReady();
 }
 
 void CachingReader::freeChunkFromList(CachingReaderChunkForOwner* pChunk) {
@@ -102,24 +339,22 @@ void CachingReader::freeChunkFromList(CachingReaderChunkForOwner* pChunk) {
             &m_mruCachingReaderChunk,
             &m_lruCachingReaderChunk);
     pChunk->free();
-    m_freeChunks.push_back(pChunk);
+    m_pChunkStorage->freeChunks.push_back(pChunk);
 }
 
 void CachingReader::freeChunk(CachingReaderChunkForOwner* pChunk) {
     DEBUG_ASSERT(pChunk);
     DEBUG_ASSERT(pChunk->getState() != CachingReaderChunkForOwner::READ_PENDING);
 
-    const int removed = m_allocatedCachingReaderChunks.remove(pChunk->getIndex());
-    Q_UNUSED(removed); // only used in DEBUG_ASSERT
-    // We'll tolerate not being in allocatedCachingReaderChunks,
+    // We'll tolerate not being in allocatedChunks,
     // because sometime you free a chunk right after you allocated it.
-    DEBUG_ASSERT(removed <= 1);
+    m_pChunkStorage->allocatedChunks.remove(pChunk->getIndex());
 
     freeChunkFromList(pChunk);
 }
 
 void CachingReader::freeAllChunks() {
-    for (const auto& pChunk: qAsConst(m_chunks)) {
+    for (const auto& pChunk : m_pChunkStorage->chunks) {
         // We will receive CHUNK_READ_INVALID for all pending chunk reads
         // which should free the chunks individually.
         if (pChunk->getState() == CachingReaderChunkForOwner::READ_PENDING) {
@@ -133,19 +368,20 @@ void CachingReader::freeAllChunks() {
     DEBUG_ASSERT(!m_mruCachingReaderChunk);
     DEBUG_ASSERT(!m_lruCachingReaderChunk);
 
-    m_allocatedCachingReaderChunks.clear();
+    m_pChunkStorage->allocatedChunks.clear();
 }
 
 CachingReaderChunkForOwner* CachingReader::allocateChunk(SINT chunkIndex) {
-    if (m_freeChunks.empty()) {
+    auto& freeChunks = m_pChunkStorage->freeChunks;
+    if (freeChunks.empty()) {
         return nullptr;
     }
-    CachingReaderChunkForOwner* pChunk = m_freeChunks.front();
-    m_freeChunks.pop_front();
+    CachingReaderChunkForOwner* pChunk = freeChunks.back();
+    freeChunks.pop_back();
 
     pChunk->init(chunkIndex);
 
-    m_allocatedCachingReaderChunks.insert(chunkIndex, pChunk);
+    m_pChunkStorage->allocatedChunks.insert(chunkIndex, pChunk);
 
     return pChunk;
 }
@@ -155,6 +391,7 @@ CachingReaderChunkForOwner* CachingReader::allocateChunkExpireLRU(SINT chunkInde
     if (!pChunk) {
         if (m_lruCachingReaderChunk) {
             freeChunk(m_lruCachingReaderChunk);
+            ++m_numEvictions;
             pChunk = allocateChunk(chunkIndex);
         } else {
             kLogger.warning() << "No cached LRU chunk available for freeing";
@@ -167,8 +404,8 @@ CachingReaderChunkForOwner* CachingReader::allocateChunkExpireLRU(SINT chunkInde
 }
 
 CachingReaderChunkForOwner* CachingReader::lookupChunk(SINT chunkIndex) {
-    // Defaults to nullptr if it's not in the hash.
-    auto* pChunk = m_allocatedCachingReaderChunks.value(chunkIndex, nullptr);
+    // Defaults to nullptr if it's not in the index.
+    auto* pChunk = m_pChunkStorage->allocatedChunks.find(chunkIndex);
     DEBUG_ASSERT(!pChunk || pChunk->getIndex() == chunkIndex);
     return pChunk;
 }
@@ -273,11 +510,27 @@ void CachingReader::process() {
                     DEBUG_ASSERT(atomicLoadRelaxed(m_state) == STATE_TRACK_LOADING);
                     freeAllChunks();
                 }
+                // The preloaded track belongs to the previous track
+                retirePreloadedTrack(m_pPreloadedTrack);
+                m_pPreloadedTrack = nullptr;
                 // Reset the readable frame index range
                 m_readableFrameIndexRange = update.readableFrameIndexRange();
                 m_state.storeRelease(STATE_TRACK_LOADED);
+            } else if (update.status == TRACK_PRELOADED) {
+                PreloadedTrack* pPreloadedTrack = update.takePreloadedTrack();
+                if (m_state.loadAcquire() == STATE_TRACK_LOADED) {
+                    DEBUG_ASSERT(!m_pPreloadedTrack);
+                    retirePreloadedTrack(m_pPreloadedTrack);
+                    m_pPreloadedTrack = pPreloadedTrack;
+                } else {
+                    // Discard the preloaded previous track while loading
+                    // or unloading
+                    retirePreloadedTrack(pPreloadedTrack);
+                }
             } else {
                 DEBUG_ASSERT(update.status == TRACK_UNLOADED);
+                retirePreloadedTrack(m_pPreloadedTrack);
+                m_pPreloadedTrack = nullptr;
                 // This message could be processed later when a new
                 // track is already loading! In this case the TRACK_LOADED will
                 // be the very next status update.
@@ -289,6 +542,9 @@ void CachingReader::process() {
             }
         }
     }
+    if (atomicLoadRelaxed(m_state) == STATE_IDLE) {
+        applyPendingChunkCapacity();
+    }
 }
 
 CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples, bool reverse, CSAMPLE* buffer) {
@@ -329,12 +585,16 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
         sample -= numSamples;
     }
 
-    SINT samplesRemaining = numSamples;
-
     // Process new messages from the reader thread before looking up
     // the first chunk and to update m_readableFrameIndexRange
     process();
 
+    if (m_pPreloadedTrack) {
+        return readPreloaded(sample, numSamples, reverse, buffer);
+    }
+
+    SINT samplesRemaining = numSamples;
+
     auto remainingFrameIndexRange =
             mixxx::IndexRange::forward(
                     CachingReaderChunk::samples2frames(sample),
@@ -425,6 +685,7 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
                 mixxx::IndexRange bufferedFrameIndexRange;
                 const CachingReaderChunkForOwner* const pChunk = lookupChunkAndFreshen(chunkIndex);
                 if (pChunk && (pChunk->getState() == CachingReaderChunkForOwner::READY)) {
+                    ++m_numCacheHits;
                     if (reverse) {
                         bufferedFrameIndexRange =
                                 pChunk->readBufferedSampleFramesReverse(
@@ -442,7 +703,7 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
                     // pending.
                     DEBUG_ASSERT(!pChunk ||
                             (pChunk->getState() == CachingReaderChunkForOwner::READ_PENDING));
-                    Counter("CachingReader::read(): Failed to read chunk on cache miss")++;
+                    ++m_numCacheMisses;
                     if (kLogger.traceEnabled()) {
                         kLogger.trace()
                                 << "Cache miss for chunk with index"
@@ -508,82 +769,152 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
     return result;
 }
 
+bool CachingReader::hintChunk(SINT chunkIndex, int priority) {
+    CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
+    if (pChunk) {
+        if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
+            // This will cause the chunk to be 'freshened' in the cache. The
+            // chunk will be moved to the end of the LRU list.
+            freshenChunk(pChunk);
+        } else {
+            // The pending request is still needed
+            DEBUG_ASSERT(pChunk->getState() == CachingReaderChunkForOwner::READ_PENDING);
+            pChunk->setHintGeneration(m_hintGeneration);
+        }
+        return false;
+    }
+    pChunk = allocateChunkExpireLRU(chunkIndex);
+    if (!pChunk) {
+        kLogger.warning()
+                << "Failed to allocate chunk"
+                << chunkIndex
+                << "for read request";
+        return true;
+    }
+    // Do not insert the allocated chunk into the MRU/LRU list,
+    // because it will be handed over to the worker immediately
+    pChunk->setHintGeneration(m_hintGeneration);
+    CachingReaderChunkReadRequest request;
+    request.giveToWorker(pChunk, priority);
+    if (kLogger.traceEnabled()) {
+        kLogger.trace()
+                << "Requesting read of chunk"
+                << request.chunk;
+    }
+    if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
+        kLogger.warning()
+                << "Failed to submit read request for chunk"
+                << chunkIndex;
+        // Revoke the chunk from the worker and free it
+        pChunk->takeFromWorker();
+        freeChunk(pChunk);
+    }
+    return true;
+}
+
+CachingReader::ReadResult CachingReader::readPreloaded(
+        SINT sample, SINT numSamples, bool reverse, CSAMPLE* buffer) {
+    DEBUG_ASSERT(m_pPreloadedTrack);
+    const auto requestedFrameIndexRange =
+            mixxx::IndexRange::forward(
+                    CachingReaderChunk::samples2frames(sample),
+                    CachingReaderChunk::samples2frames(numSamples));
+    const auto& preloadedFrameIndexRange = m_pPreloadedTrack->frameIndexRange;
+    const auto readableFrameIndexRange =
+            intersect(requestedFrameIndexRange, preloadedFrameIndexRange);
+    if (readableFrameIndexRange.empty()) {
+        SampleUtil::clear(buffer, numSamples);
+        return ReadResult::PARTIALLY_AVAILABLE;
+    }
+
+    // The requested range is split into silence before the track,
+    // the preloaded samples and silence after the track
+    const SINT prerollSamples = CachingReaderChunk::frames2samples(
+            readableFrameIndexRange.start() - requestedFrameIndexRange.start());
+    const SINT readableSamples = CachingReaderChunk::frames2samples(
+            readableFrameIndexRange.length());
+    const SINT trailingSamples = numSamples - prerollSamples - readableSamples;
+    DEBUG_ASSERT(trailingSamples >= 0);
+    const CSAMPLE* pSrc = m_pPreloadedTrack->sampleBuffer.data(
+            CachingReaderChunk::frames2samples(
+                    readableFrameIndexRange.start() -
+                    preloadedFrameIndexRange.start()));
+    if (reverse) {
+        SampleUtil::clear(buffer, trailingSamples);
+        SampleUtil::copyReverse(buffer + trailingSamples, pSrc, readableSamples);
+        SampleUtil::clear(buffer + trailingSamples + readableSamples, prerollSamples);
+    } else {
+        SampleUtil::clear(buffer, prerollSamples);
+        SampleUtil::copy(buffer + prerollSamples, pSrc, readableSamples);
+        SampleUtil::clear(buffer + prerollSamples + readableSamples, trailingSamples);
+    }
+    ++m_numCacheHits;
+    if (prerollSamples > 0 || trailingSamples > 0) {
+        return ReadResult::PARTIALLY_AVAILABLE;
+    }
+    return ReadResult::AVAILABLE;
+}
+
 void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
-    // If no file is loaded, skip.
-    if (atomicLoadRelaxed(m_state) != STATE_TRACK_LOADED) {
+    // Invoked once per callback
+    reportStats();
+
+    // If no file is loaded or the whole track is in memory, skip.
+    if (atomicLoadRelaxed(m_state) != STATE_TRACK_LOADED || m_pPreloadedTrack) {
         return;
     }
 
+    // Requests for chunks that are no longer hinted will be discarded
+    // by the worker
+    ++m_hintGeneration;
+    m_worker.setHintGeneration(m_hintGeneration);
+
     // For every chunk that the hints indicated, check if it is in the cache. If
-    // any are not, then wake.
+    // any are not, then wake. Chunks are requested in the order of their
+    // priority, because the number of in-flight requests is limited.
     bool shouldWake = false;
 
-    for (const auto& hint: hintList) {
-        SINT hintFrame = hint.frame;
-        SINT hintFrameCount = hint.frameCount;
-
-        // Handle some special length values
-        if (hintFrameCount == Hint::kFrameCountForward) {
-        	hintFrameCount = kDefaultHintFrames;
-        } else if (hintFrameCount == Hint::kFrameCountBackward) {
-        	hintFrame -= kDefaultHintFrames;
-        	hintFrameCount = kDefaultHintFrames;
-            if (hintFrame < 0) {
-            	hintFrameCount += hintFrame;
-                if (hintFrameCount <= 0) {
-                    continue;
+    for (const int priority : kHintPriorities) {
+        for (const auto& hint : hintList) {
+            if (Hint::priority(hint.type) != priority) {
+                continue;
+            }
+            SINT hintFrame = hint.frame;
+            SINT hintFrameCount = hint.frameCount;
+
+            // Handle some special length values
+            if (hintFrameCount == Hint::kFrameCountForward) {
+                hintFrameCount = kDefaultHintFrames;
+            } else if (hintFrameCount == Hint::kFrameCountBackward) {
+                hintFrame -= kDefaultHintFrames;
+                hintFrameCount = kDefaultHintFrames;
+                if (hintFrame < 0) {
+                    hintFrameCount += hintFrame;
+                    if (hintFrameCount <= 0) {
+                        continue;
+                    }
+                    hintFrame = 0;
                 }
-                hintFrame = 0;
             }
-        }
 
-        VERIFY_OR_DEBUG_ASSERT(hintFrameCount >= 0) {
-            kLogger.warning() << "CachingReader: Ignoring negative hint length.";
-            continue;
-        }
+            VERIFY_OR_DEBUG_ASSERT(hintFrameCount >= 0) {
+                kLogger.warning() << "CachingReader: Ignoring negative hint length.";
+                continue;
+            }
 
-        const auto readableFrameIndexRange = intersect(
-                m_readableFrameIndexRange,
-                mixxx::IndexRange::forward(hintFrame, hintFrameCount));
-        if (readableFrameIndexRange.empty()) {
-            continue;
-        }
+            const auto readableFrameIndexRange = intersect(
+                    m_readableFrameIndexRange,
+                    mixxx::IndexRange::forward(hintFrame, hintFrameCount));
+            if (readableFrameIndexRange.empty()) {
+                continue;
+            }
 
-        const int firstChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.start());
-        const int lastChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.end() - 1);
-        for (int chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
-            CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
-            if (!pChunk) {
-                shouldWake = true;
-                pChunk = allocateChunkExpireLRU(chunkIndex);
-                if (!pChunk) {
-                    kLogger.warning()
-                            << "Failed to allocate chunk"
-                            << chunkIndex
-                            << "for read request";
-                    continue;
-                }
-                // Do not insert the allocated chunk into the MRU/LRU list,
-                // because it will be handed over to the worker immediately
-                CachingReaderChunkReadRequest request;
-                request.giveToWorker(pChunk);
-                if (kLogger.traceEnabled()) {
-                    kLogger.trace()
-                            << "Requesting read of chunk"
-                            << request.chunk;
+            const int firstChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.start());
+            const int lastChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.end() - 1);
+            for (int chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
+                if (hintChunk(chunkIndex, priority)) {
+                    shouldWake = true;
                 }
-                if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
-                    kLogger.warning()
-                            << "Failed to submit read request for chunk"
-                            << chunkIndex;
-                    // Revoke the chunk from the worker and free it
-                    pChunk->takeFromWorker();
-                    freeChunk(pChunk);
-                }
-            } else if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
-                // This will cause the chunk to be 'freshened' in the cache. The
-                // chunk will be moved to the end of the LRU list.
-                freshenChunk(pChunk);
             }
         }
     }
@@ -1,44 +1,50 @@
 #pragma once
 
 #include <QAtomicInt>
-#include <QHash>
 #include <QList>
 #include <QVarLengthArray>
-#include <QVector>
-#include <list>
+#include <atomic>
+#include <memory>
+#include <vector>
 
+#include "engine/cachingreader/cachingreaderchunkindex.h"
 #include "engine/cachingreader/cachingreaderworker.h"
 #include "engine/engineworker.h"
 #include "preferences/usersettings.h"
 #include "track/track_decl.h"
+#include "util/counter.h"
 #include "util/fifo.h"
 #include "util/types.h"
 
+class ControlObject;
+
 // A Hint is an indication to the CachingReader that a certain section of a
 // SoundSource will be used 'soon' and so it should be brought into memory by
 // the reader work thread.
 typedef struct Hint {
     enum class Type {
-        SlipPosition,     // prio 1 (so far unused Mixxx 2.3 priority for reference)
+        SlipPosition,     // prio 1
         CurrentPosition,  // prio 1
         LoopStartEnabled, // prio 2
         MainCue,          // prio 10
         HotCue,           // prio 10
         LoopEndEnabled,   // prio 10
         LoopStart,        // prio 10
-        FirstSound,
-        IntroStart,
-        IntroEnd,
-        OutroStart
+        FirstSound,       // prio 20
+        IntroStart,       // prio 20
+        IntroEnd,         // prio 20
+        OutroStart        // prio 20
     };
 
+    // Chunks for hints with a lower value are requested and read first
+    static int priority(Type type);
+
     // The frame to ensure is present in memory.
     SINT frame;
     // If a range of frames should be present, use frameCount to indicate that the
     // range (frame, frame + frameCount) should be present in memory.
     SINT frameCount;
-    // Currently unused -- but in the future could be used to prioritize certain
-    // hints over others.
+    // Determines the priority of the hint.
     Type type;
 
     // for the default frame count in forward direction
@@ -77,6 +83,15 @@ typedef QVarLengthArray<Hint, 512> HintVector;
 // least-recently-used list. When a chunk needs to be allocated and there are no
 // free chunks then the least recently used chunk is free'd (see
 // allocateChunkExpireLRU).
+//
+// Decks can optionally preload the whole track into memory. Once the worker
+// has decoded the complete track all reads are served from this contiguous
+// buffer without any chunk lookups or requests.
+//
+// The number of chunks is configured separately for decks, samplers and
+// preview decks. It can be changed at runtime with the [ChannelN],cached_chunks
+// control and the new capacity takes effect once the deck is stopped. Cache hits, misses and
+// evictions are reported to the StatsManager.
 class CachingReader : public QObject {
     Q_OBJECT
 
@@ -118,19 +133,55 @@ class CachingReader : public QObject {
         m_worker.setScheduler(pScheduler);
     }
 
+    // Returns the number of chunks that are currently kept in memory. Must
+    // only be called from the engine callback.
+    SINT chunkCapacity() const {
+        return static_cast<SINT>(m_pChunkStorage->chunks.size());
+    }
+
+    // Request to change the number of chunks that are kept in memory. The
+    // memory is allocated by the calling thread, which must not be the
+    // engine thread. Only a single thread is allowed to call this method.
+    void setChunkCapacity(SINT numChunks);
+
+    // Replaces all chunks with those that have been allocated by the last
+    // call of setChunkCapacity(), unless a chunk is still being read by the
+    // worker. The contents of the cache are discarded and the replaced
+    // chunks are deleted by the worker. Must only be called from the engine
+    // callback while the deck is stopped or no track is loaded. Returns
+    // true if the capacity has been changed.
+    bool applyPendingChunkCapacity();
+
   signals:
     // Emitted once a new track is loaded and ready to be read from.
     void trackLoading();
     void trackLoaded(TrackPointer pTrack, int iSampleRate, int iNumSamples);
     void trackLoadFailed(TrackPointer pTrack, const QString& reason);
 
+  private slots:
+    void slotChunkCapacityChangeRequest(double value);
+
   private:
+    // Requests a chunk for a hint with the given priority if it is not
+    // yet present. Returns true if the worker needs to be woken up.
+    bool hintChunk(SINT chunkIndex, int priority);
+
+    // Reports and resets the statistics that have been collected
+    // since the last report.
+    void reportStats();
+
+    ReadResult readPreloaded(SINT sample, SINT numSamples, bool reverse, CSAMPLE* buffer);
+
+    // Hands the preloaded track back to the worker for deletion
+    void retirePreloadedTrack(PreloadedTrack* pPreloadedTrack);
+
     const UserSettingsPointer m_pConfig;
 
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
     FIFO<CachingReaderChunkReadRequest> m_chunkReadRequestFIFO;
     FIFO<ReaderStatusUpdate> m_readerStatusUpdateFIFO;
+    FIFO<PreloadedTrack*> m_retiredPreloadedTrackFIFO;
 
     // Looks for the provided chunk number in the index of in-memory chunks and
     // returns it if it is present. If not, returns nullptr. If it is present then
@@ -165,26 +216,39 @@ class CachingReader : public QObject {
     };
     QAtomicInt m_state;
 
-    // Keeps track of all CachingReaderChunks we've allocated.
-    QVector<CachingReaderChunkForOwner*> m_chunks;
-
-    // List of free chunks. Linked list so that we have constant time insertions
-    // and deletions. Iteration is not necessary.
-    std::list<CachingReaderChunkForOwner*> m_freeChunks;
+    std::unique_ptr<CachingReaderChunkStorage> m_pChunkStorage;
 
-    // Keeps track of what CachingReaderChunks we've allocated and indexes them based on what
-    // chunk number they are allocated to.
-    QHash<int, CachingReaderChunkForOwner*> m_allocatedCachingReaderChunks;
+    // Handed over from setChunkCapacity() to the engine thread.
+    std::atomic<CachingReaderChunkStorage*> m_pPendingChunkStorage;
+    // Handed back from the engine thread to the worker for deletion.
+    std::atomic<CachingReaderChunkStorage*> m_pRetiredChunkStorage;
 
     // The linked list of recently-used chunks.
     CachingReaderChunkForOwner* m_mruCachingReaderChunk;
     CachingReaderChunkForOwner* m_lruCachingReaderChunk;
 
-    // The raw memory buffer which is divided up into chunks.
-    mixxx::SampleBuffer m_sampleBuffer;
+    // Incremented for each invocation of hintAndMaybeWake()
+    unsigned int m_hintGeneration;
+
+    // Collected on the engine thread and reported once per callback
+    int m_numCacheHits;
+    int m_numCacheMisses;
+    int m_numEvictions;
+    Counter m_cacheHitCounter;
+    Counter m_cacheMissCounter;
+    Counter m_evictionCounter;
 
     // The readable frame index range as reported by the worker.
     mixxx::IndexRange m_readableFrameIndexRange;
 
+    // Owned by the engine thread after the worker has finished
+    // preloading the current track, otherwise nullptr.
+    PreloadedTrack* m_pPreloadedTrack;
+
     CachingReaderWorker m_worker;
+
+    // [ChannelN],cached_chunks: The number of chunks that are kept in memory
+    std::unique_ptr<ControlObject> m_pChunkCapacity;
+
+    friend class CachingReaderTest;
 };
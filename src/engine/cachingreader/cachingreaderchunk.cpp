@@ -33,7 +33,8 @@ const SINT CachingReaderChunk::kSamples =
 CachingReaderChunk::CachingReaderChunk(
         mixxx::SampleBuffer::WritableSlice sampleBuffer)
         : m_index(kInvalidChunkIndex),
-          m_sampleBuffer(std::move(sampleBuffer)) {
+          m_sampleBuffer(std::move(sampleBuffer)),
+          m_hintGeneration(0) {
     DEBUG_ASSERT(m_sampleBuffer.length() == kSamples);
 }
 
@@ -79,6 +80,22 @@ mixxx::IndexRange CachingReaderChunk::bufferSampleFrames(
     return m_bufferedSampleFrames.frameIndexRange();
 }
 
+mixxx::IndexRange CachingReaderChunk::bufferSampleFrames(
+        const mixxx::ReadableSampleFrames& sampleFrames) {
+    DEBUG_ASSERT(m_index != kInvalidChunkIndex);
+    DEBUG_ASSERT(sampleFrames.frameIndexRange().length() <= kFrames);
+    const SINT sampleCount = frames2samples(sampleFrames.frameIndexRange().length());
+    DEBUG_ASSERT(sampleFrames.readableLength() == sampleCount);
+    SampleUtil::copy(
+            m_sampleBuffer.data(),
+            sampleFrames.readableData(),
+            sampleCount);
+    m_bufferedSampleFrames = mixxx::ReadableSampleFrames(
+            sampleFrames.frameIndexRange(),
+            mixxx::SampleBuffer::ReadableSlice(m_sampleBuffer.data(), sampleCount));
+    return m_bufferedSampleFrames.frameIndexRange();
+}
+
 mixxx::IndexRange CachingReaderChunk::readBufferedSampleFrames(
         CSAMPLE* sampleBuffer,
         const mixxx::IndexRange& frameIndexRange) const {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "sources/audiosource.h"
 
 // A Chunk is a memory-resident section of audio that has been cached.
@@ -56,6 +58,15 @@ public:
             const mixxx::AudioSourcePointer& pAudioSource,
             mixxx::SampleBuffer::WritableSlice tempOutputBuffer);
 
+    // Copy sample frames that have already been decoded elsewhere and
+    // return the range of frames that have been copied.
+    mixxx::IndexRange bufferSampleFrames(
+            const mixxx::ReadableSampleFrames& sampleFrames);
+
+    const mixxx::ReadableSampleFrames& bufferedSampleFrames() const {
+        return m_bufferedSampleFrames;
+    }
+
     mixxx::IndexRange readBufferedSampleFrames(
             CSAMPLE* sampleBuffer,
             const mixxx::IndexRange& frameIndexRange) const;
@@ -63,6 +74,17 @@ public:
             CSAMPLE* reverseSampleBuffer,
             const mixxx::IndexRange& frameIndexRange) const;
 
+    // The generation of the most recent hints that referred to this chunk,
+    // see CachingReader::hintAndMaybeWake(). Unlike all other members this
+    // is updated by the cache while the worker owns the chunk, which then
+    // skips reading chunks that are no longer needed.
+    unsigned int getHintGeneration() const {
+        return m_hintGeneration.load(std::memory_order_relaxed);
+    }
+    void setHintGeneration(unsigned int hintGeneration) {
+        m_hintGeneration.store(hintGeneration, std::memory_order_relaxed);
+    }
+
 protected:
     explicit CachingReaderChunk(
             mixxx::SampleBuffer::WritableSlice sampleBuffer);
@@ -81,6 +103,8 @@ private:
     // set the corresponding frame index range.
     mixxx::SampleBuffer::WritableSlice m_sampleBuffer;
     mixxx::ReadableSampleFrames m_bufferedSampleFrames;
+
+    std::atomic<unsigned int> m_hintGeneration;
 };
 
 // This derived class is only accessible for the cache as the owner,
@@ -0,0 +1,86 @@
+#include "engine/cachingreader/cachingreaderchunkindex.h"
+
+#include <algorithm>
+
+#include "util/assert.h"
+
+namespace {
+
+// Keep the table at most half full
+constexpr SINT kSlotsPerChunk = 2;
+
+// The hash function needs at least a single bit
+constexpr SINT kMinSlotCount = 2;
+
+} // anonymous namespace
+
+CachingReaderChunkIndex::CachingReaderChunkIndex(SINT capacity)
+        : m_capacity(capacity),
+          m_size(0),
+          m_mask(0),
+          m_shift(64) {
+    DEBUG_ASSERT(capacity >= 0);
+    SINT slotCount = kMinSlotCount;
+    while (slotCount < capacity * kSlotsPerChunk) {
+        slotCount *= 2;
+    }
+    m_mask = slotCount - 1;
+    for (SINT i = 1; i < slotCount; i *= 2) {
+        --m_shift;
+    }
+    m_entries.resize(slotCount);
+}
+
+bool CachingReaderChunkIndex::insert(
+        SINT chunkIndex, CachingReaderChunkForOwner* pChunk) {
+    DEBUG_ASSERT(pChunk);
+    SINT slot = slotFor(chunkIndex);
+    while (m_entries[slot].pChunk && m_entries[slot].chunkIndex != chunkIndex) {
+        slot = nextSlot(slot);
+    }
+    Entry& entry = m_entries[slot];
+    if (!entry.pChunk) {
+        VERIFY_OR_DEBUG_ASSERT(m_size < m_capacity) {
+            return false;
+        }
+        ++m_size;
+    }
+    entry.chunkIndex = chunkIndex;
+    entry.pChunk = pChunk;
+    return true;
+}
+
+bool CachingReaderChunkIndex::remove(SINT chunkIndex) {
+    SINT slot = slotFor(chunkIndex);
+    while (m_entries[slot].pChunk && m_entries[slot].chunkIndex != chunkIndex) {
+        slot = nextSlot(slot);
+    }
+    if (!m_entries[slot].pChunk) {
+        return false;
+    }
+    // Shift all following entries of the probe sequence that would
+    // not be found anymore after emptying the slot.
+    SINT emptySlot = slot;
+    for (SINT next = nextSlot(slot); m_entries[next].pChunk; next = nextSlot(next)) {
+        const SINT home = slotFor(m_entries[next].chunkIndex);
+        // Check if home is cyclically outside of (emptySlot, next]
+        const bool movable = emptySlot <= next
+                ? (home <= emptySlot || home > next)
+                : (home <= emptySlot && home > next);
+        if (movable) {
+            m_entries[emptySlot] = m_entries[next];
+            emptySlot = next;
+        }
+    }
+    m_entries[emptySlot] = Entry();
+    --m_size;
+    return true;
+}
+
+void CachingReaderChunkIndex::clear() {
+    if (m_size == 0) {
+        return;
+    }
+    std::fill(m_entries.begin(), m_entries.end(), Entry());
+    m_size = 0;
+}
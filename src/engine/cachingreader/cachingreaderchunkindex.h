@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "util/types.h"
+
+class CachingReaderChunkForOwner;
+
+/// CachingReaderChunkIndex maps chunk indices to the chunks that are
+/// currently allocated by a CachingReader. It is accessed on the engine
+/// thread for each chunk that is read or hinted.
+///
+/// The index is a flat open-addressing hash table with linear probing.
+/// The table is allocated once when constructed for a fixed maximum number
+/// of chunks and is kept at most half full, i.e. neither lookups nor
+/// modifications allocate memory. Removed entries are not marked as deleted,
+/// instead the following entries of the same probe sequence are shifted
+/// backwards to keep probe sequences short.
+class CachingReaderChunkIndex final {
+  public:
+    explicit CachingReaderChunkIndex(SINT capacity);
+
+    SINT capacity() const {
+        return m_capacity;
+    }
+
+    SINT size() const {
+        return m_size;
+    }
+
+    /// Returns nullptr if no chunk has been inserted for chunkIndex.
+    CachingReaderChunkForOwner* find(SINT chunkIndex) const {
+        for (SINT slot = slotFor(chunkIndex);; slot = nextSlot(slot)) {
+            const Entry& entry = m_entries[slot];
+            if (!entry.pChunk || entry.chunkIndex == chunkIndex) {
+                return entry.pChunk;
+            }
+        }
+    }
+
+    /// Inserts or replaces the chunk for chunkIndex. Returns false if
+    /// the index is full.
+    bool insert(SINT chunkIndex, CachingReaderChunkForOwner* pChunk);
+
+    /// Returns false if no chunk has been inserted for chunkIndex.
+    bool remove(SINT chunkIndex);
+
+    void clear();
+
+  private:
+    struct Entry {
+        SINT chunkIndex = 0;
+        // nullptr for empty slots
+        CachingReaderChunkForOwner* pChunk = nullptr;
+    };
+
+    SINT slotFor(SINT chunkIndex) const {
+        // Fibonacci hashing spreads consecutive chunk indices
+        // across the whole table.
+        return static_cast<SINT>(
+                (static_cast<std::uint64_t>(chunkIndex) * 0x9E3779B97F4A7C15ull) >>
+                m_shift);
+    }
+
+    SINT nextSlot(SINT slot) const {
+        return (slot + 1) & m_mask;
+    }
+
+    const SINT m_capacity;
+    SINT m_size;
+    SINT m_mask;
+    int m_shift;
+    std::vector<Entry> m_entries;
+};
@@ -3,16 +3,20 @@
 #include <QAtomicInt>
 #include <QFileInfo>
 #include <QtDebug>
+#include <algorithm>
 
 #include "analyzer/analyzersilence.h"
 #include "control/controlobject.h"
+#include "control/controlpushbutton.h"
+#include "engine/cachingreader/sharedchunkcache.h"
 #include "moc_cachingreaderworker.cpp"
+#include "sources/audiosourcestereoproxy.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
 #include "util/compatibility/qmutex.h"
-#include "util/event.h"
 #include "util/logger.h"
 #include "util/span.h"
+#include "util/tracing.h"
 
 namespace {
 
@@ -21,20 +25,58 @@ mixxx::Logger kLogger("CachingReaderWorker");
 // we need the last silence frame and the first sound frame
 constexpr SINT kNumSoundFrameToVerify = 2;
 
+// Requests for chunks that have not been hinted for more callbacks
+// have been superseded, e.g. after jumping to a different position.
+// The previous generation is still accepted, because the engine might
+// be busy with issuing the current hints.
+constexpr unsigned int kMaxHintGenerationAge = 1;
+
 } // anonymous namespace
 
 CachingReaderWorker::CachingReaderWorker(
         const QString& group,
         FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
-        FIFO<ReaderStatusUpdate>* pReaderStatusFIFO)
+        FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
+        FIFO<PreloadedTrack*>* pRetiredPreloadedTrackFIFO,
+        std::atomic<CachingReaderChunkStorage*>* pRetiredChunkStorage,
+        SINT maxPreloadFrames)
         : m_group(group),
-          m_tag(QString("CachingReaderWorker %1").arg(m_group)),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
-          m_pReaderStatusFIFO(pReaderStatusFIFO) {
+          m_pReaderStatusFIFO(pReaderStatusFIFO),
+          m_pRetiredPreloadedTrackFIFO(pRetiredPreloadedTrackFIFO),
+          m_pRetiredChunkStorage(pRetiredChunkStorage),
+          m_hintGeneration(0),
+          m_maxPreloadFrames(maxPreloadFrames),
+          m_preloadFrameIndex(0),
+          m_pPreloadProgress(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("preload_progress")))),
+          m_pPreloadPause(std::make_unique<ControlPushButton>(
+                  ConfigKey(group, QStringLiteral("preload_pause")))) {
+    m_pPreloadProgress->setReadOnly();
+    m_pPreloadPause->setButtonMode(ControlPushButton::TOGGLE);
+    connect(m_pPreloadPause.get(),
+            &ControlObject::valueChanged,
+            this,
+            [this](double value) {
+                if (value == 0.0) {
+                    // Resume preloading
+                    workReady();
+                }
+            },
+            Qt::DirectConnection);
+}
+
+CachingReaderWorker::~CachingReaderWorker() {
+    if (!m_sharedChunkSourceKey.isEmpty()) {
+        SharedChunkCache::instance().closeSource(m_sharedChunkSourceKey);
+    }
+    deleteRetiredPreloadedTracks();
+    deleteRetiredChunkStorage();
 }
 
 ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         const CachingReaderChunkReadRequest& request) {
+    mixxx::ScopedTrace trace("CachingReaderWorker::processReadRequest");
     CachingReaderChunk* pChunk = request.chunk;
     DEBUG_ASSERT(pChunk);
 
@@ -50,6 +92,21 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         return result;
     }
 
+    // Copy the chunk if it has already been decoded by another worker,
+    // e.g. when the same track is loaded into multiple decks
+    const SharedChunkCache::ChunkPointer pSharedChunk =
+            SharedChunkCache::instance().lookup(
+                    m_sharedChunkSourceKey, pChunk->getIndex());
+    if (pSharedChunk && pSharedChunk->frameIndexRange == chunkFrameIndexRange) {
+        const mixxx::IndexRange bufferedFrameIndexRange =
+                pChunk->bufferSampleFrames(pSharedChunk->readableSampleFrames());
+        DEBUG_ASSERT(bufferedFrameIndexRange == chunkFrameIndexRange);
+        verifyFirstSound(pChunk);
+        ReaderStatusUpdate result;
+        result.init(CHUNK_READ_SUCCESS, pChunk, m_pAudioSource->frameIndexRange());
+        return result;
+    }
+
     // Try to read the data required for the chunk from the audio source
     const mixxx::IndexRange bufferedFrameIndexRange = pChunk->bufferSampleFrames(
             m_pAudioSource,
@@ -71,6 +128,12 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         if (bufferedFrameIndexRange.empty()) {
             status = CHUNK_READ_INVALID; // overwrite EOF (see above)
         }
+    } else if (!bufferedFrameIndexRange.empty()) {
+        // Only complete chunks are shared with other workers, if any
+        SharedChunkCache::instance().insert(
+                m_sharedChunkSourceKey,
+                pChunk->getIndex(),
+                pChunk->bufferedSampleFrames());
     }
 
     // This call here assumes that the caching reader will read the first sound cue at
@@ -106,9 +169,11 @@ void CachingReaderWorker::run() {
     const auto id = lastId.fetchAndAddRelaxed(1) + 1;
     QThread::currentThread()->setObjectName(
             QStringLiteral("CachingReaderWorker ") + QString::number(id));
+    mixxx::Tracing::registerCurrentThread("CachingReaderWorker");
 
-    Event::start(m_tag);
     while (!m_stop.loadAcquire()) {
+        deleteRetiredPreloadedTracks();
+        deleteRetiredChunkStorage();
         // Request is initialized by reading from FIFO
         CachingReaderChunkReadRequest request;
         if (m_newTrackAvailable.loadAcquire()) {
@@ -126,38 +191,89 @@ void CachingReaderWorker::run() {
                 // here, the engine is already stopped
                 unloadTrack();
             }
-        } else if (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        } else if (takeNextReadRequest(&request)) {
             // Read the requested chunk and send the result
             const ReaderStatusUpdate update = processReadRequest(request);
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
+        } else if (isPreloading() && !m_pPreloadPause->toBool()) {
+            // Pending read requests always take precedence
+            preloadNextChunk();
         } else {
-            Event::end(m_tag);
             m_semaRun.acquire();
-            Event::start(m_tag);
         }
     }
 }
 
+bool CachingReaderWorker::takeNextReadRequest(CachingReaderChunkReadRequest* pRequest) {
+    CachingReaderChunkReadRequest request;
+    while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        m_pendingRequests.push_back(request);
+    }
+
+    // Discard all requests that have been superseded by newer hints
+    const unsigned int hintGeneration =
+            m_hintGeneration.load(std::memory_order_relaxed);
+    std::size_t numRemaining = 0;
+    for (const auto& pendingRequest : m_pendingRequests) {
+        // Unsigned arithmetic handles wrap-arounds
+        if (hintGeneration - pendingRequest.chunk->getHintGeneration() >
+                kMaxHintGenerationAge) {
+            discardReadRequest(pendingRequest);
+            continue;
+        }
+        m_pendingRequests[numRemaining++] = pendingRequest;
+    }
+    m_pendingRequests.resize(numRemaining);
+    if (m_pendingRequests.empty()) {
+        return false;
+    }
+
+    // Requests with equal priorities are read in the order of their arrival
+    const auto nextRequest = std::min_element(
+            m_pendingRequests.begin(),
+            m_pendingRequests.end(),
+            [](const auto& lhs, const auto& rhs) {
+                return lhs.priority < rhs.priority;
+            });
+    *pRequest = *nextRequest;
+    m_pendingRequests.erase(nextRequest);
+    return true;
+}
+
+void CachingReaderWorker::discardReadRequest(const CachingReaderChunkReadRequest& request) {
+    const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
+    m_pReaderStatusFIFO->writeBlocking(&update, 1);
+}
+
 void CachingReaderWorker::discardAllPendingRequests() {
+    for (const auto& request : m_pendingRequests) {
+        discardReadRequest(request);
+    }
+    m_pendingRequests.clear();
     CachingReaderChunkReadRequest request;
     while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
-        const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
-        m_pReaderStatusFIFO->writeBlocking(&update, 1);
+        discardReadRequest(request);
     }
 }
 
 void CachingReaderWorker::closeAudioSource() {
     discardAllPendingRequests();
+    stopPreload();
 
     if (m_pAudioSource) {
         // Closes open file handles of the old track.
         m_pAudioSource->close();
         m_pAudioSource.reset();
     }
+    if (!m_sharedChunkSourceKey.isEmpty()) {
+        SharedChunkCache::instance().closeSource(m_sharedChunkSourceKey);
+        m_sharedChunkSourceKey.clear();
+    }
 
     // This function has to be called with the engine stopped only
     // to avoid collecting new requests for the old track
     DEBUG_ASSERT(!m_pChunkReadRequestFIFO->readAvailable());
+    DEBUG_ASSERT(m_pendingRequests.empty());
 }
 
 void CachingReaderWorker::unloadTrack() {
@@ -168,6 +284,7 @@ void CachingReaderWorker::unloadTrack() {
 }
 
 void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
+    mixxx::ScopedTrace trace("CachingReaderWorker::loadTrack");
     // This emit is directly connected and returns synchronized
     // after the engine has been stopped.
     emit trackLoading();
@@ -220,6 +337,9 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         return;
     }
 
+    m_sharedChunkSourceKey = SharedChunkCache::sourceKey(pTrack->getFileInfo());
+    SharedChunkCache::instance().openSource(m_sharedChunkSourceKey);
+
     // Adjust the internal buffer
     const SINT tempReadBufferSize =
             m_pAudioSource->getSignalInfo().frames2samples(
@@ -249,6 +369,9 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     // The engine must not request any chunks before receiving the
     // trackLoaded() signal
     DEBUG_ASSERT(!m_pChunkReadRequestFIFO->readAvailable());
+    DEBUG_ASSERT(m_pendingRequests.empty());
+
+    startPreload();
 
     emit trackLoaded(
             pTrack,
@@ -256,6 +379,100 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
             sampleCount);
 }
 
+bool CachingReaderWorker::isPreloading() const {
+    return static_cast<bool>(m_pPreloadingTrack);
+}
+
+void CachingReaderWorker::startPreload() {
+    DEBUG_ASSERT(!isPreloading());
+    DEBUG_ASSERT(m_pAudioSource);
+    if (m_maxPreloadFrames <= 0) {
+        return;
+    }
+    const auto frameIndexRange = m_pAudioSource->frameIndexRange();
+    if (frameIndexRange.length() > m_maxPreloadFrames) {
+        kLogger.info()
+                << m_group
+                << "Not preloading track with"
+                << frameIndexRange.length()
+                << "frames that exceeds the memory limit of"
+                << m_maxPreloadFrames
+                << "frames";
+        return;
+    }
+    m_pPreloadingTrack = std::make_unique<PreloadedTrack>(frameIndexRange);
+    m_preloadFrameIndex = frameIndexRange.start();
+}
+
+void CachingReaderWorker::stopPreload() {
+    m_pPreloadingTrack.reset();
+    m_pPreloadProgress->forceSet(0.0);
+}
+
+void CachingReaderWorker::preloadNextChunk() {
+    mixxx::ScopedTrace trace("CachingReaderWorker::preloadNextChunk");
+    DEBUG_ASSERT(isPreloading());
+    DEBUG_ASSERT(m_pAudioSource);
+    const auto trackFrameIndexRange = m_pPreloadingTrack->frameIndexRange;
+    const auto frameIndexRange = intersect(
+            mixxx::IndexRange::forward(
+                    m_preloadFrameIndex,
+                    CachingReaderChunk::kFrames),
+            trackFrameIndexRange);
+    DEBUG_ASSERT(!frameIndexRange.empty());
+
+    mixxx::AudioSourceStereoProxy audioSourceProxy(
+            m_pAudioSource,
+            mixxx::SampleBuffer::WritableSlice(m_tempReadBuffer));
+    const auto readableSampleFrames =
+            audioSourceProxy.readSampleFrames(
+                    mixxx::WritableSampleFrames(
+                            frameIndexRange,
+                            mixxx::SampleBuffer::WritableSlice(
+                                    m_pPreloadingTrack->sampleBuffer,
+                                    CachingReaderChunk::frames2samples(
+                                            frameIndexRange.start() -
+                                            trackFrameIndexRange.start()),
+                                    CachingReaderChunk::frames2samples(
+                                            frameIndexRange.length()))));
+    if (readableSampleFrames.frameIndexRange() != frameIndexRange) {
+        // Gaps are not supported, the affected regions of the
+        // track are continuously requested as chunks instead.
+        kLogger.warning()
+                << m_group
+                << "Aborting preload after failing to read sample frames:"
+                << "expected =" << frameIndexRange
+                << ", actual =" << readableSampleFrames.frameIndexRange();
+        stopPreload();
+        return;
+    }
+
+    m_preloadFrameIndex = frameIndexRange.end();
+    if (m_preloadFrameIndex < trackFrameIndexRange.end()) {
+        m_pPreloadProgress->forceSet(
+                static_cast<double>(m_preloadFrameIndex - trackFrameIndexRange.start()) /
+                trackFrameIndexRange.length());
+        return;
+    }
+
+    // The CachingReader takes the ownership of the preloaded track
+    const auto update = ReaderStatusUpdate::trackPreloaded(
+            m_pPreloadingTrack.release());
+    m_pReaderStatusFIFO->writeBlocking(&update, 1);
+    m_pPreloadProgress->forceSet(1.0);
+}
+
+void CachingReaderWorker::deleteRetiredPreloadedTracks() {
+    PreloadedTrack* pPreloadedTrack;
+    while (m_pRetiredPreloadedTrackFIFO->read(&pPreloadedTrack, 1) == 1) {
+        delete pPreloadedTrack;
+    }
+}
+
+void CachingReaderWorker::deleteRetiredChunkStorage() {
+    delete m_pRetiredChunkStorage->exchange(nullptr, std::memory_order_acquire);
+}
+
 void CachingReaderWorker::quitWait() {
     m_stop = 1;
     m_semaRun.release();
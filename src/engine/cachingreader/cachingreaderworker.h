@@ -5,28 +5,75 @@
 #include <QString>
 #include <QThread>
 #include <QtDebug>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "audio/frame.h"
 #include "engine/cachingreader/cachingreaderchunk.h"
+#include "engine/cachingreader/cachingreaderchunkindex.h"
 #include "engine/engineworker.h"
 #include "sources/audiosource.h"
 #include "track/track_decl.h"
 #include "util/fifo.h"
 
+class ControlObject;
+class ControlPushButton;
+
 // POD with trivial ctor/dtor/copy for passing through FIFO
 typedef struct CachingReaderChunkReadRequest {
     CachingReaderChunk* chunk;
+    // Pending requests are read in ascending order,
+    // see Hint::priority()
+    int priority;
 
-    void giveToWorker(CachingReaderChunkForOwner* chunkForOwner) {
+    void giveToWorker(CachingReaderChunkForOwner* chunkForOwner, int priorityArg) {
         DEBUG_ASSERT(chunkForOwner);
         chunk = chunkForOwner;
+        priority = priorityArg;
         chunkForOwner->giveToWorker();
     }
 } CachingReaderChunkReadRequest;
 
+// The decoded samples of a whole track in a contiguous buffer
+struct PreloadedTrack {
+    explicit PreloadedTrack(const mixxx::IndexRange& frameIndexRangeArg)
+            : frameIndexRange(frameIndexRangeArg),
+              sampleBuffer(CachingReaderChunk::frames2samples(
+                      frameIndexRangeArg.length())) {
+    }
+
+    // The first frame is stored at the beginning of the buffer
+    const mixxx::IndexRange frameIndexRange;
+    mixxx::SampleBuffer sampleBuffer;
+};
+
+// The chunks of a CachingReader and the raw memory which is divided up
+// between them. The storage is allocated and deleted outside of the engine
+// thread.
+struct CachingReaderChunkStorage {
+    explicit CachingReaderChunkStorage(SINT numChunks);
+    ~CachingReaderChunkStorage();
+
+    // The raw memory buffer which is divided up into chunks.
+    mixxx::SampleBuffer sampleBuffer;
+
+    // Keeps track of all CachingReaderChunks we've allocated.
+    std::vector<CachingReaderChunkForOwner*> chunks;
+
+    // Stack of free chunks. Reserved for all chunks, i.e. pushing
+    // and popping chunks never allocates memory.
+    std::vector<CachingReaderChunkForOwner*> freeChunks;
+
+    // Keeps track of what CachingReaderChunks we've allocated and
+    // indexes them based on what chunk number they are allocated to.
+    CachingReaderChunkIndex allocatedChunks;
+};
+
 enum ReaderStatus {
     TRACK_LOADED,
     TRACK_UNLOADED,
+    TRACK_PRELOADED,
     CHUNK_READ_SUCCESS,
     CHUNK_READ_EOF,
     CHUNK_READ_INVALID,
@@ -37,6 +84,7 @@ enum ReaderStatus {
 typedef struct ReaderStatusUpdate {
   private:
     CachingReaderChunk* chunk;
+    PreloadedTrack* preloadedTrack;
     SINT readableFrameIndexRangeStart;
     SINT readableFrameIndexRangeEnd;
 
@@ -49,6 +97,7 @@ typedef struct ReaderStatusUpdate {
             const mixxx::IndexRange& readableFrameIndexRangeArg) {
         status = statusArg;
         chunk = chunkArg;
+        preloadedTrack = nullptr;
         readableFrameIndexRangeStart = readableFrameIndexRangeArg.start();
         readableFrameIndexRangeEnd = readableFrameIndexRangeArg.end();
     }
@@ -74,6 +123,22 @@ typedef struct ReaderStatusUpdate {
         return update;
     }
 
+    static ReaderStatusUpdate trackPreloaded(
+            PreloadedTrack* pPreloadedTrack) {
+        DEBUG_ASSERT(pPreloadedTrack);
+        ReaderStatusUpdate update;
+        update.init(TRACK_PRELOADED, nullptr, pPreloadedTrack->frameIndexRange);
+        update.preloadedTrack = pPreloadedTrack;
+        return update;
+    }
+
+    // Transfers the ownership to the caller
+    PreloadedTrack* takePreloadedTrack() {
+        PreloadedTrack* pPreloadedTrack = preloadedTrack;
+        preloadedTrack = nullptr;
+        return pPreloadedTrack;
+    }
+
     CachingReaderChunkForOwner* takeFromWorker() {
         CachingReaderChunkForOwner* pChunk = nullptr;
         if (chunk) {
@@ -96,15 +161,31 @@ class CachingReaderWorker : public EngineWorker {
     Q_OBJECT
 
   public:
-    // Construct a CachingReader with the given group.
+    // Construct a CachingReader with the given group. Tracks are preloaded
+    // into memory if maxPreloadFrames is positive and the track has at most
+    // this number of frames. Preloaded tracks that are no longer needed are
+    // returned through pRetiredPreloadedTrackFIFO and chunk storage that has
+    // been replaced through pRetiredChunkStorage. Both are deleted by the
+    // worker when it wakes up.
     CachingReaderWorker(const QString& group,
             FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
-            FIFO<ReaderStatusUpdate>* pReaderStatusFIFO);
-    ~CachingReaderWorker() override = default;
+            FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
+            FIFO<PreloadedTrack*>* pRetiredPreloadedTrackFIFO,
+            std::atomic<CachingReaderChunkStorage*>* pRetiredChunkStorage,
+            SINT maxPreloadFrames);
+    ~CachingReaderWorker() override;
 
     // Request to load a new track. wake() must be called afterwards.
     void newTrack(TrackPointer pTrack);
 
+    // Publishes the generation of the most recent hints. Pending requests
+    // for chunks that have not been hinted by the current or the previous
+    // generation are discarded without reading them. Called from the
+    // engine callback.
+    void setHintGeneration(unsigned int hintGeneration) {
+        m_hintGeneration.store(hintGeneration, std::memory_order_relaxed);
+    }
+
     // Run upkeep operations like loading tracks and reading from file. Run by a
     // thread pool via the EngineWorkerScheduler.
     void run() override;
@@ -119,12 +200,19 @@ class CachingReaderWorker : public EngineWorker {
 
   private:
     const QString m_group;
-    QString m_tag;
 
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
     FIFO<CachingReaderChunkReadRequest>* m_pChunkReadRequestFIFO;
     FIFO<ReaderStatusUpdate>* m_pReaderStatusFIFO;
+    FIFO<PreloadedTrack*>* m_pRetiredPreloadedTrackFIFO;
+    std::atomic<CachingReaderChunkStorage*>* m_pRetiredChunkStorage;
+
+    // Requests that have been fetched from the FIFO in the order of
+    // their arrival. Only accessed by the worker thread.
+    std::vector<CachingReaderChunkReadRequest> m_pendingRequests;
+
+    std::atomic<unsigned int> m_hintGeneration;
 
     // Queue of Tracks to load, and the corresponding lock. Must acquire the
     // lock to touch.
@@ -134,6 +222,13 @@ class CachingReaderWorker : public EngineWorker {
 
     void discardAllPendingRequests();
 
+    /// Fetches all new requests from the FIFO, discards the requests that
+    /// have been superseded by newer hints and returns the pending request
+    /// with the highest priority.
+    bool takeNextReadRequest(CachingReaderChunkReadRequest* pRequest);
+
+    void discardReadRequest(const CachingReaderChunkReadRequest& request);
+
     /// call to be prepare for new tracks
     /// Make sure engine has been stopped before
     void closeAudioSource();
@@ -148,16 +243,50 @@ class CachingReaderWorker : public EngineWorker {
     ReaderStatusUpdate processReadRequest(
             const CachingReaderChunkReadRequest& request);
 
+    /// Starts preloading the current track if enabled and the
+    /// track does not exceed the memory limit.
+    void startPreload();
+
+    /// Aborts preloading of the current track.
+    void stopPreload();
+
+    /// Decodes the next chunk of the track that is being preloaded
+    /// and sends the track to the CachingReader when finished.
+    void preloadNextChunk();
+
+    bool isPreloading() const;
+
+    void deleteRetiredPreloadedTracks();
+    void deleteRetiredChunkStorage();
+
     void verifyFirstSound(const CachingReaderChunk* pChunk);
 
     // The current audio source of the track loaded
     mixxx::AudioSourcePointer m_pAudioSource;
 
+    // Identifies the chunks of the current audio source in the
+    // SharedChunkCache
+    QString m_sharedChunkSourceKey;
+
     mixxx::audio::FramePos m_firstSoundFrameToVerify;
 
     // Temporary buffer for reading samples from all channels
     // before conversion to a stereo signal.
     mixxx::SampleBuffer m_tempReadBuffer;
 
+    const SINT m_maxPreloadFrames;
+    std::unique_ptr<PreloadedTrack> m_pPreloadingTrack;
+    // The next frame that needs to be decoded into m_pPreloadingTrack
+    SINT m_preloadFrameIndex;
+
+    // [ChannelN],preload_progress: The fraction of the track that has been
+    // preloaded into memory or 0 if the track is not preloaded.
+    std::unique_ptr<ControlObject> m_pPreloadProgress;
+    // [ChannelN],preload_pause: Pauses preloading while enabled, e.g. to
+    // give other decks precedence when loading tracks from slow storage.
+    std::unique_ptr<ControlPushButton> m_pPreloadPause;
+
     QAtomicInt m_stop;
+
+    friend class CachingReaderWorkerTest;
 };
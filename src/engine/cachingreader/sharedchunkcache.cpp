@@ -0,0 +1,116 @@
+#include "engine/cachingreader/sharedchunkcache.h"
+
+#include <QDateTime>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/fileinfo.h"
+#include "util/sample.h"
+
+SharedChunkCache::Chunk::Chunk(const mixxx::ReadableSampleFrames& sampleFrames)
+        : frameIndexRange(sampleFrames.frameIndexRange()),
+          sampleBuffer(sampleFrames.readableLength()) {
+    SampleUtil::copy(sampleBuffer.data(),
+            sampleFrames.readableData(),
+            sampleFrames.readableLength());
+}
+
+SharedChunkCache::SharedChunkCache(int maxChunks)
+        : m_chunks(maxChunks) {
+}
+
+// static
+SharedChunkCache& SharedChunkCache::instance() {
+    static SharedChunkCache s_instance;
+    return s_instance;
+}
+
+// static
+QString SharedChunkCache::sourceKey(const mixxx::FileInfo& fileInfo) {
+    return QStringLiteral("%1|%2|%3")
+            .arg(fileInfo.location(),
+                    QString::number(fileInfo.sizeInBytes()),
+                    QString::number(fileInfo.lastModified().toMSecsSinceEpoch()));
+}
+
+int SharedChunkCache::capacity() const {
+    const auto locker = lockMutex(&m_mutex);
+    return static_cast<int>(m_chunks.maxCost());
+}
+
+void SharedChunkCache::setCapacity(int maxChunks) {
+    DEBUG_ASSERT(maxChunks >= 0);
+    const auto locker = lockMutex(&m_mutex);
+    m_chunks.setMaxCost(maxChunks);
+}
+
+int SharedChunkCache::size() const {
+    const auto locker = lockMutex(&m_mutex);
+    return static_cast<int>(m_chunks.size());
+}
+
+void SharedChunkCache::openSource(const QString& sourceKey) {
+    DEBUG_ASSERT(!sourceKey.isEmpty());
+    const auto locker = lockMutex(&m_mutex);
+    ++m_openSources[sourceKey];
+}
+
+void SharedChunkCache::closeSource(const QString& sourceKey) {
+    const auto locker = lockMutex(&m_mutex);
+    const auto it = m_openSources.find(sourceKey);
+    VERIFY_OR_DEBUG_ASSERT(it != m_openSources.end()) {
+        return;
+    }
+    if (--it.value() <= 0) {
+        m_openSources.erase(it);
+    }
+    if (isSharedLocked(sourceKey)) {
+        return;
+    }
+    // Only a single worker is left that does not need the chunks
+    const auto keys = m_chunks.keys();
+    for (const auto& key : keys) {
+        if (key.sourceKey == sourceKey) {
+            m_chunks.remove(key);
+        }
+    }
+}
+
+SharedChunkCache::ChunkPointer SharedChunkCache::lookup(
+        const QString& sourceKey, SINT chunkIndex) const {
+    const auto locker = lockMutex(&m_mutex);
+    const ChunkPointer* ppChunk = m_chunks.object(Key{sourceKey, chunkIndex});
+    if (!ppChunk) {
+        return nullptr;
+    }
+    return *ppChunk;
+}
+
+void SharedChunkCache::insert(const QString& sourceKey,
+        SINT chunkIndex,
+        const mixxx::ReadableSampleFrames& sampleFrames) {
+    VERIFY_OR_DEBUG_ASSERT(!sampleFrames.frameIndexRange().empty()) {
+        return;
+    }
+    {
+        const auto locker = lockMutex(&m_mutex);
+        if (m_chunks.maxCost() <= 0 || !isSharedLocked(sourceKey)) {
+            return;
+        }
+    }
+    // Copy the samples before locking the cache again
+    auto* ppChunk = new ChunkPointer(std::make_shared<const Chunk>(sampleFrames));
+    const auto locker = lockMutex(&m_mutex);
+    if (!isSharedLocked(sourceKey)) {
+        // The other worker has closed the source in the meantime
+        delete ppChunk;
+        return;
+    }
+    // Deletes the chunk if the cache has been disabled in the meantime
+    m_chunks.insert(Key{sourceKey, chunkIndex}, ppChunk);
+}
+
+void SharedChunkCache::clear() {
+    const auto locker = lockMutex(&m_mutex);
+    m_chunks.clear();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <memory>
+
+#include "sources/audiosource.h"
+#include "util/compatibility/qhash.h"
+
+namespace mixxx {
+class FileInfo;
+} // namespace mixxx
+
+/// A process-wide cache of decoded chunks that is shared by the workers of
+/// all CachingReaders, e.g. when the same track is loaded into multiple
+/// decks or a sampler. The workers look up a chunk here before decoding it.
+/// Decoded chunks are only published while at least two workers have opened
+/// the same source, so tracks that are loaded into a single deck are not
+/// copied into the cache. The chunks of a source are evicted as soon as
+/// fewer than two workers keep it open.
+///
+/// Chunks are immutable and reference-counted. They are only kept alive by
+/// the cache while the total number of chunks does not exceed the capacity,
+/// least recently used chunks are evicted first. The samples are copied into
+/// the chunks of the CachingReader by the worker, so the engine thread keeps
+/// reading from its own chunks and never accesses this cache.
+///
+/// All functions are thread-safe.
+class SharedChunkCache {
+  public:
+    struct Chunk {
+        explicit Chunk(const mixxx::ReadableSampleFrames& sampleFrames);
+
+        /// The first frame is stored at the beginning of the buffer
+        const mixxx::IndexRange frameIndexRange;
+        mixxx::SampleBuffer sampleBuffer;
+
+        mixxx::ReadableSampleFrames readableSampleFrames() const {
+            return mixxx::ReadableSampleFrames(frameIndexRange,
+                    mixxx::SampleBuffer::ReadableSlice(
+                            sampleBuffer, 0, sampleBuffer.size()));
+        }
+    };
+    typedef std::shared_ptr<const Chunk> ChunkPointer;
+
+    /// A capacity of 0 disables the cache
+    explicit SharedChunkCache(int maxChunks = 0);
+
+    /// The instance that is shared by all workers
+    static SharedChunkCache& instance();
+
+    /// Identifies the decoded audio data of a file. Chunks that have
+    /// been decoded before the file has been modified are not found.
+    static QString sourceKey(const mixxx::FileInfo& fileInfo);
+
+    int capacity() const;
+    /// Evicts the least recently used chunks if needed
+    void setCapacity(int maxChunks);
+
+    int size() const;
+
+    /// Must be balanced by closeSource() when the worker unloads the track
+    void openSource(const QString& sourceKey);
+    void closeSource(const QString& sourceKey);
+
+    /// Returns nullptr if the chunk is not cached
+    ChunkPointer lookup(const QString& sourceKey, SINT chunkIndex) const;
+
+    /// Copies the samples and replaces an existing chunk. Does nothing
+    /// unless the source is opened by multiple workers.
+    void insert(const QString& sourceKey,
+            SINT chunkIndex,
+            const mixxx::ReadableSampleFrames& sampleFrames);
+
+    void clear();
+
+  private:
+    struct Key {
+        QString sourceKey;
+        SINT chunkIndex;
+
+        friend bool operator==(const Key& lhs, const Key& rhs) {
+            return lhs.chunkIndex == rhs.chunkIndex &&
+                    lhs.sourceKey == rhs.sourceKey;
+        }
+
+        friend qhash_seed_t qHash(
+                const Key& key,
+                qhash_seed_t seed = 0) {
+            return qHash(key.sourceKey, seed) ^ qHash(key.chunkIndex, seed);
+        }
+    };
+
+    bool isSharedLocked(const QString& sourceKey) const {
+        return m_openSources.value(sourceKey) > 1;
+    }
+
+    mutable QMutex m_mutex;
+    // The number of workers that have opened each source
+    QHash<QString, int> m_openSources;
+    // Each chunk has a cost of 1. The cache owns the shared pointers,
+    // i.e. chunks that are still in use by a worker are only released
+    // after the worker has finished copying them.
+    QCache<Key, ChunkPointer> m_chunks;
+};
@@ -97,6 +97,7 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_iSeekPhaseQueued(0),
           m_iEnableSyncQueued(SYNC_REQUEST_NONE),
           m_iSyncModeQueued(static_cast<int>(SyncMode::Invalid)),
+          m_bConcurrentProcessing(false),
           m_bPlayAfterLoading(false),
           m_pCrossfadeBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_bCrossfadeReady(false),
@@ -452,6 +453,18 @@ void EngineBuffer::requestClonePosition(EngineChannel* pChannel) {
     atomicStoreRelaxed(m_pChannelToCloneFrom, pChannel);
 }
 
+bool EngineBuffer::beginConcurrentProcessing() {
+    if (m_pSyncControl->isSynchronized() ||
+            atomicLoadRelaxed(m_iEnableSyncQueued) != SYNC_REQUEST_NONE ||
+            atomicLoadRelaxed(m_iSyncModeQueued) !=
+                    static_cast<int>(SyncMode::Invalid) ||
+            atomicLoadRelaxed(m_pChannelToCloneFrom) != nullptr) {
+        return false;
+    }
+    m_bConcurrentProcessing = true;
+    return true;
+}
+
 void EngineBuffer::readToCrossfadeBuffer(const int iBufferSize) {
     if (!m_bCrossfadeReady) {
         // Read buffer, as if there where no parameter change
@@ -1212,6 +1225,12 @@ void EngineBuffer::processSlip(int iBufferSize) {
 }
 
 void EngineBuffer::processSyncRequests() {
+    if (m_bConcurrentProcessing) {
+        // EngineSync must not be modified while other channels are
+        // processed concurrently. The request stays queued and is picked
+        // up by the next callback, where this buffer is processed serially.
+        return;
+    }
     SyncRequestQueued enable_request =
             static_cast<SyncRequestQueued>(
                     m_iEnableSyncQueued.fetchAndStoreRelease(SYNC_REQUEST_NONE));
@@ -1241,7 +1260,11 @@ void EngineBuffer::processSyncRequests() {
 void EngineBuffer::processSeek(bool paused) {
     m_previousBufferSeek = false;
     // Check if we are cloning another channel before doing any seeking.
-    EngineChannel* pChannel = m_pChannelToCloneFrom.fetchAndStoreRelaxed(nullptr);
+    // The other channel might be processed concurrently, in that case
+    // cloning is deferred to the next callback.
+    EngineChannel* pChannel = m_bConcurrentProcessing
+            ? nullptr
+            : m_pChannelToCloneFrom.fetchAndStoreRelaxed(nullptr);
     if (pChannel) {
         seekCloneBuffer(pChannel->getEngineBuffer());
     }
@@ -1434,6 +1457,11 @@ void EngineBuffer::hintReader(const double dRate) {
     for (const auto& pControl: qAsConst(m_engineControls)) {
         pControl->hintReader(&m_hintList);
     }
+    if (dRate == 0) {
+        // Discarding the cache is inaudible while the deck is stopped
+        // and the hints will refill it immediately.
+        m_pReader->applyPendingChunkCapacity();
+    }
     m_pReader->hintAndMaybeWake(m_hintList);
 }
 
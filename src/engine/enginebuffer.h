@@ -126,6 +126,15 @@ class EngineBuffer : public EngineObject {
     void processSlip(int iBufferSize);
     void postProcess(const int iBufferSize);
 
+    /// Returns true if the next process() call neither touches EngineSync nor
+    /// another deck, so that it can run on an engine worker thread concurrently
+    /// with other channels. Sync and clone requests that arrive before
+    /// endConcurrentProcessing() is called are deferred to the next callback.
+    bool beginConcurrentProcessing();
+    void endConcurrentProcessing() {
+        m_bConcurrentProcessing = false;
+    }
+
     /// Returns the seek position iff a seek is currently queued but not yet
     /// processed. If no seek was queued, and invalid frame position is returned.
     mixxx::audio::FramePos queuedSeekPosition() const;
@@ -424,6 +433,10 @@ class EngineBuffer : public EngineObject {
     static constexpr QueuedSeek kNoQueuedSeek = {mixxx::audio::kInvalidFramePos, SEEK_NONE};
     QAtomicPointer<EngineChannel> m_pChannelToCloneFrom;
 
+    // Only accessed from the callback thread and the engine worker thread
+    // that currently processes this buffer.
+    bool m_bConcurrentProcessing;
+
     // Is true if the previous buffer was silent due to pausing
     QAtomicInt m_iTrackLoading;
     bool m_bPlayAfterLoading;
@@ -15,6 +15,7 @@
 #include "engine/enginebuffer.h"
 #include "engine/enginedelay.h"
 #include "engine/enginetalkoverducking.h"
+#include "engine/enginethreadpool.h"
 #include "engine/enginevumeter.h"
 #include "engine/engineworkerscheduler.h"
 #include "engine/enginexfader.h"
@@ -24,6 +25,8 @@
 #include "moc_enginemaster.cpp"
 #include "preferences/usersettings.h"
 #include "util/defs.h"
+#include "util/math.h"
+#include "util/realtimecheck.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -66,6 +69,14 @@ EngineMaster::EngineMaster(
     m_pWorkerScheduler = new EngineWorkerScheduler(this);
     m_pWorkerScheduler->start(QThread::HighPriority);
 
+    // Optionally process channels that do not depend on each other in
+    // parallel. The audio callback thread does its share of the work, so
+    // this is the number of additional threads.
+    setEngineWorkerThreads(math_clamp(
+            pConfig->getValue(ConfigKey(group, "engine_worker_threads"), 0),
+            0,
+            QThread::idealThreadCount() - 1));
+
     // Master sample rate
     m_pMasterSampleRate = new ControlObject(ConfigKey(group, "samplerate"), true, true);
     m_pMasterSampleRate->set(44100.);
@@ -241,6 +252,7 @@ EngineMaster::~EngineMaster() {
     }
 
     delete m_pWorkerScheduler;
+    m_pThreadPool.reset();
 
     for (int i = 0; i < m_channels.size(); ++i) {
         ChannelInfo* pChannelInfo = m_channels[i];
@@ -268,6 +280,21 @@ const CSAMPLE* EngineMaster::getSidechainBuffer() const {
     return m_pSidechainMix;
 }
 
+void EngineMaster::setEngineWorkerThreads(int numWorkerThreads) {
+    DEBUG_ASSERT(numWorkerThreads >= 0);
+    // Joins the previous threads
+    m_pThreadPool.reset();
+    if (numWorkerThreads > 0) {
+        qDebug() << "EngineMaster: Processing channels on"
+                 << numWorkerThreads << "additional threads";
+        m_pThreadPool = std::make_unique<EngineThreadPool>(numWorkerThreads);
+    }
+}
+
+int EngineMaster::numEngineWorkerThreads() const {
+    return m_pThreadPool ? m_pThreadPool->numWorkerThreads() : 0;
+}
+
 void EngineMaster::processChannels(int iBufferSize) {
     // Update internal sync lock rate.
     m_pEngineSync->onCallbackStart(m_sampleRate, m_iBufferSize);
@@ -357,17 +384,33 @@ void EngineMaster::processChannels(int iBufferSize) {
     }
 
     // Now that the list is built and ordered, do the processing.
-    for (int i = activeChannelsStartIndex;
-             i < m_activeChannels.size(); ++i) {
-        ChannelInfo* pChannelInfo = m_activeChannels[i];
-        EngineChannel* pChannel = pChannelInfo->m_pChannel;
-        pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
-
-        // Collect metadata for effects
-        if (m_pEngineEffectsManager) {
-            GroupFeatureState features;
-            pChannel->collectFeatures(&features);
-            pChannelInfo->m_features = features;
+    if (m_pThreadPool) {
+        // The sync leader and all channels that interact with EngineSync or
+        // other decks are processed serially, the remaining ones in parallel.
+        m_concurrentChannels.clear();
+        for (int i = activeChannelsStartIndex;
+                i < m_activeChannels.size(); ++i) {
+            ChannelInfo* pChannelInfo = m_activeChannels[i];
+            EngineBuffer* pBuffer = pChannelInfo->m_pChannel->getEngineBuffer();
+            if (i > 0 && (!pBuffer || pBuffer->beginConcurrentProcessing())) {
+                m_concurrentChannels.append(pChannelInfo);
+            } else {
+                processChannel(pChannelInfo, iBufferSize);
+            }
+        }
+        m_pThreadPool->run(&EngineMaster::processConcurrentChannel,
+                this,
+                m_concurrentChannels.size());
+        for (ChannelInfo* pChannelInfo : std::as_const(m_concurrentChannels)) {
+            EngineBuffer* pBuffer = pChannelInfo->m_pChannel->getEngineBuffer();
+            if (pBuffer) {
+                pBuffer->endConcurrentProcessing();
+            }
+        }
+    } else {
+        for (int i = activeChannelsStartIndex;
+                i < m_activeChannels.size(); ++i) {
+            processChannel(m_activeChannels[i], iBufferSize);
         }
     }
 
@@ -388,6 +431,27 @@ void EngineMaster::processChannels(int iBufferSize) {
     }
 }
 
+void EngineMaster::processChannel(ChannelInfo* pChannelInfo, int iBufferSize) {
+    EngineChannel* pChannel = pChannelInfo->m_pChannel;
+    pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
+
+    // Collect metadata for effects
+    if (m_pEngineEffectsManager) {
+        GroupFeatureState features;
+        pChannel->collectFeatures(&features);
+        pChannelInfo->m_features = features;
+    }
+}
+
+// static
+void EngineMaster::processConcurrentChannel(void* pContext, int channelIndex) {
+    mixxx::RealtimeCheck::Scope realtimeScope;
+    auto* pEngineMaster = static_cast<EngineMaster*>(pContext);
+    pEngineMaster->processChannel(
+            pEngineMaster->m_concurrentChannels[channelIndex],
+            static_cast<int>(pEngineMaster->m_iBufferSize));
+}
+
 void EngineMaster::process(const int iBufferSize) {
     static bool haveSetName = false;
     if (!haveSetName) {
@@ -395,6 +459,7 @@ void EngineMaster::process(const int iBufferSize) {
         haveSetName = true;
     }
     //Trace t("EngineMaster::process");
+    mixxx::RealtimeCheck::Scope realtimeScope;
 
     bool masterEnabled = m_pMasterEnabled->toBool();
     bool boothEnabled = m_pBoothEnabled->toBool();
@@ -860,6 +925,7 @@ void EngineMaster::addChannel(EngineChannel* pChannel) {
     m_activeBusChannels[EngineChannel::RIGHT].reserve(m_channels.size());
     m_activeHeadphoneChannels.reserve(m_channels.size());
     m_activeTalkoverChannels.reserve(m_channels.size());
+    m_concurrentChannels.reserve(m_channels.size());
 
     EngineBuffer* pBuffer = pChannelInfo->m_pChannel->getEngineBuffer();
     if (pBuffer != nullptr) {
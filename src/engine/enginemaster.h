@@ -2,6 +2,7 @@
 
 #include <QObject>
 #include <QVarLengthArray>
+#include <memory>
 
 #include "audio/types.h"
 #include "control/controlobject.h"
@@ -30,6 +31,7 @@ class GuiTick;
 class EngineSync;
 class EngineTalkoverDucking;
 class EngineDelay;
+class EngineThreadPool;
 
 // The number of channels to pre-allocate in various structures in the
 // engine. Prevents memory allocation in EngineMaster::addChannel.
@@ -254,6 +256,12 @@ class EngineMaster : public QObject, public AudioSource {
     ControlObject* m_pHeadphoneEnabled;
     ControlObject* m_pBoothEnabled;
 
+    // Replaces the threads for processing channels in parallel without
+    // limiting their number to the available cores, so tests can run
+    // them on any machine. Must not be called while processing.
+    void setEngineWorkerThreads(int numWorkerThreads);
+    int numEngineWorkerThreads() const;
+
   private:
     // Processes active channels. The sync lock channel (if any) is processed
     // first and all others are processed after. Populates m_activeChannels,
@@ -261,6 +269,10 @@ class EngineMaster : public QObject, public AudioSource {
     // m_activeTalkoverChannels with each channel that is active for the
     // respective output.
     void processChannels(int iBufferSize);
+    // Processes a single channel and collects its features for effects.
+    void processChannel(ChannelInfo* pChannelInfo, int iBufferSize);
+    // EngineThreadPool::TaskFunction for processing m_concurrentChannels
+    static void processConcurrentChannel(void* pContext, int channelIndex);
 
     ChannelHandleFactoryPointer m_pChannelHandleFactory;
     void applyMasterEffects();
@@ -283,6 +295,8 @@ class EngineMaster : public QObject, public AudioSource {
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeBusChannels[3];
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeHeadphoneChannels;
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeTalkoverChannels;
+    // The subset of m_activeChannels that is processed on m_pThreadPool.
+    QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_concurrentChannels;
 
     mixxx::audio::SampleRate m_sampleRate;
     unsigned int m_iBufferSize;
@@ -296,6 +310,8 @@ class EngineMaster : public QObject, public AudioSource {
     CSAMPLE* m_pSidechainMix;
 
     EngineWorkerScheduler* m_pWorkerScheduler;
+    // Only allocated if parallel channel processing has been configured.
+    std::unique_ptr<EngineThreadPool> m_pThreadPool;
     EngineSync* m_pEngineSync;
 
     ControlObject* m_pMasterGain;
@@ -0,0 +1,170 @@
+#include "engine/enginethreadpool.h"
+
+#include <QThread>
+#include <QtDebug>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#ifdef __LINUX__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "util/assert.h"
+#include "util/denormalsarezero.h"
+#include "util/tracing.h"
+
+namespace {
+
+// Number of busy-wait iterations before a worker goes to sleep on the
+// futex. At ~10-100 ns per iteration this keeps a worker hot for well below
+// the period of a small audio buffer, so back-to-back callbacks do not pay
+// the wake-up latency of the scheduler while an idle engine does not burn
+// a core.
+constexpr int kSpinIterations = 4096;
+
+inline void cpuRelax() {
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+} // anonymous namespace
+
+class EngineThreadPool::WorkerThread : public QThread {
+  public:
+    explicit WorkerThread(EngineThreadPool* pPool)
+            : m_pPool(pPool) {
+    }
+
+  protected:
+    void run() override {
+#ifdef __LINUX__
+        // Use the same realtime scheduling as the audio callback, otherwise
+        // the callback would wait for a worker preempted by a GUI thread.
+        struct sched_param spm = {0};
+        spm.sched_priority = 1;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &spm)) {
+            qWarning() << "EngineThreadPool: Failed bumping priority of"
+                       << objectName();
+        }
+#endif
+#ifdef __SSE__
+        // Same as in the audio callback, see SoundDevicePortAudio
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+#endif
+        mixxx::Tracing::registerCurrentThread("EngineWorker");
+        m_pPool->workerLoop();
+    }
+
+  private:
+    EngineThreadPool* const m_pPool;
+};
+
+EngineThreadPool::EngineThreadPool(int numWorkerThreads)
+        : m_pFunction(nullptr),
+          m_pContext(nullptr),
+          m_nextTask(0),
+          m_pendingTasks(0),
+          m_generation(0),
+          m_quit(false) {
+    DEBUG_ASSERT(numWorkerThreads >= 0);
+    m_workers.reserve(numWorkerThreads);
+    for (int i = 0; i < numWorkerThreads; ++i) {
+        auto pWorker = std::make_unique<WorkerThread>(this);
+        pWorker->setObjectName(QStringLiteral("EngineWorker %1").arg(i + 1));
+        pWorker->start(QThread::TimeCriticalPriority);
+        m_workers.push_back(std::move(pWorker));
+    }
+}
+
+EngineThreadPool::~EngineThreadPool() {
+    m_quit.store(true, std::memory_order_release);
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
+    m_generation.notify_all();
+    for (const auto& pWorker : m_workers) {
+        pWorker->wait();
+    }
+}
+
+void EngineThreadPool::run(TaskFunction pFunction, void* pContext, int numTasks) {
+    if (numTasks <= 0) {
+        return;
+    }
+    if (m_workers.empty() || numTasks == 1) {
+        // Nothing to gain from waking up the workers
+        for (int i = 0; i < numTasks; ++i) {
+            pFunction(pContext, i);
+        }
+        return;
+    }
+
+    m_pFunction = pFunction;
+    m_pContext = pContext;
+    m_pendingTasks.store(numTasks, std::memory_order_relaxed);
+    const std::uint32_t generation =
+            m_generation.load(std::memory_order_relaxed) + 1;
+    // Publishes the batch, see the acquire operations in runTasks()
+    m_nextTask.store((static_cast<std::uint64_t>(generation) << 32) |
+                    static_cast<std::uint32_t>(numTasks),
+            std::memory_order_release);
+    m_generation.store(generation, std::memory_order_release);
+    m_generation.notify_all();
+
+    runTasks(generation);
+
+    // Join: Spin first, the remaining tasks are already running.
+    int pendingTasks = m_pendingTasks.load(std::memory_order_acquire);
+    for (int i = 0; pendingTasks > 0 && i < kSpinIterations; ++i) {
+        cpuRelax();
+        pendingTasks = m_pendingTasks.load(std::memory_order_acquire);
+    }
+    while (pendingTasks > 0) {
+        m_pendingTasks.wait(pendingTasks, std::memory_order_acquire);
+        pendingTasks = m_pendingTasks.load(std::memory_order_acquire);
+    }
+}
+
+void EngineThreadPool::runTasks(std::uint32_t generation) {
+    std::uint64_t nextTask = m_nextTask.load(std::memory_order_acquire);
+    while (static_cast<std::uint32_t>(nextTask >> 32) == generation) {
+        const auto unclaimedTasks = static_cast<std::uint32_t>(nextTask);
+        if (unclaimedTasks == 0) {
+            return;
+        }
+        if (!m_nextTask.compare_exchange_weak(nextTask,
+                    nextTask - 1,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+            continue;
+        }
+        // The batch can't be replaced before this task has been finished.
+        m_pFunction(m_pContext, static_cast<int>(unclaimedTasks - 1));
+        if (m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_pendingTasks.notify_one();
+        }
+        nextTask = m_nextTask.load(std::memory_order_acquire);
+    }
+}
+
+void EngineThreadPool::workerLoop() {
+    std::uint32_t lastGeneration = m_generation.load(std::memory_order_acquire);
+    while (!m_quit.load(std::memory_order_acquire)) {
+        std::uint32_t generation = m_generation.load(std::memory_order_acquire);
+        for (int i = 0; generation == lastGeneration && i < kSpinIterations; ++i) {
+            cpuRelax();
+            generation = m_generation.load(std::memory_order_acquire);
+        }
+        if (generation == lastGeneration) {
+            m_generation.wait(lastGeneration, std::memory_order_acquire);
+            continue;
+        }
+        lastGeneration = generation;
+        runTasks(generation);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// EngineThreadPool distributes independent work items of a single audio
+/// callback to pre-spawned worker threads. The calling thread participates
+/// in the work and run() only returns after all tasks have been finished,
+/// i.e. it behaves like a parallel for-loop.
+///
+/// The handoff between the callback thread and the workers is lock-free.
+/// After finishing a batch the workers spin for a short while, because the
+/// next callback is due soon, and then go to sleep on a futex
+/// (std::atomic::wait) until the next batch is published. run() neither
+/// allocates memory nor locks a mutex and can be called from the realtime
+/// audio thread.
+class EngineThreadPool final {
+  public:
+    /// A plain function pointer is used instead of std::function to avoid
+    /// hidden heap allocations on the audio thread.
+    typedef void (*TaskFunction)(void* pContext, int taskIndex);
+
+    /// Spawns numWorkerThreads threads in addition to the calling thread.
+    explicit EngineThreadPool(int numWorkerThreads);
+    ~EngineThreadPool();
+
+    int numWorkerThreads() const {
+        return static_cast<int>(m_workers.size());
+    }
+
+    /// Invokes pFunction(pContext, i) for every i in [0, numTasks) and
+    /// returns after all invocations have returned. The order in which the
+    /// tasks are executed is unspecified. Must not be called concurrently.
+    void run(TaskFunction pFunction, void* pContext, int numTasks);
+
+  private:
+    class WorkerThread;
+
+    void workerLoop();
+    /// Claims and executes tasks of the given generation until all of them
+    /// have been claimed or the generation has been superseded.
+    void runTasks(std::uint32_t generation);
+
+    // Written by run() before the batch is published through m_nextTask and
+    // not modified again until all of its tasks have been finished.
+    TaskFunction m_pFunction;
+    void* m_pContext;
+
+    // The upper 32 bits contain the generation of the current batch, the
+    // lower 32 bits the number of tasks that have not been claimed yet.
+    // Combining both prevents a worker that wakes up late from claiming a
+    // task of the next batch on behalf of the previous one.
+    std::atomic<std::uint64_t> m_nextTask;
+    std::atomic<int> m_pendingTasks;
+    std::atomic<std::uint32_t> m_generation;
+    std::atomic<bool> m_quit;
+
+    std::vector<std::unique_ptr<WorkerThread>> m_workers;
+};
@@ -5,7 +5,7 @@
 #include "engine/engineworker.h"
 #include "moc_engineworkerscheduler.cpp"
 #include "util/compatibility/qmutex.h"
-#include "util/event.h"
+#include "util/tracing.h"
 
 EngineWorkerScheduler::EngineWorkerScheduler(QObject* pParent)
         : m_bWakeScheduler(false),
@@ -40,16 +40,14 @@ void EngineWorkerScheduler::runWorkers() {
 }
 
 void EngineWorkerScheduler::run() {
-    static const QString tag("EngineWorkerScheduler");
     while (!m_bQuit) {
-        Event::start(tag);
         {
+            mixxx::ScopedTrace trace("EngineWorkerScheduler");
             const auto locker = lockMutex(&m_mutex);
             for(const auto& pWorker: m_workers) {
                 pWorker->wakeIfReady();
             }
         }
-        Event::end(tag);
         {
             const auto lock = lockMutex(&m_mutex);
             if (!m_bQuit) {
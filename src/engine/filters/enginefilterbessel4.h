@@ -1,6 +1,6 @@
 #pragma once
 
-#include "engine/filters/enginefilteriir.h"
+#include "engine/filters/enginefilteriirblock.h"
 
 class EngineFilterBessel4Low : public EngineFilterIIR<4, IIR_LP> {
     Q_OBJECT
@@ -14,7 +14,7 @@ class EngineFilterBessel4Low : public EngineFilterIIR<4, IIR_LP> {
     int setFrequencyCornersForIntDelay(double desiredCorner1Ratio, int maxDelay);
 };
 
-class EngineFilterBessel4Band : public EngineFilterIIR<8, IIR_BP> {
+class EngineFilterBessel4Band : public EngineFilterIIRBlock<8, IIR_BP> {
     Q_OBJECT
   public:
     EngineFilterBessel4Band(int sampleRate, double freqCorner1,
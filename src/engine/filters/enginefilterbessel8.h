@@ -1,8 +1,8 @@
 #pragma once
 
-#include "engine/filters/enginefilteriir.h"
+#include "engine/filters/enginefilteriirblock.h"
 
-class EngineFilterBessel8Low : public EngineFilterIIR<8, IIR_LP> {
+class EngineFilterBessel8Low : public EngineFilterIIRBlock<8, IIR_LP> {
     Q_OBJECT
   public:
     EngineFilterBessel8Low(int sampleRate, double freqCorner1);
@@ -14,7 +14,7 @@ class EngineFilterBessel8Low : public EngineFilterIIR<8, IIR_LP> {
     int setFrequencyCornersForIntDelay(double desiredCorner1Ratio, int maxDelay);
 };
 
-class EngineFilterBessel8Band : public EngineFilterIIR<16, IIR_BP> {
+class EngineFilterBessel8Band : public EngineFilterIIRBlock<16, IIR_BP> {
     Q_OBJECT
   public:
     EngineFilterBessel8Band(int sampleRate, double freqCorner1,
@@ -23,7 +23,7 @@ class EngineFilterBessel8Band : public EngineFilterIIR<16, IIR_BP> {
             double freqCorner2);
 };
 
-class EngineFilterBessel8High : public EngineFilterIIR<8, IIR_HP> {
+class EngineFilterBessel8High : public EngineFilterIIRBlock<8, IIR_HP> {
     Q_OBJECT
   public:
     EngineFilterBessel8High(int sampleRate, double freqCorner1);
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "engine/filters/enginefilteriir.h"
+#include "engine/filters/enginefilteriirblock.h"
 
 class EngineFilterButterworth4Low : public EngineFilterIIR<4, IIR_LP> {
     Q_OBJECT
@@ -9,7 +9,7 @@ class EngineFilterButterworth4Low : public EngineFilterIIR<4, IIR_LP> {
     void setFrequencyCorners(int sampleRate, double freqCorner1);
 };
 
-class EngineFilterButterworth4Band : public EngineFilterIIR<8, IIR_BP> {
+class EngineFilterButterworth4Band : public EngineFilterIIRBlock<8, IIR_BP> {
     Q_OBJECT
   public:
     EngineFilterButterworth4Band(int sampleRate, double freqCorner1,
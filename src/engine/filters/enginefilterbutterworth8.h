@@ -1,15 +1,15 @@
 #pragma once
 
-#include "engine/filters/enginefilteriir.h"
+#include "engine/filters/enginefilteriirblock.h"
 
-class EngineFilterButterworth8Low : public EngineFilterIIR<8, IIR_LP> {
+class EngineFilterButterworth8Low : public EngineFilterIIRBlock<8, IIR_LP> {
     Q_OBJECT
   public:
     EngineFilterButterworth8Low(int sampleRate, double freqCorner1);
     void setFrequencyCorners(int sampleRate, double freqCorner1);
 };
 
-class EngineFilterButterworth8Band : public EngineFilterIIR<16, IIR_BP> {
+class EngineFilterButterworth8Band : public EngineFilterIIRBlock<16, IIR_BP> {
     Q_OBJECT
   public:
     EngineFilterButterworth8Band(int sampleRate, double freqCorner1,
@@ -18,7 +18,7 @@ class EngineFilterButterworth8Band : public EngineFilterIIR<16, IIR_BP> {
             double freqCorner2);
 };
 
-class EngineFilterButterworth8High : public EngineFilterIIR<8, IIR_HP> {
+class EngineFilterButterworth8High : public EngineFilterIIRBlock<8, IIR_HP> {
     Q_OBJECT
   public:
     EngineFilterButterworth8High(int sampleRate, double freqCorner1);
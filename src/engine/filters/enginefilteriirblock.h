@@ -0,0 +1,524 @@
+#pragma once
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIXXX_IIR_BLOCK_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MIXXX_IIR_BLOCK_NEON
+#endif
+
+#include "engine/filters/enginefilteriir.h"
+
+// The coefficients of a single section of an IIR cascade, see
+// EngineFilterIIR::processSample() for the sample by sample version.
+// A second order section calculates
+//   iir = in * gain - a2 * d2 - a1 * d1
+//   out = b2 * d2 + b1 * d1 + b0 * iir
+// and shifts iir into its state (d2, d1). First order sections
+// only use d2.
+struct EngineFilterIIRSection {
+    double gain;
+    double a2;
+    double a1;
+    double b2;
+    double b1;
+    double b0;
+};
+
+// Describes the processSample() specializations of EngineFilterIIR as
+// a cascade of kSections sections of the order kOrder. The state of
+// section s is stored in buf[kOrder * s] ... buf[kOrder * s + kOrder - 1]
+// of EngineFilterIIR.
+template<unsigned int SIZE, enum IIRPass PASS>
+struct EngineFilterIIRCascade;
+
+namespace mixxx {
+namespace iir {
+
+// A second order section with a numerator of 1 + b1 * z^-1 + z^-2,
+// i.e. b1 = 2 for low passes and b1 = -2 for high passes.
+inline EngineFilterIIRSection biquadSection(const double* coef, int section, double b1) {
+    return EngineFilterIIRSection{
+            section == 0 ? coef[0] : 1.0,
+            coef[1 + 2 * section],
+            coef[2 + 2 * section],
+            1.0,
+            b1,
+            1.0};
+}
+
+// A first order section with a numerator of b2 * z^-1 + 1
+inline EngineFilterIIRSection firstOrderSection(
+        const double* coef, int section, double gain, double b2) {
+    return EngineFilterIIRSection{
+            section == 0 ? gain : 1.0,
+            coef[1 + section],
+            0.0,
+            b2,
+            0.0,
+            1.0};
+}
+
+
+// The left and the right channel of a section, processed together in
+// one SIMD register. SSE2 is part of the x86-64 baseline and NEON of
+// AArch64, so no runtime dispatch is required.
+#if defined(MIXXX_IIR_BLOCK_SSE2)
+typedef __m128d StereoSample;
+
+inline StereoSample stereoSet(double left, double right) {
+    return _mm_set_pd(right, left);
+}
+inline StereoSample stereoBroadcast(double value) {
+    return _mm_set1_pd(value);
+}
+inline StereoSample stereoAdd(StereoSample a, StereoSample b) {
+    return _mm_add_pd(a, b);
+}
+inline StereoSample stereoSub(StereoSample a, StereoSample b) {
+    return _mm_sub_pd(a, b);
+}
+inline StereoSample stereoMul(StereoSample a, StereoSample b) {
+    return _mm_mul_pd(a, b);
+}
+inline double stereoLeft(StereoSample a) {
+    return _mm_cvtsd_f64(a);
+}
+inline double stereoRight(StereoSample a) {
+    return _mm_cvtsd_f64(_mm_unpackhi_pd(a, a));
+}
+#elif defined(MIXXX_IIR_BLOCK_NEON)
+typedef float64x2_t StereoSample;
+
+inline StereoSample stereoSet(double left, double right) {
+    return vsetq_lane_f64(right, vdupq_n_f64(left), 1);
+}
+inline StereoSample stereoBroadcast(double value) {
+    return vdupq_n_f64(value);
+}
+inline StereoSample stereoAdd(StereoSample a, StereoSample b) {
+    return vaddq_f64(a, b);
+}
+inline StereoSample stereoSub(StereoSample a, StereoSample b) {
+    return vsubq_f64(a, b);
+}
+inline StereoSample stereoMul(StereoSample a, StereoSample b) {
+    return vmulq_f64(a, b);
+}
+inline double stereoLeft(StereoSample a) {
+    return vgetq_lane_f64(a, 0);
+}
+inline double stereoRight(StereoSample a) {
+    return vgetq_lane_f64(a, 1);
+}
+#else
+struct StereoSample {
+    double left;
+    double right;
+};
+
+inline StereoSample stereoSet(double left, double right) {
+    return StereoSample{left, right};
+}
+inline StereoSample stereoBroadcast(double value) {
+    return StereoSample{value, value};
+}
+inline StereoSample stereoAdd(StereoSample a, StereoSample b) {
+    return StereoSample{a.left + b.left, a.right + b.right};
+}
+inline StereoSample stereoSub(StereoSample a, StereoSample b) {
+    return StereoSample{a.left - b.left, a.right - b.right};
+}
+inline StereoSample stereoMul(StereoSample a, StereoSample b) {
+    return StereoSample{a.left * b.left, a.right * b.right};
+}
+inline double stereoLeft(StereoSample a) {
+    return a.left;
+}
+inline double stereoRight(StereoSample a) {
+    return a.right;
+}
+#endif
+
+} // namespace iir
+} // namespace mixxx
+
+template<>
+struct EngineFilterIIRCascade<2, IIR_LP> {
+    static constexpr int kSections = 1;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, 2.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<2, IIR_BP> {
+    static constexpr int kSections = 1;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        Q_UNUSED(section);
+        return EngineFilterIIRSection{coef[0], coef[1], coef[2], -1.0, 0.0, 1.0};
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<2, IIR_HP> {
+    static constexpr int kSections = 1;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, -2.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<4, IIR_LP> {
+    static constexpr int kSections = 2;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, 2.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<4, IIR_HP> {
+    static constexpr int kSections = 2;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, -2.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<8, IIR_LP> {
+    static constexpr int kSections = 4;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, 2.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<8, IIR_HP> {
+    static constexpr int kSections = 4;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, -2.0);
+    }
+};
+
+// The high pass sections come first
+template<>
+struct EngineFilterIIRCascade<8, IIR_BP> {
+    static constexpr int kSections = 4;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, section < 2 ? -2.0 : 2.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<16, IIR_BP> {
+    static constexpr int kSections = 8;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::biquadSection(coef, section, section < 4 ? -2.0 : 2.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<5, IIR_BP> {
+    static constexpr int kSections = 1;
+    static constexpr int kOrder = 2;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        Q_UNUSED(section);
+        return EngineFilterIIRSection{coef[0], coef[1], coef[3], coef[2], coef[4], coef[5]};
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<4, IIR_LPMO> {
+    static constexpr int kSections = 4;
+    static constexpr int kOrder = 1;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::firstOrderSection(coef, section, coef[0], 1.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<4, IIR_HPMO> {
+    static constexpr int kSections = 4;
+    static constexpr int kOrder = 1;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::firstOrderSection(coef, section, coef[0], -1.0);
+    }
+};
+
+template<>
+struct EngineFilterIIRCascade<2, IIR_LP2> {
+    static constexpr int kSections = 2;
+    static constexpr int kOrder = 1;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::firstOrderSection(coef, section, coef[0], 1.0);
+    }
+};
+
+// The gain is inverted to be in phase with IIR_LP2
+template<>
+struct EngineFilterIIRCascade<2, IIR_HP2> {
+    static constexpr int kSections = 2;
+    static constexpr int kOrder = 1;
+    static EngineFilterIIRSection section(const double* coef, int section) {
+        return mixxx::iir::firstOrderSection(coef, section, -coef[0], -1.0);
+    }
+};
+
+// A drop-in replacement for EngineFilterIIR that processes whole blocks
+// instead of single samples. It uses the same coefficients and state, so
+// derived filters only need to change their base class.
+//
+// The left and right channel of each section are processed together in
+// one SIMD register, and the sections of the cascade form a pipeline: In
+// each step section s filters the frame step - s, using the output of
+// section s - 1 from the previous step. The sections of a step do not
+// depend on each other, so the CPU can overlap them. The pipeline is
+// filled and drained within each block, so there is no additional latency
+// and each section does the same calculations as processSample().
+//
+// This pays off for cascades of at least four sections. Shorter cascades
+// are faster with EngineFilterIIR, because the CPU already overlaps the
+// processing of consecutive samples.
+//
+// Coefficient changes are smoothed like in EngineFilterIIR by a crossfade
+// between the old and the new filter. The crossfade is calculated in blocks
+// of kRampingBlockFrames using buffers on the stack.
+template<unsigned int SIZE, enum IIRPass PASS>
+class EngineFilterIIRBlock : public EngineFilterIIR<SIZE, PASS> {
+  public:
+    void process(const CSAMPLE* pIn, CSAMPLE* pOutput, const int iBufferSize) override {
+        if (!this->m_doRamping) {
+            processBlock(this->m_coef, this->m_buf1, this->m_buf2, pIn, pOutput, iBufferSize / 2);
+            return;
+        }
+        CSAMPLE oldOutput[kRampingBlockFrames * 2];
+        CSAMPLE newOutput[kRampingBlockFrames * 2];
+        double cross_mix = 0.0;
+        const double cross_inc = 4.0 / static_cast<double>(iBufferSize);
+        for (int offset = 0; offset < iBufferSize; offset += kRampingBlockFrames * 2) {
+            const int numSamples = std::min(kRampingBlockFrames * 2, iBufferSize - offset);
+            if (!this->m_doStart) {
+                // Process old filter, but only if we do not do a fresh start
+                processBlock(this->m_oldCoef,
+                        this->m_oldBuf1,
+                        this->m_oldBuf2,
+                        pIn + offset,
+                        oldOutput,
+                        numSamples / 2);
+            } else if (this->m_startFromDry) {
+                std::copy(pIn + offset, pIn + offset + numSamples, oldOutput);
+            } else {
+                std::fill(oldOutput, oldOutput + numSamples, CSAMPLE_ZERO);
+            }
+            processBlock(this->m_coef,
+                    this->m_buf1,
+                    this->m_buf2,
+                    pIn + offset,
+                    newOutput,
+                    numSamples / 2);
+            // The same crossfade as in EngineFilterIIR::process()
+            for (int j = 0; j < numSamples; j += 2) {
+                const int i = offset + j;
+                if (i < iBufferSize / 2) {
+                    pOutput[i] = oldOutput[j];
+                    pOutput[i + 1] = oldOutput[j + 1];
+                } else {
+                    pOutput[i] = static_cast<CSAMPLE>(
+                            newOutput[j] * cross_mix + oldOutput[j] * (1.0 - cross_mix));
+                    pOutput[i + 1] = static_cast<CSAMPLE>(
+                            newOutput[j + 1] * cross_mix + oldOutput[j + 1] * (1.0 - cross_mix));
+                    cross_mix += cross_inc;
+                }
+            }
+        }
+        this->m_doRamping = false;
+        this->m_doStart = false;
+    }
+
+  private:
+    typedef EngineFilterIIRCascade<SIZE, PASS> Cascade;
+    static constexpr int kSections = Cascade::kSections;
+    static constexpr int kOrder = Cascade::kOrder;
+    static constexpr int kLanes = 2 * kSections;
+    static constexpr int kRampingBlockFrames = 64;
+
+    // Lane 2 * s is the left and lane 2 * s + 1 the right channel of section s
+    struct Lanes {
+        double a2[kLanes];
+        double a1[kLanes];
+        double b2[kLanes];
+        double b1[kLanes];
+        double b0[kLanes];
+        double d2[kLanes];
+        double d1[kLanes];
+        // The output of each section in the previous step
+        double out[kLanes];
+    };
+
+    // Processes one step while the pipeline is filled or drained. Only
+    // the sections [sectionBegin, sectionEnd) are active, the state of the
+    // other sections is kept.
+    static void processPartialStep(Lanes* pLanes,
+            const CSAMPLE* pIn,
+            CSAMPLE* pOutput,
+            int numFrames,
+            int step,
+            double gain) {
+        const int sectionBegin = std::max(0, step - numFrames + 1);
+        const int sectionEnd = std::min(kSections, step + 1);
+        // Backwards, so each section reads the output of its predecessor
+        // from the previous step
+        for (int l = 2 * sectionEnd - 1; l >= 2 * sectionBegin; --l) {
+            double iir = l < 2 ? pIn[step * 2 + l] * gain : pLanes->out[l - 2];
+            iir -= pLanes->a2[l] * pLanes->d2[l];
+            double fir = pLanes->b2[l] * pLanes->d2[l];
+            if (kOrder == 2) {
+                iir -= pLanes->a1[l] * pLanes->d1[l];
+                fir += pLanes->b1[l] * pLanes->d1[l];
+                pLanes->d2[l] = pLanes->d1[l];
+                pLanes->d1[l] = iir;
+            } else {
+                pLanes->d2[l] = iir;
+            }
+            fir += pLanes->b0[l] * iir;
+            pLanes->out[l] = fir;
+        }
+        if (sectionEnd == kSections) {
+            const int frame = step - (kSections - 1);
+            pOutput[frame * 2] = static_cast<CSAMPLE>(pLanes->out[kLanes - 2]);
+            pOutput[frame * 2 + 1] = static_cast<CSAMPLE>(pLanes->out[kLanes - 1]);
+        }
+    }
+
+    // Processes the steps [stepBegin, stepEnd) in which all sections are
+    // active. The lanes are copied into local variables that are only
+    // indexed by constants, so they stay in registers.
+    static void processSteps(Lanes* pLanes,
+            const CSAMPLE* pIn,
+            CSAMPLE* pOutput,
+            int stepBegin,
+            int stepEnd,
+            double gain) {
+        using namespace mixxx::iir;
+        if (stepBegin >= stepEnd) {
+            return;
+        }
+        StereoSample a2[kSections];
+        StereoSample a1[kSections];
+        StereoSample b2[kSections];
+        StereoSample b1[kSections];
+        StereoSample b0[kSections];
+        StereoSample d2[kSections];
+        StereoSample d1[kSections];
+        StereoSample out[kSections];
+        for (int s = 0; s < kSections; ++s) {
+            const int l = 2 * s;
+            a2[s] = stereoBroadcast(pLanes->a2[l]);
+            a1[s] = stereoBroadcast(pLanes->a1[l]);
+            b2[s] = stereoBroadcast(pLanes->b2[l]);
+            b1[s] = stereoBroadcast(pLanes->b1[l]);
+            b0[s] = stereoBroadcast(pLanes->b0[l]);
+            d2[s] = stereoSet(pLanes->d2[l], pLanes->d2[l + 1]);
+            d1[s] = stereoSet(pLanes->d1[l], pLanes->d1[l + 1]);
+            out[s] = stereoSet(pLanes->out[l], pLanes->out[l + 1]);
+        }
+        const StereoSample stereoGain = stereoBroadcast(gain);
+        for (int step = stepBegin; step < stepEnd; ++step) {
+            // Backwards, so each section reads the output of its
+            // predecessor from the previous step
+            for (int s = kSections - 1; s >= 0; --s) {
+                StereoSample iir = s == 0
+                        ? stereoMul(stereoSet(pIn[step * 2], pIn[step * 2 + 1]),
+                                  stereoGain)
+                        : out[s - 1];
+                iir = stereoSub(iir, stereoMul(a2[s], d2[s]));
+                StereoSample fir = stereoMul(b2[s], d2[s]);
+                if (kOrder == 2) {
+                    iir = stereoSub(iir, stereoMul(a1[s], d1[s]));
+                    fir = stereoAdd(fir, stereoMul(b1[s], d1[s]));
+                    d2[s] = d1[s];
+                    d1[s] = iir;
+                } else {
+                    d2[s] = iir;
+                }
+                out[s] = stereoAdd(fir, stereoMul(b0[s], iir));
+            }
+            const int frame = step - (kSections - 1);
+            pOutput[frame * 2] = static_cast<CSAMPLE>(stereoLeft(out[kSections - 1]));
+            pOutput[frame * 2 + 1] = static_cast<CSAMPLE>(stereoRight(out[kSections - 1]));
+        }
+        for (int s = 0; s < kSections; ++s) {
+            const int l = 2 * s;
+            pLanes->d2[l] = stereoLeft(d2[s]);
+            pLanes->d2[l + 1] = stereoRight(d2[s]);
+            pLanes->d1[l] = stereoLeft(d1[s]);
+            pLanes->d1[l + 1] = stereoRight(d1[s]);
+            pLanes->out[l] = stereoLeft(out[s]);
+            pLanes->out[l + 1] = stereoRight(out[s]);
+        }
+    }
+
+    static void processBlock(const double* coef,
+            double* buf1,
+            double* buf2,
+            const CSAMPLE* pIn,
+            CSAMPLE* pOutput,
+            int numFrames) {
+        Lanes lanes;
+        const double gain = Cascade::section(coef, 0).gain;
+        for (int s = 0; s < kSections; ++s) {
+            const EngineFilterIIRSection section = Cascade::section(coef, s);
+            DEBUG_ASSERT(s == 0 || section.gain == 1.0);
+            for (int c = 0; c < 2; ++c) {
+                const int l = 2 * s + c;
+                const double* buf = c == 0 ? buf1 : buf2;
+                lanes.a2[l] = section.a2;
+                lanes.a1[l] = section.a1;
+                lanes.b2[l] = section.b2;
+                lanes.b1[l] = section.b1;
+                lanes.b0[l] = section.b0;
+                lanes.d2[l] = buf[kOrder * s];
+                lanes.d1[l] = kOrder == 2 ? buf[kOrder * s + 1] : 0.0;
+                lanes.out[l] = 0.0;
+            }
+        }
+
+        // Writing the output lags behind reading the input, so processing
+        // in place is safe. Only the few steps that fill and drain the
+        // pipeline need to skip sections, all other steps are processed
+        // by processSteps() without any branches.
+        const int numSteps = numFrames + kSections - 1;
+        const int steadyBegin = std::min(kSections - 1, numSteps);
+        const int steadyEnd = std::max(steadyBegin, numFrames);
+        for (int step = 0; step < steadyBegin; ++step) {
+            processPartialStep(&lanes, pIn, pOutput, numFrames, step, gain);
+        }
+        processSteps(&lanes, pIn, pOutput, steadyBegin, steadyEnd, gain);
+        for (int step = steadyEnd; step < numSteps; ++step) {
+            processPartialStep(&lanes, pIn, pOutput, numFrames, step, gain);
+        }
+
+        for (int s = 0; s < kSections; ++s) {
+            for (int c = 0; c < 2; ++c) {
+                const int l = 2 * s + c;
+                double* buf = c == 0 ? buf1 : buf2;
+                buf[kOrder * s] = lanes.d2[l];
+                if (kOrder == 2) {
+                    buf[kOrder * s + 1] = lanes.d1[l];
+                }
+            }
+        }
+    }
+};
@@ -1,8 +1,8 @@
 #pragma once
 
-#include "engine/filters/enginefilteriir.h"
+#include "engine/filters/enginefilteriirblock.h"
 
-class EngineFilterLinkwitzRiley8Low : public EngineFilterIIR<8, IIR_LP> {
+class EngineFilterLinkwitzRiley8Low : public EngineFilterIIRBlock<8, IIR_LP> {
     Q_OBJECT
   public:
     EngineFilterLinkwitzRiley8Low(int sampleRate, double freqCorner1);
@@ -10,7 +10,7 @@ class EngineFilterLinkwitzRiley8Low : public EngineFilterIIR<8, IIR_LP> {
 };
 
 
-class EngineFilterLinkwitzRiley8High : public EngineFilterIIR<8, IIR_HP> {
+class EngineFilterLinkwitzRiley8High : public EngineFilterIIRBlock<8, IIR_HP> {
     Q_OBJECT
   public:
     EngineFilterLinkwitzRiley8High(int sampleRate, double freqCorner1);
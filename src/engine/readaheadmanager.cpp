@@ -225,13 +225,13 @@ void ReadAheadManager::addReadLogEntry(double virtualPlaypositionStart,
                                        double virtualPlaypositionEndNonInclusive) {
     ReadLogEntry newEntry(virtualPlaypositionStart,
                           virtualPlaypositionEndNonInclusive);
-    if (m_readAheadLog.size() > 0) {
+    if (!m_readAheadLog.isEmpty()) {
         ReadLogEntry& last = m_readAheadLog.back();
         if (last.merge(newEntry)) {
             return;
         }
     }
-    m_readAheadLog.push_back(newEntry);
+    m_readAheadLog.pushBack(newEntry);
 }
 
 // Not thread-save, call from engine thread only
@@ -242,7 +242,7 @@ double ReadAheadManager::getFilePlaypositionFromLog(
         return currentFilePlayposition;
     }
 
-    if (m_readAheadLog.size() == 0) {
+    if (m_readAheadLog.isEmpty()) {
         // No log entries to read from.
         qDebug() << this << "No read ahead log entries to read from. Case not currently handled.";
         // TODO(rryan) log through a stats pipe eventually
@@ -251,7 +251,7 @@ double ReadAheadManager::getFilePlaypositionFromLog(
 
     double filePlayposition = 0;
     bool shouldNotifySeek = false;
-    while (m_readAheadLog.size() > 0 && numConsumedSamples > 0) {
+    while (!m_readAheadLog.isEmpty() && numConsumedSamples > 0) {
         ReadLogEntry& entry = m_readAheadLog.front();
 
         // Notify EngineControls that we have taken a seek.
@@ -272,7 +272,7 @@ double ReadAheadManager::getFilePlaypositionFromLog(
 
         if (entry.length() == 0) {
             // This entry is empty now.
-            m_readAheadLog.pop_front();
+            m_readAheadLog.popFront();
         }
         shouldNotifySeek = true;
     }
@@ -2,8 +2,8 @@
 
 #include <QList>
 #include <QPair>
+#include <array>
 #include <gsl/pointers>
-#include <list>
 
 #include "audio/frame.h"
 #include "engine/cachingreader/cachingreader.h"
@@ -70,6 +70,11 @@ class ReadAheadManager {
         double virtualPlaypositionStart;
         double virtualPlaypositionEndNonInclusive;
 
+        ReadLogEntry()
+                : virtualPlaypositionStart(0),
+                  virtualPlaypositionEndNonInclusive(0) {
+        }
+
         ReadLogEntry(double virtualPlaypositionStart,
                      double virtualPlaypositionEndNonInclusive) {
             this->virtualPlaypositionStart = virtualPlaypositionStart;
@@ -114,6 +119,64 @@ class ReadAheadManager {
         }
     };
 
+    /// The read log is accessed from the engine callback and must not
+    /// allocate memory. It is a ring of fixed capacity that is consumed
+    /// on every callback, usually holding only a few entries.
+    class ReadLog {
+      public:
+        ReadLog()
+                : m_head(0),
+                  m_size(0) {
+        }
+
+        bool isEmpty() const {
+            return m_size == 0;
+        }
+
+        int size() const {
+            return m_size;
+        }
+
+        ReadLogEntry& front() {
+            DEBUG_ASSERT(!isEmpty());
+            return m_entries[m_head];
+        }
+
+        ReadLogEntry& back() {
+            DEBUG_ASSERT(!isEmpty());
+            return m_entries[(m_head + m_size - 1) % kCapacity];
+        }
+
+        /// If the log is full the oldest entry is dropped. This would
+        /// require thousands of reads within a single callback, e.g.
+        /// when looping a tiny loop at a high rate.
+        void pushBack(const ReadLogEntry& entry) {
+            if (m_size == kCapacity) {
+                popFront();
+            }
+            m_entries[(m_head + m_size) % kCapacity] = entry;
+            ++m_size;
+        }
+
+        void popFront() {
+            DEBUG_ASSERT(!isEmpty());
+            m_head = (m_head + 1) % kCapacity;
+            --m_size;
+        }
+
+        void clear() {
+            m_head = 0;
+            m_size = 0;
+        }
+
+        static constexpr int kCapacity = 1024;
+
+      private:
+        std::array<ReadLogEntry, kCapacity> m_entries;
+        int m_head;
+        int m_size;
+    };
+
     /// virtualPlaypositionEnd is the first sample in the direction that was
     /// read that was NOT read as part of this log entry.
     void addReadLogEntry(double virtualPlaypositionStart,
@@ -121,7 +184,7 @@ class ReadAheadManager {
 
     LoopingControl* m_pLoopingControl;
     RateControl* m_pRateControl;
-    std::list<ReadLogEntry> m_readAheadLog;
+    ReadLog m_readAheadLog;
     double m_currentPosition;
     CachingReader* m_pReader;
     CSAMPLE* m_pCrossFadeBuffer;
@@ -8,7 +8,7 @@
 #include "preferences/usersettings.h"
 #include "recording/defs_recording.h"
 #include "track/track.h"
-#include "util/event.h"
+#include "util/tracing.h"
 
 constexpr int kMetaDataLifeTimeout = 16;
 
@@ -112,12 +112,10 @@ bool EngineRecord::metaDataHasChanged()
 
 void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
     const auto recordingStatus = static_cast<int>(m_pRecReady->get());
-    static const QString tag("EngineRecord recording");
-
     if (recordingStatus == RECORD_OFF) {
         //qDebug("Setting record flag to: OFF");
         if (fileOpen()) {
-            Event::end(tag);
+            mixxx::Tracing::recordInstant("EngineRecord recording stopped");
             closeFile();  // Close file and free encoder.
             if (m_bCueIsEnabled) {
                 closeCueFile();
@@ -137,7 +135,7 @@ void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
             // There was already a message Box
             emit isRecording(false, false);
         } else if (openFile()) {
-            Event::start(tag);
+            mixxx::Tracing::recordInstant("EngineRecord recording started");
             qDebug("Setting record flag to: ON");
             m_pRecReady->set(RECORD_ON);
             emit isRecording(true, false);  // will notify the RecordingManager
@@ -189,7 +187,7 @@ void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
             }
         } else {  // Maybe the encoder could not be initialized
             qDebug() << "Could not open" << m_fileName << "for writing.";
-            Event::end(tag);
+            mixxx::Tracing::recordInstant("EngineRecord recording stopped");
             qDebug("Setting record flag to: OFF");
             m_pRecReady->set(RECORD_OFF);
             // An error occurred.
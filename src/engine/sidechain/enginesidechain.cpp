@@ -14,7 +14,6 @@
 #include "engine/sidechain/sidechainworker.h"
 #include "moc_enginesidechain.cpp"
 #include "util/counter.h"
-#include "util/event.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -98,16 +97,12 @@ void EngineSideChain::run() {
     // factor this out somehow), -kousu 2/2009
     unsigned static id = 0;
     QThread::currentThread()->setObjectName(QString("EngineSideChain %1").arg(++id));
-    static const QString tag("EngineSideChain");
-    Event::start(tag);
+    mixxx::Tracing::registerCurrentThread("EngineSideChain");
     while (!m_bStopThread) {
         // Sleep until samples are available.
         m_waitLock.lock();
-
-        Event::end(tag);
         m_waitForSamples.wait(&m_waitLock);
         m_waitLock.unlock();
-        Event::start(tag);
 
         int samples_read;
         while ((samples_read = m_sampleFifo.read(m_pWorkBuffer,
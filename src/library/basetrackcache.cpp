@@ -1,8 +1,13 @@
 #include "library/basetrackcache.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "library/queryutil.h"
 #include "library/searchqueryparser.h"
 #include "library/trackcollection.h"
+#include "library/tracksearchindex.h"
 #include "moc_basetrackcache.cpp"
 #include "track/globaltrackcache.h"
 #include "track/keyutils.h"
@@ -13,6 +18,207 @@ namespace {
 
 constexpr bool sDebug = false;
 
+// Columns with many duplicate values are stored dictionary-encoded
+const ColumnCache::Column kDictionaryEncodedColumns[] = {
+        ColumnCache::COLUMN_LIBRARYTABLE_ARTIST,
+        ColumnCache::COLUMN_LIBRARYTABLE_ALBUM,
+        ColumnCache::COLUMN_LIBRARYTABLE_ALBUMARTIST,
+        ColumnCache::COLUMN_LIBRARYTABLE_YEAR,
+        ColumnCache::COLUMN_LIBRARYTABLE_GENRE,
+        ColumnCache::COLUMN_LIBRARYTABLE_COMPOSER,
+        ColumnCache::COLUMN_LIBRARYTABLE_GROUPING,
+        ColumnCache::COLUMN_LIBRARYTABLE_FILETYPE,
+        ColumnCache::COLUMN_LIBRARYTABLE_KEY,
+        ColumnCache::COLUMN_LIBRARYTABLE_COVERART_LOCATION,
+};
+
+// The text columns that are matched by TextFilterNode, either
+// by plain search terms or by text filters like "artist:"
+const ColumnCache::Column kSearchIndexColumns[] = {
+        ColumnCache::COLUMN_LIBRARYTABLE_ARTIST,
+        ColumnCache::COLUMN_LIBRARYTABLE_ALBUMARTIST,
+        ColumnCache::COLUMN_LIBRARYTABLE_ALBUM,
+        ColumnCache::COLUMN_LIBRARYTABLE_TITLE,
+        ColumnCache::COLUMN_LIBRARYTABLE_GENRE,
+        ColumnCache::COLUMN_LIBRARYTABLE_COMPOSER,
+        ColumnCache::COLUMN_LIBRARYTABLE_GROUPING,
+        ColumnCache::COLUMN_LIBRARYTABLE_COMMENT,
+        ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION,
+};
+
+// A value of the cache after the conversion by the SQL expression of
+// ColumnCache::columnSortForFieldIndex(). Values of different classes
+// are ordered like in SQLite: NULL < numbers < text.
+struct SortValue {
+    enum class Class : quint8 {
+        Null,
+        Number,
+        String,
+    };
+    Class valueClass = Class::Null;
+    double number = 0.0;
+    QString string;
+};
+
+// A SortValue with the string replaced by its rank
+struct SortKey {
+    SortValue::Class valueClass;
+    double number;
+};
+
+SortValue numberSortValue(double number) {
+    SortValue value;
+    value.valueClass = SortValue::Class::Number;
+    value.number = number;
+    return value;
+}
+
+SortValue stringSortValue(QString string) {
+    SortValue value;
+    value.valueClass = SortValue::Class::String;
+    value.string = std::move(string);
+    return value;
+}
+
+SortValue cellSortValue(const TrackColumnTable& table, int row, int column) {
+    if (row < 0) {
+        return SortValue();
+    }
+    switch (table.valueClass(row, column)) {
+    case TrackColumnTable::ValueClass::Null:
+        return SortValue();
+    case TrackColumnTable::ValueClass::Number:
+        return numberSortValue(table.doubleValue(row, column));
+    case TrackColumnTable::ValueClass::String:
+        return stringSortValue(table.stringValue(row, column));
+    case TrackColumnTable::ValueClass::Other:
+        return stringSortValue(table.value(row, column).toString());
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return SortValue();
+}
+
+SortValue variantSortValue(const QVariant& variant) {
+    switch (variant.userType()) {
+    case QMetaType::QString:
+        if (variant.isNull()) {
+            return SortValue();
+        }
+        return stringSortValue(variant.toString());
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return numberSortValue(variant.toDouble());
+    default:
+        if (!variant.isValid()) {
+            return SortValue();
+        }
+        return stringSortValue(variant.toString());
+    }
+}
+
+// The leading integer of a string like CAST(... AS INTEGER) in SQLite
+qint64 leadingInteger(const QString& string) {
+    int i = 0;
+    while (i < string.size() && string.at(i).isSpace()) {
+        ++i;
+    }
+    bool negative = false;
+    if (i < string.size() && (string.at(i) == '-' || string.at(i) == '+')) {
+        negative = string.at(i) == '-';
+        ++i;
+    }
+    qint64 result = 0;
+    for (; i < string.size() && string.at(i) >= '0' && string.at(i) <= '9'; ++i) {
+        result = result * 10 + (string.at(i).unicode() - '0');
+    }
+    return negative ? -result : result;
+}
+
+SortValue convertSortValue(SortValue value,
+        ColumnCache::SortType sortType,
+        KeyUtils::KeyNotation keyNotation) {
+    if (value.valueClass == SortValue::Class::Null) {
+        return value;
+    }
+    switch (sortType) {
+    case ColumnCache::SortType::Default:
+    case ColumnCache::SortType::NoCaseLex:
+        // The collation only affects the comparison of strings
+        return value;
+    case ColumnCache::SortType::NoCase:
+        // lower() converts numbers to text and only folds ASCII characters
+        if (value.valueClass == SortValue::Class::Number) {
+            return stringSortValue(QString::number(value.number, 'g', 15));
+        }
+        for (QChar& c : value.string) {
+            if (c >= 'A' && c <= 'Z') {
+                c = QChar(c.unicode() + ('a' - 'A'));
+            }
+        }
+        return value;
+    case ColumnCache::SortType::Integer:
+        if (value.valueClass == SortValue::Class::Number) {
+            return numberSortValue(std::trunc(value.number));
+        }
+        return numberSortValue(static_cast<double>(leadingInteger(value.string)));
+    case ColumnCache::SortType::Key: {
+        const auto key = value.valueClass == SortValue::Class::Number
+                ? static_cast<qint64>(value.number)
+                : leadingInteger(value.string);
+        if (key < 0 || key > 24) {
+            // No WHEN clause of the CASE expression matches
+            return SortValue();
+        }
+        return numberSortValue(KeyUtils::keyToCircleOfFifthsOrder(
+                static_cast<mixxx::track::io::key::ChromaticKey>(key),
+                keyNotation));
+    }
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return value;
+}
+
+int compareSortStrings(const QString& string1,
+        const QString& string2,
+        ColumnCache::SortType sortType,
+        const mixxx::StringCollator& collator) {
+    if (sortType == ColumnCache::SortType::NoCaseLex) {
+        return collator.compare(string1, string2);
+    }
+    return string1.compare(string2);
+}
+
+int compareSortValues(const SortValue& value1,
+        const SortValue& value2,
+        ColumnCache::SortType sortType,
+        const mixxx::StringCollator& collator) {
+    if (value1.valueClass != value2.valueClass) {
+        return value1.valueClass < value2.valueClass ? -1 : 1;
+    }
+    switch (value1.valueClass) {
+    case SortValue::Class::Null:
+        return 0;
+    case SortValue::Class::Number:
+        return (value1.number > value2.number) - (value1.number < value2.number);
+    case SortValue::Class::String:
+        return compareSortStrings(value1.string, value2.string, sortType, collator);
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return 0;
+}
+
+int compareSortKeys(const SortKey& key1, const SortKey& key2) {
+    if (key1.valueClass != key2.valueClass) {
+        return key1.valueClass < key2.valueClass ? -1 : 1;
+    }
+    return (key1.number > key2.number) - (key1.number < key2.number);
+}
+
 }  // namespace
 
 BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
@@ -26,9 +232,18 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
           m_columnsJoined(columns.join(",")),
           m_columnCache(columns),
           m_pQueryParser(new SearchQueryParser(pTrackCollection)),
+          m_bPrevResultsValid(false),
           m_bIndexBuilt(false),
           m_bIsCaching(isCaching),
+          m_trackInfo(m_columnCount),
           m_database(pTrackCollection->database()) {
+    for (const auto column : kDictionaryEncodedColumns) {
+        const int index = m_columnCache.fieldIndex(column);
+        if (index >= 0) {
+            m_trackInfo.setDictionaryEncoded(index);
+        }
+    }
+
     m_searchColumns << "artist"
                     << "album"
                     << "album_artist"
@@ -83,6 +298,7 @@ void BaseTrackCache::slotScanTrackAdded(TrackPointer pTrack) {
     if (sDebug) {
         qDebug() << this << "slotScanTrackAdded";
     }
+    m_bPrevResultsValid = false;
     updateTrackInIndex(pTrack);
 }
 
@@ -90,8 +306,9 @@ void BaseTrackCache::slotTracksRemoved(const QSet<TrackId>& trackIds) {
     if (sDebug) {
         qDebug() << this << "slotTracksRemoved" << trackIds.size();
     }
+    m_bPrevResultsValid = false;
     for (const auto& trackId : qAsConst(trackIds)) {
-        m_trackInfo.remove(trackId);
+        m_trackInfo.removeRow(trackId);
         m_dirtyTracks.remove(trackId);
     }
 }
@@ -100,6 +317,7 @@ void BaseTrackCache::slotTrackDirty(TrackId trackId) {
     if (sDebug) {
         qDebug() << this << "slotTrackDirty" << trackId;
     }
+    m_bPrevResultsValid = false;
     m_dirtyTracks.insert(trackId);
 }
 
@@ -125,9 +343,52 @@ void BaseTrackCache::ensureCached(const QSet<TrackId>& trackIds) {
 }
 
 void BaseTrackCache::setSearchColumns(const QStringList& columns) {
+    m_bPrevResultsValid = false;
     m_searchColumns = columns;
 }
 
+void BaseTrackCache::setSearchIndexEnabled(bool enabled) {
+    if (enabled == static_cast<bool>(m_pSearchIndex)) {
+        return;
+    }
+    if (!enabled) {
+        m_pSearchIndex.reset();
+        m_searchIndexColumnIndices.clear();
+        return;
+    }
+    QStringList columns;
+    for (const auto column : kSearchIndexColumns) {
+        const int index = m_columnCache.fieldIndex(column);
+        if (index >= 0) {
+            columns << m_columnCache.columnNameForFieldIndex(index);
+            m_searchIndexColumnIndices << index;
+        }
+    }
+    m_pSearchIndex = std::make_unique<TrackSearchIndex>(m_idColumn, columns);
+    for (int row = 0; row < m_trackInfo.rowCapacity(); ++row) {
+        if (m_trackInfo.trackIdOfRow(row).isValid()) {
+            updateSearchIndex(row);
+        }
+    }
+    m_pSearchIndex->commit();
+}
+
+void BaseTrackCache::updateSearchIndex(int row) {
+    DEBUG_ASSERT(m_pSearchIndex);
+    const TrackId trackId = m_trackInfo.trackIdOfRow(row);
+    for (const auto column : qAsConst(m_searchIndexColumnIndices)) {
+        QString text = m_trackInfo.stringValue(row, column);
+        if (text.isEmpty()) {
+            continue;
+        }
+        if (fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION) == column) {
+            // The database stores all locations with Qt separators
+            text = QDir::fromNativeSeparators(text);
+        }
+        m_pSearchIndex->addText(trackId, text);
+    }
+}
+
 const TrackPointer& BaseTrackCache::getRecentTrack(TrackId trackId) const {
     DEBUG_ASSERT(m_bIsCaching);
     // Only refresh the recently used track if the identifiers
@@ -218,13 +479,19 @@ bool BaseTrackCache::updateTrackInIndex(
 
     TrackId trackId = pTrack->getId();
     if (trackId.isValid()) {
-        // m_trackInfo[id] will insert a QVector<QVariant> into the
-        // m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        // preallocate memory for all columns at once
-        record.resize(numColumns);
+        const int row = m_trackInfo.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
-            getTrackValueForColumn(pTrack, i, record[i]);
+            // Values of columns that are not provided by the track
+            // object are kept
+            QVariant value = m_trackInfo.value(row, i);
+            getTrackValueForColumn(pTrack, i, value);
+            m_trackInfo.setValue(row, i, value);
+        }
+        if (m_pSearchIndex) {
+            // Previous values remain in the index, see TrackSearchIndex.
+            // Committed lazily before the next search, because a scan
+            // updates many tracks in a row.
+            updateSearchIndex(row);
         }
         if (m_bIsCaching) {
             replaceRecentTrack(std::move(trackId), std::move(pTrack));
@@ -266,21 +533,26 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
     while (query.next()) {
         TrackId trackId(query.value(idColumn));
 
-        //m_trackInfo[id] will insert a QVector<QVariant> into the
-        //m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        record.resize(numColumns);
-
+        const int row = m_trackInfo.insertRow(trackId);
+        VERIFY_OR_DEBUG_ASSERT(row >= 0) {
+            continue;
+        }
         for (int i = 0; i < numColumns; ++i) {
             if (fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION) == i) {
                 // Database stores all locations with Qt separators: "/"
                 // Here we want to cache the display string with native separators.
                 QString location = query.value(i).toString();
-                record[i] = QDir::toNativeSeparators(location);
+                m_trackInfo.setValue(row, i, QDir::toNativeSeparators(location));
             } else {
-                record[i] = query.value(i);
+                m_trackInfo.setValue(row, i, query.value(i));
             }
         }
+        if (m_pSearchIndex) {
+            updateSearchIndex(row);
+        }
+    }
+    if (m_pSearchIndex) {
+        m_pSearchIndex->commit();
     }
 
     qDebug() << this << "updateIndexWithQuery took" << timer.elapsed().debugMillisWithUnit();
@@ -303,6 +575,10 @@ void BaseTrackCache::buildIndex() {
     // clear the table, and keep track of what IDs we see, then delete the ones
     // we don't see.
     m_trackInfo.clear();
+    if (m_pSearchIndex) {
+        m_pSearchIndex->clear();
+    }
+    m_bPrevResultsValid = false;
 
     if (!updateIndexWithQuery(queryString)) {
         qDebug() << "buildIndex failed!";
@@ -321,6 +597,8 @@ void BaseTrackCache::updateTracksInIndex(const QSet<TrackId>& trackIds) {
     if (trackIds.isEmpty()) {
         return;
     }
+    // The tracks might have been modified in the database
+    m_bPrevResultsValid = false;
 
     QStringList idStrings;
     for (const auto& trackId: trackIds) {
@@ -444,11 +722,10 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     // TODO(rryan) this code is flawed for columns that contains row-specific
     // metadata. Currently the upper-levels will not delegate row-specific
     // columns to this method, but there should still be a check here I think.
-    if (!result.isValid()) {
-        auto it = m_trackInfo.constFind(trackId);
-        if (it != m_trackInfo.constEnd()) {
-            const QVector<QVariant>& fields = it.value();
-            result = fields.value(column, result);
+    if (!result.isValid() && column >= 0 && column < m_trackInfo.columnCount()) {
+        const int row = m_trackInfo.findRow(trackId);
+        if (row >= 0) {
+            result = m_trackInfo.value(row, column);
         }
     }
     return result;
@@ -470,72 +747,135 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         buildIndex();
     }
 
-    QStringList idStrings;
-    // TODO(rryan) consider making this the data passed in and a separate
-    // QVector for output
+    // Tracks that did not match the previous query will not match a more
+    // specific query either, e.g. while the user is typing "tec" -> "tech".
+    // In this case only the previous results need to be filtered again.
+    const bool refinePrevResults = m_bPrevResultsValid &&
+            extraFilter == m_prevExtraFilter &&
+            SearchQueryParser::queryIsMoreSpecific(m_prevSearchQuery, searchQuery) &&
+            trackIds == m_prevTrackIds;
+
+    // Dirty tracks are always evaluated in memory (see below). They might
+    // have been modified since the previous query.
     QSet<TrackId> dirtyTracks;
-    for (const auto& trackId: trackIds) {
-        idStrings << trackId.toString();
-        if (m_dirtyTracks.contains(trackId)) {
+    for (const auto& trackId : qAsConst(m_dirtyTracks)) {
+        if (trackIds.contains(trackId)) {
             dirtyTracks.insert(trackId);
         }
     }
 
-    QStringList queryFragments;
-    if (!extraFilter.isNull() && extraFilter != "") {
-        queryFragments << QString("(%1)").arg(extraFilter);
-    }
-    if (idStrings.size() > 0) {
-        queryFragments << QString("%1 in (%2)")
-                .arg(m_idColumn, idStrings.join(","));
+    if (m_pSearchIndex) {
+        m_pSearchIndex->commit();
     }
 
-    const std::unique_ptr<QueryNode> pQuery =
-            m_pQueryParser->parseQuery(
-                    searchQuery,
-                    m_searchColumns,
-                    queryFragments.join(" AND "));
-
-    QString filter = pQuery->toSql();
-    if (!filter.isEmpty()) {
-        filter.prepend("WHERE ");
-    }
-
-    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
-            .arg(m_idColumn, m_tableName, filter, orderByClause);
-
-    if (sDebug) {
-        qDebug() << this << "select() executing:" << queryString;
-    }
-
-    QSqlQuery query(m_database);
-    // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
-    // won't allocate a giant in-memory table that we won't use at all.
-    query.setForwardOnly(true);
-    query.prepare(queryString);
-
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    // TODO(rryan) consider making this the data passed in and a separate
+    // QVector for output
+    QVector<TrackId> candidates;
+    if (refinePrevResults) {
+        if (sDebug) {
+            qDebug() << this << "Refining" << m_trackOrder.size() << "previous results";
+        }
+        candidates = m_trackOrder;
+    } else {
+        candidates.reserve(trackIds.size());
+        for (const auto& trackId : trackIds) {
+            candidates.append(trackId);
+        }
     }
 
-    int idColumn = query.record().indexOf(m_idColumn);
-    int rows = query.size();
-
-    if (sDebug) {
-        qDebug() << "Rows returned:" << rows;
+    // The query and the sort order are evaluated on the typed columns of
+    // m_trackInfo if possible. SQLite is only needed for extra SQL filters,
+    // search terms with LIKE wildcards and sorting by columns of the table
+    // model, e.g. the position in a playlist.
+    std::unique_ptr<QueryNode> pQuery;
+    std::vector<CacheSortColumn> cacheSortColumns;
+    if (extraFilter.isEmpty() &&
+            (orderByClause.isEmpty() ||
+                    resolveSortColumns(sortColumns, columnOffset, &cacheSortColumns))) {
+        // Tracks that have not been loaded yet, e.g. if they have been
+        // added in the meantime, must be known before the query is bound
+        // to the search index
+        QStringList missingIdStrings;
+        for (const auto& trackId : qAsConst(candidates)) {
+            if (!m_trackInfo.contains(trackId)) {
+                missingIdStrings << trackId.toString();
+            }
+        }
+        if (!missingIdStrings.isEmpty()) {
+            QString queryString = QString("SELECT %1 FROM %2 WHERE %3 in (%4)")
+                    .arg(m_columnsJoined,
+                            m_tableName,
+                            m_idColumn,
+                            missingIdStrings.join(","));
+            updateIndexWithQuery(queryString);
+        }
+        pQuery = m_pQueryParser->parseQuery(
+                searchQuery,
+                m_searchColumns,
+                QString(),
+                m_pSearchIndex.get());
+        const auto resolveColumn = [this](const QString& columnName) {
+            return fieldIndex(columnName);
+        };
+        if (!pQuery->bindColumns(resolveColumn)) {
+            pQuery.reset();
+        }
     }
 
     m_trackOrder.resize(0); // keeps allocated memory
     trackToIndex->clear();
-    if (rows > 0) {
-        trackToIndex->reserve(rows);
-        m_trackOrder.reserve(rows);
-    }
 
-    while (query.next()) {
-        TrackId trackId(query.value(idColumn));
-        (*trackToIndex)[trackId] = m_trackOrder.size();
-        m_trackOrder.append(trackId);
+    if (pQuery) {
+        for (const auto& trackId : qAsConst(candidates)) {
+            const int row = m_trackInfo.findRow(trackId);
+            if (row >= 0 && pQuery->matchRow(m_trackInfo, row)) {
+                m_trackOrder.append(trackId);
+            }
+        }
+        if (!cacheSortColumns.empty()) {
+            sortTracks(cacheSortColumns, &m_trackOrder);
+        }
+        trackToIndex->reserve(m_trackOrder.size());
+        for (int i = 0; i < m_trackOrder.size(); ++i) {
+            (*trackToIndex)[m_trackOrder[i]] = i;
+        }
+        m_prevTrackIds = trackIds;
+        m_prevSearchQuery = searchQuery;
+        m_prevExtraFilter = extraFilter;
+        m_bPrevResultsValid = true;
+    } else {
+        QStringList idStrings;
+        idStrings.reserve(candidates.size());
+        for (const auto& trackId : qAsConst(candidates)) {
+            idStrings << trackId.toString();
+        }
+
+        QStringList queryFragments;
+        if (!extraFilter.isNull() && extraFilter != "") {
+            queryFragments << QString("(%1)").arg(extraFilter);
+        }
+        if (idStrings.size() > 0) {
+            queryFragments << QString("%1 in (%2)")
+                    .arg(m_idColumn, idStrings.join(","));
+        }
+
+        pQuery = m_pQueryParser->parseQuery(
+                searchQuery,
+                m_searchColumns,
+                queryFragments.join(" AND "),
+                m_pSearchIndex.get());
+
+        // An empty id list would select all tracks of the table instead of none
+        if (!idStrings.isEmpty()) {
+            if (selectWithQuery(*pQuery, orderByClause, trackToIndex)) {
+                m_prevTrackIds = trackIds;
+                m_prevSearchQuery = searchQuery;
+                m_prevExtraFilter = extraFilter;
+                m_bPrevResultsValid = true;
+            } else {
+                m_bPrevResultsValid = false;
+            }
+        }
     }
 
     // At this point, the original set of tracks have been divided into two
@@ -551,6 +891,8 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         return;
     }
 
+    // The index is only fixed once after all dirty tracks have been processed
+    bool trackOrderModified = false;
     for (TrackId trackId: qAsConst(dirtyTracks)) {
         // Only get the track if it is in the cache. Tracks that
         // are not cached in memory cannot be dirty.
@@ -566,17 +908,15 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
                 pQuery->match(pTrack);
 
         // If the track is in this result set.
-        bool isInResultSet = trackToIndex->contains(trackId);
+        const int index = m_trackOrder.indexOf(trackId);
 
         if (shouldBeInResultSet) {
             // Track should be in result set...
 
             // Remove the track from the results first (we have to do this or it
             // will sort wrong).
-            if (isInResultSet) {
-                int index = (*trackToIndex)[trackId];
+            if (index >= 0) {
                 m_trackOrder.remove(index);
-                // Don't update trackToIndex, since we do it below.
             }
 
             // Figure out where it is supposed to sort. The table is sorted by
@@ -592,39 +932,225 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
 
             // The track should sort at insertRow
             m_trackOrder.insert(insertRow, trackId);
-
-            trackToIndex->clear();
-            // Fix the index. TODO(rryan) find a non-stupid way to do this.
-            for (int i = 0; i < m_trackOrder.size(); ++i) {
-                (*trackToIndex)[m_trackOrder[i]] = i;
-            }
-        } else if (isInResultSet) {
+            trackOrderModified = true;
+        } else if (index >= 0) {
             // Track should not be in this result set, but it is. We need to
             // remove it.
-            int index = (*trackToIndex)[trackId];
             m_trackOrder.remove(index);
+            trackOrderModified = true;
+        }
+    }
+
+    if (trackOrderModified) {
+        trackToIndex->clear();
+        trackToIndex->reserve(m_trackOrder.size());
+        for (int i = 0; i < m_trackOrder.size(); ++i) {
+            (*trackToIndex)[m_trackOrder[i]] = i;
+        }
+    }
+}
+
+bool BaseTrackCache::selectWithQuery(const QueryNode& query,
+        const QString& orderByClause,
+        QHash<TrackId, int>* trackToIndex) {
+    QString filter = query.toSql();
+    if (!filter.isEmpty()) {
+        filter.prepend("WHERE ");
+    }
+
+    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
+            .arg(m_idColumn, m_tableName, filter, orderByClause);
 
-            trackToIndex->clear();
-            // Fix the index. TODO(rryan) find a non-stupid way to do this.
-            for (int i = 0; i < m_trackOrder.size(); ++i) {
-                (*trackToIndex)[m_trackOrder[i]] = i;
+    if (sDebug) {
+        qDebug() << this << "select() executing:" << queryString;
+    }
+
+    QSqlQuery sqlQuery(m_database);
+    // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
+    // won't allocate a giant in-memory table that we won't use at all.
+    sqlQuery.setForwardOnly(true);
+    sqlQuery.prepare(queryString);
+
+    if (!sqlQuery.exec()) {
+        LOG_FAILED_QUERY(sqlQuery);
+        return false;
+    }
+
+    int idColumn = sqlQuery.record().indexOf(m_idColumn);
+    int rows = sqlQuery.size();
+
+    if (sDebug) {
+        qDebug() << "Rows returned:" << rows;
+    }
+
+    if (rows > 0) {
+        trackToIndex->reserve(rows);
+        m_trackOrder.reserve(rows);
+    }
+
+    while (sqlQuery.next()) {
+        TrackId trackId(sqlQuery.value(idColumn));
+        (*trackToIndex)[trackId] = m_trackOrder.size();
+        m_trackOrder.append(trackId);
+    }
+    return true;
+}
+
+bool BaseTrackCache::resolveSortColumns(const QList<SortColumn>& sortColumns,
+        const int columnOffset,
+        std::vector<CacheSortColumn>* pCacheSortColumns) const {
+    bool resolved = true;
+    pCacheSortColumns->clear();
+    pCacheSortColumns->reserve(sortColumns.size());
+    for (const auto& sc : sortColumns) {
+        int column;
+        if (sc.m_column == 0) {
+            // The id column, see BaseSqlTableModel::setSort()
+            column = 0;
+        } else if (sc.m_column <= columnOffset) {
+            // Columns of the table model, e.g. the position in a playlist,
+            // are not contained in the cache
+            resolved = false;
+            continue;
+        } else {
+            column = sc.m_column - columnOffset;
+        }
+        if (column >= columnCount()) {
+            resolved = false;
+            continue;
+        }
+        const auto sortType = m_columnCache.columnSortTypeForFieldIndex(column);
+        if (sortType == ColumnCache::SortType::Key) {
+            // Keys are sorted by the key code in the key_id column
+            column = fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY_ID);
+            if (column < 0) {
+                resolved = false;
+                continue;
+            }
+        }
+        pCacheSortColumns->push_back(CacheSortColumn{column, sortType, sc.m_order});
+    }
+    return resolved;
+}
+
+void BaseTrackCache::sortTracks(const std::vector<CacheSortColumn>& sortColumns,
+        QVector<TrackId>* pTrackIds) const {
+    const auto keyNotation = m_columnCache.keyNotation();
+    const int numTracks = pTrackIds->size();
+    std::vector<int> rows;
+    rows.reserve(numTracks);
+    for (const auto& trackId : qAsConst(*pTrackIds)) {
+        rows.push_back(m_trackInfo.findRow(trackId));
+    }
+
+    // The sort keys of all tracks for each sort column. Strings are
+    // replaced by their rank among the distinct strings of the column
+    // to avoid repeated collations of the same strings while sorting.
+    std::vector<std::vector<SortKey>> keys(sortColumns.size());
+    for (std::size_t i = 0; i < sortColumns.size(); ++i) {
+        const auto& sortColumn = sortColumns[i];
+        std::vector<SortKey>& columnKeys = keys[i];
+        columnKeys.reserve(numTracks);
+        QHash<QString, int> stringIndices;
+        std::vector<QString> strings;
+        for (const int row : rows) {
+            SortValue value = convertSortValue(
+                    cellSortValue(m_trackInfo, row, sortColumn.column),
+                    sortColumn.sortType,
+                    keyNotation);
+            if (value.valueClass != SortValue::Class::String) {
+                columnKeys.push_back(SortKey{value.valueClass, value.number});
+                continue;
+            }
+            auto it = stringIndices.constFind(value.string);
+            if (it == stringIndices.constEnd()) {
+                it = stringIndices.insert(value.string, static_cast<int>(strings.size()));
+                strings.push_back(std::move(value.string));
+            }
+            columnKeys.push_back(SortKey{SortValue::Class::String, double(it.value())});
+        }
+        if (strings.empty()) {
+            continue;
+        }
+
+        std::vector<int> stringOrder(strings.size());
+        std::iota(stringOrder.begin(), stringOrder.end(), 0);
+        std::sort(stringOrder.begin(),
+                stringOrder.end(),
+                [&](int lhs, int rhs) {
+                    return compareSortStrings(strings[lhs],
+                                   strings[rhs],
+                                   sortColumn.sortType,
+                                   m_collator) < 0;
+                });
+        std::vector<int> stringRanks(strings.size());
+        int rank = 0;
+        for (std::size_t j = 0; j < stringOrder.size(); ++j) {
+            if (j > 0 &&
+                    compareSortStrings(strings[stringOrder[j - 1]],
+                            strings[stringOrder[j]],
+                            sortColumn.sortType,
+                            m_collator) != 0) {
+                ++rank;
+            }
+            stringRanks[stringOrder[j]] = rank;
+        }
+        for (auto& key : columnKeys) {
+            if (key.valueClass == SortValue::Class::String) {
+                key.number = stringRanks[static_cast<int>(key.number)];
             }
         }
     }
+
+    std::vector<int> permutation(numTracks);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::sort(permutation.begin(),
+            permutation.end(),
+            [&](int lhs, int rhs) {
+                for (std::size_t i = 0; i < sortColumns.size(); ++i) {
+                    int result = compareSortKeys(keys[i][lhs], keys[i][rhs]);
+                    if (sortColumns[i].order == Qt::DescendingOrder) {
+                        result = -result;
+                    }
+                    if (result != 0) {
+                        return result < 0;
+                    }
+                }
+                // Deterministic order of tracks with equal values
+                return (*pTrackIds)[lhs] < (*pTrackIds)[rhs];
+            });
+
+    QVector<TrackId> sortedTrackIds;
+    sortedTrackIds.reserve(numTracks);
+    for (const int index : permutation) {
+        sortedTrackIds.append((*pTrackIds)[index]);
+    }
+    *pTrackIds = std::move(sortedTrackIds);
 }
 
 int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
         const QList<SortColumn>& sortColumns,
         const int columnOffset,
         const QVector<TrackId>& trackIds) const {
-    QList<QVariant> trackValues;
     if (sortColumns.isEmpty()) {
         return 0;
     }
-    for (const auto& sc: sortColumns) {
+    // Columns that are not contained in the cache are ignored
+    std::vector<CacheSortColumn> cacheSortColumns;
+    resolveSortColumns(sortColumns, columnOffset, &cacheSortColumns);
+
+    const auto keyNotation = m_columnCache.keyNotation();
+    std::vector<SortValue> trackValues;
+    trackValues.reserve(cacheSortColumns.size());
+    for (const auto& sortColumn : cacheSortColumns) {
         QVariant trackValue;
-        getTrackValueForColumn(pTrack, sc.m_column - columnOffset, trackValue);
-        trackValues.append(trackValue);
+        getTrackValueForColumn(pTrack, sortColumn.column, trackValue);
+        if (!trackValue.isValid()) {
+            // Not a track property, e.g. the id
+            trackValue = data(pTrack->getId(), sortColumn.column);
+        }
+        trackValues.push_back(convertSortValue(
+                variantSortValue(trackValue), sortColumn.sortType, keyNotation));
     }
 
     int min = 0;
@@ -632,7 +1158,7 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
 
     if (sDebug) {
         qDebug() << this << "Trying to insertion sort:"
-                 << trackValues.at(0) << "min" << min << "max" << max;
+                 << pTrack->getId() << "min" << min << "max" << max;
     }
 
     // If trackIds is empty, min is 0 and max is -1 so findSortInsertionPoint
@@ -649,15 +1175,22 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
         }
 
         int compare = 0;
-        for (int i = 0; i < sortColumns.count(); i++) {
-            QVariant tableValue =
-                    data(otherTrackId, sortColumns[i].m_column - columnOffset);
-
-            compare = compareColumnValues(
-                    sortColumns[i].m_column - columnOffset,
-                    sortColumns[i].m_order,
+        for (std::size_t i = 0; i < cacheSortColumns.size(); ++i) {
+            const auto& sortColumn = cacheSortColumns[i];
+            const SortValue tableValue = convertSortValue(
+                    variantSortValue(data(otherTrackId, sortColumn.column)),
+                    sortColumn.sortType,
+                    keyNotation);
+
+            compare = compareSortValues(
                     trackValues[i],
-                    tableValue);
+                    tableValue,
+                    sortColumn.sortType,
+                    m_collator);
+            // If we're in descending order, flip the comparison.
+            if (sortColumn.order == Qt::DescendingOrder) {
+                compare = -compare;
+            }
 
             if (compare != 0) {
                 break;
@@ -677,57 +1210,3 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
     }
     return min;
 }
-
-int BaseTrackCache::compareColumnValues(int sortColumn,
-        Qt::SortOrder sortOrder,
-        const QVariant& val1,
-        const QVariant& val2) const {
-    int result = 0;
-
-    if (sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_SAMPLERATE) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION)
-    ) {
-        // Sort as floats.
-        double delta = val1.toDouble() - val2.toDouble();
-
-        if (fabs(delta) < .00001) {
-            result = 0;
-        } else if (delta > 0.0) {
-            result = 1;
-        } else {
-            result = -1;
-        }
-    } else if (sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY)) {
-        KeyUtils::KeyNotation keyNotation = m_columnCache.keyNotation();
-
-        int key1 = KeyUtils::keyToCircleOfFifthsOrder(
-            KeyUtils::guessKeyFromText(val1.toString()), keyNotation);
-        int key2 = KeyUtils::keyToCircleOfFifthsOrder(
-            KeyUtils::guessKeyFromText(val2.toString()), keyNotation);
-        if (key1 > key2) {
-            result = 1;
-        } else if (key1 < key2) {
-            result = -1;
-        } else if (key1 == key2) {
-            result = 0;
-        }
-    } else {
-        result = m_collator.compare(val1.toString(), val2.toString());
-    }
-
-    // If we're in descending order, flip the comparison.
-    if (sortOrder == Qt::DescendingOrder) {
-        result = -result;
-    }
-
-    return result;
-}
@@ -9,15 +9,19 @@
 #include <QStringList>
 #include <QVector>
 #include <memory>
+#include <vector>
 
 #include "library/columncache.h"
+#include "library/trackcolumntable.h"
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/class.h"
 #include "util/string.h"
 
+class QueryNode;
 class SearchQueryParser;
 class TrackCollection;
+class TrackSearchIndex;
 
 class SortColumn {
   public:
@@ -75,6 +79,11 @@ class BaseTrackCache : public QObject {
     virtual void ensureCached(const QSet<TrackId>& trackIds);
     virtual void setSearchColumns(const QStringList& columns);
 
+    /// Maintains an in-memory trigram index of the text columns that
+    /// speeds up searching in large libraries at the cost of additional
+    /// memory. Disabled by default.
+    void setSearchIndexEnabled(bool enabled);
+
   signals:
     void tracksChanged(const QSet<TrackId>& trackIds);
 
@@ -93,20 +102,36 @@ class BaseTrackCache : public QObject {
     void resetRecentTrack() const;
 
     bool updateIndexWithQuery(const QString& query);
+    void updateSearchIndex(int row);
     void updateTrackInIndex(TrackId trackId);
     bool updateTrackInIndex(const TrackPointer& pTrack);
     void updateTracksInIndex(const QSet<TrackId>& trackIds);
     void getTrackValueForColumn(TrackPointer pTrack, int column,
                                 QVariant& trackValue) const;
 
+    // A sort column that is compared on the values in m_trackInfo
+    struct CacheSortColumn {
+        // The field index of the compared values, i.e. key_id for the key
+        int column;
+        ColumnCache::SortType sortType;
+        Qt::SortOrder order;
+    };
+
+    // Fails if any of the sort columns is not contained in the cache.
+    // The resolved columns are returned in any case.
+    bool resolveSortColumns(const QList<SortColumn>& sortColumns,
+            const int columnOffset,
+            std::vector<CacheSortColumn>* pCacheSortColumns) const;
+    void sortTracks(const std::vector<CacheSortColumn>& sortColumns,
+            QVector<TrackId>* pTrackIds) const;
+    bool selectWithQuery(const QueryNode& query,
+            const QString& orderByClause,
+            QHash<TrackId, int>* trackToIndex);
+
     int findSortInsertionPoint(TrackPointer pTrack,
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
                                const QVector<TrackId>& trackIds) const;
-    int compareColumnValues(int sortColumn,
-            Qt::SortOrder sortOrder,
-            const QVariant& val1,
-            const QVariant& val2) const;
     bool trackMatches(const TrackPointer& pTrack,
             const QRegularExpression& matcher) const;
     bool trackMatchesNumeric(const TrackPointer& pTrack,
@@ -133,6 +158,14 @@ class BaseTrackCache : public QObject {
 
     QVector<TrackId> m_trackOrder;
 
+    // Parameters of the most recent invocation of filterAndSort(). The
+    // results in m_trackOrder are reused if the search query is refined,
+    // unless tracks have been modified in the meantime.
+    QSet<TrackId> m_prevTrackIds;
+    QString m_prevSearchQuery;
+    QString m_prevExtraFilter;
+    bool m_bPrevResultsValid;
+
     // Remember key and value of the most recent cache lookup to avoid querying
     // the global track cache again and again while populating the columns
     // of a single row. These members serve as a single-valued private cache.
@@ -147,7 +180,10 @@ class BaseTrackCache : public QObject {
 
     bool m_bIndexBuilt;
     bool m_bIsCaching;
-    QHash<TrackId, QVector<QVariant>> m_trackInfo;
+    TrackColumnTable m_trackInfo;
+    // Field indices of the columns in m_pSearchIndex
+    QVector<int> m_searchIndexColumnIndices;
+    std::unique_ptr<TrackSearchIndex> m_pSearchIndex;
     QSqlDatabase m_database;
 
     DISALLOW_COPY_AND_ASSIGN(BaseTrackCache);
@@ -388,6 +388,10 @@ QAbstractItemDelegate* BaseTrackTableModel::delegateForColumn(
                 &WLibraryTableView::onlyCachedCoverArt,
                 pCoverArtDelegate,
                 &CoverArtDelegate::slotInhibitLazyLoading);
+        connect(pTableView,
+                &WLibraryTableView::prefetchCoverArt,
+                pCoverArtDelegate,
+                &CoverArtDelegate::slotPrefetchRows);
         // CoverArtDelegate -> BaseTrackTableModel
         connect(pCoverArtDelegate,
                 &CoverArtDelegate::rowsChanged,
@@ -71,6 +71,7 @@ void BrowseThread::executePopulation(mixxx::FileAccess path, BrowseTableModel* c
 
 void BrowseThread::run() {
     QThread::currentThread()->setObjectName("BrowseThread");
+    mixxx::Tracing::registerCurrentThread("BrowseThread");
     m_mutex.lock();
 
     while (!m_bStopThread) {
@@ -103,23 +103,24 @@ void ColumnCache::setColumns(const QStringList& columns) {
     }
 
     m_columnSortByIndex.clear();
+    m_columnSortTypeByIndex.clear();
     // Add the columns that requires a special sort
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_ARTIST, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_TITLE, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_ALBUM, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_ALBUMARTIST, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_YEAR, kSortNoCase);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_GENRE, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_COMPOSER, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_GROUPING, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_TRACKNUMBER, kSortInt);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_FILETYPE, kSortNoCase);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_COMMENT, kSortNoCaseLex);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_BITRATE, kSortInt);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_SAMPLERATE, kSortInt);
-    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_TIMESPLAYED, kSortInt);
-
-    insertColumnSortByEnum(COLUMN_TRACKLOCATIONSTABLE_LOCATION, kSortNoCase);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_ARTIST, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_TITLE, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_ALBUM, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_ALBUMARTIST, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_YEAR, kSortNoCase, SortType::NoCase);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_GENRE, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_COMPOSER, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_GROUPING, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_TRACKNUMBER, kSortInt, SortType::Integer);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_FILETYPE, kSortNoCase, SortType::NoCase);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_COMMENT, kSortNoCaseLex, SortType::NoCaseLex);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_BITRATE, kSortInt, SortType::Integer);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_SAMPLERATE, kSortInt, SortType::Integer);
+    insertColumnSortByEnum(COLUMN_LIBRARYTABLE_TIMESPLAYED, kSortInt, SortType::Integer);
+
+    insertColumnSortByEnum(COLUMN_TRACKLOCATIONSTABLE_LOCATION, kSortNoCase, SortType::NoCase);
 
     slotSetKeySortOrder(m_pKeyNotationCP->get());
 }
@@ -153,4 +154,5 @@ void ColumnCache::slotSetKeySortOrder(double notationValue) {
 
     // Replace the existing sort order
     m_columnSortByIndex[keyColumnIndex] = keySortSQL;
+    m_columnSortTypeByIndex[keyColumnIndex] = SortType::Key;
 }
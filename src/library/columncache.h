@@ -102,15 +102,31 @@ class ColumnCache : public QObject {
         return format.arg(columnNameForFieldIndex(index));
     }
 
+    // The comparison of column values that is equivalent to the SQL
+    // expression of columnSortForFieldIndex() for sorting in memory
+    enum class SortType {
+        Default,
+        NoCase,
+        NoCaseLex,
+        Integer,
+        Key,
+    };
+
+    inline SortType columnSortTypeForFieldIndex(int index) const {
+        return m_columnSortTypeByIndex.value(index, SortType::Default);
+    }
+
     void insertColumnSortByEnum(
             Column column,
-            const QString& sortFormat) {
+            const QString& sortFormat,
+            SortType sortType) {
         int index = fieldIndex(column);
         if (index < 0) {
             return;
         }
         DEBUG_ASSERT(!m_columnSortByIndex.contains(index));
         m_columnSortByIndex.insert(index, sortFormat);
+        m_columnSortTypeByIndex.insert(index, sortType);
     }
 
     void insertColumnNameByEnum(
@@ -132,6 +148,7 @@ class ColumnCache : public QObject {
   private:
     QStringList m_columnsByIndex;
     QMap<int, QString> m_columnSortByIndex;
+    QMap<int, SortType> m_columnSortTypeByIndex;
     QMap<QString, int> m_columnIndexByName;
     QMap<Column, QString> m_columnNameByEnum;
     // A mapping from column enum to logical index.
@@ -170,6 +170,27 @@ CoverInfo::LoadedImage CoverInfo::loadImage(
     return loadedImage;
 }
 
+QString CoverInfo::imageLocation() const {
+    if (type == CoverInfo::METADATA) {
+        return trackLocation;
+    }
+    if (type != CoverInfo::FILE) {
+        return QString();
+    }
+    const auto coverFile = mixxx::FileInfo(coverLocation);
+    if (!coverFile.isRelative()) {
+        return coverFile.location();
+    }
+    if (trackLocation.isEmpty()) {
+        return QString();
+    }
+    // Compose track directory with relative path
+    return mixxx::FileInfo(
+            mixxx::FileInfo(trackLocation).locationPath(),
+            coverLocation)
+            .location();
+}
+
 bool CoverInfo::refreshImageDigest(
         const QImage& loadedImage,
         const SecurityTokenPointer& pTrackLocationToken) {
@@ -170,6 +170,7 @@ class CoverInfo : public CoverInfoRelative {
 
       private:
         friend class CoverArt;
+        friend class CoverArtCache;
         friend class CoverInfo;
         LoadedImage(Result result)
                 : result(result) {
@@ -178,6 +179,10 @@ class CoverInfo : public CoverInfoRelative {
     LoadedImage loadImage(
             const SecurityTokenPointer& pTrackLocationToken = SecurityTokenPointer()) const;
 
+    /// The LoadedImage::location of loadImage() without loading the image.
+    /// Empty if the location is unknown.
+    QString imageLocation() const;
+
     /// Verify the image digest and update it if necessary.
     /// If the corresponding image has already been loaded it
     /// could be provided as a parameter to avoid reloading
@@ -8,7 +8,9 @@
 #include "library/coverartutils.h"
 #include "moc_coverartcache.cpp"
 #include "track/track.h"
+#include "util/imagefilecache.h"
 #include "util/logger.h"
+#include "util/mutex.h"
 #include "util/thread_affinity.h"
 
 namespace {
@@ -29,6 +31,13 @@ QString pixmapCacheKey(mixxx::cache_key_t hash, int width) {
             .arg(QString::number(hash), QString::number(width));
 }
 
+// Resized covers of the library table are about 10 to 50 KB each
+constexpr qint64 kDiskCacheLimitBytes = 128 * 1024 * 1024;
+
+QString diskCacheKey(mixxx::cache_key_t hash, int width) {
+    return QString::number(hash) + QChar('_') + QString::number(width);
+}
+
 // The transformation mode when scaling images
 const Qt::TransformationMode kTransformationMode = Qt::SmoothTransformation;
 
@@ -37,10 +46,127 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
     return image.scaledToWidth(width, kTransformationMode);
 }
 
+// Prefetching must not delay the covers that are requested by
+// visible widgets, which are loaded on the global thread pool
+constexpr int kMaxPrefetchThreads = 2;
+
 } // anonymous namespace
 
+class CoverArtCache::PrefetchRequest {
+  public:
+    void setCacheKeys(QSet<mixxx::cache_key_t> cacheKeys) {
+        const MMutexLocker locker(&m_mutex);
+        m_cacheKeys = std::move(cacheKeys);
+    }
+
+    bool containsCacheKey(mixxx::cache_key_t cacheKey) {
+        const MMutexLocker locker(&m_mutex);
+        return m_cacheKeys.contains(cacheKey);
+    }
+
+  private:
+    MMutex m_mutex;
+    QSet<mixxx::cache_key_t> m_cacheKeys GUARDED_BY(m_mutex);
+};
+
 CoverArtCache::CoverArtCache() {
     QPixmapCache::setCacheLimit(kPixmapCacheLimit);
+    m_prefetchThreadPool.setMaxThreadCount(kMaxPrefetchThreads);
+}
+
+CoverArtCache::~CoverArtCache() {
+    for (const auto& pRequest : std::as_const(m_prefetchRequests)) {
+        pRequest->setCacheKeys({});
+    }
+    m_prefetchThreadPool.waitForDone();
+}
+
+void CoverArtCache::setDiskCacheDirectory(const QString& directory) {
+    auto pDiskCache = std::make_shared<const mixxx::ImageFileCache>(directory);
+    if (!pDiskCache->isValid()) {
+        m_pDiskCache.reset();
+        return;
+    }
+    m_pDiskCache = pDiskCache;
+    QtConcurrent::run([pDiskCache] {
+        pDiskCache->prune(kDiskCacheLimitBytes);
+    });
+}
+
+void CoverArtCache::prefetchCovers(
+        const QObject* pRequestor,
+        const QList<CoverInfo>& coverInfos,
+        int desiredWidth) {
+    VERIFY_OR_DEBUG_ASSERT(desiredWidth > 0) {
+        return;
+    }
+    auto& pRequest = m_prefetchRequests[pRequestor];
+    if (!pRequest) {
+        pRequest = std::make_shared<PrefetchRequest>();
+    }
+
+    QSet<mixxx::cache_key_t> cacheKeys;
+    QList<CoverInfo> pendingCoverInfos;
+    for (const auto& coverInfo : coverInfos) {
+        if (!coverInfo.hasImage()) {
+            continue;
+        }
+        const auto cacheKey = coverInfo.cacheKey();
+        if (cacheKeys.contains(cacheKey)) {
+            // Tracks of the same album share their cover
+            continue;
+        }
+        // Requests that are still running remain wanted
+        cacheKeys.insert(cacheKey);
+        QPixmap pixmap;
+        if (m_runningRequests.contains(qMakePair(pRequestor, cacheKey)) ||
+                QPixmapCache::find(pixmapCacheKey(cacheKey, desiredWidth), &pixmap)) {
+            continue;
+        }
+        pendingCoverInfos.append(coverInfo);
+    }
+    pRequest->setCacheKeys(std::move(cacheKeys));
+
+    for (const auto& coverInfo : std::as_const(pendingCoverInfos)) {
+        const auto cacheKey = coverInfo.cacheKey();
+        m_runningRequests.insert(qMakePair(pRequestor, cacheKey));
+        // The watcher will be deleted in coverLoaded()
+        QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
+        QFuture<FutureResult> future = QtConcurrent::run(
+                &m_prefetchThreadPool,
+                [pRequestor,
+                        pRequest,
+                        coverInfo,
+                        cacheKey,
+                        desiredWidth,
+                        pDiskCache = m_pDiskCache] {
+                    if (!pRequest->containsCacheKey(cacheKey)) {
+                        // Not wanted anymore, e.g. if the row has been
+                        // scrolled out of view again
+                        return FutureResult(pRequestor, cacheKey, false);
+                    }
+                    return loadCover(
+                            pRequestor,
+                            TrackPointer(),
+                            coverInfo,
+                            desiredWidth,
+                            true,
+                            pDiskCache);
+                });
+        connect(watcher,
+                &QFutureWatcher<FutureResult>::finished,
+                this,
+                &CoverArtCache::coverLoaded);
+        watcher->setFuture(future);
+    }
+}
+
+void CoverArtCache::cancelPrefetch(
+        const QObject* pRequestor) {
+    const auto pRequest = m_prefetchRequests.take(pRequestor);
+    if (pRequest) {
+        pRequest->setCacheKeys({});
+    }
 }
 
 //static
@@ -148,7 +274,8 @@ QPixmap CoverArtCache::tryLoadCover(
             pTrack,
             coverInfo,
             desiredWidth,
-            loading == Loading::Default);
+            loading == Loading::Default,
+            m_pDiskCache);
     connect(watcher,
             &QFutureWatcher<FutureResult>::finished,
             this,
@@ -163,7 +290,8 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
         TrackPointer pTrack,
         CoverInfo coverInfo,
         int desiredWidth,
-        bool signalWhenDone) {
+        bool signalWhenDone,
+        std::shared_ptr<const mixxx::ImageFileCache> pDiskCache) {
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "loadCover"
@@ -180,6 +308,27 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             signalWhenDone);
     DEBUG_ASSERT(!res.coverInfoUpdated);
 
+    // Only resized covers are cached on disk, see coverLoaded()
+    if (!pDiskCache || desiredWidth <= 0) {
+        pDiskCache.reset();
+    } else if (coverInfo.hasImage()) {
+        // The key is derived from the digest of the original image,
+        // so the cached cover is replaced when the image changes
+        const QString key = diskCacheKey(coverInfo.cacheKey(), desiredWidth);
+        QImage cachedImage = pDiskCache->load(key);
+        if (!cachedImage.isNull()) {
+            CoverInfo::LoadedImage loadedImage(CoverInfo::LoadedImage::Result::Ok);
+            loadedImage.image = std::move(cachedImage);
+            // The location of the original image, not of the cached copy
+            loadedImage.location = coverInfo.imageLocation();
+            res.coverArt = CoverArt(
+                    std::move(coverInfo),
+                    std::move(loadedImage),
+                    desiredWidth);
+            return res;
+        }
+    }
+
     auto loadedImage = coverInfo.loadImage(
             pTrack ? pTrack->getFileAccess().token() : SecurityTokenPointer());
     if (!loadedImage.image.isNull()) {
@@ -198,6 +347,12 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             // or downsize the image for efficiency.
             loadedImage.image = resizeImageWidth(loadedImage.image, desiredWidth);
         }
+
+        if (pDiskCache && coverInfo.hasImage() && loadedImage.image.colorCount() == 0) {
+            pDiskCache->store(
+                    diskCacheKey(coverInfo.cacheKey(), desiredWidth),
+                    loadedImage.image);
+        }
     }
 
     res.coverArt = CoverArt(
@@ -1,15 +1,23 @@
 #pragma once
 
+#include <QHash>
+#include <QList>
 #include <QObject>
 #include <QPair>
 #include <QPixmap>
 #include <QSet>
+#include <QThreadPool>
 #include <QtDebug>
+#include <memory>
 
 #include "library/coverart.h"
 #include "track/track_decl.h"
 #include "util/singleton.h"
 
+namespace mixxx {
+class ImageFileCache;
+} // namespace mixxx
+
 class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     Q_OBJECT
   public:
@@ -22,6 +30,27 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             const QObject* pRequestor,
             const TrackPointer& pTrack);
 
+    /// Persists resized covers in the directory, which spares decoding
+    /// the original images when the same covers are requested again
+    /// after a restart. Least recently used covers are removed when
+    /// the cache grows too large.
+    void setDiskCacheDirectory(const QString& directory);
+
+    /// Loads resized covers ahead of time on a small dedicated thread pool,
+    /// e.g. for library rows that are about to be scrolled into view. The
+    /// covers are loaded in the given order and coverFound() is emitted
+    /// for each of them.
+    ///
+    /// Each request replaces the previous request of the same requestor.
+    /// Covers that are no longer requested are skipped if loading has not
+    /// started yet.
+    void prefetchCovers(
+            const QObject* pRequestor,
+            const QList<CoverInfo>& coverInfos,
+            int desiredWidth);
+    void cancelPrefetch(
+            const QObject* pRequestor);
+
     /* This method is used to request a cover art pixmap.
      *
      * @param pRequestor : an arbitrary pointer (can be any number you'd like,
@@ -84,7 +113,8 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             TrackPointer pTrack,
             CoverInfo coverInfo,
             int desiredWidth,
-            bool emitSignals);
+            bool emitSignals,
+            std::shared_ptr<const mixxx::ImageFileCache> pDiskCache = nullptr);
 
   private slots:
     // Called when loadCover is complete in the main thread.
@@ -100,7 +130,7 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
 
   protected:
     CoverArtCache();
-    ~CoverArtCache() override = default;
+    ~CoverArtCache() override;
     friend class Singleton<CoverArtCache>;
 
   private:
@@ -116,7 +146,14 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             int desiredWidth,
             Loading loading);
 
+    // The cache keys of the covers that a requestor wants to be
+    // prefetched, shared with the worker threads
+    class PrefetchRequest;
+
     QSet<QPair<const QObject*, mixxx::cache_key_t>> m_runningRequests;
+    std::shared_ptr<const mixxx::ImageFileCache> m_pDiskCache;
+    QHash<const QObject*, std::shared_ptr<PrefetchRequest>> m_prefetchRequests;
+    QThreadPool m_prefetchThreadPool;
 };
 
 inline
@@ -40,6 +40,12 @@ CoverArtDelegate::CoverArtDelegate(QTableView* parent)
     }
 }
 
+CoverArtDelegate::~CoverArtDelegate() {
+    if (m_pCache) {
+        m_pCache->cancelPrefetch(this);
+    }
+}
+
 void CoverArtDelegate::emitRowsChanged(
         QList<int>&& rows) {
     if (rows.isEmpty()) {
@@ -70,6 +76,35 @@ void CoverArtDelegate::slotInhibitLazyLoading(
     emitRowsChanged(std::move(staleRows));
 }
 
+void CoverArtDelegate::slotPrefetchRows(
+        const QList<int>& rows) {
+    if (!m_pCache) {
+        return;
+    }
+    auto* pTableView = qobject_cast<QTableView*>(parent());
+    VERIFY_OR_DEBUG_ASSERT(pTableView && m_pTrackModel) {
+        return;
+    }
+    const int column = m_pTrackModel->fieldIndex(LIBRARYTABLE_COVERART);
+    if (column < 0 || pTableView->isColumnHidden(column)) {
+        m_pCache->cancelPrefetch(this);
+        return;
+    }
+    // Same size as requested by paintItem()
+    const int desiredWidth = static_cast<int>(
+            pTableView->columnWidth(column) * pTableView->devicePixelRatioF());
+    if (desiredWidth <= 0) {
+        return;
+    }
+    const QAbstractItemModel* pModel = pTableView->model();
+    QList<CoverInfo> coverInfos;
+    coverInfos.reserve(rows.size());
+    for (const int row : rows) {
+        coverInfos.append(m_pTrackModel->getCoverInfo(pModel->index(row, column)));
+    }
+    m_pCache->prefetchCovers(this, coverInfos, desiredWidth);
+}
+
 void CoverArtDelegate::slotCoverFound(
         const QObject* pRequestor,
         const CoverInfo& coverInfo,
@@ -138,6 +173,11 @@ void CoverArtDelegate::paintItem(
                 // miss. Record this row so that when we switch to requesting
                 // non-cache we can request an update.
                 m_cacheMissRows.append(index.row());
+                // The cover might already be prefetched in the background
+                // and the row is refreshed as soon as it has been loaded.
+                if (!m_pendingCacheRows.contains(coverInfo.cacheKey(), index.row())) {
+                    m_pendingCacheRows.insert(coverInfo.cacheKey(), index.row());
+                }
             } else {
                 // If we asked for a non-cache image and got a null pixmap,
                 // then our request was queued.
@@ -18,7 +18,7 @@ class CoverArtDelegate : public TableItemDelegate {
   public:
     explicit CoverArtDelegate(
             QTableView* parent);
-    ~CoverArtDelegate() override = default;
+    ~CoverArtDelegate() override;
 
     void paintItem(
             QPainter* painter,
@@ -44,6 +44,12 @@ class CoverArtDelegate : public TableItemDelegate {
     void slotInhibitLazyLoading(
             bool inhibitLazyLoading);
 
+    // Load the covers of the given rows in the background, most
+    // important rows first. Replaces the previous prefetch request,
+    // i.e. covers of rows that are no longer included are skipped.
+    void slotPrefetchRows(
+            const QList<int>& rows);
+
   private slots:
     void slotCoverFound(
             const QObject* pRequestor,
@@ -2,11 +2,13 @@
 #include <QSqlResult>
 #include <QSqlError>
 #include <QtDebug>
+#include <limits>
 
 #include "library/dao/analysisdao.h"
 #include "library/queryutil.h"
 #include "preferences/waveformsettings.h"
 #include "util/performancetimer.h"
+#include "waveform/compactwaveformformat.h"
 #include "waveform/waveform.h"
 
 const QString AnalysisDao::s_analysisTableName = "track_analysis";
@@ -84,21 +86,19 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         int checksum = query->value(dataChecksumColumn).toInt();
         QString dataPath = analysisPath.absoluteFilePath(
             QString::number(info.analysisId));
-        const QByteArray compressedData = loadDataFromFile(dataPath);
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        const int file_checksum = qChecksum(
-                compressedData);
-#else
-        const int file_checksum = qChecksum(
-                compressedData.constData(),
-                compressedData.length());
-#endif
-        if (checksum != file_checksum) {
+        const QByteArray fileData = loadDataFromFile(dataPath, &info.pMappedFile);
+        if (checksum != dataChecksum(fileData)) {
             qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
-                     << "length" << compressedData.length();
+                     << "length" << fileData.length();
             continue;
         }
-        info.data = qUncompress(compressedData);
+        if (mixxx::CompactWaveformFormat::hasMagic(fileData)) {
+            // Each level of detail is compressed separately
+            info.data = fileData;
+        } else {
+            info.data = qUncompress(fileData);
+            info.pMappedFile.reset();
+        }
         bytes += info.data.length();
         analyses.append(info);
     }
@@ -120,15 +120,11 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     PerformanceTimer time;
     time.start();
 
-    const QByteArray compressedData = qCompress(info->data, kCompressionLevel);
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    const int checksum = qChecksum(
-            compressedData);
-#else
-    const int checksum = qChecksum(
-            compressedData.constData(),
-            compressedData.length());
-#endif
+    const QByteArray compressedData =
+            mixxx::CompactWaveformFormat::hasMagic(info->data)
+            ? info->data
+            : qCompress(info->data, kCompressionLevel);
+    const int checksum = dataChecksum(compressedData);
     QSqlQuery query(m_database);
     if (info->analysisId == -1) {
         query.prepare(QString(
@@ -262,15 +258,49 @@ QDir AnalysisDao::getAnalysisStoragePath() const {
     return dir.absolutePath().append("/");
 }
 
-QByteArray AnalysisDao::loadDataFromFile(const QString& filename) const {
-    QFile file(filename);
-    if (!file.exists()) {
+QByteArray AnalysisDao::loadDataFromFile(const QString& filename,
+        std::shared_ptr<QFile>* ppMappedFile) const {
+    auto pFile = std::make_shared<QFile>(filename);
+    if (!pFile->exists()) {
         return QByteArray();
     }
-    if (!file.open(QIODevice::ReadOnly)) {
+    if (!pFile->open(QIODevice::ReadOnly)) {
         return QByteArray();
     }
-    return file.readAll();
+#ifndef __WINDOWS__
+    // Files in the compact format are memory mapped to load only the
+    // required levels of detail. Windows does not allow to replace
+    // mapped files, which would prevent updating the analysis.
+    if (ppMappedFile && mixxx::CompactWaveformFormat::hasMagic(pFile->peek(4))) {
+        const qint64 size = pFile->size();
+        uchar* pData = size <= std::numeric_limits<int>::max()
+                ? pFile->map(0, size)
+                : nullptr;
+        if (pData) {
+            *ppMappedFile = std::move(pFile);
+            return QByteArray::fromRawData(
+                    reinterpret_cast<const char*>(pData), static_cast<int>(size));
+        }
+    }
+#else
+    Q_UNUSED(ppMappedFile);
+#endif
+    return pFile->readAll();
+}
+
+// static
+int AnalysisDao::dataChecksum(const QByteArray& data) {
+    // Only the header of the compact format is verified here to avoid
+    // accessing all data. Each level of detail has its own checksum.
+    mixxx::CompactWaveformFormat::Header header;
+    const int size = mixxx::CompactWaveformFormat::readHeader(data, &header)
+            ? header.size
+            : data.length();
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return qChecksum(QByteArrayView(data.constData(), size));
+#else
+    return qChecksum(data.constData(), size);
+#endif
 }
 
 bool AnalysisDao::deleteFile(const QString& fileName) const {
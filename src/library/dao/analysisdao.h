@@ -2,7 +2,9 @@
 
 #include <QObject>
 #include <QDir>
+#include <QFile>
 #include <QSqlDatabase>
+#include <memory>
 
 #include "preferences/usersettings.h"
 #include "library/dao/dao.h"
@@ -30,6 +32,8 @@ class AnalysisDao : public DAO {
         QString description;
         QString version;
         QByteArray data;
+        // Keeps the file open if data refers to a memory mapped file
+        std::shared_ptr<QFile> pMappedFile;
     };
 
     explicit AnalysisDao(UserSettingsPointer pConfig);
@@ -59,7 +63,9 @@ class AnalysisDao : public DAO {
 
   private:
     QDir getAnalysisStoragePath() const;
-    QByteArray loadDataFromFile(const QString& fileName) const;
+    QByteArray loadDataFromFile(const QString& fileName,
+            std::shared_ptr<QFile>* ppMappedFile = nullptr) const;
+    static int dataChecksum(const QByteArray& data);
     bool saveDataToFile(const QString& fileName, const QByteArray& data) const;
     bool deleteFile(const QString& filename) const;
     QList<AnalysisInfo> loadAnalysesFromQuery(TrackId trackId, QSqlQuery* query);
@@ -61,6 +61,26 @@ CuePointer cueFromRow(const QSqlRecord& row) {
     return pCue;
 }
 
+/// Appends a cue that has been loaded from the database. A previously
+/// loaded hot cue with the same number is dropped.
+void appendLoadedCue(QList<CuePointer>* pCues, CuePointer pCue) {
+    const int hotCueNumber = pCue->getHotCue();
+    if (hotCueNumber != Cue::kNoHotCue) {
+        for (auto it = pCues->begin(); it != pCues->end(); ++it) {
+            if ((*it)->getHotCue() == hotCueNumber) {
+                kLogger.warning()
+                        << "Dropping hot cue"
+                        << (*it)->getId()
+                        << "with duplicate number"
+                        << hotCueNumber;
+                pCues->erase(it);
+                break;
+            }
+        }
+    }
+    pCues->push_back(std::move(pCue));
+}
+
 } // namespace
 
 QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
@@ -81,30 +101,53 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
         DEBUG_ASSERT(!"failed query");
         return cues;
     }
-    QMap<int, CuePointer> hotCuesByNumber;
     while (query.next()) {
         CuePointer pCue = cueFromRow(query.record());
         VERIFY_OR_DEBUG_ASSERT(pCue) {
             continue;
         }
-        int hotCueNumber = pCue->getHotCue();
-        if (hotCueNumber != Cue::kNoHotCue) {
-            const auto pDuplicateCue = hotCuesByNumber.take(hotCueNumber);
-            if (pDuplicateCue) {
-                kLogger.warning()
-                        << "Dropping hot cue"
-                        << pDuplicateCue->getId()
-                        << "with duplicate number"
-                        << hotCueNumber;
-                cues.removeOne(pDuplicateCue);
-            }
-            hotCuesByNumber.insert(hotCueNumber, pCue);
-        }
-        cues.push_back(pCue);
+        appendLoadedCue(&cues, std::move(pCue));
     }
     return cues;
 }
 
+QHash<TrackId, QList<CuePointer>> CueDAO::getCuesForTracks(
+        const QList<TrackId>& trackIds) const {
+    QHash<TrackId, QList<CuePointer>> cuesByTrackId;
+    if (trackIds.isEmpty()) {
+        return cuesByTrackId;
+    }
+
+    QStringList idList;
+    idList.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        idList << trackId.toString();
+    }
+
+    FwdSqlQuery query(
+            m_database,
+            QStringLiteral("SELECT * FROM " CUE_TABLE " WHERE track_id IN (%1)")
+                    .arg(idList.join(",")));
+    if (query.hasError() || !query.execPrepared()) {
+        kLogger.warning()
+                << "Failed to load cues of"
+                << trackIds.size()
+                << "tracks";
+        DEBUG_ASSERT(!"failed query");
+        return cuesByTrackId;
+    }
+    const DbFieldIndex trackIdColumn = query.fieldIndex("track_id");
+    while (query.next()) {
+        const TrackId trackId(query.fieldValue(trackIdColumn));
+        CuePointer pCue = cueFromRow(query.record());
+        VERIFY_OR_DEBUG_ASSERT(pCue) {
+            continue;
+        }
+        appendLoadedCue(&cuesByTrackId[trackId], std::move(pCue));
+    }
+    return cuesByTrackId;
+}
+
 bool CueDAO::deleteCuesForTrack(TrackId trackId) const {
     qDebug() << "CueDAO::deleteCuesForTrack" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(m_database);
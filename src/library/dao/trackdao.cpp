@@ -79,6 +79,30 @@ QString locationPathPrefixFromRootDir(const QDir& rootDir) {
     return mixxx::FileInfo(rootDir).location() + '/';
 }
 
+/// Replaces the record of a newly created track with the metadata that
+/// has already been parsed from the same file into a temporary track object.
+/// Returns false if the metadata still needs to be imported, e.g. if the
+/// file has been modified in the meantime or if cue points and beats that
+/// are not part of the record have been imported.
+bool adoptParsedTrackMetadata(Track* pTrack, const Track& parsedTrack) {
+    DEBUG_ASSERT(!pTrack->getId().isValid());
+    if (pTrack->getRecord().checkSourceSyncStatus(pTrack->getFileInfo()) !=
+            mixxx::TrackRecord::SourceSyncStatus::Void) {
+        // Same as UpdateTrackFromSourceMode::Once, but there is nothing
+        // left to do
+        return true;
+    }
+    if (parsedTrack.getLocation() != pTrack->getLocation() ||
+            !parsedTrack.checkSourceSynchronized() ||
+            parsedTrack.getCueImportStatus() != Track::ImportStatus::Complete ||
+            parsedTrack.getBeatsImportStatus() != Track::ImportStatus::Complete ||
+            !parsedTrack.getCuePoints().isEmpty()) {
+        return false;
+    }
+    pTrack->replaceRecord(parsedTrack.getRecord(), parsedTrack.getBeats());
+    return true;
+}
+
 } // anonymous namespace
 
 TrackDAO::TrackDAO(CueDAO& cueDao,
@@ -827,7 +851,8 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 
 TrackPointer TrackDAO::addTracksAddFile(
         const mixxx::FileAccess& fileAccess,
-        bool unremove) {
+        bool unremove,
+        const TrackPointer& pParsedTrack) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -874,10 +899,12 @@ TrackPointer TrackDAO::addTracksAddFile(
     // object is known and has been updated in the cache.
 
     // Initially (re-)import the metadata for the newly created track
-    // from the file.
-    SoundSourceProxy(pTrack).updateTrackFromSource(
-            SoundSourceProxy::UpdateTrackFromSourceMode::Once,
-            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+    // from the file, unless it has already been parsed by the caller.
+    if (!pParsedTrack || !adoptParsedTrackMetadata(pTrack.get(), *pParsedTrack)) {
+        SoundSourceProxy(pTrack).updateTrackFromSource(
+                SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+    }
     if (!pTrack->checkSourceSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -1334,6 +1361,141 @@ struct ColumnPopulator {
     TrackPopulatorFn populator;
 };
 
+constexpr ColumnPopulator kTrackColumns[] = {
+        // Location must be first and is populated manually!
+        {"track_locations.location", nullptr},
+        {"artist", setTrackArtist},
+        {"title", setTrackTitle},
+        {"album", setTrackAlbum},
+        {"album_artist", setTrackAlbumArtist},
+        {"year", setTrackYear},
+        {"genre", setTrackGenre},
+        {"composer", setTrackComposer},
+        {"grouping", setTrackGrouping},
+        {"tracknumber", setTrackNumber},
+        {"tracktotal", setTrackTotal},
+        {"filetype", setTrackFiletype},
+        {"rating", setTrackRating},
+        {"color", setTrackColor},
+        {"comment", setTrackComment},
+        {"url", setTrackUrl},
+        {"cuepoint", setTrackCuePoint},
+        {"replaygain", setTrackReplayGainRatio},
+        {"replaygain_peak", setTrackReplayGainPeak},
+        {"timesplayed", setTrackTimesPlayed},
+        {"last_played_at", setTrackLastPlayedAt},
+        {"played", setTrackPlayed},
+        {"datetime_added", setTrackDateAdded},
+        {"header_parsed", setTrackHeaderParsed},
+        {"source_synchronized_ms", setTrackSourceSynchronizedAt},
+
+        // Audio properties are set together at once. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"channels", setTrackAudioProperties},
+        {"samplerate", nullptr},
+        {"bitrate", nullptr},
+        {"duration", nullptr},
+
+        // Beat detection columns are handled by setTrackBeats. Do not change
+        // the ordering of these columns or put other columns in between them!
+        {"bpm", setTrackBeats},
+        {"beats_version", nullptr},
+        {"beats_sub_version", nullptr},
+        {"beats", nullptr},
+        {"bpm_lock", nullptr},
+
+        // Beat detection columns are handled by setTrackKey. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"key", setTrackKey},
+        {"keys_version", nullptr},
+        {"keys_sub_version", nullptr},
+        {"keys", nullptr},
+
+        // Cover art columns are handled by setTrackCoverInfo. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"coverart_source", setTrackCoverInfo},
+        {"coverart_type", nullptr},
+        {"coverart_location", nullptr},
+        {"coverart_color", nullptr},
+        {"coverart_digest", nullptr},
+        {"coverart_hash", nullptr},
+};
+constexpr int kTrackColumnsCount = static_cast<int>(std::size(kTrackColumns));
+
+// Limits the length of the SQL statements for loading multiple tracks
+constexpr int kMaxTrackIdsPerQuery = 1000;
+
+const QString& trackColumnsSql() {
+    static const QString columnsSql = [] {
+        QStringList columnNames;
+        columnNames.reserve(kTrackColumnsCount);
+        for (const auto& column : kTrackColumns) {
+            columnNames.append(QString::fromLatin1(column.name));
+        }
+        return columnNames.join(QChar(','));
+    }();
+    return columnsSql;
+}
+
+/// Resolves the track object for a database record in the GlobalTrackCache.
+///
+/// Returns the cached track on a hit, or a new, empty track object that
+/// needs to be populated from the record on a miss. On a conflict a
+/// nullptr is returned.
+TrackPointer resolveTrackFromRecord(
+        TrackId trackId,
+        const QSqlRecord& queryRecord,
+        bool* pCacheMiss) {
+    DEBUG_ASSERT(pCacheMiss);
+    *pCacheMiss = false;
+    // Location is the first column.
+    DEBUG_ASSERT(queryRecord.count() > 0);
+    const auto trackLocation = queryRecord.value(0).toString();
+    const auto fileInfo = mixxx::FileInfo(trackLocation);
+    const auto fileAccess = mixxx::FileAccess(fileInfo);
+    const auto cacheResolver = GlobalTrackCacheResolver(fileAccess, trackId);
+    TrackPointer pTrack = cacheResolver.getTrack();
+    switch (cacheResolver.getLookupResult()) {
+    case GlobalTrackCacheLookupResult::Hit:
+        // Due to race conditions the track might have been reloaded
+        // from the database in the meantime. In this case we abort
+        // the operation and simply return the already cached Track
+        // object which is up-to-date.
+        DEBUG_ASSERT(pTrack);
+        DEBUG_ASSERT(!trackId.isValid() || trackId == pTrack->getId());
+        DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
+        return pTrack;
+    case GlobalTrackCacheLookupResult::Miss:
+        // An (almost) empty track object
+        DEBUG_ASSERT(pTrack);
+        DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
+        DEBUG_ASSERT(!trackId.isValid() || trackId == pTrack->getId());
+        // Continue and populate the (almost) empty track object
+        *pCacheMiss = true;
+        return pTrack;
+    case GlobalTrackCacheLookupResult::ConflictCanonicalLocation:
+        // Reject requests that would otherwise cause a caching caching conflict
+        // by accessing the same, physical file from multiple tracks concurrently.
+        DEBUG_ASSERT(!pTrack);
+        DEBUG_ASSERT(cacheResolver.getTrackRef().hasId());
+        DEBUG_ASSERT(!trackId.isValid() || trackId == cacheResolver.getTrackRef().getId());
+        DEBUG_ASSERT(cacheResolver.getTrackRef().hasCanonicalLocation());
+        DEBUG_ASSERT(cacheResolver.getTrackRef().getCanonicalLocation() ==
+                fileInfo.canonicalLocation());
+        kLogger.warning()
+                << "Failed to load track with id"
+                << trackId
+                << "that is referencing the same file"
+                << cacheResolver.getTrackRef().getCanonicalLocation()
+                << "as the cached track with id"
+                << cacheResolver.getTrackRef().getId();
+        return nullptr;
+    default:
+        DEBUG_ASSERT(!"unreachable");
+        return nullptr;
+    }
+}
+
 }  // namespace
 
 TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
@@ -1347,67 +1509,6 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return pTrack;
     }
 
-    constexpr ColumnPopulator columns[] = {
-            // Location must be first and is populated manually!
-            {"track_locations.location", nullptr},
-            {"artist", setTrackArtist},
-            {"title", setTrackTitle},
-            {"album", setTrackAlbum},
-            {"album_artist", setTrackAlbumArtist},
-            {"year", setTrackYear},
-            {"genre", setTrackGenre},
-            {"composer", setTrackComposer},
-            {"grouping", setTrackGrouping},
-            {"tracknumber", setTrackNumber},
-            {"tracktotal", setTrackTotal},
-            {"filetype", setTrackFiletype},
-            {"rating", setTrackRating},
-            {"color", setTrackColor},
-            {"comment", setTrackComment},
-            {"url", setTrackUrl},
-            {"cuepoint", setTrackCuePoint},
-            {"replaygain", setTrackReplayGainRatio},
-            {"replaygain_peak", setTrackReplayGainPeak},
-            {"timesplayed", setTrackTimesPlayed},
-            {"last_played_at", setTrackLastPlayedAt},
-            {"played", setTrackPlayed},
-            {"datetime_added", setTrackDateAdded},
-            {"header_parsed", setTrackHeaderParsed},
-            {"source_synchronized_ms", setTrackSourceSynchronizedAt},
-
-            // Audio properties are set together at once. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"channels", setTrackAudioProperties},
-            {"samplerate", nullptr},
-            {"bitrate", nullptr},
-            {"duration", nullptr},
-
-            // Beat detection columns are handled by setTrackBeats. Do not change
-            // the ordering of these columns or put other columns in between them!
-            {"bpm", setTrackBeats},
-            {"beats_version", nullptr},
-            {"beats_sub_version", nullptr},
-            {"beats", nullptr},
-            {"bpm_lock", nullptr},
-
-            // Beat detection columns are handled by setTrackKey. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"key", setTrackKey},
-            {"keys_version", nullptr},
-            {"keys_sub_version", nullptr},
-            {"keys", nullptr},
-
-            // Cover art columns are handled by setTrackCoverInfo. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"coverart_source", setTrackCoverInfo},
-            {"coverart_type", nullptr},
-            {"coverart_location", nullptr},
-            {"coverart_color", nullptr},
-            {"coverart_digest", nullptr},
-            {"coverart_hash", nullptr},
-    };
-    constexpr int columnsCount = static_cast<int>(std::size(columns));
-
     // Accessing the database is a time consuming operation that should not
     // be executed with a lock on the GlobalTrackCache. The GlobalTrackCache
     // will be locked again after the query has been executed (see below)
@@ -1416,25 +1517,12 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
 
     QSqlRecord queryRecord;
     {
-        QString columnsStr;
-        int columnsSize = 0;
-        for (int i = 0; i < columnsCount; ++i) {
-            columnsSize += qstrlen(columns[i].name) + 1;
-        }
-        columnsStr.reserve(columnsSize);
-        for (int i = 0; i < columnsCount; ++i) {
-            if (i > 0) {
-                columnsStr.append(QChar(','));
-            }
-            columnsStr.append(columns[i].name);
-        }
-
         QSqlQuery query(m_database);
         query.prepare(QString(
                 "SELECT %1 FROM Library "
                 "INNER JOIN track_locations ON library.location = track_locations.id "
                 "WHERE library.id = %2")
-                              .arg(columnsStr, trackId.toString()));
+                              .arg(trackColumnsSql(), trackId.toString()));
         if (!query.exec()) {
             LOG_FAILED_QUERY(query)
                     << QString("getTrack(%1)").arg(trackId.toString());
@@ -1451,74 +1539,142 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         DEBUG_ASSERT(!query.next());
     }
 
+    bool cacheMiss;
+    pTrack = resolveTrackFromRecord(trackId, queryRecord, &cacheMiss);
+    if (cacheMiss) {
+        populateTrackFromRecord(pTrack, queryRecord, m_cueDao.getCuesForTrack(trackId));
+    }
+    return pTrack;
+}
+
+QList<TrackPointer> TrackDAO::getTracksByIds(
+        const QList<TrackId>& trackIds) const {
+    QHash<TrackId, TrackPointer> tracksById;
+    tracksById.reserve(trackIds.size());
+    QList<TrackId> uncachedTrackIds;
     {
-        // Location is the first column.
-        DEBUG_ASSERT(queryRecord.count() > 0);
-        const auto trackLocation = queryRecord.value(0).toString();
-        const auto fileInfo = mixxx::FileInfo(trackLocation);
-        const auto fileAccess = mixxx::FileAccess(fileInfo);
-        const auto cacheResolver = GlobalTrackCacheResolver(fileAccess, trackId);
-        pTrack = cacheResolver.getTrack();
-        switch (cacheResolver.getLookupResult()) {
-        case GlobalTrackCacheLookupResult::Hit:
-            // Due to race conditions the track might have been reloaded
-            // from the database in the meantime. In this case we abort
-            // the operation and simply return the already cached Track
-            // object which is up-to-date.
-            DEBUG_ASSERT(pTrack);
-            DEBUG_ASSERT(!trackId.isValid() || trackId == pTrack->getId());
-            DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
-            return pTrack;
-        case GlobalTrackCacheLookupResult::Miss:
-            // An (almost) empty track object
-            DEBUG_ASSERT(pTrack);
-            DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
-            DEBUG_ASSERT(!trackId.isValid() || trackId == pTrack->getId());
-            // Continue and populate the (almost) empty track object
-            break;
-        case GlobalTrackCacheLookupResult::ConflictCanonicalLocation:
-            // Reject requests that would otherwise cause a caching caching conflict
-            // by accessing the same, physical file from multiple tracks concurrently.
-            DEBUG_ASSERT(!pTrack);
-            DEBUG_ASSERT(cacheResolver.getTrackRef().hasId());
-            DEBUG_ASSERT(!trackId.isValid() || trackId == cacheResolver.getTrackRef().getId());
-            DEBUG_ASSERT(cacheResolver.getTrackRef().hasCanonicalLocation());
-            DEBUG_ASSERT(cacheResolver.getTrackRef().getCanonicalLocation() ==
-                    fileInfo.canonicalLocation());
-            kLogger.warning()
-                    << "Failed to load track with id"
-                    << trackId
-                    << "that is referencing the same file"
-                    << cacheResolver.getTrackRef().getCanonicalLocation()
-                    << "as the cached track with id"
-                    << cacheResolver.getTrackRef().getId();
-            return nullptr;
-        default:
-            DEBUG_ASSERT(!"unreachable");
-            return nullptr;
+        // Look up all cached tracks at once
+        const GlobalTrackCacheLocker cacheLocker;
+        for (const auto& trackId : trackIds) {
+            if (!trackId.isValid() || tracksById.contains(trackId)) {
+                continue;
+            }
+            TrackPointer pTrack = cacheLocker.lookupTrackById(trackId);
+            if (!pTrack) {
+                uncachedTrackIds.append(trackId);
+            }
+            tracksById.insert(trackId, std::move(pTrack));
+        }
+    }
+
+    if (!uncachedTrackIds.isEmpty()) {
+        ScopedTimer t("TrackDAO::getTracksByIds");
+
+        QHash<TrackId, QSqlRecord> queryRecords;
+        queryRecords.reserve(uncachedTrackIds.size());
+        QHash<TrackId, QList<CuePointer>> cuesByTrackId;
+        for (int i = 0; i < uncachedTrackIds.size(); i += kMaxTrackIdsPerQuery) {
+            const QList<TrackId> chunkTrackIds =
+                    uncachedTrackIds.mid(i, kMaxTrackIdsPerQuery);
+            QStringList idList;
+            idList.reserve(chunkTrackIds.size());
+            for (const auto& trackId : chunkTrackIds) {
+                idList.append(trackId.toString());
+            }
+            // The id is appended after all populated columns
+            QSqlQuery query(m_database);
+            query.setForwardOnly(true);
+            query.prepare(QString(
+                    "SELECT %1,library.id FROM Library "
+                    "INNER JOIN track_locations ON library.location = track_locations.id "
+                    "WHERE library.id IN (%2)")
+                                  .arg(trackColumnsSql(), idList.join(QChar(','))));
+            if (!query.exec()) {
+                LOG_FAILED_QUERY(query)
+                        << "getTracksByIds()";
+                DEBUG_ASSERT(!"Failed query");
+                return {};
+            }
+            while (query.next()) {
+                const TrackId trackId(query.value(kTrackColumnsCount));
+                queryRecords.insert(trackId, query.record());
+            }
+            auto chunkCuesByTrackId = m_cueDao.getCuesForTracks(chunkTrackIds);
+            for (auto it = chunkCuesByTrackId.begin(); it != chunkCuesByTrackId.end(); ++it) {
+                cuesByTrackId.insert(it.key(), std::move(it.value()));
+            }
+        }
+
+        // All tracks are resolved while the GlobalTrackCache is locked only
+        // once. The recursive mutex is still acquired for each track, but
+        // without any contention. Populating the tracks happens after
+        // unlocking the cache, like in getTrackById().
+        QList<TrackId> missedTrackIds;
+        {
+            const GlobalTrackCacheLocker cacheLocker;
+            for (const auto& trackId : qAsConst(uncachedTrackIds)) {
+                const auto queryRecord = queryRecords.constFind(trackId);
+                if (queryRecord == queryRecords.constEnd()) {
+                    qDebug() << "Track with id =" << trackId << "not found";
+                    continue;
+                }
+                bool cacheMiss;
+                tracksById.insert(trackId,
+                        resolveTrackFromRecord(trackId, queryRecord.value(), &cacheMiss));
+                if (cacheMiss) {
+                    missedTrackIds.append(trackId);
+                }
+            }
+        }
+
+        for (const auto& trackId : qAsConst(missedTrackIds)) {
+            populateTrackFromRecord(tracksById.value(trackId),
+                    queryRecords.value(trackId),
+                    cuesByTrackId.take(trackId));
+        }
+    }
+
+    QList<TrackPointer> tracks;
+    tracks.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        TrackPointer pTrack = tracksById.value(trackId);
+        if (pTrack) {
+            tracks.append(std::move(pTrack));
         }
     }
+    return tracks;
+}
+
+void TrackDAO::populateTrackFromRecord(
+        const TrackPointer& pTrack,
+        const QSqlRecord& queryRecord,
+        QList<CuePointer> cues) const {
+    DEBUG_ASSERT(pTrack);
+    const TrackId trackId = pTrack->getId();
 
     // NOTE(uklotzde, 2018-02-06):
     // pTrack has only the id set and is otherwise empty. It is registered
     // in the cache with both the id and the canonical location of the file.
-    // The following database query will restore and populate all remaining
-    // properties while the virgin track object is already visible for other
-    // threads when looking it up in the cache. This temporary inconsistency
+    // The following code will restore and populate all remaining
+    // properties from the query record while the virgin track object is
+    // already visible for other threads when looking it up in the cache.
+    // This temporary inconsistency
     // is acceptable as a tradeoff for reduced lock contention. Otherwise the
     // global cache would need to be locked until the query and the population
     // of the properties has finished.
 
     // For every column run its populator to fill the track in with the data.
+    // Additional columns at the end of the record are ignored.
     bool shouldDirty = false;
     {
         int recordCount = queryRecord.count();
-        if (recordCount != columnsCount) {
-            recordCount = math_min(recordCount, columnsCount);
+        if (recordCount < kTrackColumnsCount) {
             DEBUG_ASSERT(!"Failed query");
+        } else {
+            recordCount = kTrackColumnsCount;
         }
         for (int i = 0; i < recordCount; ++i) {
-            TrackPopulatorFn populator = columns[i].populator;
+            TrackPopulatorFn populator = kTrackColumns[i].populator;
             if (populator && (*populator)(queryRecord, i, pTrack.get())) {
                 // If any populator says the track should be dirty then we dirty it.
                 shouldDirty = true;
@@ -1527,7 +1683,7 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     }
 
     // Populate track cues from the cues table.
-    pTrack->setCuePoints(m_cueDao.getCuesForTrack(trackId));
+    pTrack->setCuePoints(std::move(cues));
 
     // Normally we will set the track as clean but sometimes when loading from
     // the database we need to perform upkeep that ought to be written back to
@@ -1611,8 +1767,6 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     } else {
         emit mixxx::thisAsNonConst(this)->trackClean(trackId);
     }
-
-    return pTrack;
 }
 
 TrackId TrackDAO::getTrackIdByRef(
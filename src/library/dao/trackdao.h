@@ -10,11 +10,13 @@
 #include "library/dao/dao.h"
 #include "library/relocatedtrack.h"
 #include "preferences/usersettings.h"
+#include "track/cue.h"
 #include "track/globaltrackcache.h"
 #include "util/class.h"
 #include "util/memory.h"
 
 class FwdSqlQuery;
+class QSqlRecord;
 class SqlTransaction;
 class PlaylistDAO;
 class AnalysisDao;
@@ -132,11 +134,18 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     friend class LibraryScanner;
     friend class TrackCollection;
     friend class TrackAnalysisScheduler;
+    friend class LibraryScannerTest;
 
     TrackId getTrackIdByLocation(
             const QString& location) const;
     TrackPointer getTrackById(
             TrackId trackId) const;
+    /// Loads multiple tracks at once. All tracks that are not cached
+    /// are fetched with a few queries instead of one query per track.
+    /// The tracks are returned in the order of the given ids. Tracks
+    /// that could not be loaded are skipped.
+    QList<TrackPointer> getTracksByIds(
+            const QList<TrackId>& trackIds) const;
 
     // Loads a track from the database (by id if available, otherwise by location)
     // or adds it if not found in case the location is known. The (optional) out
@@ -151,15 +160,21 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    /// The metadata of the new track is parsed from the file unless
+    /// it is provided by pParsedTrack, a temporary track object that
+    /// has already been updated from the same file.
     TrackPointer addTracksAddFile(
             const mixxx::FileAccess& fileAccess,
-            bool unremove);
+            bool unremove,
+            const TrackPointer& pParsedTrack = nullptr);
     TrackPointer addTracksAddFile(
             const QString& filePath,
-            bool unremove) {
+            bool unremove,
+            const TrackPointer& pParsedTrack = nullptr) {
         return addTracksAddFile(
                 mixxx::FileAccess(mixxx::FileInfo(filePath)),
-                unremove);
+                unremove,
+                pParsedTrack);
     }
     void addTracksFinish(bool rollback = false);
 
@@ -195,6 +210,13 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     void detectCoverArtForTracksWithoutCover(volatile const bool* pCancel,
                                         QSet<TrackId>* pTracksChanged);
 
+    /// Populates a new and empty track object that has just been
+    /// inserted into the GlobalTrackCache.
+    void populateTrackFromRecord(
+            const TrackPointer& pTrack,
+            const QSqlRecord& queryRecord,
+            QList<CuePointer> cues) const;
+
     // Callback for GlobalTrackCache
     mixxx::FileAccess relocateCachedTrack(
             TrackId trackId,
@@ -79,3 +79,13 @@ const ConfigKey mixxx::library::prefs::kUseRelativePathOnExportConfigKey =
         ConfigKey{
                 mixxx::library::prefs::kConfigGroup,
                 QStringLiteral("UseRelativePathOnExport")};
+
+const ConfigKey mixxx::library::prefs::kScannerThreadPoolSizeConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("ScannerThreadPoolSize")};
+
+const ConfigKey mixxx::library::prefs::kSearchIndexEnabledConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("SearchIndexEnabled")};
@@ -44,6 +44,18 @@ extern const ConfigKey kSyncSeratoMetadataConfigKey;
 
 extern const ConfigKey kUseRelativePathOnExportConfigKey;
 
+/// Number of worker threads of the library scanner. Values <= 0 select
+/// the number of available CPU cores.
+extern const ConfigKey kScannerThreadPoolSizeConfigKey;
+
+const int kScannerThreadPoolSizeDefault = 1;
+
+/// Maintain an in-memory trigram index for searching the
+/// track library, see TrackSearchIndex.
+extern const ConfigKey kSearchIndexEnabledConfigKey;
+
+const bool kSearchIndexEnabledDefault = false;
+
 } // namespace prefs
 
 } // namespace library
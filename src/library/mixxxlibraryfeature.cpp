@@ -11,6 +11,7 @@
 #include "library/dlgmissing.h"
 #include "library/hiddentablemodel.h"
 #include "library/library.h"
+#include "library/library_prefs.h"
 #include "library/librarytablemodel.h"
 #include "library/missingtablemodel.h"
 #include "library/parser.h"
@@ -98,6 +99,9 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
 
     BaseTrackCache* pBaseTrackCache = new BaseTrackCache(
             m_pTrackCollection, tableName, LIBRARYTABLE_ID, columns, true);
+    pBaseTrackCache->setSearchIndexEnabled(m_pConfig->getValue(
+            mixxx::library::prefs::kSearchIndexEnabledConfigKey,
+            mixxx::library::prefs::kSearchIndexEnabledDefault));
     m_pBaseTrackCache = QSharedPointer<BaseTrackCache>(pBaseTrackCache);
     m_pTrackCollection->connectTrackSource(m_pBaseTrackCache);
 
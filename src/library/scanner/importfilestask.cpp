@@ -2,6 +2,8 @@
 
 #include "library/scanner/libraryscanner.h"
 #include "moc_importfilestask.cpp"
+#include "sources/soundsourceproxy.h"
+#include "track/track.h"
 #include "util/timer.h"
 
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
@@ -50,7 +52,22 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit addNewTrack(trackLocation);
+            TrackPointer pParsedTrack;
+            const auto& concurrentMetadataImport =
+                    m_scannerGlobal->concurrentMetadataImport();
+            if (concurrentMetadataImport) {
+                // Parsing the tags is the most expensive part of adding a
+                // new track. Do it here on the worker thread with a temporary
+                // track object and let the scanner thread only write the
+                // results into the database.
+                pParsedTrack = Track::newTemporary(
+                        mixxx::FileAccess(mixxx::FileInfo(fileInfo), m_pToken));
+                SoundSourceProxy(pParsedTrack)
+                        .updateTrackFromSource(
+                                SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                                *concurrentMetadataImport);
+            }
+            emit addNewTrack(trackLocation, pParsedTrack);
         }
     }
     // Insert or update the hash in the database.
@@ -1,6 +1,7 @@
 #include "library/scanner/libraryscanner.h"
 
 #include "library/coverartutils.h"
+#include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "library/scanner/libraryscannerdlg.h"
 #include "library/scanner/recursivescandirectorytask.h"
@@ -13,19 +14,30 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 namespace {
 
-// TODO(rryan) make configurable
-constexpr int kScannerThreadPoolSize = 1;
-
 mixxx::Logger kLogger("LibraryScanner");
 
 QAtomicInt s_instanceCounter(0);
 
+// Limits the rate of progress updates for processed files
+constexpr int kFilesProcessedProgressInterval = 16;
+
+int scannerThreadPoolSize(const UserSettings& config) {
+    const int threadPoolSize = config.getValue(
+            mixxx::library::prefs::kScannerThreadPoolSizeConfigKey,
+            mixxx::library::prefs::kScannerThreadPoolSizeDefault);
+    if (threadPoolSize > 0) {
+        return threadPoolSize;
+    }
+    return math_max(QThread::idealThreadCount(), 1);
+}
+
 // Returns the number of affected rows or -1 on error
 int execRowCountQuery(FwdSqlQuery& query) {
     VERIFY_OR_DEBUG_ASSERT(query.isPrepared()) {
@@ -98,6 +110,7 @@ LibraryScanner::LibraryScanner(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         const UserSettingsPointer& pConfig)
         : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_pConfig(pConfig),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao,
                   m_analysisDao, m_libraryHashDao,
@@ -112,8 +125,6 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
-
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
     connect(this, &LibraryScanner::startScan, this, &LibraryScanner::slotStartScan);
@@ -127,6 +138,10 @@ LibraryScanner::LibraryScanner(
             &LibraryScanner::progressHashing,
             m_pProgressDlg.data(),
             &LibraryScannerDlg::slotUpdate);
+    connect(this,
+            &LibraryScanner::progressFilesProcessed,
+            m_pProgressDlg.data(),
+            &LibraryScannerDlg::slotUpdateFilesProcessed);
     connect(this,
             &LibraryScanner::scanStarted,
             m_pProgressDlg.data(),
@@ -206,9 +221,29 @@ void LibraryScanner::slotStartScan() {
                     QRegularExpression::CaseInsensitiveOption);
     QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
 
+    // The size of the pool is re-read for each scan. With more than a single
+    // worker thread the tags of new files are parsed concurrently by the
+    // worker tasks. The database is still only accessed by the scanner thread
+    // that adds all tracks within a single transaction.
+    const int threadPoolSize = scannerThreadPoolSize(*m_pConfig);
+    m_pool.setMaxThreadCount(threadPoolSize);
+    std::optional<SyncTrackMetadataParams> concurrentMetadataImport;
+    if (threadPoolSize > 1) {
+        concurrentMetadataImport =
+                SyncTrackMetadataParams::readFromUserSettings(*m_pConfig);
+    }
+    kLogger.info()
+            << "Scanning with"
+            << threadPoolSize
+            << "worker thread(s)";
+
     m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
-                              coverExtensionFilter, directoryBlacklist));
+            new ScannerGlobal(trackLocations,
+                    directoryHashes,
+                    extensionFilter,
+                    coverExtensionFilter,
+                    directoryBlacklist,
+                    std::move(concurrentMetadataImport)));
 
     m_scannerGlobal->startTimer();
 
@@ -427,12 +462,14 @@ void LibraryScanner::slotFinishUnhashedScan() {
            "%d unchanged directories. "
            "%d changed/added directories. "
            "%d tracks verified from changed/added directories. "
-           "%d new tracks.",
+           "%d new tracks. "
+           "%d files processed.",
             m_scannerGlobal->timerElapsed().formatNanosWithUnit().toLocal8Bit().constData(),
             static_cast<int>(m_scannerGlobal->verifiedDirectories().size()),
             m_scannerGlobal->numScannedDirectories(),
             static_cast<int>(m_scannerGlobal->verifiedTracks().size()),
-            static_cast<int>(m_scannerGlobal->addedTracks().size()));
+            static_cast<int>(m_scannerGlobal->addedTracks().size()),
+            m_scannerGlobal->numProcessedFiles());
 
     m_scannerGlobal.clear();
     changeScannerState(FINISHED);
@@ -564,15 +601,19 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     if (m_scannerGlobal) {
         m_scannerGlobal->addVerifiedTrack(trackPath);
     }
+    fileProcessed();
 }
 
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
+void LibraryScanner::slotAddNewTrack(
+        const QString& trackPath,
+        TrackPointer pParsedTrack) {
     //kLogger.debug() << "slotAddNewTrack" << trackPath;
     ScopedTimer timer("LibraryScanner::addNewTrack");
     // For statistics tracking and to detect moved tracks
     TrackPointer pTrack = m_trackDao.addTracksAddFile(
             trackPath,
-            false);
+            false,
+            pParsedTrack);
     if (pTrack) {
         DEBUG_ASSERT(!pTrack->isDirty());
         // The track's actual location might differ from the
@@ -597,6 +638,18 @@ void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
                 << "Failed to add track to library:"
                 << trackPath;
     }
+    fileProcessed();
+}
+
+void LibraryScanner::fileProcessed() {
+    if (!m_scannerGlobal) {
+        return;
+    }
+    m_scannerGlobal->fileProcessed();
+    const int numProcessedFiles = m_scannerGlobal->numProcessedFiles();
+    if (numProcessedFiles % kFilesProcessedProgressInterval == 0) {
+        emit progressFilesProcessed(numProcessedFiles);
+    }
 }
 
 bool LibraryScanner::changeScannerState(ScannerState newState) {
@@ -46,6 +46,7 @@ class LibraryScanner : public QThread {
     void progressHashing(const QString&);
     void progressLoading(const QString& path);
     void progressCoverArt(const QString& file);
+    void progressFilesProcessed(int numFiles);
     void trackAdded(TrackPointer pTrack);
     void tracksChanged(const QSet<TrackId>& changedTrackIds);
     void tracksRelocated(const QList<RelocatedTrack>& relocatedTracks);
@@ -70,7 +71,7 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+    void slotAddNewTrack(const QString& trackPath, TrackPointer pParsedTrack);
 
   private:
     enum ScannerState {
@@ -95,8 +96,10 @@ class LibraryScanner : public QThread {
     bool changeScannerState(LibraryScanner::ScannerState newState);
 
     void cleanUpScan();
+    void fileProcessed();
 
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    const UserSettingsPointer m_pConfig;
 
     // The pool of threads used for worker tasks.
     QThreadPool m_pool;
@@ -33,6 +33,10 @@ LibraryScannerDlg::LibraryScannerDlg(QWidget* parent, Qt::WindowFlags f)
     pCurrent->setWordWrap(true);
     connect(this, &LibraryScannerDlg::progress, pCurrent, &QLabel::setText);
     pLayout->addWidget(pCurrent);
+
+    QLabel* pThroughput = new QLabel(this);
+    connect(this, &LibraryScannerDlg::throughput, pThroughput, &QLabel::setText);
+    pLayout->addWidget(pThroughput);
     setLayout(pLayout);
 }
 
@@ -63,6 +67,19 @@ void LibraryScannerDlg::slotUpdateCover(const QString& path) {
     }
 }
 
+void LibraryScannerDlg::slotUpdateFilesProcessed(int numFiles) {
+    if (!isVisible()) {
+        return;
+    }
+    const double elapsedSeconds = m_timer.elapsed().toDoubleSeconds();
+    if (elapsedSeconds <= 0) {
+        return;
+    }
+    emit throughput(tr("%1 files processed (%2 files/s)")
+                            .arg(QString::number(numFiles),
+                                    QString::number(numFiles / elapsedSeconds, 'f', 1)));
+}
+
 void LibraryScannerDlg::slotCancel() {
     qDebug() << "Cancelling library scan...";
     m_bCancelled = true;
@@ -73,6 +90,7 @@ void LibraryScannerDlg::slotCancel() {
 void LibraryScannerDlg::slotScanStarted() {
     m_bCancelled = false;
     m_timer.start();
+    emit throughput(QString());
 }
 
 void LibraryScannerDlg::slotScanFinished() {
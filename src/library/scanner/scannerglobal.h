@@ -7,7 +7,9 @@
 #include <QSet>
 #include <QSharedPointer>
 #include <QStringList>
+#include <optional>
 
+#include "track/track_decl.h"
 #include "util/cache.h"
 #include "util/compatibility/qmutex.h"
 #include "util/fileaccess.h"
@@ -20,16 +22,20 @@ class ScannerGlobal {
             const QHash<QString, mixxx::cache_key_t>& directoryHashes,
             const QRegularExpression& supportedExtensionsMatcher,
             const QRegularExpression& supportedCoverExtensionsMatcher,
-            const QStringList& directoriesBlacklist)
+            const QStringList& directoriesBlacklist,
+            std::optional<SyncTrackMetadataParams> concurrentMetadataImport =
+                    std::nullopt)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
+              m_concurrentMetadataImport(std::move(concurrentMetadataImport)),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
-              m_numScannedDirectories(0) {
+              m_numScannedDirectories(0),
+              m_numProcessedFiles(0) {
     }
 
     TaskWatcher& getTaskWatcher() {
@@ -94,6 +100,13 @@ class ScannerGlobal {
         return match.hasMatch();
     }
 
+    /// If set the metadata of new tracks is parsed by the worker tasks
+    /// in parallel instead of by the scanner thread while adding them
+    /// to the database.
+    const std::optional<SyncTrackMetadataParams>& concurrentMetadataImport() const {
+        return m_concurrentMetadataImport;
+    }
+
     bool shouldCancel() const {
         return m_shouldCancel;
     }
@@ -153,6 +166,13 @@ class ScannerGlobal {
         m_numScannedDirectories++;
     }
 
+    int numProcessedFiles() const {
+        return m_numProcessedFiles;
+    }
+    void fileProcessed() {
+        m_numProcessedFiles++;
+    }
+
   private:
     TaskWatcher m_watcher;
 
@@ -182,6 +202,8 @@ class ScannerGlobal {
     // this has never been investigated.
     QStringList m_directoriesBlacklist;
 
+    const std::optional<SyncTrackMetadataParams> m_concurrentMetadataImport;
+
     // The list of directories verified by the scan.
     QStringList m_verifiedDirectories;
 
@@ -197,6 +219,7 @@ class ScannerGlobal {
     // Stats tracking.
     PerformanceTimer m_timer;
     int m_numScannedDirectories;
+    int m_numProcessedFiles;
 };
 
 typedef QSharedPointer<ScannerGlobal> ScannerGlobalPointer;
@@ -4,6 +4,7 @@
 #include <QRunnable>
 
 #include "library/scanner/scannerglobal.h"
+#include "track/track_decl.h"
 
 class LibraryScanner;
 
@@ -23,7 +24,9 @@ class ScannerTask : public QObject, public QRunnable {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void directoryUnchanged(const QString& directoryPath);
     void trackExists(const QString& filePath);
-    void addNewTrack(const QString& filePath);
+    /// The optional track contains the metadata that has already been
+    /// parsed from the file, see ScannerGlobal::concurrentMetadataImport().
+    void addNewTrack(const QString& filePath, TrackPointer pParsedTrack);
 
     // Feedback to GUI
     void progressLoading(const QString& fileName);
@@ -5,6 +5,8 @@
 
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
+#include "library/trackcolumntable.h"
+#include "library/tracksearchindex.h"
 #include "library/trackset/crate/crateschema.h"
 #include "track/keyutils.h"
 #include "track/track.h"
@@ -22,6 +24,35 @@ const QRegularExpression kDurationRegex(QStringLiteral("^(\\d+)(m|:)?([0-5]?\\d)
 // > the entire expression matches, is the one that is chosen. This means that alternatives
 // > are not necessarily greedy.
 const QRegularExpression kNumericOperatorRegex(QStringLiteral("^(<=|>=|=|<|>)(.*)$"));
+
+/// Resolves all columns or returns false if any of them is not available
+bool resolveColumns(const QStringList& sqlColumns,
+        const QueryNode::ColumnResolver& resolveColumn,
+        std::vector<int>* pColumns) {
+    pColumns->clear();
+    pColumns->reserve(sqlColumns.size());
+    for (const auto& sqlColumn : sqlColumns) {
+        const int column = resolveColumn(sqlColumn);
+        if (column < 0) {
+            return false;
+        }
+        pColumns->push_back(column);
+    }
+    return true;
+}
+
+/// The text of a cell as it is matched by LIKE
+QString textValue(const TrackColumnTable& table, int row, int column) {
+    switch (table.valueClass(row, column)) {
+    case TrackColumnTable::ValueClass::Null:
+        return QString();
+    case TrackColumnTable::ValueClass::String:
+        return table.stringValue(row, column);
+    default:
+        return table.value(row, column).toString();
+    }
+}
+
 } // namespace
 
 QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& column) {
@@ -92,6 +123,27 @@ QString QueryNode::concatSqlClauses(
     }
 }
 
+bool QueryNode::bindColumns(const ColumnResolver& resolveColumn) {
+    Q_UNUSED(resolveColumn);
+    return false;
+}
+
+bool QueryNode::matchRow(const TrackColumnTable& table, int row) const {
+    Q_UNUSED(table);
+    Q_UNUSED(row);
+    DEBUG_ASSERT(!"matchRow() requires bindColumns()");
+    return false;
+}
+
+bool GroupNode::bindColumns(const ColumnResolver& resolveColumn) {
+    for (const auto& pNode : m_nodes) {
+        if (!pNode->bindColumns(resolveColumn)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool AndNode::match(const TrackPointer& pTrack) const {
     for (const auto& pNode : m_nodes) {
         if (!pNode->match(pTrack)) {
@@ -115,6 +167,15 @@ QString AndNode::toSql() const {
     return concatSqlClauses(queryFragments, "AND");
 }
 
+bool AndNode::matchRow(const TrackColumnTable& table, int row) const {
+    for (const auto& pNode : m_nodes) {
+        if (!pNode->matchRow(table, row)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool OrNode::match(const TrackPointer& pTrack) const {
     // An empty OR node would always evaluate to false
     // which is inconsistent with the generated SQL query!
@@ -144,6 +205,19 @@ QString OrNode::toSql() const {
     return concatSqlClauses(queryFragments, "OR");
 }
 
+bool OrNode::matchRow(const TrackColumnTable& table, int row) const {
+    // An empty OR node generates no SQL, see match()
+    if (m_nodes.empty()) {
+        return true;
+    }
+    for (const auto& pNode : m_nodes) {
+        if (pNode->matchRow(table, row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool NotNode::match(const TrackPointer& pTrack) const {
     return !m_pNode->match(pTrack);
 }
@@ -160,13 +234,27 @@ QString NotNode::toSql() const {
     }
 }
 
+bool NotNode::bindColumns(const ColumnResolver& resolveColumn) {
+    return m_pNode->bindColumns(resolveColumn);
+}
+
+bool NotNode::matchRow(const TrackColumnTable& table, int row) const {
+    return !m_pNode->matchRow(table, row);
+}
+
 TextFilterNode::TextFilterNode(const QSqlDatabase& database,
         const QStringList& sqlColumns,
-        const QString& argument)
+        const QString& argument,
+        const TrackSearchIndex* pSearchIndex)
         : m_database(database),
           m_sqlColumns(sqlColumns),
-          m_argument(argument) {
+          m_argument(argument),
+          m_pSearchIndex(pSearchIndex),
+          m_locationColumn(-1) {
     mixxx::DbConnection::makeStringLatinLow(&m_argument);
+    if (m_pSearchIndex && !m_pSearchIndex->coversColumns(m_sqlColumns)) {
+        m_pSearchIndex = nullptr;
+    }
 }
 
 bool TextFilterNode::match(const TrackPointer& pTrack) const {
@@ -201,7 +289,67 @@ QString TextFilterNode::toSql() const {
     for (const auto& sqlColumn : m_sqlColumns) {
         searchClauses << QString("%1 LIKE %2").arg(sqlColumn, escapedArgument);
     }
-    return concatSqlClauses(searchClauses, "OR");
+    QString likeClause = concatSqlClauses(searchClauses, "OR");
+    if (!m_pSearchIndex) {
+        return likeClause;
+    }
+    const auto candidates = m_pSearchIndex->findCandidates(m_argument);
+    if (!candidates) {
+        return likeClause;
+    }
+    // The candidates are a superset of the matching tracks. The LIKE
+    // clause is still needed, but only evaluated for the candidates.
+    QStringList idStrings;
+    idStrings.reserve(static_cast<int>(candidates->size()));
+    for (const auto& trackId : *candidates) {
+        idStrings << trackId.toString();
+    }
+    return QString("%1 IN (%2) AND (%3)")
+            .arg(m_pSearchIndex->idColumn(), idStrings.join(","), likeClause);
+}
+
+bool TextFilterNode::bindColumns(const ColumnResolver& resolveColumn) {
+    if (m_argument.contains(kSqlLikeMatchAll) ||
+            m_argument.contains(kSqlLikeMatchOne) ||
+            (!m_argument.isEmpty() && m_argument.back().isSpace())) {
+        // Only plain substrings are matched in memory, see toSql()
+        return false;
+    }
+    if (!resolveColumns(m_sqlColumns, resolveColumn, &m_columns)) {
+        return false;
+    }
+    m_locationColumn = m_sqlColumns.contains(TRACKLOCATIONSTABLE_LOCATION)
+            ? resolveColumn(TRACKLOCATIONSTABLE_LOCATION)
+            : -1;
+    if (m_pSearchIndex) {
+        m_candidates = m_pSearchIndex->findCandidates(m_argument);
+    }
+    return true;
+}
+
+bool TextFilterNode::matchRow(const TrackColumnTable& table, int row) const {
+    if (m_candidates &&
+            !std::binary_search(m_candidates->begin(),
+                    m_candidates->end(),
+                    table.trackIdOfRow(row))) {
+        return false;
+    }
+    for (const auto column : m_columns) {
+        QString text = textValue(table, row, column);
+        if (text.isNull()) {
+            // NULL LIKE ... is never true
+            continue;
+        }
+        if (column == m_locationColumn) {
+            // The database stores all locations with Qt separators
+            text = QDir::fromNativeSeparators(text);
+        }
+        mixxx::DbConnection::makeStringLatinLow(&text);
+        if (text.contains(m_argument)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool NullOrEmptyTextFilterNode::match(const TrackPointer& pTrack) const {
@@ -224,6 +372,25 @@ QString NullOrEmptyTextFilterNode::toSql() const {
     return QString();
 }
 
+bool NullOrEmptyTextFilterNode::bindColumns(const ColumnResolver& resolveColumn) {
+    if (m_sqlColumns.isEmpty()) {
+        return false;
+    }
+    m_column = resolveColumn(m_sqlColumns.first());
+    return m_column >= 0;
+}
+
+bool NullOrEmptyTextFilterNode::matchRow(const TrackColumnTable& table, int row) const {
+    switch (table.valueClass(row, m_column)) {
+    case TrackColumnTable::ValueClass::Null:
+        return true;
+    case TrackColumnTable::ValueClass::String:
+        return table.stringValue(row, m_column).isEmpty();
+    default:
+        return false;
+    }
+}
+
 CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
         const QString& crateNameLike)
         : m_pCrateStorage(pCrateStorage),
@@ -232,6 +399,19 @@ CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
 }
 
 bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+    return matchTrackId(pTrack->getId());
+}
+
+bool CrateFilterNode::bindColumns(const ColumnResolver& resolveColumn) {
+    Q_UNUSED(resolveColumn);
+    return true;
+}
+
+bool CrateFilterNode::matchRow(const TrackColumnTable& table, int row) const {
+    return matchTrackId(table.trackIdOfRow(row));
+}
+
+bool CrateFilterNode::matchTrackId(TrackId trackId) const {
     if (!m_matchInitialized) {
         CrateTrackSelectResult crateTracks(
                 m_pCrateStorage->selectTracksSortedByCrateNameLike(m_crateNameLike));
@@ -243,7 +423,7 @@ bool CrateFilterNode::match(const TrackPointer& pTrack) const {
         m_matchInitialized = true;
     }
 
-    return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
+    return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), trackId);
 }
 
 QString CrateFilterNode::toSql() const {
@@ -258,6 +438,19 @@ NoCrateFilterNode::NoCrateFilterNode(const CrateStorage* pCrateStorage)
 }
 
 bool NoCrateFilterNode::match(const TrackPointer& pTrack) const {
+    return matchTrackId(pTrack->getId());
+}
+
+bool NoCrateFilterNode::bindColumns(const ColumnResolver& resolveColumn) {
+    Q_UNUSED(resolveColumn);
+    return true;
+}
+
+bool NoCrateFilterNode::matchRow(const TrackColumnTable& table, int row) const {
+    return matchTrackId(table.trackIdOfRow(row));
+}
+
+bool NoCrateFilterNode::matchTrackId(TrackId trackId) const {
     if (!m_matchInitialized) {
         TrackSelectResult tracks(
                 m_pCrateStorage->selectAllTracksSorted());
@@ -269,7 +462,7 @@ bool NoCrateFilterNode::match(const TrackPointer& pTrack) const {
         m_matchInitialized = true;
     }
 
-    return !std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
+    return !std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), trackId);
 }
 
 QString NoCrateFilterNode::toSql() const {
@@ -341,23 +534,24 @@ bool NumericFilterNode::match(const TrackPointer& pTrack) const {
             continue;
         }
 
-        double dValue = value.toDouble();
-        if (m_bOperatorQuery) {
-            if ((m_operator == "=" && dValue == m_dOperatorArgument) ||
-                    (m_operator == "<" && dValue < m_dOperatorArgument) ||
-                    (m_operator == ">" && dValue > m_dOperatorArgument) ||
-                    (m_operator == "<=" && dValue <= m_dOperatorArgument) ||
-                    (m_operator == ">=" && dValue >= m_dOperatorArgument)) {
-                return true;
-            }
-        } else if (m_bRangeQuery && dValue >= m_dRangeLow &&
-                dValue <= m_dRangeHigh) {
+        if (matchValue(value.toDouble())) {
             return true;
         }
     }
     return false;
 }
 
+bool NumericFilterNode::matchValue(double dValue) const {
+    if (m_bOperatorQuery) {
+        return (m_operator == "=" && dValue == m_dOperatorArgument) ||
+                (m_operator == "<" && dValue < m_dOperatorArgument) ||
+                (m_operator == ">" && dValue > m_dOperatorArgument) ||
+                (m_operator == "<=" && dValue <= m_dOperatorArgument) ||
+                (m_operator == ">=" && dValue >= m_dOperatorArgument);
+    }
+    return m_bRangeQuery && dValue >= m_dRangeLow && dValue <= m_dRangeHigh;
+}
+
 QString NumericFilterNode::toSql() const {
     if (m_bNullQuery) {
         for (const auto& sqlColumn : m_sqlColumns) {
@@ -393,6 +587,32 @@ QString NumericFilterNode::toSql() const {
     return QString();
 }
 
+bool NumericFilterNode::bindColumns(const ColumnResolver& resolveColumn) {
+    if (!m_bNullQuery && !m_bOperatorQuery && !m_bRangeQuery) {
+        // No SQL is generated for invalid arguments, see toSql()
+        return false;
+    }
+    return !m_sqlColumns.isEmpty() &&
+            resolveColumns(m_sqlColumns, resolveColumn, &m_columns);
+}
+
+bool NumericFilterNode::matchRow(const TrackColumnTable& table, int row) const {
+    if (m_bNullQuery) {
+        // Only the major column, see toSql()
+        return table.valueClass(row, m_columns.front()) ==
+                TrackColumnTable::ValueClass::Null;
+    }
+    for (const auto column : m_columns) {
+        if (table.valueClass(row, column) == TrackColumnTable::ValueClass::Null) {
+            continue;
+        }
+        if (matchValue(table.doubleValue(row, column))) {
+            return true;
+        }
+    }
+    return false;
+}
+
 NullNumericFilterNode::NullNumericFilterNode(const QStringList& sqlColumns)
         : m_sqlColumns(sqlColumns) {
 }
@@ -416,6 +636,18 @@ QString NullNumericFilterNode::toSql() const {
     return QString();
 }
 
+bool NullNumericFilterNode::bindColumns(const ColumnResolver& resolveColumn) {
+    if (m_sqlColumns.isEmpty()) {
+        return false;
+    }
+    m_column = resolveColumn(m_sqlColumns.first());
+    return m_column >= 0;
+}
+
+bool NullNumericFilterNode::matchRow(const TrackColumnTable& table, int row) const {
+    return table.valueClass(row, m_column) == TrackColumnTable::ValueClass::Null;
+}
+
 DurationFilterNode::DurationFilterNode(
         const QStringList& sqlColumns, const QString& argument)
         : NumericFilterNode(sqlColumns) {
@@ -473,3 +705,20 @@ QString KeyFilterNode::toSql() const {
     }
     return concatSqlClauses(searchClauses, "OR");
 }
+
+bool KeyFilterNode::bindColumns(const ColumnResolver& resolveColumn) {
+    if (m_matchKeys.isEmpty()) {
+        return false;
+    }
+    m_keyIdColumn = resolveColumn(LIBRARYTABLE_KEY_ID);
+    return m_keyIdColumn >= 0;
+}
+
+bool KeyFilterNode::matchRow(const TrackColumnTable& table, int row) const {
+    if (table.valueClass(row, m_keyIdColumn) != TrackColumnTable::ValueClass::Number) {
+        return false;
+    }
+    const auto key = static_cast<mixxx::track::io::key::ChromaticKey>(
+            static_cast<int>(table.doubleValue(row, m_keyIdColumn)));
+    return m_matchKeys.contains(key);
+}
@@ -5,6 +5,8 @@
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
+#include <functional>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -14,6 +16,9 @@
 #include "util/assert.h"
 #include "util/memory.h"
 
+class TrackColumnTable;
+class TrackSearchIndex;
+
 const QString kMissingFieldSearchTerm = "\"\""; // "" searches for an empty string
 
 QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& column);
@@ -26,6 +31,20 @@ class QueryNode {
     virtual bool match(const TrackPointer& pTrack) const = 0;
     virtual QString toSql() const = 0;
 
+    /// Maps the name of an SQL column to a column of a TrackColumnTable,
+    /// or -1 if the column is not available.
+    using ColumnResolver = std::function<int(const QString&)>;
+
+    /// Prepares the evaluation with matchRow(). Returns false if the node
+    /// can only be evaluated by the database with toSql(), e.g. because it
+    /// refers to columns that are not available in memory.
+    virtual bool bindColumns(const ColumnResolver& resolveColumn);
+
+    /// Evaluates the node for a row of cached values like the database
+    /// would evaluate the SQL of toSql(). Requires that bindColumns() has
+    /// returned true.
+    virtual bool matchRow(const TrackColumnTable& table, int row) const;
+
   protected:
     QueryNode() = default;
 
@@ -39,6 +58,8 @@ class GroupNode : public QueryNode {
         m_nodes.push_back(std::move(pNode));
     }
 
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+
   protected:
     // NOTE(uklotzde): std::vector is more suitable (efficiency)
     // than a QList for a private member. And QList from Qt 4
@@ -50,12 +71,14 @@ class OrNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 };
 
 class AndNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 };
 
 class NotNode : public QueryNode {
@@ -67,6 +90,8 @@ class NotNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
   private:
     std::unique_ptr<QueryNode> m_pNode;
@@ -74,17 +99,28 @@ class NotNode : public QueryNode {
 
 class TextFilterNode : public QueryNode {
   public:
+    /// The optional search index is used to restrict the SQL
+    /// query to the tracks that might contain the argument.
     TextFilterNode(const QSqlDatabase& database,
             const QStringList& sqlColumns,
-            const QString& argument);
+            const QString& argument,
+            const TrackSearchIndex* pSearchIndex = nullptr);
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
   private:
     QSqlDatabase m_database;
     QStringList m_sqlColumns;
     QString m_argument;
+    const TrackSearchIndex* m_pSearchIndex;
+    std::vector<int> m_columns;
+    // The location column stores native separators in memory
+    int m_locationColumn;
+    // Sorted superset of the matching tracks from the search index
+    std::optional<std::vector<TrackId>> m_candidates;
 };
 
 class NullOrEmptyTextFilterNode : public QueryNode {
@@ -97,10 +133,13 @@ class NullOrEmptyTextFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
   private:
     QSqlDatabase m_database;
     QStringList m_sqlColumns;
+    int m_column = -1;
 };
 
 class CrateFilterNode : public QueryNode {
@@ -110,8 +149,12 @@ class CrateFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
   private:
+    bool matchTrackId(TrackId trackId) const;
+
     const CrateStorage* m_pCrateStorage;
     QString m_crateNameLike;
     mutable bool m_matchInitialized;
@@ -124,8 +167,12 @@ class NoCrateFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
   private:
+    bool matchTrackId(TrackId trackId) const;
+
     const CrateStorage* m_pCrateStorage;
     QString m_crateNameLike;
     mutable bool m_matchInitialized;
@@ -138,6 +185,8 @@ class NumericFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
   protected:
     // Single argument constructor for that does not call init()
@@ -152,7 +201,10 @@ class NumericFilterNode : public QueryNode {
   private:
     virtual double parse(const QString& arg, bool* ok);
 
+    bool matchValue(double value) const;
+
     QStringList m_sqlColumns;
+    std::vector<int> m_columns;
     bool m_bOperatorQuery;
     bool m_bNullQuery;
     QString m_operator;
@@ -168,8 +220,13 @@ class NullNumericFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
     QStringList m_sqlColumns;
+
+  private:
+    int m_column = -1;
 };
 
 class DurationFilterNode : public NumericFilterNode {
@@ -186,9 +243,12 @@ class KeyFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool bindColumns(const ColumnResolver& resolveColumn) override;
+    bool matchRow(const TrackColumnTable& table, int row) const override;
 
   private:
     QList<mixxx::track::io::key::ChromaticKey> m_matchKeys;
+    int m_keyIdColumn = -1;
 };
 
 class SqlNode : public QueryNode {
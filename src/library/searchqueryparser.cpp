@@ -1,6 +1,7 @@
 #include "library/searchqueryparser.h"
 
 #include <QRegularExpression>
+#include <algorithm>
 
 #include "track/keyutils.h"
 
@@ -123,7 +124,8 @@ QString SearchQueryParser::getTextArgument(QString argument,
 
 void SearchQueryParser::parseTokens(QStringList tokens,
                                     QStringList searchColumns,
-                                    AndNode* pQuery) const {
+                                    AndNode* pQuery,
+                                    const TrackSearchIndex* pSearchIndex) const {
     // we need to create a filtered columns list that are handled differently
     auto queryColumns = QStringList();
     queryColumns.reserve(searchColumns.count());
@@ -174,7 +176,9 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                 } else {
                     pNode = std::make_unique<TextFilterNode>(
                             m_pTrackCollection->database(),
-                            m_fieldToSqlColumns[field], argument);
+                            m_fieldToSqlColumns[field],
+                            argument,
+                            pSearchIndex);
                 }
             }
         } else if (numericFilterMatch.hasMatch()) {
@@ -208,7 +212,10 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                                     m_pTrackCollection->database(), m_fieldToSqlColumns[field]);
                         } else {
                             pNode = std::make_unique<TextFilterNode>(
-                                    m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument);
+                                    m_pTrackCollection->database(),
+                                    m_fieldToSqlColumns[field],
+                                    argument,
+                                    pSearchIndex);
                         }
                     } else {
                         pNode = std::make_unique<KeyFilterNode>(key, fuzzy);
@@ -242,12 +249,18 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                     gNode->addNode(std::make_unique<CrateFilterNode>(
                                     &m_pTrackCollection->crates(), argument));
                     gNode->addNode(std::make_unique<TextFilterNode>(
-                                    m_pTrackCollection->database(), queryColumns, argument));
+                                    m_pTrackCollection->database(),
+                                    queryColumns,
+                                    argument,
+                                    pSearchIndex));
 
                     pNode = std::move(gNode);
                 } else {
                     pNode = std::make_unique<TextFilterNode>(
-                             m_pTrackCollection->database(), queryColumns, argument);
+                             m_pTrackCollection->database(),
+                             queryColumns,
+                             argument,
+                             pSearchIndex);
                 }
             }
         }
@@ -262,7 +275,8 @@ void SearchQueryParser::parseTokens(QStringList tokens,
 
 std::unique_ptr<QueryNode> SearchQueryParser::parseQuery(const QString& query,
                                          const QStringList& searchColumns,
-                                         const QString& extraFilter) const {
+                                         const QString& extraFilter,
+                                         const TrackSearchIndex* pSearchIndex) const {
     auto pQuery(std::make_unique<AndNode>());
 
     if (!extraFilter.isEmpty()) {
@@ -271,7 +285,7 @@ std::unique_ptr<QueryNode> SearchQueryParser::parseQuery(const QString& query,
 
     if (!query.isEmpty()) {
         QStringList tokens = query.split(" ");
-        parseTokens(tokens, searchColumns, pQuery.get());
+        parseTokens(tokens, searchColumns, pQuery.get(), pSearchIndex);
     }
 
     return pQuery;
@@ -321,3 +335,54 @@ bool SearchQueryParser::queryIsLessSpecific(const QString& original, const QStri
     }
     return false;
 }
+
+namespace {
+
+/// A plain search term is matched as a substring against the text
+/// columns, see TextFilterNode. Terms with a prefix, a filter field
+/// or quotes are handled differently.
+bool isPlainSearchTerm(const QString& word) {
+    return !word.startsWith(kNegatePrefix) &&
+            !word.startsWith(kFuzzyPrefix) &&
+            !word.contains(':') &&
+            !word.contains('"');
+}
+
+} // anonymous namespace
+
+bool SearchQueryParser::queryIsMoreSpecific(const QString& original, const QString& changed) {
+    const QStringList oldWordList = SearchQueryParser::splitQueryIntoWords(original);
+    const QStringList newWordList = SearchQueryParser::splitQueryIntoWords(changed);
+
+    // The argument of a filter might be separated from the field by a space,
+    // e.g. "artist: abc". Such an argument must not be mistaken for a plain
+    // search term.
+    const auto hasDetachedArgument = [](const QString& word) {
+        return word.endsWith(':');
+    };
+    if (std::any_of(oldWordList.begin(), oldWordList.end(), hasDetachedArgument) ||
+            std::any_of(newWordList.begin(), newWordList.end(), hasDetachedArgument)) {
+        return false;
+    }
+
+    // All terms are combined with AND. Each term of the original query must
+    // be implied by at least one term of the changed query.
+    for (const QString& oldWord : oldWordList) {
+        bool implied = false;
+        for (const QString& newWord : newWordList) {
+            // A track that contains the longer term also contains each of
+            // its substrings
+            if (oldWord == newWord ||
+                    (isPlainSearchTerm(oldWord) &&
+                            isPlainSearchTerm(newWord) &&
+                            newWord.contains(oldWord))) {
+                implied = true;
+                break;
+            }
+        }
+        if (!implied) {
+            return false;
+        }
+    }
+    return true;
+}
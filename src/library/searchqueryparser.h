@@ -14,20 +14,29 @@ class SearchQueryParser {
 
     virtual ~SearchQueryParser();
 
+    /// The optional search index is used for speeding up
+    /// the SQL queries of text filters.
     std::unique_ptr<QueryNode> parseQuery(
             const QString& query,
             const QStringList& searchColumns,
-            const QString& extraFilter) const;
+            const QString& extraFilter,
+            const TrackSearchIndex* pSearchIndex = nullptr) const;
 
     /// splits the query into a list of terms
     static QStringList splitQueryIntoWords(const QString& query);
     /// checks if the changed search query is less specific then the original term
     static bool queryIsLessSpecific(const QString& original, const QString& changed);
+    /// checks if all tracks matching the changed search query are guaranteed
+    /// to match the original query, i.e. if the changed query only refines
+    /// the original query. This is a conservative check that may return
+    /// false negatives.
+    static bool queryIsMoreSpecific(const QString& original, const QString& changed);
 
   private:
     void parseTokens(QStringList tokens,
                      QStringList searchColumns,
-                     AndNode* pQuery) const;
+                     AndNode* pQuery,
+                     const TrackSearchIndex* pSearchIndex) const;
 
     QString getTextArgument(QString argument,
                             QStringList* tokens) const;
@@ -569,6 +569,12 @@ TrackPointer TrackCollectionManager::getTrackById(
             trackId);
 }
 
+QList<TrackPointer> TrackCollectionManager::getTracksByIds(
+        const QList<TrackId>& trackIds) const {
+    return internalCollection()->getTracksByIds(
+            trackIds);
+}
+
 TrackPointer TrackCollectionManager::getTrackByRef(
         const TrackRef& trackRef) const {
     return internalCollection()->getTrackByRef(
@@ -49,6 +49,10 @@ class TrackCollectionManager: public QObject,
 
     TrackPointer getTrackById(
             TrackId trackId) const;
+    /// Loads multiple tracks at once, which is much faster than loading
+    /// them one by one. Tracks that could not be loaded are skipped.
+    QList<TrackPointer> getTracksByIds(
+            const QList<TrackId>& trackIds) const;
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
     QList<TrackId> resolveTrackIdsFromUrls(
@@ -0,0 +1,297 @@
+#include "library/trackcolumntable.h"
+
+#include "util/assert.h"
+
+namespace {
+
+// The dense row index grows with the table. Track ids beyond this
+// distance from the current row capacity are kept in a hash instead.
+constexpr int kMinDenseRowIndexSize = 1024;
+
+QVariant nullStringVariant() {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return QVariant(QMetaType(QMetaType::QString));
+#else
+    return QVariant(QVariant::String);
+#endif
+}
+
+} // anonymous namespace
+
+quint32 TrackColumnTable::StringDictionary::acquire(const QString& string) {
+    const auto it = m_codes.constFind(string);
+    if (it != m_codes.constEnd()) {
+        ++m_refCounts[it.value()];
+        return it.value();
+    }
+    quint32 code;
+    if (m_freeCodes.empty()) {
+        code = static_cast<quint32>(m_strings.size());
+        m_strings.push_back(string);
+        m_refCounts.push_back(1);
+    } else {
+        code = m_freeCodes.back();
+        m_freeCodes.pop_back();
+        m_strings[code] = string;
+        m_refCounts[code] = 1;
+    }
+    m_codes.insert(string, code);
+    return code;
+}
+
+void TrackColumnTable::StringDictionary::release(quint32 code) {
+    DEBUG_ASSERT(code < m_refCounts.size());
+    DEBUG_ASSERT(m_refCounts[code] > 0);
+    if (--m_refCounts[code] > 0) {
+        return;
+    }
+    m_codes.remove(m_strings[code]);
+    m_strings[code] = QString();
+    m_freeCodes.push_back(code);
+}
+
+void TrackColumnTable::StringDictionary::clear() {
+    m_codes.clear();
+    m_strings.clear();
+    m_refCounts.clear();
+    m_freeCodes.clear();
+}
+
+TrackColumnTable::TrackColumnTable(int numColumns)
+        : m_columns(numColumns),
+          m_rowCount(0) {
+}
+
+void TrackColumnTable::setDictionaryEncoded(int column) {
+    VERIFY_OR_DEBUG_ASSERT(column >= 0 && column < columnCount()) {
+        return;
+    }
+    DEBUG_ASSERT(m_trackIds.empty());
+    m_columns[column].dictionaryEncoded = true;
+}
+
+void TrackColumnTable::clear() {
+    for (auto& column : m_columns) {
+        column.types.clear();
+        column.numbers.clear();
+        column.strings.clear();
+        column.codes.clear();
+        column.dictionary.clear();
+        column.otherValues.clear();
+    }
+    m_trackIds.clear();
+    m_freeRows.clear();
+    m_rowCount = 0;
+    m_denseRowIndex.clear();
+    m_sparseRowIndex.clear();
+}
+
+int TrackColumnTable::findRow(TrackId trackId) const {
+    if (!trackId.isValid()) {
+        return -1;
+    }
+    const auto value = static_cast<std::size_t>(trackId.value());
+    if (value < m_denseRowIndex.size() && m_denseRowIndex[value] >= 0) {
+        return m_denseRowIndex[value];
+    }
+    return m_sparseRowIndex.value(trackId, -1);
+}
+
+void TrackColumnTable::setRowIndex(TrackId trackId, int row) {
+    const int value = trackId.value();
+    if (value < 2 * rowCapacity() + kMinDenseRowIndexSize) {
+        if (static_cast<std::size_t>(value) >= m_denseRowIndex.size()) {
+            m_denseRowIndex.resize(value + 1, -1);
+        }
+        m_denseRowIndex[value] = row;
+    } else {
+        m_sparseRowIndex.insert(trackId, row);
+    }
+}
+
+int TrackColumnTable::insertRow(TrackId trackId) {
+    if (!trackId.isValid()) {
+        return -1;
+    }
+    int row = findRow(trackId);
+    if (row >= 0) {
+        return row;
+    }
+    if (m_freeRows.empty()) {
+        row = rowCapacity();
+        m_trackIds.push_back(trackId);
+        for (auto& column : m_columns) {
+            column.types.push_back(CellType::Invalid);
+        }
+    } else {
+        row = m_freeRows.back();
+        m_freeRows.pop_back();
+        m_trackIds[row] = trackId;
+    }
+    ++m_rowCount;
+    setRowIndex(trackId, row);
+    return row;
+}
+
+bool TrackColumnTable::removeRow(TrackId trackId) {
+    const int row = findRow(trackId);
+    if (row < 0) {
+        return false;
+    }
+    for (auto& column : m_columns) {
+        clearCell(&column, row);
+    }
+    const auto value = static_cast<std::size_t>(trackId.value());
+    if (value < m_denseRowIndex.size() && m_denseRowIndex[value] == row) {
+        m_denseRowIndex[value] = -1;
+    } else {
+        m_sparseRowIndex.remove(trackId);
+    }
+    m_trackIds[row] = TrackId();
+    m_freeRows.push_back(row);
+    --m_rowCount;
+    return true;
+}
+
+void TrackColumnTable::clearCell(Column* pColumn, int row) {
+    switch (pColumn->types[row]) {
+    case CellType::String:
+        if (pColumn->dictionaryEncoded) {
+            pColumn->dictionary.release(pColumn->codes[row]);
+        } else {
+            pColumn->strings[row] = QString();
+        }
+        break;
+    case CellType::Other:
+        pColumn->otherValues.remove(row);
+        break;
+    default:
+        break;
+    }
+    pColumn->types[row] = CellType::Invalid;
+}
+
+void TrackColumnTable::setValue(int row, int column, const QVariant& value) {
+    VERIFY_OR_DEBUG_ASSERT(row >= 0 && row < rowCapacity() &&
+            column >= 0 && column < columnCount()) {
+        return;
+    }
+    DEBUG_ASSERT(m_trackIds[row].isValid());
+    Column* pColumn = &m_columns[column];
+    clearCell(pColumn, row);
+    if (!value.isValid()) {
+        return;
+    }
+    const auto ensureNumbers = [this, pColumn] {
+        if (pColumn->numbers.size() < m_trackIds.size()) {
+            pColumn->numbers.resize(m_trackIds.size());
+        }
+    };
+    switch (value.userType()) {
+    case QMetaType::QString:
+        if (value.isNull()) {
+            pColumn->types[row] = CellType::NullString;
+        } else if (pColumn->dictionaryEncoded) {
+            if (pColumn->codes.size() < m_trackIds.size()) {
+                pColumn->codes.resize(m_trackIds.size());
+            }
+            pColumn->codes[row] = pColumn->dictionary.acquire(value.toString());
+            pColumn->types[row] = CellType::String;
+        } else {
+            if (pColumn->strings.size() < m_trackIds.size()) {
+                pColumn->strings.resize(m_trackIds.size());
+            }
+            pColumn->strings[row] = value.toString();
+            pColumn->types[row] = CellType::String;
+        }
+        return;
+    case QMetaType::Bool:
+        ensureNumbers();
+        pColumn->numbers[row].integer = value.toBool() ? 1 : 0;
+        pColumn->types[row] = CellType::Bool;
+        return;
+    case QMetaType::Int:
+        ensureNumbers();
+        pColumn->numbers[row].integer = value.toInt();
+        pColumn->types[row] = CellType::Int;
+        return;
+    case QMetaType::LongLong:
+        ensureNumbers();
+        pColumn->numbers[row].integer = value.toLongLong();
+        pColumn->types[row] = CellType::LongLong;
+        return;
+    case QMetaType::Double:
+        ensureNumbers();
+        pColumn->numbers[row].real = value.toDouble();
+        pColumn->types[row] = CellType::Double;
+        return;
+    default:
+        pColumn->otherValues.insert(row, value);
+        pColumn->types[row] = CellType::Other;
+        return;
+    }
+}
+
+QVariant TrackColumnTable::value(int row, int column) const {
+    VERIFY_OR_DEBUG_ASSERT(row >= 0 && row < rowCapacity() &&
+            column >= 0 && column < columnCount()) {
+        return QVariant();
+    }
+    const Column& col = m_columns[column];
+    switch (col.types[row]) {
+    case CellType::Invalid:
+        return QVariant();
+    case CellType::NullString:
+        return nullStringVariant();
+    case CellType::String:
+        if (col.dictionaryEncoded) {
+            return QVariant(col.dictionary.string(col.codes[row]));
+        }
+        return QVariant(col.strings[row]);
+    case CellType::Bool:
+        return QVariant(col.numbers[row].integer != 0);
+    case CellType::Int:
+        return QVariant(static_cast<int>(col.numbers[row].integer));
+    case CellType::LongLong:
+        return QVariant(col.numbers[row].integer);
+    case CellType::Double:
+        return QVariant(col.numbers[row].real);
+    case CellType::Other:
+        return col.otherValues.value(row);
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QVariant();
+}
+
+QString TrackColumnTable::stringValue(int row, int column) const {
+    DEBUG_ASSERT(row >= 0 && row < rowCapacity());
+    DEBUG_ASSERT(column >= 0 && column < columnCount());
+    const Column& col = m_columns[column];
+    if (col.types[row] != CellType::String) {
+        return QString();
+    }
+    if (col.dictionaryEncoded) {
+        return col.dictionary.string(col.codes[row]);
+    }
+    return col.strings[row];
+}
+
+double TrackColumnTable::doubleValue(int row, int column) const {
+    DEBUG_ASSERT(row >= 0 && row < rowCapacity());
+    DEBUG_ASSERT(column >= 0 && column < columnCount());
+    const Column& col = m_columns[column];
+    switch (col.types[row]) {
+    case CellType::Bool:
+    case CellType::Int:
+    case CellType::LongLong:
+        return static_cast<double>(col.numbers[row].integer);
+    case CellType::Double:
+        return col.numbers[row].real;
+    case CellType::String:
+        return stringValue(row, column).toDouble();
+    case CellType::Other:
+        return col.otherValues.value(row).toDouble();
+    default:
+        return 0.0;
+    }
+}
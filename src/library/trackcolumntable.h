@@ -0,0 +1,169 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <vector>
+
+#include "track/trackid.h"
+#include "util/assert.h"
+
+/// TrackColumnTable is a column-oriented, typed in-memory table of track
+/// properties that are addressed by row and column index. It replaces a
+/// hash of QVector<QVariant> records, which needed a separate heap
+/// allocation per row and a QVariant per cell.
+///
+/// Each cell is stored as a 1-byte type tag with its payload kept in
+/// contiguous per-column arrays: integers and floating point numbers in a
+/// single 8-byte array and strings either in a plain array or, for columns
+/// with many duplicate values like artist, album or genre, as 32-bit codes
+/// into a reference counted dictionary. The payload arrays are only
+/// allocated for columns that actually contain values of the corresponding
+/// kind. The rare values of other types (e.g. QDateTime) are kept as
+/// QVariant in a side table of the column.
+///
+/// value() returns a QVariant with the same type and contents as the one
+/// that has been passed to setValue().
+///
+/// Rows are looked up by TrackId through a dense array that is indexed by
+/// the id value, falling back to a hash for ids that are far beyond the
+/// size of the table. Removed rows are recycled.
+class TrackColumnTable final {
+  public:
+    explicit TrackColumnTable(int numColumns);
+
+    /// Enables dictionary encoding of string values for the given column.
+    /// Must be called before inserting any rows.
+    void setDictionaryEncoded(int column);
+
+    int columnCount() const {
+        return static_cast<int>(m_columns.size());
+    }
+
+    /// The number of rows that are currently occupied by tracks.
+    int rowCount() const {
+        return m_rowCount;
+    }
+
+    bool isEmpty() const {
+        return m_rowCount == 0;
+    }
+
+    void clear();
+
+    /// Returns the row of the given track or -1 if it is not contained.
+    int findRow(TrackId trackId) const;
+
+    bool contains(TrackId trackId) const {
+        return findRow(trackId) >= 0;
+    }
+
+    /// Returns the row of the given track, inserting a new empty row
+    /// if the track is not contained yet. Returns -1 for invalid ids.
+    int insertRow(TrackId trackId);
+
+    /// Returns false if the track was not contained.
+    bool removeRow(TrackId trackId);
+
+    /// Invalid for rows that are not occupied.
+    TrackId trackIdOfRow(int row) const {
+        return m_trackIds[row];
+    }
+
+    /// The upper bound of all row indices, including unoccupied rows.
+    int rowCapacity() const {
+        return static_cast<int>(m_trackIds.size());
+    }
+
+    QVariant value(int row, int column) const;
+    void setValue(int row, int column, const QVariant& value);
+
+    /// Provides typed access to string cells without the construction of
+    /// an intermediate QVariant. Returns a null string for other cells.
+    QString stringValue(int row, int column) const;
+
+    /// Provides typed access to numeric cells without the construction of
+    /// an intermediate QVariant, with the same result as QVariant::toDouble().
+    double doubleValue(int row, int column) const;
+
+    /// The storage class of a cell like in SQLite, which orders values
+    /// of different classes as Null < Number < String < Other.
+    enum class ValueClass : quint8 {
+        Null,
+        Number,
+        String,
+        Other,
+    };
+
+    ValueClass valueClass(int row, int column) const {
+        DEBUG_ASSERT(row >= 0 && row < rowCapacity());
+        DEBUG_ASSERT(column >= 0 && column < columnCount());
+        switch (m_columns[column].types[row]) {
+        case CellType::Invalid:
+        case CellType::NullString:
+            return ValueClass::Null;
+        case CellType::String:
+            return ValueClass::String;
+        case CellType::Other:
+            return ValueClass::Other;
+        default:
+            return ValueClass::Number;
+        }
+    }
+
+  private:
+    enum class CellType : quint8 {
+        Invalid,
+        NullString,
+        String,
+        Bool,
+        Int,
+        LongLong,
+        Double,
+        Other,
+    };
+
+    union Number {
+        qint64 integer;
+        double real;
+    };
+
+    class StringDictionary {
+      public:
+        quint32 acquire(const QString& string);
+        void release(quint32 code);
+        const QString& string(quint32 code) const {
+            return m_strings[code];
+        }
+        void clear();
+
+      private:
+        QHash<QString, quint32> m_codes;
+        std::vector<QString> m_strings;
+        std::vector<quint32> m_refCounts;
+        std::vector<quint32> m_freeCodes;
+    };
+
+    struct Column {
+        bool dictionaryEncoded = false;
+        std::vector<CellType> types;
+        // The following arrays are allocated on demand
+        std::vector<Number> numbers;
+        std::vector<QString> strings;
+        std::vector<quint32> codes;
+        StringDictionary dictionary;
+        QHash<int, QVariant> otherValues;
+    };
+
+    void clearCell(Column* pColumn, int row);
+    void setRowIndex(TrackId trackId, int row);
+
+    std::vector<Column> m_columns;
+    std::vector<TrackId> m_trackIds;
+    std::vector<int> m_freeRows;
+    int m_rowCount;
+
+    // Rows indexed by TrackId::value(), -1 for absent tracks
+    std::vector<int> m_denseRowIndex;
+    QHash<TrackId, int> m_sparseRowIndex;
+};
@@ -0,0 +1,151 @@
+#include "library/tracksearchindex.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "util/assert.h"
+#include "util/db/dbconnection.h"
+#include "util/db/sqllikewildcards.h"
+
+namespace {
+
+constexpr int kTrigramLength = 3;
+
+// Scanning all tracks is more efficient than passing the ids of more
+// than this fraction of all tracks to SQLite
+constexpr int kMaxCandidatesDivisor = 8;
+
+inline quint64 trigramAt(const QString& text, int pos) {
+    return (static_cast<quint64>(text.at(pos).unicode()) << 32) |
+            (static_cast<quint64>(text.at(pos + 1).unicode()) << 16) |
+            static_cast<quint64>(text.at(pos + 2).unicode());
+}
+
+} // anonymous namespace
+
+TrackSearchIndex::TrackSearchIndex(const QString& idColumn, const QStringList& columns)
+        : m_idColumn(idColumn),
+          m_columns(columns),
+          m_numIndexedTracks(0) {
+}
+
+bool TrackSearchIndex::coversColumns(const QStringList& columns) const {
+    for (const auto& column : columns) {
+        if (!m_columns.contains(column)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TrackSearchIndex::clear() {
+    m_postingLists.clear();
+    m_uncommittedTrigrams.clear();
+    m_indexedTracks.clear();
+    m_numIndexedTracks = 0;
+}
+
+void TrackSearchIndex::addText(TrackId trackId, QString text) {
+    VERIFY_OR_DEBUG_ASSERT(trackId.isValid()) {
+        return;
+    }
+    const auto value = trackId.value();
+    if (static_cast<std::size_t>(value) >= m_indexedTracks.size()) {
+        m_indexedTracks.resize(value + 1);
+    }
+    if (!m_indexedTracks[value]) {
+        m_indexedTracks[value] = true;
+        ++m_numIndexedTracks;
+    }
+
+    mixxx::DbConnection::makeStringLatinLow(&text);
+    for (int pos = 0; pos + kTrigramLength <= text.size(); ++pos) {
+        const quint64 trigram = trigramAt(text, pos);
+        PostingList& postingList = m_postingLists[trigram];
+        if (!postingList.trackIds.empty() && postingList.trackIds.back() == value) {
+            // Repeated trigram of the same track
+            continue;
+        }
+        const bool sorted = postingList.sortedSize == postingList.trackIds.size();
+        if (sorted &&
+                (postingList.trackIds.empty() || postingList.trackIds.back() < value)) {
+            // Tracks are usually added in ascending order and new tracks
+            // get the highest id, so the list stays sorted without a commit
+            postingList.trackIds.push_back(value);
+            postingList.sortedSize = postingList.trackIds.size();
+            continue;
+        }
+        if (sorted) {
+            m_uncommittedTrigrams.push_back(trigram);
+        }
+        postingList.trackIds.push_back(value);
+    }
+}
+
+void TrackSearchIndex::commit() {
+    for (const auto trigram : m_uncommittedTrigrams) {
+        PostingList& postingList = m_postingLists[trigram];
+        auto& trackIds = postingList.trackIds;
+        const auto sortedEnd = trackIds.begin() + postingList.sortedSize;
+        std::sort(sortedEnd, trackIds.end());
+        std::inplace_merge(trackIds.begin(), sortedEnd, trackIds.end());
+        trackIds.erase(std::unique(trackIds.begin(), trackIds.end()), trackIds.end());
+        postingList.sortedSize = trackIds.size();
+    }
+    m_uncommittedTrigrams.clear();
+}
+
+std::optional<std::vector<TrackId>> TrackSearchIndex::findCandidates(
+        const QString& term) const {
+    DEBUG_ASSERT(m_uncommittedTrigrams.empty());
+    if (term.size() < kTrigramLength ||
+            term.contains(kSqlLikeMatchAll) ||
+            term.contains(kSqlLikeMatchOne)) {
+        return std::nullopt;
+    }
+
+    std::vector<const std::vector<TrackId::value_type>*> postingLists;
+    postingLists.reserve(term.size() - kTrigramLength + 1);
+    for (int pos = 0; pos + kTrigramLength <= term.size(); ++pos) {
+        const auto it = m_postingLists.constFind(trigramAt(term, pos));
+        if (it == m_postingLists.constEnd()) {
+            // No track contains this trigram
+            return std::vector<TrackId>();
+        }
+        postingLists.push_back(&it.value().trackIds);
+    }
+    // Start with the most selective trigram to keep the
+    // intermediate results small
+    std::sort(postingLists.begin(),
+            postingLists.end(),
+            [](const auto* lhs, const auto* rhs) {
+                return lhs->size() < rhs->size();
+            });
+    postingLists.erase(std::unique(postingLists.begin(), postingLists.end()),
+            postingLists.end());
+
+    const auto maxCandidates = static_cast<std::size_t>(
+            m_numIndexedTracks / kMaxCandidatesDivisor);
+    if (postingLists.front()->size() > maxCandidates) {
+        return std::nullopt;
+    }
+
+    std::vector<TrackId::value_type> candidates = *postingLists.front();
+    std::vector<TrackId::value_type> intersection;
+    for (std::size_t i = 1; i < postingLists.size() && !candidates.empty(); ++i) {
+        intersection.clear();
+        std::set_intersection(candidates.begin(),
+                candidates.end(),
+                postingLists[i]->begin(),
+                postingLists[i]->end(),
+                std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    std::vector<TrackId> result;
+    result.reserve(candidates.size());
+    for (const auto value : candidates) {
+        result.emplace_back(value);
+    }
+    return result;
+}
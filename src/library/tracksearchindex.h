@@ -0,0 +1,83 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <optional>
+#include <vector>
+
+#include "track/trackid.h"
+
+/// TrackSearchIndex is an in-memory trigram index of the text columns of
+/// a BaseTrackCache. It is used to narrow down the tracks that need to be
+/// matched against a plain text search term with SQL LIKE, which otherwise
+/// requires a full scan of all text columns of the library for each term.
+///
+/// The index stores the sorted ids of all tracks that contain a trigram for
+/// each trigram that occurs in any of the indexed columns. All strings are
+/// converted with DbConnection::makeStringLatinLow() before indexing, i.e.
+/// exactly like the custom LIKE operator does.
+///
+/// The candidates returned for a term are a superset of the actual matches:
+/// Trigrams of different columns are not distinguished and trigrams of
+/// previous values of modified tracks are not removed until the index is
+/// rebuilt. The results must always be verified, e.g. by combining the
+/// candidates with the original LIKE clause.
+class TrackSearchIndex final {
+  public:
+    /// Only columns with a single text value per track must be indexed,
+    /// i.e. columns that are matched by TextFilterNode. The id column is
+    /// needed for restricting SQL queries to the candidates.
+    TrackSearchIndex(const QString& idColumn, const QStringList& columns);
+
+    const QString& idColumn() const {
+        return m_idColumn;
+    }
+
+    const QStringList& columns() const {
+        return m_columns;
+    }
+
+    /// Checks if all text of the given columns is indexed.
+    bool coversColumns(const QStringList& columns) const;
+
+    void clear();
+
+    /// Adds the trigrams of a column value of a track.
+    void addText(TrackId trackId, QString text);
+
+    /// Sorts the tracks that have been added out of order since the last
+    /// commit. The costs are proportional to the size of the affected
+    /// posting lists, so commit once after a batch of updates. Must be
+    /// called before findCandidates().
+    void commit();
+
+    bool isCommitted() const {
+        return m_uncommittedTrigrams.empty();
+    }
+
+    /// Returns the candidates for a search term that has already been
+    /// converted with DbConnection::makeStringLatinLow(). Returns nothing
+    /// if the index cannot be used for this term, e.g. because it is too
+    /// short, contains LIKE wildcards or is too common to save anything
+    /// compared to a full scan.
+    std::optional<std::vector<TrackId>> findCandidates(const QString& term) const;
+
+  private:
+    struct PostingList {
+        // Only sorted up to sortedSize, the remaining ids are
+        // sorted and merged into the list on commit()
+        std::vector<TrackId::value_type> trackIds;
+        std::size_t sortedSize = 0;
+    };
+
+    const QString m_idColumn;
+    const QStringList m_columns;
+
+    QHash<quint64, PostingList> m_postingLists;
+    std::vector<quint64> m_uncommittedTrigrams;
+
+    // Indexed by TrackId::value()
+    std::vector<bool> m_indexedTracks;
+    int m_numIndexedTracks;
+};
@@ -632,11 +632,15 @@ void BasePlaylistFeature::slotExportTrackFiles() {
     pPlaylistTableModel->select();
 
     int rows = pPlaylistTableModel->rowCount();
-    TrackPointerList tracks;
+    QList<TrackId> trackIds;
+    trackIds.reserve(rows);
     for (int i = 0; i < rows; ++i) {
         QModelIndex index = pPlaylistTableModel->index(i, 0);
-        tracks.push_back(pPlaylistTableModel->getTrack(index));
+        trackIds.append(pPlaylistTableModel->getTrackId(index));
     }
+    // Load all tracks at once instead of one by one
+    const TrackPointerList tracks =
+            m_pLibrary->trackCollectionManager()->getTracksByIds(trackIds);
 
     TrackExportWizard track_export(nullptr, m_pConfig, tracks);
     track_export.exportTracks();
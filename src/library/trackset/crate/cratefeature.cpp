@@ -798,11 +798,15 @@ void CrateFeature::slotExportTrackFiles() {
     pCrateTableModel->select();
 
     int rows = pCrateTableModel->rowCount();
-    TrackPointerList trackpointers;
+    QList<TrackId> trackIds;
+    trackIds.reserve(rows);
     for (int i = 0; i < rows; ++i) {
         QModelIndex index = m_crateTableModel.index(i, 0);
-        trackpointers.push_back(m_crateTableModel.getTrack(index));
+        trackIds.append(m_crateTableModel.getTrackId(index));
     }
+    // Load all tracks at once instead of one by one
+    const TrackPointerList trackpointers =
+            m_pLibrary->trackCollectionManager()->getTracksByIds(trackIds);
 
     TrackExportWizard track_export(nullptr, m_pConfig, trackpointers);
     track_export.exportTracks();
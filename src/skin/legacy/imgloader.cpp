@@ -2,12 +2,22 @@
 #include <QFileInfo>
 
 #include "imgloader.h"
+#include "skin/legacy/skinimagecache.h"
 #include "widget/wwidget.h"
 
 ImgLoader::ImgLoader() {
 }
 
 QImage* ImgLoader::getImage(const QString& fileName, double scaleFactor) const {
+    const QImage preloadedImage = SkinImageCache::image(fileName, scaleFactor);
+    if (!preloadedImage.isNull()) {
+        return new QImage(preloadedImage);
+    }
+    return readImage(fileName, scaleFactor);
+}
+
+// static
+QImage* ImgLoader::readImage(const QString& fileName, double scaleFactor) {
     QImage* pImage = new QImage();
     QFileInfo info(fileName);
     if (scaleFactor > 2.0) {
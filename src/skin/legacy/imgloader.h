@@ -7,4 +7,8 @@ class ImgLoader : public ImgSource {
 public:
     ImgLoader();
     QImage* getImage(const QString &fileName, double scaleFactor) const override;
+
+    /// Decodes the image without looking it up in the SkinImageCache.
+    /// Can be called from any thread.
+    static QImage* readImage(const QString& fileName, double scaleFactor);
 };
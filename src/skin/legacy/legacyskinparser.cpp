@@ -6,6 +6,7 @@
 #include <QSplitter>
 #include <QStackedWidget>
 #include <QVBoxLayout>
+#include <QtConcurrentRun>
 #include <QtDebug>
 #include <QtGlobal>
 
@@ -24,6 +25,7 @@
 #include "skin/legacy/colorschemeparser.h"
 #include "skin/legacy/launchimage.h"
 #include "skin/legacy/skincontext.h"
+#include "skin/legacy/skinimagecache.h"
 #include "util/cmdlineargs.h"
 #include "util/timer.h"
 #include "util/valuetransformer.h"
@@ -100,6 +102,90 @@ QSet<QString> LegacySkinParser::s_sharedGroupStrings;
 
 static bool sDebug = false;
 
+namespace {
+
+const QString kSkinPathPrefix = QStringLiteral("skin:");
+const QString kSkinImageCacheDir = QStringLiteral("skincache/");
+
+/// The templates and images that are referenced by a skin document
+struct SkinResources {
+    QString templatePath;
+    QDomElement templateElement;
+    QStringList templatePaths;
+    QStringList imagePaths;
+};
+
+bool isImageFilePath(const QString& path) {
+    return path.endsWith(QStringLiteral(".svg"), Qt::CaseInsensitive) ||
+            path.endsWith(QStringLiteral(".png"), Qt::CaseInsensitive) ||
+            path.endsWith(QStringLiteral(".jpg"), Qt::CaseInsensitive);
+}
+
+/// Resolves a path like the "skin" search path that is set up by the
+/// SkinContext. Returns an empty string if the file does not exist.
+QString resolveSkinFilePath(const QString& path, const QStringList& searchDirs) {
+    QString relativePath = path;
+    if (relativePath.startsWith(kSkinPathPrefix)) {
+        relativePath.remove(0, kSkinPathPrefix.size());
+    } else if (relativePath.startsWith("/") || relativePath.contains(":")) {
+        QFileInfo fileInfo(relativePath);
+        return fileInfo.isFile() ? QDir::cleanPath(fileInfo.absoluteFilePath()) : QString();
+    }
+    for (const auto& searchDir : searchDirs) {
+        QFileInfo fileInfo(QDir(searchDir), relativePath);
+        if (fileInfo.isFile()) {
+            return QDir::cleanPath(fileInfo.absoluteFilePath());
+        }
+    }
+    return QString();
+}
+
+/// Collects the literal template and image paths. Paths that are
+/// composed of variables are only known when the widgets are created.
+void collectSkinResources(const QDomElement& element,
+        const QStringList& searchDirs,
+        SkinResources* pResources) {
+    if (element.tagName() == QLatin1String("Template")) {
+        const QString path = resolveSkinFilePath(element.attribute("src"), searchDirs);
+        if (!path.isEmpty()) {
+            pResources->templatePaths.append(path);
+        }
+    }
+    for (QDomNode child = element.firstChild(); !child.isNull();
+            child = child.nextSibling()) {
+        if (child.isElement()) {
+            collectSkinResources(child.toElement(), searchDirs, pResources);
+        } else if (child.isText()) {
+            const QString text = child.nodeValue().trimmed();
+            if (!isImageFilePath(text)) {
+                continue;
+            }
+            const QString path = resolveSkinFilePath(text, searchDirs);
+            if (!path.isEmpty()) {
+                pResources->imagePaths.append(path);
+            }
+        }
+    }
+}
+
+/// Parses a template file on a worker thread. Errors are reported
+/// by LegacySkinParser::loadTemplate() when the template is instantiated.
+SkinResources preparseTemplate(const QString& templatePath, const QString& skinBasePath) {
+    SkinResources resources;
+    resources.templatePath = templatePath;
+    QFile templateFile(templatePath);
+    QDomDocument tmpl("template");
+    if (!templateFile.open(QIODevice::ReadOnly) || !tmpl.setContent(&templateFile)) {
+        return resources;
+    }
+    resources.templateElement = tmpl.documentElement();
+    const QStringList searchDirs{skinBasePath, QFileInfo(templatePath).absolutePath()};
+    collectSkinResources(resources.templateElement, searchDirs, &resources);
+    return resources;
+}
+
+} // anonymous namespace
+
 ControlObject* LegacySkinParser::controlFromConfigKey(
         const ConfigKey& key, bool bPersist, bool* pCreated) {
     if (!key.isValid()) {
@@ -404,7 +490,11 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     // created parent so MixxxMainWindow can use it for various purposes
     // (fullscreen mostly) --bkgood
     m_pParent = pParent;
+    preloadSkinResources(skinDocument);
     QList<QWidget*> widgets = parseNode(skinDocument);
+    // The widgets keep their own copies of the images
+    SkinImageCache::clear();
+    m_preparsedTemplates.clear();
 
     if (widgets.empty()) {
         SKIN_WARNING(skinDocument, *m_pContext) << "Skin produced no widgets!";
@@ -1655,28 +1745,71 @@ QDomElement LegacySkinParser::loadTemplate(const QString& path) {
         return it.value();
     }
 
-    QFile templateFile(absolutePath);
-
-    if (!templateFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "Could not open template file:" << absolutePath;
-    }
+    QDomElement templateElement = m_preparsedTemplates.take(QDir::cleanPath(absolutePath));
+    if (templateElement.isNull()) {
+        QFile templateFile(absolutePath);
 
-    QDomDocument tmpl("template");
-    QString errorMessage;
-    int errorLine;
-    int errorColumn;
+        if (!templateFile.open(QIODevice::ReadOnly)) {
+            qWarning() << "Could not open template file:" << absolutePath;
+        }
 
-    if (!tmpl.setContent(&templateFile, &errorMessage,
-                         &errorLine, &errorColumn)) {
-        qWarning() << "LegacySkinParser::loadTemplate - setContent failed see"
-                   << absolutePath << "line:" << errorLine << "column:" << errorColumn;
-        qWarning() << "LegacySkinParser::loadTemplate - message:" << errorMessage;
-        return QDomElement();
+        QDomDocument tmpl("template");
+        QString errorMessage;
+        int errorLine;
+        int errorColumn;
+
+        if (!tmpl.setContent(&templateFile, &errorMessage,
+                             &errorLine, &errorColumn)) {
+            qWarning() << "LegacySkinParser::loadTemplate - setContent failed see"
+                       << absolutePath << "line:" << errorLine << "column:" << errorColumn;
+            qWarning() << "LegacySkinParser::loadTemplate - message:" << errorMessage;
+            return QDomElement();
+        }
+        templateElement = tmpl.documentElement();
     }
 
-    m_templateCache[absolutePath] = tmpl.documentElement();
+    m_templateCache[absolutePath] = templateElement;
     m_pContext->setSkinTemplatePath(templateFileInfo.absoluteDir().absolutePath());
-    return tmpl.documentElement();
+    return templateElement;
+}
+
+void LegacySkinParser::preloadSkinResources(const QDomElement& skinDocument) {
+    ScopedTimer timer("SkinLoader::preloadSkinResources");
+    const QString skinBasePath = m_pContext->getSkinBasePath();
+    const double scaleFactor = m_pContext->getScaleFactor();
+    const QString diskCacheDir = QDir(m_pConfig->getSettingsPath())
+                                         .filePath(kSkinImageCacheDir +
+                                                 QDir(skinBasePath).dirName());
+
+    SkinResources skinResources;
+    collectSkinResources(skinDocument, QStringList{skinBasePath}, &skinResources);
+    SkinImageCache::preload(skinResources.imagePaths, scaleFactor, diskCacheDir);
+
+    // Templates may instantiate other templates, so they are parsed
+    // level by level. The images of each level are loaded while the
+    // next level is parsed.
+    QSet<QString> visitedTemplatePaths;
+    QStringList templatePaths = skinResources.templatePaths;
+    while (!templatePaths.isEmpty()) {
+        QList<QFuture<SkinResources>> futures;
+        for (const auto& templatePath : std::as_const(templatePaths)) {
+            if (visitedTemplatePaths.contains(templatePath)) {
+                continue;
+            }
+            visitedTemplatePaths.insert(templatePath);
+            futures.append(QtConcurrent::run(preparseTemplate, templatePath, skinBasePath));
+        }
+        templatePaths.clear();
+        for (const auto& future : std::as_const(futures)) {
+            const SkinResources resources = future.result();
+            if (resources.templateElement.isNull()) {
+                continue;
+            }
+            m_preparsedTemplates.insert(resources.templatePath, resources.templateElement);
+            SkinImageCache::preload(resources.imagePaths, scaleFactor, diskCacheDir);
+            templatePaths.append(resources.templatePaths);
+        }
+    }
 }
 
 QList<QWidget*> LegacySkinParser::parseTemplate(const QDomElement& node) {
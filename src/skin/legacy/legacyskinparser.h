@@ -65,6 +65,10 @@ class LegacySkinParser : public QObject, public SkinParser {
     // Load the given template from file and return its document element.
     QDomElement loadTemplate(const QString& path);
 
+    // Parse the templates and start loading the images that are referenced
+    // by the skin in parallel, before any widget is created.
+    void preloadSkinResources(const QDomElement& skinDocument);
+
     // Parsers for each node
 
     // Most widgets can use parseStandardWidget.
@@ -163,5 +167,8 @@ class LegacySkinParser : public QObject, public SkinParser {
     QString m_style;
     Tooltips m_tooltips;
     QHash<QString, QDomElement> m_templateCache;
+    // Templates parsed by preloadSkinResources() that are moved to
+    // m_templateCache when they are loaded
+    QHash<QString, QDomElement> m_preparsedTemplates;
     static QSet<QString> s_sharedGroupStrings;
 };
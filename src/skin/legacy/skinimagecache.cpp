@@ -0,0 +1,153 @@
+#include "skin/legacy/skinimagecache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QHash>
+#include <QPainter>
+#include <QSet>
+#include <QSvgRenderer>
+#include <QtConcurrentRun>
+#include <memory>
+#include <utility>
+
+#include "skin/legacy/imgloader.h"
+#include "util/assert.h"
+#include "util/imagefilecache.h"
+
+namespace {
+
+struct LoadResult {
+    QImage image;
+    QString cacheKey;
+};
+
+// Only accessed from the GUI thread
+QHash<QString, QFuture<LoadResult>> s_images;
+QSet<QString> s_usedCacheKeys;
+QString s_diskCacheDir;
+double s_scaleFactor = 1.0;
+
+QString imageKey(const QString& fileName) {
+    // Resolves search path prefixes like "skin:"
+    return QDir::cleanPath(QFileInfo(fileName).absoluteFilePath());
+}
+
+} // anonymous namespace
+
+// static
+void SkinImageCache::preload(const QStringList& filePaths,
+        double scaleFactor,
+        const QString& diskCacheDir) {
+    if (s_images.isEmpty()) {
+        s_scaleFactor = scaleFactor;
+        s_diskCacheDir = diskCacheDir;
+        if (!s_diskCacheDir.isEmpty() && !QDir().mkpath(s_diskCacheDir)) {
+            s_diskCacheDir.clear();
+        }
+    }
+    VERIFY_OR_DEBUG_ASSERT(scaleFactor == s_scaleFactor) {
+        return;
+    }
+    for (const auto& filePath : filePaths) {
+        const QString key = imageKey(filePath);
+        if (s_images.contains(key)) {
+            continue;
+        }
+        s_images.insert(key, QtConcurrent::run([key, scaleFactor, diskCacheDir = s_diskCacheDir] {
+            LoadResult result;
+            result.image = loadImage(key, scaleFactor, diskCacheDir, &result.cacheKey);
+            return result;
+        }));
+    }
+}
+
+// static
+QImage SkinImageCache::image(const QString& fileName, double scaleFactor) {
+    if (s_images.isEmpty() || scaleFactor != s_scaleFactor) {
+        return QImage();
+    }
+    const auto it = s_images.constFind(imageKey(fileName));
+    if (it == s_images.constEnd()) {
+        return QImage();
+    }
+    // Runs the load on this thread if no worker has picked it up yet
+    return it.value().result().image;
+}
+
+// static
+void SkinImageCache::clear() {
+    for (const auto& future : std::as_const(s_images)) {
+        const QString cacheKey = future.result().cacheKey;
+        if (!cacheKey.isEmpty()) {
+            s_usedCacheKeys.insert(cacheKey);
+        }
+    }
+    s_images.clear();
+
+    if (!s_diskCacheDir.isEmpty()) {
+        // Remove the entries of modified files and other scale factors
+        mixxx::ImageFileCache(s_diskCacheDir).retain(s_usedCacheKeys);
+    }
+    s_usedCacheKeys.clear();
+    s_diskCacheDir.clear();
+}
+
+// static
+QImage SkinImageCache::loadImage(const QString& filePath,
+        double scaleFactor,
+        const QString& diskCacheDir,
+        QString* pCacheKey) {
+    std::unique_ptr<mixxx::ImageFileCache> pDiskCache;
+    QString cacheKey;
+    if (!diskCacheDir.isEmpty()) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QImage();
+        }
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(&file);
+        cacheKey = QString::fromLatin1(hash.result().toHex()) +
+                QChar('@') + QString::number(scaleFactor);
+        if (pCacheKey) {
+            *pCacheKey = cacheKey;
+        }
+        pDiskCache = std::make_unique<mixxx::ImageFileCache>(diskCacheDir);
+        QImage image = pDiskCache->load(cacheKey);
+        if (!image.isNull()) {
+            return image;
+        }
+    }
+
+    QImage image;
+    if (filePath.endsWith(QStringLiteral(".svg"), Qt::CaseInsensitive)) {
+        image = renderSvg(filePath, scaleFactor);
+    } else {
+        std::unique_ptr<QImage> pImage(ImgLoader::readImage(filePath, scaleFactor));
+        if (pImage) {
+            image = *pImage;
+        }
+    }
+    if (pDiskCache && !image.isNull() && image.colorCount() == 0) {
+        pDiskCache->store(cacheKey, image);
+    }
+    return image;
+}
+
+// static
+QImage SkinImageCache::renderSvg(const QString& filePath, double scaleFactor) {
+    QSvgRenderer renderer;
+    if (!renderer.load(filePath)) {
+        // The above line already logs a warning
+        return QImage();
+    }
+    QImage image(renderer.defaultSize() * scaleFactor, QImage::Format_ARGB32);
+    image.fill(0x00000000); // Transparent black.
+    {
+        QPainter painter(&image);
+        renderer.render(&painter);
+    }
+    return image;
+}
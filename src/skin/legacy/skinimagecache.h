@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QImage>
+#include <QString>
+#include <QStringList>
+
+/// Decodes and rasterizes the images referenced by a skin on a worker pool
+/// while the widgets of the skin are being created.
+///
+/// ImgLoader, WImageStore and Paintable look up the images here before
+/// loading them on the GUI thread. If an image is still being loaded, the
+/// lookup waits for it. Rasterized images are also stored in an
+/// ImageFileCache keyed by the hash of the file contents and the scale
+/// factor, so that subsequent skin loads only need to read the raw pixels.
+///
+/// Apart from loadImage() and renderSvg() all functions must be called from
+/// the GUI thread.
+class SkinImageCache {
+  public:
+    /// Starts loading the images in the background. Passing an empty
+    /// directory disables the disk cache.
+    static void preload(const QStringList& filePaths,
+            double scaleFactor,
+            const QString& diskCacheDir);
+
+    /// Returns the preloaded image for the file or a null image if the
+    /// file has not been preloaded for this scale factor.
+    static QImage image(const QString& fileName, double scaleFactor);
+
+    /// Waits for pending loads and releases all preloaded images. Disk cache
+    /// entries that have not been used since the last clear() are removed.
+    static void clear();
+
+    /// Loads a single image from the disk cache or decodes it and stores it
+    /// in the disk cache. SVG files are rasterized. Color corrections are
+    /// not applied. Returns a null image if the file could not be loaded.
+    static QImage loadImage(const QString& filePath,
+            double scaleFactor,
+            const QString& diskCacheDir,
+            QString* pCacheKey = nullptr);
+
+    /// Renders an SVG file at its default size times the scale factor.
+    static QImage renderSvg(const QString& filePath, double scaleFactor);
+};
@@ -44,6 +44,9 @@ int paV19Callback(const void *inputBuffer, void *outputBuffer,
                   const PaStreamCallbackTimeInfo *timeInfo,
                   PaStreamCallbackFlags statusFlags,
                   void *soundDevice) {
+    // PortAudio creates the callback thread, so it can only be
+    // registered here. Registering is cheap and realtime-safe.
+    mixxx::Tracing::registerCurrentThread("SoundDevicePortAudio");
     return ((SoundDevicePortAudio*) soundDevice)->callbackProcess(
             (SINT) framesPerBuffer, (CSAMPLE*) outputBuffer,
             (const CSAMPLE*) inputBuffer, timeInfo, statusFlags);
@@ -54,6 +57,7 @@ int paV19CallbackDrift(const void *inputBuffer, void *outputBuffer,
                        const PaStreamCallbackTimeInfo *timeInfo,
                        PaStreamCallbackFlags statusFlags,
                        void *soundDevice) {
+    mixxx::Tracing::registerCurrentThread("SoundDevicePortAudio");
     return ((SoundDevicePortAudio*) soundDevice)->callbackProcessDrift(
             (SINT) framesPerBuffer, (CSAMPLE*) outputBuffer,
             (const CSAMPLE*) inputBuffer, timeInfo, statusFlags);
@@ -64,6 +68,7 @@ int paV19CallbackClkRef(const void *inputBuffer, void *outputBuffer,
                         const PaStreamCallbackTimeInfo *timeInfo,
                         PaStreamCallbackFlags statusFlags,
                         void *soundDevice) {
+    mixxx::Tracing::registerCurrentThread("SoundDevicePortAudio");
     return ((SoundDevicePortAudio*) soundDevice)->callbackProcessClkRef(
             (SINT) framesPerBuffer, (CSAMPLE*) outputBuffer,
             (const CSAMPLE*) inputBuffer, timeInfo, statusFlags);
@@ -0,0 +1,206 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <QThreadPool>
+#include <memory>
+#include <vector>
+
+#include "analyzer/constants.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+
+namespace {
+
+constexpr int kChunkCount = 4;
+constexpr SINT kChunksPerTrack = 100;
+
+/// Records a checksum of all processed samples
+class RecordingAnalyzer : public Analyzer {
+  public:
+    explicit RecordingAnalyzer(SINT maxChunks = kChunksPerTrack)
+            : m_maxChunks(maxChunks),
+              m_processedChunks(0),
+              m_processedSamples(0),
+              m_sum(0.0),
+              m_threadPriority(QThread::InheritPriority) {
+    }
+
+    bool initialize(const AnalyzerTrack&,
+            mixxx::audio::SampleRate,
+            SINT) override {
+        m_processedChunks = 0;
+        m_processedSamples = 0;
+        m_sum = 0.0;
+        return true;
+    }
+
+    bool processSamples(const CSAMPLE* pIn, SINT iLen) override {
+        for (SINT i = 0; i < iLen; ++i) {
+            // Weighted by position to detect reordered chunks
+            m_sum += static_cast<double>(pIn[i]) * (m_processedSamples + i);
+        }
+        m_processedSamples += iLen;
+        m_threadPriority = QThread::currentThread()->priority();
+        return ++m_processedChunks < m_maxChunks;
+    }
+
+    void storeResults(TrackPointer) override {
+    }
+
+    void cleanup() override {
+    }
+
+    SINT processedSamples() const {
+        return m_processedSamples;
+    }
+
+    double sum() const {
+        return m_sum;
+    }
+
+    /// The priority of the thread that processed the last chunk
+    QThread::Priority threadPriority() const {
+        return m_threadPriority;
+    }
+
+  private:
+    const SINT m_maxChunks;
+    SINT m_processedChunks;
+    SINT m_processedSamples;
+    double m_sum;
+    QThread::Priority m_threadPriority;
+};
+
+class AnalyzerPipelineTest : public MixxxTest {
+  protected:
+    AnalyzerPipelineTest()
+            : m_pThreadPool(std::make_shared<QThreadPool>()),
+              m_track(Track::newTemporary()) {
+        // Fewer threads than analyzers
+        m_pThreadPool->setMaxThreadCount(2);
+    }
+
+    RecordingAnalyzer* addAnalyzer(SINT maxChunks = kChunksPerTrack) {
+        auto pAnalyzer = std::make_unique<RecordingAnalyzer>(maxChunks);
+        RecordingAnalyzer* pRecordingAnalyzer = pAnalyzer.get();
+        m_analyzers.push_back(AnalyzerWithState(std::move(pAnalyzer)));
+        return pRecordingAnalyzer;
+    }
+
+    void initializeAnalyzers() {
+        for (auto& analyzer : m_analyzers) {
+            analyzer.initialize(m_track, mixxx::audio::SampleRate(44100), 0);
+        }
+    }
+
+    void finishAnalyzers() {
+        for (auto& analyzer : m_analyzers) {
+            analyzer.finish(m_track);
+        }
+    }
+
+    // Publishes chunks of varying length and returns the
+    // expected checksum
+    double publishChunks(AnalyzerPipeline* pPipeline, SINT sampleCount) {
+        double expectedSum = 0.0;
+        SINT samplePos = 0;
+        for (SINT chunk = 0; chunk < kChunksPerTrack; ++chunk) {
+            auto chunkBuffer = pPipeline->writableChunk();
+            const SINT length = (chunk % 2 == 0) ? sampleCount : sampleCount / 2;
+            for (SINT i = 0; i < length; ++i) {
+                const CSAMPLE sample = static_cast<CSAMPLE>((chunk + i) % 7);
+                chunkBuffer[i] = sample;
+                expectedSum += static_cast<double>(sample) * (samplePos + i);
+            }
+            pPipeline->publishChunk(chunkBuffer.data(), length);
+            samplePos += length;
+        }
+        return expectedSum;
+    }
+
+    std::shared_ptr<QThreadPool> m_pThreadPool;
+    AnalyzerTrack m_track;
+    std::vector<AnalyzerWithState> m_analyzers;
+};
+
+TEST_F(AnalyzerPipelineTest, AllAnalyzersProcessAllChunksInOrder) {
+    std::vector<RecordingAnalyzer*> analyzers;
+    for (int i = 0; i < 5; ++i) {
+        // All analyzers stay active until the last chunk
+        analyzers.push_back(addAnalyzer(kChunksPerTrack + 1));
+    }
+    AnalyzerPipeline pipeline(m_pThreadPool, kChunkCount);
+
+    // Reuse the pipeline for multiple tracks
+    for (int track = 0; track < 3; ++track) {
+        initializeAnalyzers();
+        pipeline.start(&m_analyzers);
+        const double expectedSum =
+                publishChunks(&pipeline, mixxx::kAnalysisSamplesPerChunk);
+        pipeline.finish();
+        for (const auto* pAnalyzer : analyzers) {
+            EXPECT_EQ(kChunksPerTrack / 2 * mixxx::kAnalysisSamplesPerChunk * 3 / 2,
+                    pAnalyzer->processedSamples());
+            EXPECT_DOUBLE_EQ(expectedSum, pAnalyzer->sum());
+        }
+        finishAnalyzers();
+    }
+}
+
+TEST_F(AnalyzerPipelineTest, InactiveAnalyzers) {
+    RecordingAnalyzer* pActiveAnalyzer = addAnalyzer(kChunksPerTrack + 1);
+    // Becomes inactive after processing the first chunk
+    RecordingAnalyzer* pFailingAnalyzer = addAnalyzer(1);
+    AnalyzerPipeline pipeline(m_pThreadPool, kChunkCount);
+
+    initializeAnalyzers();
+    pipeline.start(&m_analyzers);
+    const double expectedSum = publishChunks(&pipeline, 16);
+    pipeline.finish();
+    EXPECT_DOUBLE_EQ(expectedSum, pActiveAnalyzer->sum());
+    EXPECT_EQ(16, pFailingAnalyzer->processedSamples());
+    EXPECT_TRUE(m_analyzers[0].isActive());
+    EXPECT_FALSE(m_analyzers[1].isActive());
+    finishAnalyzers();
+}
+
+TEST_F(AnalyzerPipelineTest, Cancel) {
+    addAnalyzer();
+    addAnalyzer();
+    AnalyzerPipeline pipeline(m_pThreadPool, kChunkCount);
+
+    initializeAnalyzers();
+    pipeline.start(&m_analyzers);
+    pipeline.publishChunk(pipeline.writableChunk().data(), 16);
+    // Acquired, but never published
+    pipeline.writableChunk();
+    pipeline.finish(true);
+    for (auto& analyzer : m_analyzers) {
+        analyzer.cancel();
+    }
+
+    // The pipeline is ready for the next track
+    addAnalyzer(kChunksPerTrack + 1);
+    initializeAnalyzers();
+    pipeline.start(&m_analyzers);
+    publishChunks(&pipeline, 16);
+    pipeline.finish();
+    finishAnalyzers();
+}
+
+TEST_F(AnalyzerPipelineTest, ThreadPriority) {
+    RecordingAnalyzer* pAnalyzer = addAnalyzer(kChunksPerTrack + 1);
+    AnalyzerPipeline pipeline(m_pThreadPool, kChunkCount, QThread::LowPriority);
+
+    initializeAnalyzers();
+    pipeline.start(&m_analyzers);
+    publishChunks(&pipeline, 16);
+    pipeline.finish();
+    // The pooled threads have been started with the priority of this thread
+    EXPECT_EQ(QThread::LowPriority, pAnalyzer->threadPriority());
+    finishAnalyzers();
+}
+
+} // namespace
@@ -0,0 +1,532 @@
+#include "engine/cachingreader/cachingreader.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <QtDebug>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "engine/cachingreader/cachingreaderchunkindex.h"
+#include "engine/cachingreader/sharedchunkcache.h"
+#include "engine/engineworkerscheduler.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+
+namespace {
+
+constexpr SINT kNumChunks = 64;
+
+class CachingReaderChunkIndexTest : public testing::Test {
+  protected:
+    CachingReaderChunkIndexTest()
+            : m_sampleBuffer(CachingReaderChunk::kSamples * kNumChunks) {
+        for (SINT i = 0; i < kNumChunks; ++i) {
+            m_chunks.push_back(std::make_unique<CachingReaderChunkForOwner>(
+                    mixxx::SampleBuffer::WritableSlice(
+                            m_sampleBuffer,
+                            CachingReaderChunk::kSamples * i,
+                            CachingReaderChunk::kSamples)));
+        }
+    }
+
+    CachingReaderChunkForOwner* chunk(SINT i) const {
+        return m_chunks[i].get();
+    }
+
+    mixxx::SampleBuffer m_sampleBuffer;
+    std::vector<std::unique_ptr<CachingReaderChunkForOwner>> m_chunks;
+};
+
+TEST_F(CachingReaderChunkIndexTest, InsertFindRemove) {
+    CachingReaderChunkIndex index(kNumChunks);
+    EXPECT_EQ(kNumChunks, index.capacity());
+    EXPECT_EQ(0, index.size());
+    EXPECT_EQ(nullptr, index.find(0));
+
+    EXPECT_TRUE(index.insert(0, chunk(0)));
+    EXPECT_TRUE(index.insert(7, chunk(1)));
+    EXPECT_EQ(2, index.size());
+    EXPECT_EQ(chunk(0), index.find(0));
+    EXPECT_EQ(chunk(1), index.find(7));
+    EXPECT_EQ(nullptr, index.find(1));
+
+    // Replace
+    EXPECT_TRUE(index.insert(7, chunk(2)));
+    EXPECT_EQ(2, index.size());
+    EXPECT_EQ(chunk(2), index.find(7));
+
+    EXPECT_TRUE(index.remove(0));
+    EXPECT_FALSE(index.remove(0));
+    EXPECT_EQ(1, index.size());
+    EXPECT_EQ(nullptr, index.find(0));
+    EXPECT_EQ(chunk(2), index.find(7));
+
+    index.clear();
+    EXPECT_EQ(0, index.size());
+    EXPECT_EQ(nullptr, index.find(7));
+}
+
+TEST_F(CachingReaderChunkIndexTest, RandomOperations) {
+    // Compare the index with a std::map for a deterministic sequence of
+    // insertions and removals that fills the index completely
+    CachingReaderChunkIndex index(kNumChunks);
+    std::map<SINT, CachingReaderChunkForOwner*> expected;
+    quint32 state = 12345;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 1664525 + 1013904223;
+        // Chunk indices of a long track that collide frequently
+        const SINT chunkIndex = (state >> 8) % 1000;
+        CachingReaderChunkForOwner* pChunk = chunk((state >> 4) % kNumChunks);
+        if (((state >> 20) & 1) && static_cast<SINT>(expected.size()) < kNumChunks) {
+            EXPECT_TRUE(index.insert(chunkIndex, pChunk));
+            expected[chunkIndex] = pChunk;
+        } else {
+            EXPECT_EQ(expected.erase(chunkIndex) > 0, index.remove(chunkIndex));
+        }
+        ASSERT_EQ(static_cast<SINT>(expected.size()), index.size());
+    }
+    for (SINT chunkIndex = 0; chunkIndex < 1000; ++chunkIndex) {
+        const auto it = expected.find(chunkIndex);
+        EXPECT_EQ(it == expected.end() ? nullptr : it->second,
+                index.find(chunkIndex));
+    }
+}
+
+// Returns the samples of a complete chunk with distinct values
+mixxx::SampleBuffer decodedChunkSamples(SINT chunkIndex) {
+    mixxx::SampleBuffer sampleBuffer(CachingReaderChunk::kSamples);
+    for (SINT i = 0; i < sampleBuffer.size(); ++i) {
+        sampleBuffer[i] = static_cast<CSAMPLE>(chunkIndex) + i / 65536.0f;
+    }
+    return sampleBuffer;
+}
+
+mixxx::ReadableSampleFrames readableChunkFrames(
+        SINT chunkIndex, const mixxx::SampleBuffer& sampleBuffer) {
+    return mixxx::ReadableSampleFrames(
+            mixxx::IndexRange::forward(
+                    chunkIndex * CachingReaderChunk::kFrames,
+                    CachingReaderChunk::kFrames),
+            mixxx::SampleBuffer::ReadableSlice(
+                    sampleBuffer, 0, sampleBuffer.size()));
+}
+
+TEST_F(CachingReaderChunkIndexTest, BufferSharedChunk) {
+    SharedChunkCache cache(4);
+    cache.openSource(QStringLiteral("track"));
+    cache.openSource(QStringLiteral("track"));
+    const auto samples = decodedChunkSamples(3);
+    cache.insert(QStringLiteral("track"), 3, readableChunkFrames(3, samples));
+
+    const auto pSharedChunk = cache.lookup(QStringLiteral("track"), 3);
+    ASSERT_NE(nullptr, pSharedChunk);
+    chunk(0)->init(3);
+    EXPECT_EQ(pSharedChunk->frameIndexRange,
+            chunk(0)->bufferSampleFrames(pSharedChunk->readableSampleFrames()));
+
+    mixxx::SampleBuffer output(CachingReaderChunk::kSamples);
+    EXPECT_EQ(pSharedChunk->frameIndexRange,
+            chunk(0)->readBufferedSampleFrames(
+                    output.data(), pSharedChunk->frameIndexRange));
+    for (SINT i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(samples[i], output[i]);
+    }
+}
+
+TEST(SharedChunkCacheTest, InsertLookupEvict) {
+    SharedChunkCache cache(2);
+    for (const auto& sourceKey : {QStringLiteral("a"), QStringLiteral("b")}) {
+        cache.openSource(sourceKey);
+        cache.openSource(sourceKey);
+    }
+    EXPECT_EQ(nullptr, cache.lookup(QStringLiteral("a"), 0));
+
+    const auto samples0 = decodedChunkSamples(0);
+    const auto samples1 = decodedChunkSamples(1);
+    cache.insert(QStringLiteral("a"), 0, readableChunkFrames(0, samples0));
+    cache.insert(QStringLiteral("a"), 1, readableChunkFrames(1, samples1));
+    EXPECT_EQ(2, cache.size());
+
+    // The samples are copied
+    const auto pChunk0 = cache.lookup(QStringLiteral("a"), 0);
+    ASSERT_NE(nullptr, pChunk0);
+    EXPECT_NE(samples0.data(), pChunk0->sampleBuffer.data());
+    EXPECT_EQ(samples0[42], pChunk0->sampleBuffer[42]);
+    EXPECT_EQ(nullptr, cache.lookup(QStringLiteral("b"), 0));
+
+    // Evicts the least recently used chunk
+    cache.insert(QStringLiteral("b"), 0, readableChunkFrames(0, samples0));
+    EXPECT_EQ(2, cache.size());
+    EXPECT_EQ(nullptr, cache.lookup(QStringLiteral("a"), 1));
+    EXPECT_NE(nullptr, cache.lookup(QStringLiteral("a"), 0));
+    EXPECT_NE(nullptr, cache.lookup(QStringLiteral("b"), 0));
+
+    // Evicted chunks stay valid while they are referenced
+    cache.setCapacity(0);
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(samples0[42], pChunk0->sampleBuffer[42]);
+
+    // Disabled
+    cache.insert(QStringLiteral("a"), 0, readableChunkFrames(0, samples0));
+    EXPECT_EQ(nullptr, cache.lookup(QStringLiteral("a"), 0));
+}
+
+TEST(SharedChunkCacheTest, OnlyPopulatedForMultipleReaders) {
+    SharedChunkCache cache(4);
+    const auto samples = decodedChunkSamples(0);
+
+    // A single reader does not copy its chunks into the cache
+    cache.openSource(QStringLiteral("a"));
+    cache.insert(QStringLiteral("a"), 0, readableChunkFrames(0, samples));
+    EXPECT_EQ(0, cache.size());
+
+    // A second reader has opened the same track
+    cache.openSource(QStringLiteral("a"));
+    cache.insert(QStringLiteral("a"), 0, readableChunkFrames(0, samples));
+    EXPECT_EQ(1, cache.size());
+    EXPECT_NE(nullptr, cache.lookup(QStringLiteral("a"), 0));
+
+    // Other tracks are still opened by a single reader
+    cache.openSource(QStringLiteral("b"));
+    cache.insert(QStringLiteral("b"), 0, readableChunkFrames(0, samples));
+    EXPECT_EQ(nullptr, cache.lookup(QStringLiteral("b"), 0));
+
+    // The chunks are evicted when only a single reader is left
+    cache.closeSource(QStringLiteral("a"));
+    EXPECT_EQ(0, cache.size());
+    cache.insert(QStringLiteral("a"), 0, readableChunkFrames(0, samples));
+    EXPECT_EQ(0, cache.size());
+    cache.closeSource(QStringLiteral("a"));
+    cache.closeSource(QStringLiteral("b"));
+}
+
+} // namespace
+
+// Drives the request handling of a worker whose thread is never started
+class CachingReaderWorkerTest : public MixxxTest {
+  protected:
+    static constexpr SINT kNumRequestChunks = 16;
+
+    CachingReaderWorkerTest()
+            : m_chunkReadRequestFIFO(kNumRequestChunks),
+              m_readerStatusUpdateFIFO(kNumRequestChunks),
+              m_retiredPreloadedTrackFIFO(2),
+              m_pRetiredChunkStorage(nullptr),
+              m_worker(QStringLiteral("[Channel1]"),
+                      &m_chunkReadRequestFIFO,
+                      &m_readerStatusUpdateFIFO,
+                      &m_retiredPreloadedTrackFIFO,
+                      &m_pRetiredChunkStorage,
+                      0),
+              m_sampleBuffer(CachingReaderChunk::kSamples * kNumRequestChunks) {
+        for (SINT i = 0; i < kNumRequestChunks; ++i) {
+            m_chunks.push_back(std::make_unique<CachingReaderChunkForOwner>(
+                    mixxx::SampleBuffer::WritableSlice(
+                            m_sampleBuffer,
+                            CachingReaderChunk::kSamples * i,
+                            CachingReaderChunk::kSamples)));
+        }
+    }
+
+    // Requests a chunk like CachingReader::hintAndMaybeWake()
+    void requestChunk(SINT chunkIndex, Hint::Type type, unsigned int hintGeneration) {
+        CachingReaderChunkForOwner* pChunk = m_chunks[chunkIndex].get();
+        pChunk->init(chunkIndex);
+        pChunk->setHintGeneration(hintGeneration);
+        CachingReaderChunkReadRequest request;
+        request.giveToWorker(pChunk, Hint::priority(type));
+        ASSERT_EQ(1, m_chunkReadRequestFIFO.write(&request, 1));
+    }
+
+    // Returns the index of the chunk the worker would read next
+    // or -1 if no request is pending
+    SINT takeNextRequestedChunk() {
+        CachingReaderChunkReadRequest request;
+        if (!m_worker.takeNextReadRequest(&request)) {
+            return -1;
+        }
+        return request.chunk->getIndex();
+    }
+
+    int takeNumDiscardedRequests() {
+        int numDiscarded = 0;
+        ReaderStatusUpdate update;
+        while (m_readerStatusUpdateFIFO.read(&update, 1) == 1) {
+            if (update.status == CHUNK_READ_DISCARDED) {
+                ++numDiscarded;
+            }
+        }
+        return numDiscarded;
+    }
+
+    FIFO<CachingReaderChunkReadRequest> m_chunkReadRequestFIFO;
+    FIFO<ReaderStatusUpdate> m_readerStatusUpdateFIFO;
+    FIFO<PreloadedTrack*> m_retiredPreloadedTrackFIFO;
+    std::atomic<CachingReaderChunkStorage*> m_pRetiredChunkStorage;
+    CachingReaderWorker m_worker;
+    mixxx::SampleBuffer m_sampleBuffer;
+    std::vector<std::unique_ptr<CachingReaderChunkForOwner>> m_chunks;
+};
+
+namespace {
+
+TEST_F(CachingReaderWorkerTest, ReadsRequestsByPriority) {
+    m_worker.setHintGeneration(1);
+    requestChunk(0, Hint::Type::IntroStart, 1);
+    requestChunk(1, Hint::Type::HotCue, 1);
+    requestChunk(2, Hint::Type::CurrentPosition, 1);
+    requestChunk(3, Hint::Type::HotCue, 1);
+
+    // Equal priorities are read in the order of their arrival
+    EXPECT_EQ(2, takeNextRequestedChunk());
+    EXPECT_EQ(1, takeNextRequestedChunk());
+    EXPECT_EQ(3, takeNextRequestedChunk());
+    EXPECT_EQ(0, takeNextRequestedChunk());
+    EXPECT_EQ(-1, takeNextRequestedChunk());
+    EXPECT_EQ(0, takeNumDiscardedRequests());
+}
+
+TEST_F(CachingReaderWorkerTest, DiscardsRequestsOfPreviousJumps) {
+    // Each callback jumps to a position that has not been cached, while
+    // the worker is still busy, e.g. when beatjumping quickly
+    for (unsigned int generation = 1; generation <= 10; ++generation) {
+        requestChunk(generation, Hint::Type::CurrentPosition, generation);
+    }
+    // The hot cue was hinted again by each callback
+    requestChunk(0, Hint::Type::HotCue, 10);
+    m_worker.setHintGeneration(10);
+
+    // Only the positions of the last two callbacks are still read, before
+    // the lower priority hot cue
+    EXPECT_EQ(9, takeNextRequestedChunk());
+    EXPECT_EQ(8, takeNumDiscardedRequests());
+    EXPECT_EQ(10, takeNextRequestedChunk());
+    EXPECT_EQ(0, takeNextRequestedChunk());
+    EXPECT_EQ(-1, takeNextRequestedChunk());
+    EXPECT_EQ(0, takeNumDiscardedRequests());
+}
+
+} // namespace
+
+class CachingReaderTest : public MixxxTest, SoundSourceProviderRegistration {
+  protected:
+    std::unique_ptr<CachingReader> createReader(const QString& group) {
+        auto pReader = std::make_unique<CachingReader>(group, config());
+        // The scheduler is never started, processUntil() runs the worker
+        pReader->setScheduler(&m_scheduler);
+        return pReader;
+    }
+
+    // Runs the worker whenever the reader has woken it up and processes
+    // its responses like the engine until the condition holds
+    template<typename Condition>
+    bool processUntil(CachingReader* pReader, Condition condition) {
+        for (int i = 0; i < 10000; ++i) {
+            pReader->m_worker.wakeIfReady();
+            pReader->process();
+            if (condition()) {
+                return true;
+            }
+            QThread::msleep(1);
+        }
+        return false;
+    }
+
+    // Loads a track with 30 s of stereo audio, i.e. about 10 MB of samples
+    bool loadTestTrack(CachingReader* pReader) {
+        pReader->newTrack(Track::newTemporary(
+                getTestDir().filePath(QStringLiteral("sine-30.wav"))));
+        return processUntil(pReader, [pReader] {
+            return pReader->m_state.loadAcquire() == CachingReader::STATE_TRACK_LOADED;
+        });
+    }
+
+    static bool hasRetiredChunkStorage(const CachingReader& reader) {
+        return reader.m_pRetiredChunkStorage.load() != nullptr;
+    }
+
+    static bool isPreloaded(const CachingReader& reader) {
+        return reader.m_pPreloadedTrack != nullptr;
+    }
+
+    static int numRetiredPreloadedTracks(const CachingReader& reader) {
+        return reader.m_retiredPreloadedTrackFIFO.readAvailable();
+    }
+
+    // Reads a few frames from the middle of the track, which have not
+    // been hinted
+    static CachingReader::ReadResult readFromMiddle(CachingReader* pReader) {
+        CSAMPLE buffer[kReadSamples];
+        return pReader->read(kMiddleSample, kReadSamples, false, buffer);
+    }
+
+    static constexpr SINT kMiddleSample = 44100 * 2 * 15;
+    static constexpr SINT kReadSamples = 512;
+
+    EngineWorkerScheduler m_scheduler;
+};
+
+namespace {
+
+TEST_F(CachingReaderTest, ConfiguredSharedChunkCapacity) {
+    {
+        CachingReader reader(QStringLiteral("[Channel1]"), config());
+        EXPECT_EQ(256, SharedChunkCache::instance().capacity());
+    }
+    config()->setValue(ConfigKey("[Master]", "cached_chunks_shared"), 0);
+    {
+        CachingReader reader(QStringLiteral("[Channel1]"), config());
+        EXPECT_EQ(0, SharedChunkCache::instance().capacity());
+    }
+    SharedChunkCache::instance().setCapacity(256);
+}
+
+TEST_F(CachingReaderTest, ConfiguredChunkCapacity) {
+    config()->setValue(ConfigKey("[Master]", "cached_chunks_sampler"), 16);
+    config()->setValue(ConfigKey("[Master]", "cached_chunks_preview_deck"), 1);
+
+    CachingReader deckReader(QStringLiteral("[Channel1]"), config());
+    EXPECT_EQ(80, deckReader.chunkCapacity());
+
+    CachingReader samplerReader(QStringLiteral("[Sampler1]"), config());
+    EXPECT_EQ(16, samplerReader.chunkCapacity());
+
+    // Clamped to the minimum
+    CachingReader previewDeckReader(QStringLiteral("[PreviewDeck1]"), config());
+    EXPECT_EQ(2, previewDeckReader.chunkCapacity());
+}
+
+TEST_F(CachingReaderTest, ChangeChunkCapacityWhileIdle) {
+    const auto pReader = createReader(QStringLiteral("[Channel1]"));
+    EXPECT_EQ(80, pReader->chunkCapacity());
+
+    pReader->setChunkCapacity(200);
+    // Not applied until the engine thread processes the reader
+    EXPECT_EQ(80, pReader->chunkCapacity());
+    pReader->process();
+    EXPECT_EQ(200, pReader->chunkCapacity());
+
+    // The replaced chunks are deleted by the worker
+    EXPECT_TRUE(processUntil(pReader.get(), [&pReader] {
+        return !hasRetiredChunkStorage(*pReader);
+    }));
+
+    // Only the last request is applied
+    pReader->setChunkCapacity(100);
+    pReader->setChunkCapacity(40);
+    EXPECT_TRUE(pReader->applyPendingChunkCapacity());
+    EXPECT_EQ(40, pReader->chunkCapacity());
+    EXPECT_FALSE(pReader->applyPendingChunkCapacity());
+}
+
+TEST_F(CachingReaderTest, ChangeChunkCapacityWithControl) {
+    const auto pReader = createReader(QStringLiteral("[Channel1]"));
+    const ConfigKey key(QStringLiteral("[Channel1]"), QStringLiteral("cached_chunks"));
+    EXPECT_EQ(80.0, ControlObject::get(key));
+
+    ControlObject::set(key, 120.0);
+    EXPECT_EQ(120.0, ControlObject::get(key));
+    pReader->process();
+    EXPECT_EQ(120, pReader->chunkCapacity());
+
+    // Clamped to the maximum
+    EXPECT_TRUE(processUntil(pReader.get(), [&pReader] {
+        return !hasRetiredChunkStorage(*pReader);
+    }));
+    ControlObject::set(key, 100000.0);
+    EXPECT_EQ(1024.0, ControlObject::get(key));
+    pReader->process();
+    EXPECT_EQ(1024, pReader->chunkCapacity());
+}
+
+TEST_F(CachingReaderTest, PreloadDisabledByDefault) {
+    const auto pReader = createReader(QStringLiteral("[Channel1]"));
+    ASSERT_TRUE(loadTestTrack(pReader.get()));
+
+    // Reading from the chunk cache requires hints and the worker
+    EXPECT_EQ(CachingReader::ReadResult::UNAVAILABLE, readFromMiddle(pReader.get()));
+    EXPECT_FALSE(isPreloaded(*pReader));
+    EXPECT_EQ(0.0,
+            ControlObject::get(ConfigKey(QStringLiteral("[Channel1]"),
+                    QStringLiteral("preload_progress"))));
+}
+
+TEST_F(CachingReaderTest, ReadPreloadedTrack) {
+    config()->setValue(ConfigKey("[Master]", "track_preload"), true);
+    const auto pReader = createReader(QStringLiteral("[Channel1]"));
+    ASSERT_TRUE(loadTestTrack(pReader.get()));
+    ASSERT_TRUE(processUntil(pReader.get(), [&pReader] {
+        return isPreloaded(*pReader);
+    }));
+
+    // Served from memory without hinting or waking the worker
+    EXPECT_EQ(CachingReader::ReadResult::AVAILABLE, readFromMiddle(pReader.get()));
+}
+
+TEST_F(CachingReaderTest, PreloadFallsBackWhenExceedingLimit) {
+    config()->setValue(ConfigKey("[Master]", "track_preload"), true);
+    config()->setValue(ConfigKey("[Master]", "track_preload_max_mb"), 1);
+    const auto pReader = createReader(QStringLiteral("[Channel1]"));
+    ASSERT_TRUE(loadTestTrack(pReader.get()));
+    EXPECT_EQ(CachingReader::ReadResult::UNAVAILABLE, readFromMiddle(pReader.get()));
+
+    // The chunk cache is used instead
+    HintVector hints;
+    hints.append(Hint{kMiddleSample / 2,
+            Hint::kFrameCountForward,
+            Hint::Type::CurrentPosition});
+    pReader->hintAndMaybeWake(hints);
+    EXPECT_TRUE(processUntil(pReader.get(), [&pReader] {
+        return readFromMiddle(pReader.get()) == CachingReader::ReadResult::AVAILABLE;
+    }));
+    EXPECT_FALSE(isPreloaded(*pReader));
+}
+
+TEST_F(CachingReaderTest, FreeRetiredPreloadedTrack) {
+    config()->setValue(ConfigKey("[Master]", "track_preload"), true);
+    const auto pReader = createReader(QStringLiteral("[Channel1]"));
+    ASSERT_TRUE(loadTestTrack(pReader.get()));
+    ASSERT_TRUE(processUntil(pReader.get(), [&pReader] {
+        return isPreloaded(*pReader);
+    }));
+
+    // Unloading the track retires the preloaded samples, which are
+    // deleted by the worker that is woken up for this purpose
+    pReader->newTrack(TrackPointer());
+    EXPECT_TRUE(processUntil(pReader.get(), [&pReader] {
+        return !isPreloaded(*pReader) && numRetiredPreloadedTracks(*pReader) == 0;
+    }));
+}
+
+// Copying a chunk that has been decoded for another deck, which
+// replaces decoding it again
+static void BM_BufferSharedChunk(benchmark::State& state) {
+    SharedChunkCache cache(kNumChunks);
+    cache.openSource(QStringLiteral("track"));
+    cache.openSource(QStringLiteral("track"));
+    const auto samples = decodedChunkSamples(0);
+    for (SINT chunkIndex = 0; chunkIndex < kNumChunks; ++chunkIndex) {
+        cache.insert(QStringLiteral("track"),
+                chunkIndex,
+                readableChunkFrames(chunkIndex, samples));
+    }
+    mixxx::SampleBuffer chunkBuffer(CachingReaderChunk::kSamples);
+    CachingReaderChunkForOwner chunk(mixxx::SampleBuffer::WritableSlice(chunkBuffer));
+    SINT chunkIndex = 0;
+    for (auto _ : state) {
+        const auto pSharedChunk = cache.lookup(QStringLiteral("track"), chunkIndex);
+        chunk.init(chunkIndex);
+        benchmark::DoNotOptimize(
+                chunk.bufferSampleFrames(pSharedChunk->readableSampleFrames()));
+        chunk.free();
+        chunkIndex = (chunkIndex + 1) % kNumChunks;
+    }
+}
+BENCHMARK(BM_BufferSharedChunk);
+
+} // namespace
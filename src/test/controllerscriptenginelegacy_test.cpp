@@ -1,5 +1,7 @@
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 
+#include <benchmark/benchmark.h>
+
 #include <QScopedPointer>
 #include <QTemporaryFile>
 #include <QThread>
@@ -109,6 +111,42 @@ TEST_F(ControllerScriptEngineLegacyTest, getSetValue) {
     EXPECT_DOUBLE_EQ(1.0, co->get());
 }
 
+TEST_F(ControllerScriptEngineLegacyTest, getControlHandle) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    auto co2 = std::make_unique<ControlObject>(ConfigKey("[Test]", "co2"));
+    const int handle = evaluate("engine.getControlHandle('[Test]', 'co');").toInt();
+    EXPECT_LE(0, handle);
+    // The handle is stable and unique
+    EXPECT_EQ(handle, evaluate("engine.getControlHandle('[Test]', 'co');").toInt());
+    EXPECT_NE(handle, evaluate("engine.getControlHandle('[Test]', 'co2');").toInt());
+    EXPECT_EQ(-1, evaluate("engine.getControlHandle('[Nothing]', 'nothing');").toInt());
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, getSetValueByHandle) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    EXPECT_TRUE(evaluateAndAssert(
+            "var handle = engine.getControlHandle('[Test]', 'co');"
+            "engine.setValueByHandle(handle, engine.getValueByHandle(handle) + 1);"));
+    EXPECT_DOUBLE_EQ(1.0, co->get());
+    EXPECT_TRUE(evaluateAndAssert("engine.setValueByHandle(handle, NaN);"));
+    EXPECT_DOUBLE_EQ(1.0, co->get());
+    // Invalid handles are ignored
+    EXPECT_TRUE(evaluateAndAssert("engine.setValueByHandle(-1, 1.0);"));
+    EXPECT_TRUE(evaluateAndAssert("engine.setValueByHandle(4711, 1.0);"));
+    EXPECT_EQ(0.0, evaluate("engine.getValueByHandle(-1);").toNumber());
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, getSetParameterByHandle) {
+    auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
+            -10.0,
+            10.0);
+    EXPECT_TRUE(evaluateAndAssert(
+            "var handle = engine.getControlHandle('[Test]', 'co');"
+            "engine.setParameterByHandle(handle, 1.0);"));
+    EXPECT_DOUBLE_EQ(10.0, co->get());
+    EXPECT_DOUBLE_EQ(1.0, evaluate("engine.getParameterByHandle(handle);").toNumber());
+}
+
 TEST_F(ControllerScriptEngineLegacyTest, setParameter) {
     auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
             -10.0,
@@ -620,3 +658,104 @@ TEST_F(ControllerScriptEngineLegacyTest, connectionExecutesWithCorrectThisObject
     // The counter should have been incremented exactly once.
     EXPECT_DOUBLE_EQ(1.0, pass->get());
 }
+
+namespace {
+
+// A jog wheel handler that is implemented in three different ways
+const QByteArray kJogScript = QByteArrayLiteral(
+        "var BenchmarkScript = {"
+        "  jogHandle: engine.getControlHandle('[Test]', 'jog'),"
+        "  jogByName: function(channel, control, value, status, group) {"
+        "    engine.setValue('[Test]', 'jog',"
+        "        engine.getValue('[Test]', 'jog') + value - 64);"
+        "  },"
+        "  jogByHandle: function(channel, control, value, status, group) {"
+        "    engine.setValueByHandle(BenchmarkScript.jogHandle,"
+        "        engine.getValueByHandle(BenchmarkScript.jogHandle) + value - 64);"
+        "  },"
+        "  jogBatched: function(channel, control, value, status, group, values) {"
+        "    var delta = 0;"
+        "    for (var i = 0; i < values.length; ++i) {"
+        "      delta += values[i] - 64;"
+        "    }"
+        "    engine.setValueByHandle(BenchmarkScript.jogHandle,"
+        "        engine.getValueByHandle(BenchmarkScript.jogHandle) + delta);"
+        "  }"
+        "};");
+
+class JogScriptBenchmark {
+  public:
+    JogScriptBenchmark()
+            : m_jog(ConfigKey("[Test]", "jog")),
+              m_engine(nullptr, logger) {
+        m_scriptFile.open();
+        m_scriptFile.write(kJogScript);
+        m_scriptFile.close();
+        LegacyControllerMapping::ScriptFileInfo script;
+        script.file = QFileInfo(m_scriptFile.fileName());
+        m_engine.setScriptFiles({script});
+        m_engine.setTesting(true);
+        m_engine.initialize();
+    }
+
+    ControllerScriptEngineLegacy* engine() {
+        return &m_engine;
+    }
+
+  private:
+    ControlObject m_jog;
+    QTemporaryFile m_scriptFile;
+    ControllerScriptEngineLegacy m_engine;
+};
+
+// The messages of a burst are dispatched with one call per message
+void dispatchIndividually(benchmark::State& state, const QString& handler) {
+    JogScriptBenchmark jogScript;
+    ControllerScriptEngineLegacy* pEngine = jogScript.engine();
+    const int burstSize = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        for (int i = 0; i < burstSize; ++i) {
+            QJSValue function = pEngine->wrapFunctionCode(handler, 5);
+            pEngine->executeFunction(function,
+                    QJSValueList{0, 0x20, 65, 0xB0, QStringLiteral("[Channel1]")});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * burstSize);
+}
+
+static void BM_ScriptDispatchByName(benchmark::State& state) {
+    dispatchIndividually(state, QStringLiteral("BenchmarkScript.jogByName"));
+}
+BENCHMARK(BM_ScriptDispatchByName)->Arg(1)->Arg(16)->Arg(128);
+
+static void BM_ScriptDispatchByHandle(benchmark::State& state) {
+    dispatchIndividually(state, QStringLiteral("BenchmarkScript.jogByHandle"));
+}
+BENCHMARK(BM_ScriptDispatchByHandle)->Arg(1)->Arg(16)->Arg(128);
+
+static void BM_ScriptDispatchBatched(benchmark::State& state) {
+    JogScriptBenchmark jogScript;
+    ControllerScriptEngineLegacy* pEngine = jogScript.engine();
+    const int burstSize = static_cast<int>(state.range(0));
+    const auto handler = QStringLiteral("BenchmarkScript.jogBatched");
+    QVector<unsigned char> values;
+    for (auto _ : state) {
+        // Like MidiController, collect the values before the single call
+        values.resize(0);
+        for (int i = 0; i < burstSize; ++i) {
+            values.append(65);
+        }
+        QJSValue function = pEngine->wrapFunctionCode(handler, 6);
+        pEngine->executeFunction(function,
+                QJSValueList{0,
+                        0x20,
+                        65,
+                        0xB0,
+                        QStringLiteral("[Channel1]"),
+                        pEngine->newValueArray(values)});
+    }
+    state.SetItemsProcessed(state.iterations() * burstSize);
+}
+BENCHMARK(BM_ScriptDispatchBatched)->Arg(1)->Arg(16)->Arg(128);
+
+} // namespace
@@ -1,7 +1,13 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
+
 #include <QtDebug>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "control/controlobject.h"
+#include "control/controlproxy.h"
 #include "util/memory.h"
 #include "test/mixxxtest.h"
 
@@ -48,6 +54,65 @@ TEST_F(ControlObjectTest, AliasRetrieval) {
 
     // Check if getControl on alias returns us the original ControlObject
     EXPECT_EQ(ControlObject::getControl(ckAlias), co.get());
+    EXPECT_EQ(ControlProxy(ckAlias).getHandle(), co->getHandle());
+}
+
+TEST_F(ControlObjectTest, getControlByHandle) {
+    const ControlHandle handle = co1->getHandle();
+    ASSERT_TRUE(handle.valid());
+    EXPECT_NE(handle, co2->getHandle());
+    EXPECT_EQ(ControlObject::getControl(handle), co1.get());
+    EXPECT_EQ(ControlProxy(ck1).getHandle(), handle);
+
+    ControlObject::set(handle, 2.0);
+    EXPECT_DOUBLE_EQ(2.0, co1->get());
+    EXPECT_DOUBLE_EQ(2.0, ControlObject::get(handle));
+
+    // Handles are not reused when the control is created again
+    co1.reset();
+    EXPECT_EQ(ControlObject::getControl(handle), (ControlObject*)nullptr);
+    co1 = std::make_unique<ControlObject>(ck1);
+    EXPECT_NE(handle, co1->getHandle());
+    EXPECT_EQ(ControlObject::getControl(handle), (ControlObject*)nullptr);
+    EXPECT_EQ(ControlObject::getControl(ck1), co1.get());
+
+    EXPECT_FALSE(ControlHandle().valid());
+    EXPECT_EQ(ControlObject::getControl(ControlHandle()), (ControlObject*)nullptr);
+}
+
+TEST_F(ControlObjectTest, StaleHandleAfterSlotReuse) {
+    const ControlHandle staleHandle = co1->getHandle();
+    co1.reset();
+    // The released slot is eventually reused by one of the new controls
+    for (int i = 0; i < 1000; ++i) {
+        const auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "reuse"));
+        ASSERT_TRUE(co->getHandle().valid());
+        EXPECT_NE(staleHandle, co->getHandle());
+        EXPECT_EQ(ControlObject::getControl(co->getHandle()), co.get());
+        EXPECT_EQ(ControlObject::getControl(staleHandle), (ControlObject*)nullptr);
+    }
+}
+
+TEST_F(ControlObjectTest, ConcurrentLookup) {
+    constexpr int kNumThreads = 4;
+    constexpr int kNumLookups = 10000;
+    std::vector<std::thread> threads;
+    std::atomic<int> numFailures(0);
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([this, &numFailures] {
+            for (int j = 0; j < kNumLookups; ++j) {
+                const ConfigKey& key = (j % 2) ? ck1 : ck2;
+                const auto pControl = ControlDoublePrivate::getControl(key);
+                if (!pControl || pControl->getKey() != key) {
+                    ++numFailures;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, numFailures.load());
 }
 
 TEST_F(ControlObjectTest, Persistence_NotPresent) {
@@ -85,4 +150,75 @@ TEST_F(ControlObjectTest, Persistence_ValidValue) {
     EXPECT_DOUBLE_EQ(5.0, co.get());
 }
 
+// Emulates a skin or controller mapping that accesses many controls
+class ControlLookupBenchmark {
+  public:
+    explicit ControlLookupBenchmark(int numControls) {
+        m_controls.reserve(numControls);
+        m_keys.reserve(numControls);
+        for (int i = 0; i < numControls; ++i) {
+            m_keys.emplace_back(QStringLiteral("[Channel%1]").arg(i % 8 + 1),
+                    QStringLiteral("control%1").arg(i));
+            m_controls.push_back(std::make_unique<ControlObject>(m_keys.back()));
+        }
+    }
+
+    const std::vector<ConfigKey>& keys() const {
+        return m_keys;
+    }
+
+    std::vector<ControlHandle> handles() const {
+        std::vector<ControlHandle> handles;
+        handles.reserve(m_controls.size());
+        for (const auto& pControl : m_controls) {
+            handles.push_back(pControl->getHandle());
+        }
+        return handles;
+    }
+
+  private:
+    std::vector<ConfigKey> m_keys;
+    std::vector<std::unique_ptr<ControlObject>> m_controls;
+};
+
+static void BM_ControlGetByKey(benchmark::State& state) {
+    const ControlLookupBenchmark controls(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& key : controls.keys()) {
+            sum += ControlObject::get(key);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ControlGetByKey)->Arg(4000);
+
+static void BM_ControlGetByHandle(benchmark::State& state) {
+    const ControlLookupBenchmark controls(static_cast<int>(state.range(0)));
+    const auto handles = controls.handles();
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& handle : handles) {
+            sum += ControlObject::get(handle);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ControlGetByHandle)->Arg(4000);
+
+// Skins and controller mappings create a ControlProxy for each control
+static void BM_ControlProxyCreate(benchmark::State& state) {
+    const ControlLookupBenchmark controls(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& key : controls.keys()) {
+            ControlProxy proxy(key);
+            benchmark::DoNotOptimize(proxy);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ControlProxyCreate)->Arg(4000);
+
 } // namespace
@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 #include <QFileInfo>
+#include <QTemporaryDir>
 
 #include "library/coverartcache.h"
 #include "library/coverartutils.h"
 #include "library/trackcollection.h"
 #include "test/librarytest.h"
 #include "sources/soundsourceproxy.h"
+#include "util/imagefilecache.h"
 
 // first inherit from MixxxTest to construct a QApplication to be able to
 // construct the default QPixmap in CoverArtCache
@@ -92,3 +94,31 @@ TEST_F(CoverArtCacheTest, loadCoverFromFileAbsolute) {
             getTestDir().filePath(kCoverLocationTest),
             getTestDir().filePath(kCoverLocationTest));
 }
+
+TEST_F(CoverArtCacheTest, loadCoverFromDiskCache) {
+    QTemporaryDir tempDir;
+    const auto pDiskCache = std::make_shared<const mixxx::ImageFileCache>(
+            tempDir.filePath(QStringLiteral("covers")));
+    constexpr int kDesiredWidth = 50;
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = kCoverFileTest;
+    info.trackLocation = getTestDir().filePath(kTrackLocationTest);
+    const auto loaded = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), info, kDesiredWidth, false, pDiskCache);
+    ASSERT_FALSE(loaded.coverArt.loadedImage.image.isNull());
+
+    // The resized cover is loaded from the disk cache, but reports the
+    // location of the original image
+    const CoverInfo loadedInfo = loaded.coverArt;
+    ASSERT_TRUE(loadedInfo.hasImage());
+    const auto cached = CoverArtCache::loadCover(
+            nullptr, TrackPointer(), loadedInfo, kDesiredWidth, false, pDiskCache);
+    EXPECT_FALSE(cached.coverInfoUpdated);
+    EXPECT_EQ(loaded.coverArt.loadedImage.image, cached.coverArt.loadedImage.image);
+    EXPECT_QSTRING_EQ(loaded.coverArt.loadedImage.location,
+            cached.coverArt.loadedImage.location);
+    EXPECT_TRUE(cached.coverArt.loadedImage.location.endsWith(kCoverFileTest));
+}
@@ -1,8 +1,17 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QtConcurrentRun>
+#include <atomic>
+#include <thread>
+#include <tuple>
+
 #include "library/dao/settingsdao.h"
 #include "test/mixxxdbtest.h"
 #include "util/db/dbconnectionpooler.h"
+#include "util/db/sqltransaction.h"
 
 class DbConnectionPoolTest : public MixxxTest {};
 
@@ -20,3 +29,174 @@ TEST_F(DbConnectionPoolTest, MoveSemantics) {
     EXPECT_TRUE(p1.isPooling());
     EXPECT_FALSE(p2.isPooling());
 }
+
+TEST_F(DbConnectionPoolTest, WriteAheadLog) {
+    const MixxxDb mixxxDb(config());
+    const mixxx::DbConnectionPooler pooler(mixxxDb.connectionPool());
+    QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+    QSqlQuery query(database);
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("wal"), query.value(0).toString());
+}
+
+TEST_F(DbConnectionPoolTest, WriteAheadLogDisabled) {
+    {
+        // Enables the persistent write-ahead log
+        const MixxxDb mixxxDb(config());
+        const mixxx::DbConnectionPooler pooler(mixxxDb.connectionPool());
+        ASSERT_TRUE(pooler.isPooling());
+    }
+    config()->setValue(ConfigKey("[Library]", "WriteAheadLog"), false);
+    const MixxxDb mixxxDb(config());
+    const mixxx::DbConnectionPooler pooler(mixxxDb.connectionPool());
+    QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+    QSqlQuery query(database);
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("delete"), query.value(0).toString());
+}
+
+TEST_F(DbConnectionPoolTest, ReadDuringWriteTransaction) {
+    const MixxxDb mixxxDb(config());
+    const mixxx::DbConnectionPooler pooler(mixxxDb.connectionPool());
+    QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+    QSqlQuery query(database);
+    ASSERT_TRUE(query.exec("CREATE TABLE tracks (id INTEGER PRIMARY KEY, title TEXT)"));
+    ASSERT_TRUE(query.exec("INSERT INTO tracks (title) VALUES ('committed')"));
+
+    SqlTransaction transaction(database);
+    ASSERT_TRUE(transaction);
+    ASSERT_TRUE(query.exec("INSERT INTO tracks (title) VALUES ('pending')"));
+
+    // The reader must neither be blocked by nor see the pending transaction
+    const mixxx::DbConnectionPoolPtr pDbConnectionPool = mixxxDb.connectionPool();
+    const auto readerResult = QtConcurrent::run([pDbConnectionPool] {
+        const mixxx::DbConnectionPooler readerPooler(pDbConnectionPool);
+        QSqlDatabase readerDatabase = mixxx::DbConnectionPooled(readerPooler);
+        QSqlQuery readerQuery(readerDatabase);
+        int rowCount = -1;
+        if (readerQuery.exec("SELECT COUNT(*) FROM tracks") && readerQuery.next()) {
+            rowCount = readerQuery.value(0).toInt();
+        }
+        const bool viewCreated = readerQuery.exec(
+                "CREATE TEMPORARY VIEW titles AS SELECT title FROM tracks");
+        return std::make_tuple(rowCount, viewCreated);
+    }).result();
+    EXPECT_EQ(1, std::get<0>(readerResult));
+    EXPECT_TRUE(std::get<1>(readerResult));
+
+    EXPECT_TRUE(transaction.commit());
+}
+
+namespace {
+
+constexpr int kSyntheticLibrarySize = 100000;
+constexpr int kScanBatchSize = 10000;
+
+// A library that is browsed by the benchmark thread while another
+// thread continuously updates all tracks in large transactions, like
+// the library scanner does.
+class ScanAndBrowseBenchmark {
+  public:
+    ScanAndBrowseBenchmark()
+            : m_pDbConnectionPool(mixxx::DbConnectionPool::create(
+                      params(m_tempDir), QStringLiteral("BENCHMARK"))),
+              m_stopScan(false) {
+        const mixxx::DbConnectionPooler pooler(m_pDbConnectionPool);
+        QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+        QSqlQuery query(database);
+        query.exec(
+                "CREATE TABLE library (id INTEGER PRIMARY KEY, "
+                "artist TEXT, title TEXT, album TEXT, bpm REAL)");
+        query.exec("CREATE INDEX idx_library_artist ON library (artist)");
+        SqlTransaction transaction(database);
+        query.prepare(
+                "INSERT INTO library (artist, title, album, bpm) "
+                "VALUES (:artist, :title, :album, :bpm)");
+        for (int i = 0; i < kSyntheticLibrarySize; ++i) {
+            query.bindValue(":artist", QStringLiteral("Artist %1").arg(i % 1000));
+            query.bindValue(":title", QStringLiteral("Title %1").arg(i));
+            query.bindValue(":album", QStringLiteral("Album %1").arg(i % 5000));
+            query.bindValue(":bpm", 80.0 + (i % 100));
+            query.exec();
+        }
+        transaction.commit();
+    }
+
+    ~ScanAndBrowseBenchmark() {
+        stopScan();
+    }
+
+    void startScan() {
+        m_scanThread = std::thread([this] {
+            const mixxx::DbConnectionPooler pooler(m_pDbConnectionPool);
+            QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+            QSqlQuery query(database);
+            query.prepare("UPDATE library SET bpm=bpm+1 WHERE id=:id");
+            int id = 0;
+            while (!m_stopScan.load()) {
+                SqlTransaction transaction(database);
+                for (int i = 0; i < kScanBatchSize; ++i) {
+                    query.bindValue(":id", id % kSyntheticLibrarySize + 1);
+                    query.exec();
+                    ++id;
+                }
+                transaction.commit();
+            }
+        });
+    }
+
+    void stopScan() {
+        if (m_scanThread.joinable()) {
+            m_stopScan.store(true);
+            m_scanThread.join();
+        }
+    }
+
+    const mixxx::DbConnectionPoolPtr& dbConnectionPool() const {
+        return m_pDbConnectionPool;
+    }
+
+  private:
+    static mixxx::DbConnection::Params params(const QTemporaryDir& tempDir) {
+        mixxx::DbConnection::Params params;
+        params.type = QStringLiteral("QSQLITE");
+        params.filePath = tempDir.filePath(QStringLiteral("mixxxdb.sqlite"));
+        return params;
+    }
+
+    QTemporaryDir m_tempDir;
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    std::atomic<bool> m_stopScan;
+    std::thread m_scanThread;
+};
+
+// Arg 0: Browsing only, Arg 1: Browsing during a scan
+static void BM_BrowseLibraryDuringScan(benchmark::State& state) {
+    ScanAndBrowseBenchmark fixture;
+    if (state.range(0)) {
+        fixture.startScan();
+    }
+    const mixxx::DbConnectionPooler pooler(fixture.dbConnectionPool());
+    QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    query.prepare(
+            "SELECT id, artist, title, album, bpm FROM library "
+            "WHERE artist LIKE :artist ORDER BY title");
+    int artist = 0;
+    for (auto _ : state) {
+        query.bindValue(":artist", QStringLiteral("Artist %1%").arg(artist++ % 100));
+        query.exec();
+        int rowCount = 0;
+        while (query.next()) {
+            ++rowCount;
+        }
+        benchmark::DoNotOptimize(rowCount);
+    }
+    fixture.stopScan();
+}
+BENCHMARK(BM_BrowseLibraryDuringScan)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "engine/filters/enginefilteriirblock.h"
+
+namespace {
+
+constexpr char kFidSpecLowPassButterworth4[] = "LpBu4";
+constexpr char kFidSpecHighPassButterworth4[] = "HpBu4";
+constexpr char kFidSpecBandPassBessel8[] = "BpBe8";
+constexpr char kFidSpecLowPassBiquad[] = "LpBq/0.707";
+constexpr char kFidSpecHighPassButterworth1[] = "HpBu1";
+
+// Both implementations do the same calculations, but the compiler
+// may reorder them differently.
+constexpr CSAMPLE kMaxError = 1e-6f;
+
+class EngineFilterIIRBlockTest : public testing::Test {
+  protected:
+    std::vector<CSAMPLE> randomSamples(int numSamples) {
+        std::uniform_real_distribution<CSAMPLE> distribution(-1.0f, 1.0f);
+        std::vector<CSAMPLE> samples(numSamples);
+        for (auto& sample : samples) {
+            sample = distribution(m_randomEngine);
+        }
+        return samples;
+    }
+
+    // Processes the same input with both implementations, including
+    // coefficient changes, pauses and buffers that are shorter than
+    // the pipeline or longer than a ramping block.
+    template<unsigned int SIZE, enum IIRPass PASS, typename SetCoefs>
+    void expectSameOutput(SetCoefs setCoefs) {
+        EngineFilterIIR<SIZE, PASS> expectedFilter;
+        EngineFilterIIRBlock<SIZE, PASS> actualFilter;
+        constexpr int kBufferSizes[] = {2, 4, 6, 128, 130, 1024, 2, 998};
+        double freq = 250.0;
+        for (int round = 0; round < 32; ++round) {
+            const int bufferSize = kBufferSizes[round % std::size(kBufferSizes)];
+            if (round % 5 == 0) {
+                setCoefs(&expectedFilter, freq);
+                setCoefs(&actualFilter, freq);
+                freq *= 1.5;
+            }
+            if (round == 20) {
+                expectedFilter.pauseFilter();
+                actualFilter.pauseFilter();
+            }
+            if (round == 25) {
+                expectedFilter.setStartFromDry(true);
+                actualFilter.setStartFromDry(true);
+                expectedFilter.pauseFilter();
+                actualFilter.pauseFilter();
+            }
+            const std::vector<CSAMPLE> input = randomSamples(bufferSize);
+            std::vector<CSAMPLE> expected(bufferSize);
+            expectedFilter.process(input.data(), expected.data(), bufferSize);
+            // Odd rounds process in place
+            std::vector<CSAMPLE> actual(bufferSize);
+            if (round % 2) {
+                actual = input;
+                actualFilter.process(actual.data(), actual.data(), bufferSize);
+            } else {
+                actualFilter.process(input.data(), actual.data(), bufferSize);
+            }
+            for (int i = 0; i < bufferSize; ++i) {
+                ASSERT_NEAR(expected[i], actual[i], kMaxError)
+                        << "round " << round << ", sample " << i;
+            }
+        }
+    }
+
+    std::mt19937 m_randomEngine;
+};
+
+TEST_F(EngineFilterIIRBlockTest, linkwitzRiley8Low) {
+    expectSameOutput<8, IIR_LP>([](EngineFilterIIR<8, IIR_LP>* pFilter, double freq) {
+        pFilter->setCoefs2(44100,
+                4,
+                kFidSpecLowPassButterworth4,
+                sizeof(kFidSpecLowPassButterworth4),
+                freq,
+                0,
+                0,
+                kFidSpecLowPassButterworth4,
+                sizeof(kFidSpecLowPassButterworth4),
+                freq,
+                0,
+                0);
+    });
+}
+
+TEST_F(EngineFilterIIRBlockTest, linkwitzRiley8High) {
+    expectSameOutput<8, IIR_HP>([](EngineFilterIIR<8, IIR_HP>* pFilter, double freq) {
+        pFilter->setCoefs2(44100,
+                4,
+                kFidSpecHighPassButterworth4,
+                sizeof(kFidSpecHighPassButterworth4),
+                freq,
+                0,
+                0,
+                kFidSpecHighPassButterworth4,
+                sizeof(kFidSpecHighPassButterworth4),
+                freq,
+                0,
+                0);
+    });
+}
+
+TEST_F(EngineFilterIIRBlockTest, bessel8Band) {
+    expectSameOutput<16, IIR_BP>([](EngineFilterIIR<16, IIR_BP>* pFilter, double freq) {
+        pFilter->setCoefs(kFidSpecBandPassBessel8,
+                sizeof(kFidSpecBandPassBessel8),
+                44100,
+                freq,
+                freq * 4);
+    });
+}
+
+TEST_F(EngineFilterIIRBlockTest, biquadLow) {
+    expectSameOutput<2, IIR_LP>([](EngineFilterIIR<2, IIR_LP>* pFilter, double freq) {
+        pFilter->setCoefs(kFidSpecLowPassBiquad, sizeof(kFidSpecLowPassBiquad), 44100, freq);
+    });
+}
+
+TEST_F(EngineFilterIIRBlockTest, linkwitzRiley2High) {
+    expectSameOutput<2, IIR_HP2>([](EngineFilterIIR<2, IIR_HP2>* pFilter, double freq) {
+        pFilter->setCoefs2(44100,
+                1,
+                kFidSpecHighPassButterworth1,
+                sizeof(kFidSpecHighPassButterworth1),
+                freq,
+                0,
+                0,
+                kFidSpecHighPassButterworth1,
+                sizeof(kFidSpecHighPassButterworth1),
+                freq,
+                0,
+                0);
+    });
+}
+
+} // namespace
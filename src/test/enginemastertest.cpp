@@ -1,14 +1,18 @@
-#include <gtest/gtest.h>
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
+#include <gtest/gtest.h>
 
 #include <QtDebug>
 
+#include "control/controlindicatortimer.h"
 #include "control/controlproxy.h"
+#include "effects/effectsmanager.h"
 #include "engine/channels/enginechannel.h"
 #include "engine/enginemaster.h"
 #include "test/mixxxtest.h"
 #include "test/signalpathtest.h"
 #include "util/defs.h"
+#include "util/realtimecheck.h"
 #include "util/sample.h"
 #include "util/types.h"
 
@@ -17,9 +21,9 @@ using ::testing::_;
 
 namespace {
 
-class EngineChannelMock : public EngineChannel {
+class EngineChannelMockBase : public EngineChannel {
   public:
-    EngineChannelMock(const QString& group,
+    EngineChannelMockBase(const QString& group,
             ChannelOrientation defaultOrientation,
             EngineMaster* pMaster)
             : EngineChannel(pMaster->registerChannelGroup(group), defaultOrientation, nullptr, /*isTalkoverChannel*/ false, /*isPrimarydeck*/ true) {
@@ -39,8 +43,52 @@ class EngineChannelMock : public EngineChannel {
     MOCK_METHOD1(postProcess, void(const int iBufferSize));
 };
 
+// gmock allocates and locks a mutex when recording calls. These are
+// excluded from the realtime check, which still covers EngineMaster.
+class EngineChannelMock : public EngineChannelMockBase {
+  public:
+    using EngineChannelMockBase::EngineChannelMockBase;
+
+    ActiveState updateActiveState() override {
+        mixxx::RealtimeCheck::Suspension suspension;
+        return EngineChannelMockBase::updateActiveState();
+    }
+    bool isActive() override {
+        mixxx::RealtimeCheck::Suspension suspension;
+        return EngineChannelMockBase::isActive();
+    }
+    bool isMasterEnabled() const override {
+        mixxx::RealtimeCheck::Suspension suspension;
+        return EngineChannelMockBase::isMasterEnabled();
+    }
+    bool isPflEnabled() const override {
+        mixxx::RealtimeCheck::Suspension suspension;
+        return EngineChannelMockBase::isPflEnabled();
+    }
+    void process(CSAMPLE* pInOut, const int iBufferSize) override {
+        mixxx::RealtimeCheck::Suspension suspension;
+        EngineChannelMockBase::process(pInOut, iBufferSize);
+    }
+    void collectFeatures(GroupFeatureState* pGroupFeatures) const override {
+        mixxx::RealtimeCheck::Suspension suspension;
+        EngineChannelMockBase::collectFeatures(pGroupFeatures);
+    }
+    void postProcess(const int iBufferSize) override {
+        mixxx::RealtimeCheck::Suspension suspension;
+        EngineChannelMockBase::postProcess(iBufferSize);
+    }
+};
+
 class EngineMasterTest : public BaseSignalPathTest {
   protected:
+    void processBuffer() {
+        // Discard violations that have been reported by engine
+        // threads outside of this test
+        mixxx::RealtimeCheck::takeViolationReport();
+        m_pEngineMaster->process(MAX_BUFFER_LEN);
+        expectNoRealtimeViolations();
+    }
+
     void assertMasterBufferMatchesGolden(const QString& testName) {
           assertBufferMatchesReference(m_pEngineMaster->getMasterBuffer(), MAX_BUFFER_LEN,
               QString("%1-master").arg(testName));
@@ -83,7 +131,7 @@ TEST_F(EngineMasterTest, SingleChannelOutputWorks) {
             .Times(1)
             .WillOnce(Return());
 
-    m_pEngineMaster->process(MAX_BUFFER_LEN);
+    processBuffer();
 
     // Check that the master output contains the channel data.
     assertMasterBufferMatchesGolden(testName);
@@ -123,7 +171,7 @@ TEST_F(EngineMasterTest, SingleChannelPFLOutputWorks) {
             .Times(1)
             .WillOnce(Return());
 
-    m_pEngineMaster->process(MAX_BUFFER_LEN);
+    processBuffer();
 
     // Check that the master output is empty.
     assertMasterBufferMatchesGolden(testName);
@@ -186,7 +234,7 @@ TEST_F(EngineMasterTest, TwoChannelOutputWorks) {
             .Times(1)
             .WillOnce(Return());
 
-    m_pEngineMaster->process(MAX_BUFFER_LEN);
+    processBuffer();
 
     // Check that the master output contains the sum of the channel data.
     assertMasterBufferMatchesGolden(testName);
@@ -249,7 +297,7 @@ TEST_F(EngineMasterTest, TwoChannelPFLOutputWorks) {
             .Times(1)
             .WillOnce(Return());
 
-    m_pEngineMaster->process(MAX_BUFFER_LEN);
+    processBuffer();
 
     // Check that the master output contains the sum of the channel data.
     assertMasterBufferMatchesGolden(testName);
@@ -334,7 +382,7 @@ TEST_F(EngineMasterTest, ThreeChannelOutputWorks) {
             .Times(1)
             .WillOnce(Return());
 
-    m_pEngineMaster->process(MAX_BUFFER_LEN);
+    processBuffer();
 
     // Check that the master output contains the sum of the channel data.
     assertMasterBufferMatchesGolden(testName);
@@ -419,7 +467,7 @@ TEST_F(EngineMasterTest, ThreeChannelPFLOutputWorks) {
             .Times(1)
             .WillOnce(Return());
 
-    m_pEngineMaster->process(MAX_BUFFER_LEN);
+    processBuffer();
 
     // Check that the master output contains the sum of the channel data.
     assertMasterBufferMatchesGolden(testName);
@@ -428,4 +476,180 @@ TEST_F(EngineMasterTest, ThreeChannelPFLOutputWorks) {
     assertHeadphoneBufferMatchesGolden(testName);
 }
 
+// Emulates the CPU load of a deck with keylock and effects enabled
+// without depending on tracks, disk I/O or the scalers.
+class SyntheticLoadChannel : public EngineChannel {
+  public:
+    SyntheticLoadChannel(const QString& group,
+            EngineMaster* pMaster,
+            CSAMPLE initialPhase,
+            int loadIterations)
+            : EngineChannel(pMaster->registerChannelGroup(group),
+                      EngineChannel::CENTER,
+                      nullptr,
+                      /*isTalkoverChannel*/ false,
+                      /*isPrimarydeck*/ true),
+              m_loadIterations(loadIterations),
+              m_phase(initialPhase) {
+    }
+
+    ActiveState updateActiveState() override {
+        return ActiveState::Active;
+    }
+    bool isActive() override {
+        return true;
+    }
+    bool isMasterEnabled() const override {
+        return true;
+    }
+    bool isPflEnabled() const override {
+        return false;
+    }
+
+    void process(CSAMPLE* pInOut, const int iBufferSize) override {
+        for (int i = 0; i < iBufferSize; ++i) {
+            CSAMPLE value = m_phase;
+            for (int j = 0; j < m_loadIterations; ++j) {
+                value = 0.5f * value + 0.25f * value * value;
+            }
+            pInOut[i] = value;
+            m_phase += 0.0001f;
+            if (m_phase > 0.5f) {
+                m_phase -= 0.5f;
+            }
+        }
+    }
+
+    void postProcess(const int iBufferSize) override {
+        Q_UNUSED(iBufferSize);
+    }
+
+  private:
+    const int m_loadIterations;
+    CSAMPLE m_phase;
+};
+
+class EngineMasterParallelTest : public MixxxTest {
+  protected:
+    EngineMasterParallelTest()
+            : m_pControlIndicatorTimer(
+                      std::make_unique<mixxx::ControlIndicatorTimer>()) {
+    }
+
+    ~EngineMasterParallelTest() override {
+        destroyEngineMaster();
+    }
+
+    void createEngineMaster(
+            int numChannels, int numWorkerThreads, int loadIterations) {
+        m_pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
+        m_pEffectsManager = new EffectsManager(config(), m_pChannelHandleFactory);
+        m_pEngineMaster = new TestEngineMaster(config(),
+                m_sMasterGroup,
+                m_pEffectsManager,
+                m_pChannelHandleFactory,
+                false);
+        // The configured number is limited to the available cores, which
+        // would process the channels serially on small CI machines
+        m_pEngineMaster->setEngineWorkerThreads(numWorkerThreads);
+        for (int i = 0; i < numChannels; ++i) {
+            m_pEngineMaster->addChannel(new SyntheticLoadChannel(
+                    QStringLiteral("[Channel%1]").arg(i + 1),
+                    m_pEngineMaster,
+                    0.01f * (i + 1),
+                    loadIterations));
+        }
+    }
+
+    void destroyEngineMaster() {
+        // Deletes all EngineChannels added to it.
+        delete m_pEngineMaster;
+        m_pEngineMaster = nullptr;
+        delete m_pEffectsManager;
+        m_pEffectsManager = nullptr;
+    }
+
+    static const QString m_sMasterGroup;
+    std::unique_ptr<mixxx::ControlIndicatorTimer> m_pControlIndicatorTimer;
+    ChannelHandleFactoryPointer m_pChannelHandleFactory;
+    EffectsManager* m_pEffectsManager = nullptr;
+    TestEngineMaster* m_pEngineMaster = nullptr;
+};
+
+const QString EngineMasterParallelTest::m_sMasterGroup = QStringLiteral("[Master]");
+
+TEST_F(EngineMasterParallelTest, ParallelProcessingMatchesSerial) {
+    constexpr int kNumChannels = 8;
+    constexpr int kNumBuffers = 4;
+
+    createEngineMaster(kNumChannels, 0, 1);
+    std::vector<CSAMPLE> serialOutput;
+    mixxx::RealtimeCheck::takeViolationReport();
+    for (int i = 0; i < kNumBuffers; ++i) {
+        m_pEngineMaster->process(MAX_BUFFER_LEN);
+        expectNoRealtimeViolations();
+        const CSAMPLE* pMaster = m_pEngineMaster->getMasterBuffer();
+        serialOutput.insert(serialOutput.end(), pMaster, pMaster + MAX_BUFFER_LEN);
+    }
+    destroyEngineMaster();
+
+    createEngineMaster(kNumChannels, 3, 1);
+    ASSERT_EQ(3, m_pEngineMaster->numEngineWorkerThreads());
+    mixxx::RealtimeCheck::takeViolationReport();
+    for (int i = 0; i < kNumBuffers; ++i) {
+        m_pEngineMaster->process(MAX_BUFFER_LEN);
+        expectNoRealtimeViolations();
+        const CSAMPLE* pMaster = m_pEngineMaster->getMasterBuffer();
+        for (int j = 0; j < MAX_BUFFER_LEN; ++j) {
+            ASSERT_FLOAT_EQ(serialOutput[i * MAX_BUFFER_LEN + j], pMaster[j]);
+        }
+    }
+}
+
+// Google Benchmark does not run gtest fixtures, so the fixture is
+// instantiated manually.
+class EngineMasterBenchmark : public EngineMasterParallelTest {
+  public:
+    EngineMasterBenchmark(int numChannels, int numWorkerThreads) {
+        // Roughly the cost of a deck with keylock on a 2 GHz core
+        constexpr int kLoadIterations = 64;
+        createEngineMaster(numChannels, numWorkerThreads, kLoadIterations);
+    }
+
+    void process(int iBufferSize) {
+        m_pEngineMaster->process(iBufferSize);
+    }
+
+  private:
+    void TestBody() override {
+    }
+};
+
+// Measures the callback time for an increasing number of decks
+// with serial (0 worker threads) and parallel channel processing.
+static void BM_EngineMasterProcessChannels(benchmark::State& state) {
+    const int numChannels = static_cast<int>(state.range(0));
+    const int numWorkerThreads = static_cast<int>(state.range(1));
+    // 128 frames
+    constexpr int kBufferSize = 256;
+
+    EngineMasterBenchmark engineMaster(numChannels, numWorkerThreads);
+    for (auto _ : state) {
+        engineMaster.process(kBufferSize);
+    }
+}
+BENCHMARK(BM_EngineMasterProcessChannels)
+        ->ArgNames({"decks", "workers"})
+        ->UseRealTime()
+        ->Args({1, 0})
+        ->Args({2, 0})
+        ->Args({4, 0})
+        ->Args({8, 0})
+        ->Args({16, 0})
+        ->Args({1, 3})
+        ->Args({2, 3})
+        ->Args({4, 3})
+        ->Args({8, 3})
+        ->Args({16, 3});
+
 }  // namespace
@@ -0,0 +1,130 @@
+#include "util/imagefilecache.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtDebug>
+
+namespace {
+
+QImage createTestImage(int width, int height) {
+    QImage image(width, height, QImage::Format_RGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixel(x, y, qRgb(x % 256, y % 256, (x + y) % 256));
+        }
+    }
+    return image;
+}
+
+class ImageFileCacheTest : public testing::Test {
+  protected:
+    ImageFileCacheTest()
+            : m_cache(m_tempDir.filePath("cache")) {
+    }
+
+    QStringList fileNames() const {
+        return QDir(m_cache.directory()).entryList(QDir::Files, QDir::Name);
+    }
+
+    QTemporaryDir m_tempDir;
+    mixxx::ImageFileCache m_cache;
+};
+
+TEST_F(ImageFileCacheTest, StoreAndLoad) {
+    ASSERT_TRUE(m_cache.isValid());
+    EXPECT_TRUE(m_cache.load("image").isNull());
+
+    const QImage image = createTestImage(31, 17);
+    ASSERT_TRUE(m_cache.store("image", image));
+    const QImage cachedImage = m_cache.load("image");
+    EXPECT_EQ(image.format(), cachedImage.format());
+    EXPECT_EQ(image, cachedImage);
+
+    const QImage transparentImage = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    ASSERT_TRUE(m_cache.store("image", transparentImage));
+    EXPECT_EQ(transparentImage, m_cache.load("image"));
+}
+
+TEST_F(ImageFileCacheTest, IgnoreInvalidFiles) {
+    ASSERT_TRUE(m_cache.store("image", createTestImage(8, 8)));
+    QFile file(m_cache.filePath("image"));
+    ASSERT_TRUE(file.resize(file.size() - 1));
+    EXPECT_TRUE(m_cache.load("image").isNull());
+
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(QByteArray(64, 'x'));
+    file.close();
+    EXPECT_TRUE(m_cache.load("image").isNull());
+}
+
+TEST_F(ImageFileCacheTest, Retain) {
+    const QImage image = createTestImage(8, 8);
+    ASSERT_TRUE(m_cache.store("a@1", image));
+    ASSERT_TRUE(m_cache.store("b@1", image));
+    ASSERT_TRUE(m_cache.store("c@1.5", image));
+    m_cache.retain(QSet<QString>{"a@1", "c@1.5"});
+    EXPECT_EQ((QStringList{"a@1.img", "c@1.5.img"}), fileNames());
+}
+
+TEST_F(ImageFileCacheTest, PruneLeastRecentlyUsed) {
+    const QImage image = createTestImage(64, 64);
+    ASSERT_TRUE(m_cache.store("a", image));
+    ASSERT_TRUE(m_cache.store("b", image));
+    ASSERT_TRUE(m_cache.store("c", image));
+    const qint64 fileSize = QFileInfo(m_cache.filePath("a")).size();
+    const QDateTime storedTime = QFileInfo(m_cache.filePath("a")).lastModified();
+
+    // The resolution of file times is coarse on some file systems
+    QThread::msleep(1100);
+    EXPECT_FALSE(m_cache.load("a").isNull());
+    EXPECT_LT(storedTime, QFileInfo(m_cache.filePath("a")).lastModified());
+
+    m_cache.prune(2 * fileSize);
+    ASSERT_EQ(2, fileNames().size());
+    EXPECT_TRUE(fileNames().contains("a.img"));
+}
+
+class ImageFileCacheBenchmark {
+  public:
+    ImageFileCacheBenchmark()
+            : m_cache(m_tempDir.filePath("cache")),
+              m_image(createTestImage(256, 256)) {
+        QBuffer buffer(&m_jpegData);
+        buffer.open(QIODevice::WriteOnly);
+        m_image.save(&buffer, "JPG");
+        m_cache.store("image", m_image);
+    }
+
+    QTemporaryDir m_tempDir;
+    mixxx::ImageFileCache m_cache;
+    QImage m_image;
+    QByteArray m_jpegData;
+};
+
+static void BM_DecodeJpegCover(benchmark::State& state) {
+    ImageFileCacheBenchmark fixture;
+    for (auto _ : state) {
+        QImage image = QImage::fromData(fixture.m_jpegData, "JPG");
+        benchmark::DoNotOptimize(image.constBits());
+    }
+}
+BENCHMARK(BM_DecodeJpegCover);
+
+static void BM_ImageFileCacheLoad(benchmark::State& state) {
+    ImageFileCacheBenchmark fixture;
+    for (auto _ : state) {
+        QImage image = fixture.m_cache.load("image");
+        benchmark::DoNotOptimize(image.constBits());
+    }
+}
+BENCHMARK(BM_ImageFileCacheLoad);
+
+} // namespace
@@ -1,15 +1,91 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <thread>
+#include <vector>
+
 #include "test/librarytest.h"
 
+#include "library/dao/trackdao.h"
 #include "library/scanner/libraryscanner.h"
+#include "sources/soundsourceproxy.h"
+#include "track/track.h"
+
+namespace {
+
+const QStringList kTrackFileNames = {
+        QStringLiteral("TOAL_TPE2.mp3"),
+        QStringLiteral("artist.mp3"),
+        QStringLiteral("cover-test-jpg.mp3"),
+        QStringLiteral("cover-test-png.mp3"),
+        QStringLiteral("cover-test-vbr.mp3"),
+        QStringLiteral("cover-test.aiff"),
+        QStringLiteral("cover-test.flac"),
+        QStringLiteral("cover-test.ogg"),
+        QStringLiteral("cover-test.wav"),
+};
+
+constexpr int kNumWorkerThreads = 4;
+
+} // namespace
 
 class LibraryScannerTest : public LibraryTest {
   protected:
     LibraryScannerTest()
             : m_libraryScanner(dbConnectionPooler(), config()) {
     }
+
+    // Copies the test files, because each file can only be added once
+    QStringList copyTrackFiles(const QDir& targetDir) const {
+        QStringList trackLocations;
+        for (const auto& fileName : kTrackFileNames) {
+            const QString trackLocation = targetDir.filePath(fileName);
+            EXPECT_TRUE(QFile::copy(
+                    getTestDir().filePath(QStringLiteral("id3-test-data/") + fileName),
+                    trackLocation));
+            trackLocations.append(trackLocation);
+        }
+        return trackLocations;
+    }
+
+    // Parses the tags of new files like the ImportFilesTasks do on the
+    // worker threads of the scanner
+    std::vector<TrackPointer> parseTracksConcurrently(
+            const QStringList& trackLocations) const {
+        const auto params = SyncTrackMetadataParams::readFromUserSettings(*config());
+        std::vector<TrackPointer> parsedTracks(trackLocations.size());
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kNumWorkerThreads; ++i) {
+            threads.emplace_back([&trackLocations, &parsedTracks, &params, i] {
+                for (int j = i; j < trackLocations.size(); j += kNumWorkerThreads) {
+                    parsedTracks[j] = Track::newTemporary(trackLocations[j]);
+                    SoundSourceProxy(parsedTracks[j])
+                            .updateTrackFromSource(
+                                    SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                                    params);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return parsedTracks;
+    }
+
+    // Adds a new track like the scanner thread does
+    TrackPointer addNewTrack(
+            const QString& trackLocation,
+            const TrackPointer& pParsedTrack) const {
+        TrackDAO& trackDao = internalCollection()->getTrackDAO();
+        trackDao.addTracksPrepare();
+        const auto pTrack = trackDao.addTracksAddFile(trackLocation, false, pParsedTrack);
+        trackDao.addTracksFinish(!pTrack);
+        return pTrack;
+    }
+
     LibraryScanner m_libraryScanner;
 };
 
@@ -52,3 +128,39 @@ TEST_F(LibraryScannerTest, ScannerRoundtrip) {
     m_libraryScanner.changeScannerState(LibraryScanner::IDLE);
     EXPECT_EQ(m_libraryScanner.m_state, LibraryScanner::IDLE);
 }
+
+TEST_F(LibraryScannerTest, AddTracksParsedConcurrently) {
+    QTemporaryDir sequentialDir;
+    QTemporaryDir concurrentDir;
+    const QStringList sequentialLocations = copyTrackFiles(QDir(sequentialDir.path()));
+    const QStringList concurrentLocations = copyTrackFiles(QDir(concurrentDir.path()));
+
+    const auto parsedTracks = parseTracksConcurrently(concurrentLocations);
+    for (int i = 0; i < kTrackFileNames.size(); ++i) {
+        ASSERT_TRUE(parsedTracks[i]);
+        EXPECT_TRUE(parsedTracks[i]->checkSourceSynchronized());
+
+        const auto pSequentialTrack = addNewTrack(sequentialLocations[i], nullptr);
+        const auto pConcurrentTrack = addNewTrack(concurrentLocations[i], parsedTracks[i]);
+        ASSERT_TRUE(pSequentialTrack);
+        ASSERT_TRUE(pConcurrentTrack);
+        EXPECT_TRUE(pConcurrentTrack->getId().isValid());
+        EXPECT_NE(pSequentialTrack->getId(), pConcurrentTrack->getId());
+        EXPECT_TRUE(pConcurrentTrack->checkSourceSynchronized());
+        EXPECT_EQ(pSequentialTrack->getMetadata(), pConcurrentTrack->getMetadata())
+                << kTrackFileNames[i].toStdString();
+    }
+}
+
+TEST_F(LibraryScannerTest, IgnoreTrackParsedFromOtherFile) {
+    QTemporaryDir tempDir;
+    const QStringList trackLocations = copyTrackFiles(QDir(tempDir.path()));
+    const auto parsedTracks = parseTracksConcurrently(trackLocations);
+
+    // The metadata of another file must not be adopted
+    const auto pTrack = addNewTrack(trackLocations[0], parsedTracks[1]);
+    ASSERT_TRUE(pTrack);
+    EXPECT_EQ(trackLocations[0], pTrack->getLocation());
+    EXPECT_EQ(parsedTracks[0]->getMetadata(), pTrack->getMetadata());
+    EXPECT_NE(parsedTracks[1]->getMetadata(), pTrack->getMetadata());
+}
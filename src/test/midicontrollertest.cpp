@@ -1,6 +1,7 @@
 #include <gmock/gmock.h>
 
 #include <QScopedPointer>
+#include <QTemporaryFile>
 
 #include "control/controlpotmeter.h"
 #include "control/controlpushbutton.h"
@@ -16,7 +17,20 @@ class MockMidiController : public MidiController {
     explicit MockMidiController()
             : MidiController("test") {
     }
-    ~MockMidiController() override { }
+    ~MockMidiController() override {
+        if (getScriptEngine()) {
+            stopEngine();
+        }
+    }
+
+    void startScriptEngine(const QFileInfo& scriptFile) {
+        startEngine();
+        LegacyControllerMapping::ScriptFileInfo script;
+        script.file = scriptFile;
+        getScriptEngine()->setScriptFiles({script});
+        getScriptEngine()->setTesting(true);
+        getScriptEngine()->initialize();
+    }
 
     MOCK_METHOD0(open, int());
     MOCK_METHOD0(close, int());
@@ -51,6 +65,14 @@ class MidiControllerTest : public MixxxTest {
                 value);
     }
 
+    void beginInputBatch() {
+        m_pController->beginInputBatch();
+    }
+
+    void endInputBatch() {
+        m_pController->endInputBatch();
+    }
+
     std::shared_ptr<LegacyMidiControllerMapping> m_pMapping;
     QScopedPointer<MockMidiController> m_pController;
 };
@@ -596,3 +618,72 @@ TEST_F(MidiControllerTest, ReceiveMessage_PotMeterCO_14BitPitchBend) {
     receivedShortMessage(MidiOpCode::PitchBendChange, channel, 0x01, 0x40);
     EXPECT_LT(kMiddleValue, potmeter.get());
 }
+
+TEST_F(MidiControllerTest, ReceiveMessage_BatchedScriptBinding) {
+    ControlObject calls(ConfigKey("[Test]", "calls"));
+    ControlObject last(ConfigKey("[Test]", "last"));
+    ControlObject sum(ConfigKey("[Test]", "sum"));
+    ConfigKey key("[Channel1]", "hotcue_1_activate");
+    ControlPushButton cpb(key);
+
+    QTemporaryFile scriptFile;
+    ASSERT_TRUE(scriptFile.open());
+    scriptFile.write(
+            "var TestScript = {"
+            "  jog: function(channel, control, value, status, group, values) {"
+            "    engine.setValue('[Test]', 'calls',"
+            "        engine.getValue('[Test]', 'calls') + 1);"
+            "    engine.setValue('[Test]', 'last', value);"
+            "    engine.setValue('[Test]', 'sum', values.reduce("
+            "        function(a, b) { return a + b; },"
+            "        engine.getValue('[Test]', 'sum')));"
+            "  }"
+            "};");
+    scriptFile.close();
+    m_pController->startScriptEngine(QFileInfo(scriptFile.fileName()));
+
+    unsigned char channel = 0x01;
+    unsigned char jogControl = 0x20;
+    unsigned char buttonControl = 0x10;
+
+    addMapping(MidiInputMapping(MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                                                MidiOpCode::ControlChange, channel),
+                                        jogControl),
+            MidiOption::Script | MidiOption::Batch,
+            ConfigKey("[Channel1]", "TestScript.jog")));
+    addMapping(MidiInputMapping(MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                                                MidiOpCode::NoteOn, channel),
+                                        buttonControl),
+            MidiOptions(),
+            key));
+    m_pController->setMapping(m_pMapping->clone());
+
+    // Outside of a batch each message is passed on immediately
+    receivedShortMessage(MidiOpCode::ControlChange, channel, jogControl, 1);
+    EXPECT_DOUBLE_EQ(1.0, calls.get());
+    EXPECT_DOUBLE_EQ(1.0, last.get());
+    EXPECT_DOUBLE_EQ(1.0, sum.get());
+
+    // Consecutive messages are coalesced
+    beginInputBatch();
+    receivedShortMessage(MidiOpCode::ControlChange, channel, jogControl, 2);
+    receivedShortMessage(MidiOpCode::ControlChange, channel, jogControl, 3);
+    receivedShortMessage(MidiOpCode::ControlChange, channel, jogControl, 4);
+    EXPECT_DOUBLE_EQ(1.0, calls.get());
+    endInputBatch();
+    EXPECT_DOUBLE_EQ(2.0, calls.get());
+    EXPECT_DOUBLE_EQ(4.0, last.get());
+    EXPECT_DOUBLE_EQ(10.0, sum.get());
+
+    // Messages for other mappings are processed in order
+    beginInputBatch();
+    receivedShortMessage(MidiOpCode::ControlChange, channel, jogControl, 5);
+    receivedShortMessage(MidiOpCode::NoteOn, channel, buttonControl, 0x7F);
+    EXPECT_DOUBLE_EQ(3.0, calls.get());
+    EXPECT_LT(0.0, cpb.get());
+    receivedShortMessage(MidiOpCode::ControlChange, channel, jogControl, 6);
+    endInputBatch();
+    EXPECT_DOUBLE_EQ(4.0, calls.get());
+    EXPECT_DOUBLE_EQ(6.0, last.get());
+    EXPECT_DOUBLE_EQ(21.0, sum.get());
+}
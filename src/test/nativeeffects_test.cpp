@@ -1,3 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include "engine/filters/enginefilteriirblock.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+constexpr char kFidSpecLowPassButterworth4[] = "LpBu4";
+constexpr char kFidSpecHighPassButterworth4[] = "HpBu4";
+constexpr char kFidSpecBandPassBessel8[] = "BpBe8";
+
+// Compares the sample by sample EngineFilterIIR with the block processing
+// EngineFilterIIRBlock for the filters of the built-in EQs
+template<class Filter, typename SetCoefs>
+void benchmarkFilter(benchmark::State& state, SetCoefs setCoefs) {
+    const SINT size = static_cast<SINT>(state.range(0));
+    Filter filter;
+    setCoefs(&filter);
+    filter.assumeSettled();
+
+    mixxx::SampleBuffer input(size);
+    mixxx::SampleBuffer output(size);
+    for (SINT i = 0; i < size; ++i) {
+        input.data()[i] = (i % 64) / 32.0f - 1.0f;
+    }
+
+    while (state.KeepRunning()) {
+        filter.process(input.data(), output.data(), static_cast<int>(size));
+    }
+}
+
+template<unsigned int SIZE, enum IIRPass PASS>
+void setLinkwitzRiley8Coefs(EngineFilterIIR<SIZE, PASS>* pFilter,
+        const char* spec,
+        size_t specSize) {
+    pFilter->setCoefs2(44100, 4, spec, specSize, 250, 0, 0, spec, specSize, 250, 0, 0);
+}
+
+static void BM_EngineFilterIIR_LinkwitzRiley8Low(benchmark::State& state) {
+    benchmarkFilter<EngineFilterIIR<8, IIR_LP>>(state, [](auto* pFilter) {
+        setLinkwitzRiley8Coefs(pFilter,
+                kFidSpecLowPassButterworth4,
+                sizeof(kFidSpecLowPassButterworth4));
+    });
+}
+BENCHMARK(BM_EngineFilterIIR_LinkwitzRiley8Low)->Range(64, 4096);
+
+static void BM_EngineFilterIIRBlock_LinkwitzRiley8Low(benchmark::State& state) {
+    benchmarkFilter<EngineFilterIIRBlock<8, IIR_LP>>(state, [](auto* pFilter) {
+        setLinkwitzRiley8Coefs(pFilter,
+                kFidSpecLowPassButterworth4,
+                sizeof(kFidSpecLowPassButterworth4));
+    });
+}
+BENCHMARK(BM_EngineFilterIIRBlock_LinkwitzRiley8Low)->Range(64, 4096);
+
+static void BM_EngineFilterIIR_LinkwitzRiley8High(benchmark::State& state) {
+    benchmarkFilter<EngineFilterIIR<8, IIR_HP>>(state, [](auto* pFilter) {
+        setLinkwitzRiley8Coefs(pFilter,
+                kFidSpecHighPassButterworth4,
+                sizeof(kFidSpecHighPassButterworth4));
+    });
+}
+BENCHMARK(BM_EngineFilterIIR_LinkwitzRiley8High)->Range(64, 4096);
+
+static void BM_EngineFilterIIRBlock_LinkwitzRiley8High(benchmark::State& state) {
+    benchmarkFilter<EngineFilterIIRBlock<8, IIR_HP>>(state, [](auto* pFilter) {
+        setLinkwitzRiley8Coefs(pFilter,
+                kFidSpecHighPassButterworth4,
+                sizeof(kFidSpecHighPassButterworth4));
+    });
+}
+BENCHMARK(BM_EngineFilterIIRBlock_LinkwitzRiley8High)->Range(64, 4096);
+
+static void BM_EngineFilterIIR_Bessel8Band(benchmark::State& state) {
+    benchmarkFilter<EngineFilterIIR<16, IIR_BP>>(state, [](auto* pFilter) {
+        pFilter->setCoefs(kFidSpecBandPassBessel8, sizeof(kFidSpecBandPassBessel8), 44100, 250, 2500);
+    });
+}
+BENCHMARK(BM_EngineFilterIIR_Bessel8Band)->Range(64, 4096);
+
+static void BM_EngineFilterIIRBlock_Bessel8Band(benchmark::State& state) {
+    benchmarkFilter<EngineFilterIIRBlock<16, IIR_BP>>(state, [](auto* pFilter) {
+        pFilter->setCoefs(kFidSpecBandPassBessel8, sizeof(kFidSpecBandPassBessel8), 44100, 250, 2500);
+    });
+}
+BENCHMARK(BM_EngineFilterIIRBlock_Bessel8Band)->Range(64, 4096);
+
+} // namespace
+
 #if 0
 // TODO: make this work again
 #include <benchmark/benchmark.h>
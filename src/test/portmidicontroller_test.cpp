@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QScopedPointer>
+#include <QThread>
 
 #include "controllers/midi/portmidicontroller.h"
 #include "controllers/midi/portmididevice.h"
@@ -9,6 +12,7 @@
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::InvokeWithoutArgs;
 using ::testing::NotNull;
 using ::testing::Return;
 using ::testing::Sequence;
@@ -443,3 +447,49 @@ TEST_F(PortMidiControllerTest, Poll_Read_SysEx_BufferOverflow) {
     pollDevice();
     pollDevice();
 };
+
+TEST_F(PortMidiControllerTest, InputThread_Read) {
+    std::vector<PmEvent> messages;
+    messages.push_back(MakeEvent(0x403C90, 0x0));
+    messages.push_back(MakeEvent(0x403C80, 0x1));
+
+    EXPECT_CALL(*m_mockInput, openInput(MIXXX_PORTMIDI_BUFFER_LEN))
+            .WillOnce(Return(pmNoError));
+    EXPECT_CALL(*m_mockInput, isOpen())
+            .WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mockInput, close())
+            .WillOnce(Return(pmNoError));
+    EXPECT_CALL(*m_mockOutput, openOutput())
+            .WillOnce(Return(pmNoError));
+    EXPECT_CALL(*m_mockOutput, isOpen())
+            .WillRepeatedly(Return(false));
+
+    // The input thread polls the device until data is available
+    EXPECT_CALL(*m_mockInput, poll())
+            .WillOnce(Return(pmNoData))
+            .WillOnce(Return(pmGotData))
+            .WillRepeatedly(Return(pmNoData));
+    EXPECT_CALL(*m_mockInput, read(NotNull(), _))
+            .WillOnce(DoAll(SetArrayArgument<0>(messages.begin(), messages.end()),
+                    Return(static_cast<int>(messages.size()))));
+
+    int receivedCount = 0;
+    Sequence read;
+    EXPECT_CALL(*m_pController, receivedShortMessage(0x90, 0x3C, 0x40, _))
+            .InSequence(read)
+            .WillOnce(InvokeWithoutArgs([&receivedCount] { ++receivedCount; }));
+    EXPECT_CALL(*m_pController, receivedShortMessage(0x80, 0x3C, 0x40, _))
+            .InSequence(read)
+            .WillOnce(InvokeWithoutArgs([&receivedCount] { ++receivedCount; }));
+
+    openDevice();
+    // The messages are processed by the event loop of the controller's thread
+    QElapsedTimer timer;
+    timer.start();
+    while (receivedCount < 2 && timer.elapsed() < 5000) {
+        QCoreApplication::processEvents();
+        QThread::msleep(1);
+    }
+    closeDevice();
+    EXPECT_EQ(2, receivedCount);
+};
@@ -138,3 +138,26 @@ TEST_F(ReadAheadManagerTest, FractionalFrameLoop) {
     // The rounding error must not exceed a half frame (one samples in stereo)
     EXPECT_NEAR(16, m_pReadAheadManager->getPlaypos(), 1);
 }
+
+TEST_F(ReadAheadManagerTest, ReadLogOfManyLoops) {
+    // The read log is a ring of fixed capacity. Loop more often
+    // than its capacity while consuming the log like the engine.
+    m_pReadAheadManager->notifySeek(0);
+    m_pLoopControl->pushTriggerReturnValue(20);
+    m_pLoopControl->pushTargetReturnValue(4);
+    EXPECT_EQ(20, m_pReadAheadManager->getNextSamples(1.0, m_pBuffer, 20));
+    EXPECT_EQ(20, m_pReadAheadManager->getFilePlaypositionFromLog(0.0, 20.0));
+    for (int i = 0; i < 3000; ++i) {
+        m_pLoopControl->pushTriggerReturnValue(20);
+        m_pLoopControl->pushTargetReturnValue(4);
+        // Two loops in a single callback
+        m_pLoopControl->pushTriggerReturnValue(20);
+        m_pLoopControl->pushTargetReturnValue(4);
+        EXPECT_EQ(16, m_pReadAheadManager->getNextSamples(1.0, m_pBuffer, 16));
+        EXPECT_EQ(16, m_pReadAheadManager->getNextSamples(1.0, m_pBuffer, 16));
+        EXPECT_EQ(12, m_pReadAheadManager->getFilePlaypositionFromLog(20.0, 8.0));
+        // Crosses the loop boundary
+        EXPECT_EQ(8, m_pReadAheadManager->getFilePlaypositionFromLog(12.0, 12.0));
+        EXPECT_EQ(20, m_pReadAheadManager->getFilePlaypositionFromLog(8.0, 12.0));
+    }
+}
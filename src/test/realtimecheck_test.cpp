@@ -0,0 +1,109 @@
+#include "util/realtimecheck.h"
+
+#include <gtest/gtest.h>
+
+#include <QMutex>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+class RealtimeCheckTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        mixxx::RealtimeCheck::takeViolationReport();
+    }
+};
+
+TEST_F(RealtimeCheckTest, NoViolations) {
+    {
+        mixxx::RealtimeCheck::Scope realtimeScope;
+        int value = 0;
+        ++value;
+        EXPECT_EQ(1, value);
+    }
+    EXPECT_TRUE(mixxx::RealtimeCheck::takeViolationReport().isEmpty());
+}
+
+TEST_F(RealtimeCheckTest, ViolationsOutsideOfScopeAreIgnored) {
+    auto pValue = std::make_unique<int>(1);
+    pValue.reset();
+    std::mutex mutex;
+    mutex.lock();
+    mutex.unlock();
+    EXPECT_TRUE(mixxx::RealtimeCheck::takeViolationReport().isEmpty());
+}
+
+TEST_F(RealtimeCheckTest, ReportViolations) {
+    if (!mixxx::RealtimeCheck::isEnabled()) {
+        // The hooks are only linked with the REALTIME_CHECK option
+        return;
+    }
+    std::mutex mutex;
+    {
+        mixxx::RealtimeCheck::Scope realtimeScope;
+        auto pValue = std::make_unique<int>(1);
+        pValue.reset();
+        mutex.lock();
+        mutex.unlock();
+    }
+    EXPECT_EQ(3, mixxx::RealtimeCheck::takeViolationCount());
+}
+
+TEST_F(RealtimeCheckTest, ReportContendedQMutex) {
+    if (!mixxx::RealtimeCheck::isEnabled()) {
+        return;
+    }
+#ifndef __linux__
+    GTEST_SKIP() << "QMutex is only detected on Linux";
+#endif
+    QMutex mutex;
+    mutex.lock();
+    std::thread realtimeThread([&mutex] {
+        mixxx::RealtimeCheck::Scope realtimeScope;
+        // Waits on the futex until the mutex is unlocked
+        mutex.lock();
+        mutex.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    mutex.unlock();
+    realtimeThread.join();
+    EXPECT_LE(1, mixxx::RealtimeCheck::takeViolationCount());
+}
+
+TEST_F(RealtimeCheckTest, SuspendedViolationsAreIgnored) {
+    {
+        mixxx::RealtimeCheck::Scope realtimeScope;
+        {
+            mixxx::RealtimeCheck::Suspension suspension;
+            EXPECT_FALSE(mixxx::RealtimeCheck::isRealtime());
+            auto pValue = std::make_unique<int>(1);
+            pValue.reset();
+        }
+        EXPECT_TRUE(mixxx::RealtimeCheck::isRealtime());
+    }
+    EXPECT_FALSE(mixxx::RealtimeCheck::isRealtime());
+    EXPECT_TRUE(mixxx::RealtimeCheck::takeViolationReport().isEmpty());
+}
+
+TEST_F(RealtimeCheckTest, ViolationReportContainsStack) {
+    if (!mixxx::RealtimeCheck::isEnabled()) {
+        return;
+    }
+    std::unique_ptr<int> pValue;
+    {
+        mixxx::RealtimeCheck::Scope realtimeScope;
+        pValue = std::make_unique<int>(1);
+    }
+    const QString report = mixxx::RealtimeCheck::takeViolationReport();
+    EXPECT_TRUE(report.contains(QStringLiteral("Allocation of 4 bytes")))
+            << report.toStdString();
+    // Symbols of local functions cannot be resolved, but the
+    // number of frames is known
+    EXPECT_GT(report.count(QChar('\n')), 2) << report.toStdString();
+    EXPECT_TRUE(mixxx::RealtimeCheck::takeViolationReport().isEmpty());
+}
+
+} // namespace
@@ -0,0 +1,285 @@
+// Interposes the allocation functions, pthread_mutex_lock and on Linux the
+// futex system call in mixxx-test to report all calls on realtime threads.
+// Only built with the REALTIME_CHECK CMake option.
+//
+// With glibc the C allocation functions are replaced, which also covers
+// allocations of C libraries. Otherwise only the C++ allocation functions
+// are replaced.
+//
+// QMutex bypasses pthread and locks with atomic operations. Only if the
+// mutex is contended it waits on a futex, which Qt invokes through the
+// syscall() function of libc. Uncontended QMutex locks remain undetected.
+
+#include <dlfcn.h>
+#include <pthread.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "util/realtimecheck.h"
+
+using mixxx::RealtimeCheck;
+
+namespace {
+
+void checkAllocation(std::size_t size) {
+    if (RealtimeCheck::isRealtime()) {
+        RealtimeCheck::reportViolation(RealtimeCheck::Violation::Allocation, size);
+    }
+}
+
+void checkDeallocation(void* ptr) {
+    if (ptr && RealtimeCheck::isRealtime()) {
+        RealtimeCheck::reportViolation(RealtimeCheck::Violation::Deallocation);
+    }
+}
+
+using PthreadMutexLockFunction = int (*)(pthread_mutex_t*);
+
+std::atomic<PthreadMutexLockFunction> s_realPthreadMutexLock(nullptr);
+
+PthreadMutexLockFunction realPthreadMutexLock() {
+    auto function = s_realPthreadMutexLock.load(std::memory_order_relaxed);
+    if (!function) {
+        function = reinterpret_cast<PthreadMutexLockFunction>(
+                dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        s_realPthreadMutexLock.store(function, std::memory_order_relaxed);
+    }
+    return function;
+}
+
+#ifdef __linux__
+using SyscallFunction = long (*)(long, ...);
+
+std::atomic<SyscallFunction> s_realSyscall(nullptr);
+
+SyscallFunction realSyscall() {
+    auto function = s_realSyscall.load(std::memory_order_relaxed);
+    if (!function) {
+        function = reinterpret_cast<SyscallFunction>(dlsym(RTLD_NEXT, "syscall"));
+        s_realSyscall.store(function, std::memory_order_relaxed);
+    }
+    return function;
+}
+
+// The operations that block until the futex is released
+bool isFutexWait(long operation) {
+    switch (operation & FUTEX_CMD_MASK) {
+    case FUTEX_WAIT:
+    case FUTEX_WAIT_BITSET:
+    case FUTEX_LOCK_PI:
+    case FUTEX_WAIT_REQUEUE_PI:
+        return true;
+    default:
+        return false;
+    }
+}
+#endif
+
+// Resolves the original functions before any realtime thread needs them,
+// because dlsym() allocates
+struct RealtimeCheckInitializer {
+    RealtimeCheckInitializer() {
+        realPthreadMutexLock();
+#ifdef __linux__
+        realSyscall();
+#endif
+        RealtimeCheck::enable();
+    }
+} s_realtimeCheckInitializer;
+
+} // anonymous namespace
+
+extern "C" {
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+    if (RealtimeCheck::isRealtime()) {
+        // Uncontended locks are just as bad, because they may block on
+        // any other run
+        RealtimeCheck::reportViolation(RealtimeCheck::Violation::Lock);
+    }
+    return realPthreadMutexLock()(mutex);
+}
+
+#ifdef __linux__
+long syscall(long number, ...) noexcept {
+    // All system calls take at most 6 arguments that are passed in
+    // registers. Reading unused arguments is harmless on the supported
+    // ABIs, glibc's own syscall() does the same.
+    long args[6];
+    va_list list;
+    va_start(list, number);
+    for (auto& arg : args) {
+        arg = va_arg(list, long);
+    }
+    va_end(list);
+    if (number == SYS_futex && RealtimeCheck::isRealtime() && isFutexWait(args[1])) {
+        // A contended QMutex, QWaitCondition or QSemaphore
+        RealtimeCheck::reportViolation(RealtimeCheck::Violation::Lock);
+    }
+    return realSyscall()(number, args[0], args[1], args[2], args[3], args[4], args[5]);
+}
+#endif
+
+} // extern "C"
+
+#ifdef __GLIBC__
+
+// The original implementations that are exported by glibc
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void* ptr);
+}
+
+extern "C" {
+
+void* malloc(std::size_t size) noexcept {
+    checkAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+    checkAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, std::size_t size) noexcept {
+    checkAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size) noexcept {
+    checkAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+    checkAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pPtr, std::size_t alignment, std::size_t size) noexcept {
+    checkAllocation(size);
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *pPtr = ptr;
+    return 0;
+}
+
+void free(void* ptr) noexcept {
+    checkDeallocation(ptr);
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+#else // __GLIBC__
+
+namespace {
+
+void* allocate(std::size_t size) {
+    checkAllocation(size);
+    // malloc(0) may return nullptr
+    void* ptr = std::malloc(size > 0 ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    checkAllocation(size);
+    const auto align = static_cast<std::size_t>(alignment);
+    // The size must be a multiple of the alignment
+    void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void deallocate(void* ptr) {
+    checkDeallocation(ptr);
+    std::free(ptr);
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+#endif // __GLIBC__
@@ -4,6 +4,9 @@
 #include <QList>
 #include <QPair>
 #include <QtDebug>
+#include <cstring>
+#include <functional>
+#include <random>
 #include <vector>
 
 #include "util/sample.h"
@@ -11,6 +14,34 @@
 
 namespace {
 
+// Selects the kernels of a SIMD level until the object is destroyed
+class ScopedSimdLevel {
+  public:
+    explicit ScopedSimdLevel(SampleUtil::SimdLevel level)
+            : m_previousLevel(SampleUtil::simdLevel()),
+              m_supported(SampleUtil::setSimdLevel(level)) {
+    }
+    ~ScopedSimdLevel() {
+        SampleUtil::setSimdLevel(m_previousLevel);
+    }
+
+    bool isSupported() const {
+        return m_supported;
+    }
+
+  private:
+    const SampleUtil::SimdLevel m_previousLevel;
+    const bool m_supported;
+};
+
+const SampleUtil::SimdLevel kSimdLevels[] = {
+        SampleUtil::SimdLevel::Scalar,
+        SampleUtil::SimdLevel::Sse41,
+        SampleUtil::SimdLevel::Avx2,
+        SampleUtil::SimdLevel::Avx512,
+        SampleUtil::SimdLevel::Neon,
+};
+
 class SampleUtilTest : public testing::Test {
   protected:
     void SetUp() override {
@@ -397,6 +428,136 @@ TEST_F(SampleUtilTest, copyReverse) {
     }
 }
 
+class SampleUtilSimdTest : public testing::Test {
+  protected:
+    typedef std::function<std::vector<CSAMPLE>(SINT numFrames)> Kernel;
+
+    // Numbers of frames that are not a multiple of any vector size
+    // to cover the scalar tails of the kernels.
+    static constexpr SINT kNumFrames[] = {0, 1, 3, 7, 8, 15, 16, 17, 33, 1023, 1027};
+
+    std::vector<CSAMPLE> randomSamples(SINT numSamples) {
+        // Samples beyond the peak for detecting clipping
+        std::uniform_real_distribution<CSAMPLE> distribution(-1.5f, 1.5f);
+        std::vector<CSAMPLE> samples(numSamples);
+        for (auto& sample : samples) {
+            sample = distribution(m_randomEngine);
+        }
+        return samples;
+    }
+
+    // Compares the results of all supported SIMD levels with the results
+    // of the scalar reference implementation. The kernel is invoked with
+    // the same random input for each level.
+    void expectBitExact(const Kernel& kernel) {
+        for (const SINT numFrames : kNumFrames) {
+            const auto seed = m_randomEngine();
+            std::vector<CSAMPLE> expected;
+            {
+                ScopedSimdLevel scalar(SampleUtil::SimdLevel::Scalar);
+                ASSERT_TRUE(scalar.isSupported());
+                m_randomEngine.seed(seed);
+                expected = kernel(numFrames);
+            }
+            for (const auto level : kSimdLevels) {
+                ScopedSimdLevel simd(level);
+                if (!simd.isSupported()) {
+                    continue;
+                }
+                m_randomEngine.seed(seed);
+                const std::vector<CSAMPLE> actual = kernel(numFrames);
+                ASSERT_EQ(expected.size(), actual.size());
+                EXPECT_EQ(0,
+                        std::memcmp(expected.data(),
+                                actual.data(),
+                                expected.size() * sizeof(CSAMPLE)))
+                        << "SIMD level " << static_cast<int>(level)
+                        << ", " << numFrames << " frames";
+            }
+        }
+    }
+
+    std::mt19937 m_randomEngine;
+};
+
+TEST_F(SampleUtilSimdTest, scalarIsAlwaysSupported) {
+    EXPECT_TRUE(SampleUtil::isSimdLevelSupported(SampleUtil::SimdLevel::Scalar));
+    EXPECT_TRUE(SampleUtil::isSimdLevelSupported(SampleUtil::bestSupportedSimdLevel()));
+    EXPECT_EQ(SampleUtil::bestSupportedSimdLevel(), SampleUtil::simdLevel());
+}
+
+TEST_F(SampleUtilSimdTest, applyGain) {
+    expectBitExact([this](SINT numFrames) {
+        std::vector<CSAMPLE> buffer = randomSamples(numFrames * 2);
+        SampleUtil::applyGain(buffer.data(), 0.37f, numFrames * 2);
+        return buffer;
+    });
+}
+
+TEST_F(SampleUtilSimdTest, copyWithRampingGain) {
+    expectBitExact([this](SINT numFrames) {
+        const std::vector<CSAMPLE> src = randomSamples(numFrames * 2);
+        std::vector<CSAMPLE> dest(numFrames * 2);
+        SampleUtil::copyWithRampingGain(dest.data(), src.data(), 0.1f, 0.9f, numFrames * 2);
+        return dest;
+    });
+}
+
+TEST_F(SampleUtilSimdTest, addWithRampingGain) {
+    expectBitExact([this](SINT numFrames) {
+        const std::vector<CSAMPLE> src = randomSamples(numFrames * 2);
+        std::vector<CSAMPLE> dest = randomSamples(numFrames * 2);
+        SampleUtil::addWithRampingGain(dest.data(), src.data(), 0.9f, 0.2f, numFrames * 2);
+        return dest;
+    });
+}
+
+TEST_F(SampleUtilSimdTest, sumAbsPerChannel) {
+    expectBitExact([this](SINT numFrames) {
+        const std::vector<CSAMPLE> buffer = randomSamples(numFrames * 2);
+        CSAMPLE sumL = 0;
+        CSAMPLE sumR = 0;
+        const SampleUtil::CLIP_STATUS clipping =
+                SampleUtil::sumAbsPerChannel(&sumL, &sumR, buffer.data(), numFrames * 2);
+        return std::vector<CSAMPLE>{sumL,
+                sumR,
+                clipping.testFlag(SampleUtil::CLIPPING_LEFT) ? 1.0f : 0.0f,
+                clipping.testFlag(SampleUtil::CLIPPING_RIGHT) ? 1.0f : 0.0f};
+    });
+}
+
+TEST_F(SampleUtilSimdTest, interleaveBuffer) {
+    expectBitExact([this](SINT numFrames) {
+        const std::vector<CSAMPLE> src1 = randomSamples(numFrames);
+        const std::vector<CSAMPLE> src2 = randomSamples(numFrames);
+        std::vector<CSAMPLE> dest(numFrames * 2);
+        SampleUtil::interleaveBuffer(dest.data(), src1.data(), src2.data(), numFrames);
+        return dest;
+    });
+}
+
+TEST_F(SampleUtilSimdTest, deinterleaveBuffer) {
+    expectBitExact([this](SINT numFrames) {
+        const std::vector<CSAMPLE> src = randomSamples(numFrames * 2);
+        std::vector<CSAMPLE> dest(numFrames * 2);
+        SampleUtil::deinterleaveBuffer(dest.data(), dest.data() + numFrames, src.data(), numFrames);
+        return dest;
+    });
+}
+
+TEST_F(SampleUtilSimdTest, convertS16ToFloat32) {
+    expectBitExact([this](SINT numFrames) {
+        std::uniform_int_distribution<int> distribution(SAMPLE_MINIMUM, SAMPLE_MAXIMUM);
+        std::vector<SAMPLE> src(numFrames * 2);
+        for (auto& sample : src) {
+            sample = static_cast<SAMPLE>(distribution(m_randomEngine));
+        }
+        std::vector<CSAMPLE> dest(numFrames * 2);
+        SampleUtil::convertS16ToFloat32(dest.data(), src.data(), numFrames * 2);
+        return dest;
+    });
+}
+
 static void BM_MemCpy(benchmark::State& state) {
     SINT size = static_cast<SINT>(state.range(0));
     CSAMPLE* buffer = SampleUtil::alloc(size);
@@ -583,4 +744,161 @@ static void BM_Copy2WithRampingGain(benchmark::State& state) {
 }
 BENCHMARK(BM_Copy2WithRampingGain)->Range(64, 4096);
 
+// The arguments of the kernel benchmarks are the number of samples
+// and the SIMD level
+static void SimdLevelArguments(benchmark::internal::Benchmark* pBenchmark) {
+    for (const auto level : kSimdLevels) {
+        for (const int size : {64, 1024, 4096}) {
+            pBenchmark->Args({size, static_cast<int>(level)});
+        }
+    }
+}
+
+static void BM_KernelApplyGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    ScopedSimdLevel simd(static_cast<SampleUtil::SimdLevel>(state.range(1)));
+    if (!simd.isSupported()) {
+        state.SkipWithError("SIMD level not supported");
+        return;
+    }
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.5f, size);
+
+    while (state.KeepRunning()) {
+        SampleUtil::applyGain(buffer, 1.0001f, size);
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_KernelApplyGain)->Apply(SimdLevelArguments);
+
+static void BM_KernelCopyWithRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    ScopedSimdLevel simd(static_cast<SampleUtil::SimdLevel>(state.range(1)));
+    if (!simd.isSupported()) {
+        state.SkipWithError("SIMD level not supported");
+        return;
+    }
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.5f, size);
+
+    while (state.KeepRunning()) {
+        SampleUtil::copyWithRampingGain(buffer, buffer2, 0.1f, 0.9f, size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_KernelCopyWithRampingGain)->Apply(SimdLevelArguments);
+
+static void BM_KernelAddWithRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    ScopedSimdLevel simd(static_cast<SampleUtil::SimdLevel>(state.range(1)));
+    if (!simd.isSupported()) {
+        state.SkipWithError("SIMD level not supported");
+        return;
+    }
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.5f, size);
+
+    while (state.KeepRunning()) {
+        SampleUtil::addWithRampingGain(buffer, buffer2, 0.1f, 0.9f, size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_KernelAddWithRampingGain)->Apply(SimdLevelArguments);
+
+static void BM_KernelSumAbsPerChannel(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    ScopedSimdLevel simd(static_cast<SampleUtil::SimdLevel>(state.range(1)));
+    if (!simd.isSupported()) {
+        state.SkipWithError("SIMD level not supported");
+        return;
+    }
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.5f, size);
+    CSAMPLE sumL = 0;
+    CSAMPLE sumR = 0;
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(SampleUtil::sumAbsPerChannel(&sumL, &sumR, buffer, size));
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_KernelSumAbsPerChannel)->Apply(SimdLevelArguments);
+
+static void BM_KernelInterleaveBuffer(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    ScopedSimdLevel simd(static_cast<SampleUtil::SimdLevel>(state.range(1)));
+    if (!simd.isSupported()) {
+        state.SkipWithError("SIMD level not supported");
+        return;
+    }
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size / 2);
+    SampleUtil::fill(buffer2, 0.5f, size / 2);
+    CSAMPLE* buffer3 = SampleUtil::alloc(size / 2);
+    SampleUtil::fill(buffer3, -0.5f, size / 2);
+
+    while (state.KeepRunning()) {
+        SampleUtil::interleaveBuffer(buffer, buffer2, buffer3, size / 2);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+    SampleUtil::free(buffer3);
+}
+BENCHMARK(BM_KernelInterleaveBuffer)->Apply(SimdLevelArguments);
+
+static void BM_KernelDeinterleaveBuffer(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    ScopedSimdLevel simd(static_cast<SampleUtil::SimdLevel>(state.range(1)));
+    if (!simd.isSupported()) {
+        state.SkipWithError("SIMD level not supported");
+        return;
+    }
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.5f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size / 2);
+    SampleUtil::fill(buffer2, 0.0f, size / 2);
+    CSAMPLE* buffer3 = SampleUtil::alloc(size / 2);
+    SampleUtil::fill(buffer3, 0.0f, size / 2);
+
+    while (state.KeepRunning()) {
+        SampleUtil::deinterleaveBuffer(buffer2, buffer3, buffer, size / 2);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+    SampleUtil::free(buffer3);
+}
+BENCHMARK(BM_KernelDeinterleaveBuffer)->Apply(SimdLevelArguments);
+
+static void BM_KernelConvertS16ToFloat32(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    ScopedSimdLevel simd(static_cast<SampleUtil::SimdLevel>(state.range(1)));
+    if (!simd.isSupported()) {
+        state.SkipWithError("SIMD level not supported");
+        return;
+    }
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    std::vector<SAMPLE> s16(size, SAMPLE_MAXIMUM / 2);
+
+    while (state.KeepRunning()) {
+        SampleUtil::convertS16ToFloat32(buffer, s16.data(), size);
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_KernelConvertS16ToFloat32)->Apply(SimdLevelArguments);
+
 }  // namespace
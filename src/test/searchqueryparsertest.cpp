@@ -2,8 +2,10 @@
 
 #include <QDir>
 #include <QtDebug>
+#include <vector>
 
 #include "library/searchqueryparser.h"
+#include "library/trackcolumntable.h"
 #include "test/librarytest.h"
 #include "track/track.h"
 #include "util/assert.h"
@@ -1097,3 +1099,115 @@ TEST_F(SearchQueryParserTest, QueryIsLessSpecific) {
             QStringLiteral("-crate:\"a b c\""),
             QStringLiteral("crate:\"a b c\"")));
 }
+
+TEST_F(SearchQueryParserTest, QueryIsMoreSpecific) {
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QLatin1String(""),
+            QStringLiteral("tec")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("tec"),
+            QStringLiteral("techno")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("tec"),
+            QStringLiteral("tec ")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("A C"),
+            QStringLiteral("A B C")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("bpm:>120 tec"),
+            QStringLiteral("bpm:>120 tech")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("techno"),
+            QStringLiteral("tec")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("A B C"),
+            QStringLiteral("A D C")));
+
+    // Negated terms exclude more tracks when shortened, not when extended
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("-tec"),
+            QStringLiteral("-tech")));
+
+    // Numeric filters are not substring matches
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("bpm:12"),
+            QStringLiteral("bpm:120")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("\"a b\""),
+            QStringLiteral("\"a bc\"")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("artist: fo"),
+            QStringLiteral("artist: bar foo")));
+}
+
+TEST_F(SearchQueryParserTest, MatchRow) {
+    const QStringList columns = {
+            QStringLiteral("artist"),
+            QStringLiteral("album_artist"),
+            QStringLiteral("title"),
+            QStringLiteral("bpm"),
+            QStringLiteral("key_id"),
+    };
+    const auto resolveColumn = [&columns](const QString& column) {
+        return columns.indexOf(column);
+    };
+    const QStringList searchColumns = {
+            QStringLiteral("artist"),
+            QStringLiteral("title"),
+    };
+
+    TrackColumnTable table(columns.size());
+    const auto addRow = [&table](int id, const QVariantList& values) {
+        const int row = table.insertRow(TrackId(id));
+        for (int column = 0; column < values.size(); ++column) {
+            table.setValue(row, column, values[column]);
+        }
+    };
+    const QVariant null;
+    const QVariant cMajor = static_cast<int>(mixxx::track::io::key::C_MAJOR);
+    addRow(1, {"Richie Hawtin", "", "Plastikman", 127.0, cMajor});
+    addRow(2, {"Sven Väth", "", "Harmonic Dream", null, null});
+    addRow(3, {null, "", "Café del Mar", 120.5, cMajor});
+
+    const auto matchingTracks = [&](const QString& query) {
+        auto pQuery = m_parser.parseQuery(query, searchColumns, QString());
+        EXPECT_TRUE(pQuery->bindColumns(resolveColumn)) << query.toStdString();
+        std::vector<int> trackIds;
+        for (int id = 1; id <= 3; ++id) {
+            if (pQuery->matchRow(table, table.findRow(TrackId(id)))) {
+                trackIds.push_back(id);
+            }
+        }
+        return trackIds;
+    };
+
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), matchingTracks(""));
+    EXPECT_EQ(std::vector<int>({1}), matchingTracks("hawtin"));
+    // Case and diacritics are folded like by LIKE
+    EXPECT_EQ(std::vector<int>({2}), matchingTracks("VATH"));
+    EXPECT_EQ(std::vector<int>({3}), matchingTracks("cafe"));
+    EXPECT_EQ(std::vector<int>({2, 3}), matchingTracks("-hawtin"));
+    EXPECT_EQ(std::vector<int>({2}), matchingTracks("title:dream"));
+    EXPECT_EQ(std::vector<int>({3}), matchingTracks("artist:\"\""));
+    EXPECT_EQ(std::vector<int>({1}), matchingTracks("bpm:>125"));
+    EXPECT_EQ(std::vector<int>({1, 3}), matchingTracks("bpm:120-130"));
+    EXPECT_EQ(std::vector<int>({2}), matchingTracks("bpm:\"\""));
+    EXPECT_EQ(std::vector<int>({1, 3}), matchingTracks("key:C"));
+    EXPECT_EQ(std::vector<int>({1}), matchingTracks("key:C plastik"));
+
+    // Queries that can only be evaluated by the database
+    EXPECT_FALSE(m_parser.parseQuery("haw%in", searchColumns, QString())
+                         ->bindColumns(resolveColumn));
+    EXPECT_FALSE(m_parser.parseQuery("genre:techno", searchColumns, QString())
+                         ->bindColumns(resolveColumn));
+    EXPECT_FALSE(m_parser.parseQuery("hawtin", searchColumns, "id > 1")
+                         ->bindColumns(resolveColumn));
+}
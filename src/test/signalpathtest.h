@@ -26,6 +26,7 @@
 #include "track/track.h"
 #include "util/defs.h"
 #include "util/memory.h"
+#include "util/realtimecheck.h"
 #include "util/sample.h"
 #include "util/types.h"
 
@@ -46,6 +47,16 @@ using ::testing::_;
         EXPECT_FRAMEPOS_EQ(position, controlPos);                        \
     }
 
+// Fails the test if memory has been allocated or a mutex has been locked
+// on a realtime thread since the last invocation. Only checked when built
+// with the REALTIME_CHECK CMake option.
+inline void expectNoRealtimeViolations() {
+    if (mixxx::RealtimeCheck::isEnabled()) {
+        const QString report = mixxx::RealtimeCheck::takeViolationReport();
+        EXPECT_TRUE(report.isEmpty()) << report.toStdString();
+    }
+}
+
 // Subclass of EngineMaster that provides access to the master buffer object
 // for comparison.
 class TestEngineMaster : public EngineMaster {
@@ -68,6 +79,9 @@ class TestEngineMaster : public EngineMaster {
     CSAMPLE* masterBuffer() {
         return m_pMaster;
     }
+
+    using EngineMaster::numEngineWorkerThreads;
+    using EngineMaster::setEngineWorkerThreads;
 };
 
 class BaseSignalPathTest : public MixxxTest, SoundSourceProviderRegistration {
@@ -242,7 +256,11 @@ class BaseSignalPathTest : public MixxxTest, SoundSourceProviderRegistration {
 
     void ProcessBuffer() {
         qDebug() << "------- Process Buffer -------";
+        // Discard violations that have been reported by engine
+        // threads outside of this test
+        mixxx::RealtimeCheck::takeViolationReport();
         m_pEngineMaster->process(kProcessBufferSize);
+        expectNoRealtimeViolations();
     }
 
     ChannelHandleFactoryPointer m_pChannelHandleFactory;
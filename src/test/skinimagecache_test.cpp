@@ -0,0 +1,92 @@
+#include "skin/legacy/skinimagecache.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+class SkinImageCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        m_imagePath = m_tempDir.filePath("image.png");
+        m_diskCacheDir = m_tempDir.filePath("cache");
+        ASSERT_TRUE(QDir().mkpath(m_diskCacheDir));
+        writeImage(Qt::red);
+    }
+
+    void TearDown() override {
+        SkinImageCache::clear();
+    }
+
+    void writeImage(const QColor& color) {
+        QImage image(16, 8, QImage::Format_ARGB32);
+        image.fill(color);
+        ASSERT_TRUE(image.save(m_imagePath, "PNG"));
+    }
+
+    QStringList cacheFileNames() const {
+        return QDir(m_diskCacheDir).entryList(QDir::Files);
+    }
+
+    QTemporaryDir m_tempDir;
+    QString m_imagePath;
+    QString m_diskCacheDir;
+};
+
+TEST_F(SkinImageCacheTest, LoadImageFromDiskCache) {
+    QString cacheKey;
+    const QImage decodedImage = SkinImageCache::loadImage(
+            m_imagePath, 1.0, m_diskCacheDir, &cacheKey);
+    ASSERT_FALSE(decodedImage.isNull());
+    EXPECT_EQ(QSize(16, 8), decodedImage.size());
+    EXPECT_EQ(1, cacheFileNames().size());
+
+    const QImage cachedImage = SkinImageCache::loadImage(
+            m_imagePath, 1.0, m_diskCacheDir);
+    EXPECT_EQ(decodedImage, cachedImage);
+
+    // Another scale factor gets its own entry
+    QString scaledCacheKey;
+    const QImage scaledImage = SkinImageCache::loadImage(
+            m_imagePath, 2.0, m_diskCacheDir, &scaledCacheKey);
+    EXPECT_EQ(QSize(32, 16), scaledImage.size());
+    EXPECT_NE(cacheKey, scaledCacheKey);
+    EXPECT_EQ(2, cacheFileNames().size());
+}
+
+TEST_F(SkinImageCacheTest, ModifiedFileIsDecodedAgain) {
+    const QImage redImage = SkinImageCache::loadImage(m_imagePath, 1.0, m_diskCacheDir);
+    EXPECT_EQ(QColor(Qt::red), redImage.pixelColor(0, 0));
+
+    writeImage(Qt::blue);
+    const QImage blueImage = SkinImageCache::loadImage(m_imagePath, 1.0, m_diskCacheDir);
+    EXPECT_EQ(QColor(Qt::blue), blueImage.pixelColor(0, 0));
+}
+
+TEST_F(SkinImageCacheTest, PreloadAndClear) {
+    SkinImageCache::preload(QStringList{m_imagePath}, 1.0, m_diskCacheDir);
+    EXPECT_FALSE(SkinImageCache::image(m_imagePath, 1.0).isNull());
+    EXPECT_TRUE(SkinImageCache::image(m_imagePath, 2.0).isNull());
+    EXPECT_TRUE(SkinImageCache::image(m_tempDir.filePath("missing.png"), 1.0).isNull());
+    SkinImageCache::clear();
+    EXPECT_TRUE(SkinImageCache::image(m_imagePath, 1.0).isNull());
+    const QStringList redCacheFileNames = cacheFileNames();
+    EXPECT_EQ(1, redCacheFileNames.size());
+
+    // The entry of the previous file contents is removed
+    writeImage(Qt::blue);
+    SkinImageCache::preload(QStringList{m_imagePath}, 1.0, m_diskCacheDir);
+    EXPECT_EQ(QColor(Qt::blue), SkinImageCache::image(m_imagePath, 1.0).pixelColor(0, 0));
+    SkinImageCache::clear();
+    const QStringList blueCacheFileNames = cacheFileNames();
+    EXPECT_EQ(1, blueCacheFileNames.size());
+    EXPECT_NE(redCacheFileNames, blueCacheFileNames);
+}
+
+} // namespace
@@ -0,0 +1,131 @@
+#include "util/tracing.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+#include <memory>
+
+namespace {
+
+class TracingTest : public testing::Test {
+  protected:
+    void TearDown() override {
+        mixxx::Tracing::disable();
+    }
+
+    QJsonArray writeAndReadTraceEvents() {
+        QTemporaryDir tempDir;
+        EXPECT_TRUE(tempDir.isValid());
+        const QString filePath = tempDir.filePath(QStringLiteral("trace.json"));
+        EXPECT_TRUE(mixxx::Tracing::writeChromeTrace(filePath));
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        const auto doc = QJsonDocument::fromJson(file.readAll());
+        EXPECT_TRUE(doc.isObject());
+        return doc.object().value(QStringLiteral("traceEvents")).toArray();
+    }
+};
+
+QJsonObject findTraceEvent(const QJsonArray& traceEvents, const QString& name) {
+    for (const auto& traceEvent : traceEvents) {
+        if (traceEvent.toObject().value(QStringLiteral("name")).toString() == name) {
+            return traceEvent.toObject();
+        }
+    }
+    return QJsonObject();
+}
+
+TEST_F(TracingTest, DisabledByDefault) {
+    EXPECT_FALSE(mixxx::Tracing::isEnabled());
+    {
+        mixxx::ScopedTrace trace("TracingTest::DisabledByDefault span");
+    }
+    mixxx::Tracing::recordInstant("TracingTest::DisabledByDefault instant");
+    const auto traceEvents = writeAndReadTraceEvents();
+    EXPECT_TRUE(findTraceEvent(traceEvents,
+            QStringLiteral("TracingTest::DisabledByDefault span"))
+                        .isEmpty());
+    EXPECT_TRUE(findTraceEvent(traceEvents,
+            QStringLiteral("TracingTest::DisabledByDefault instant"))
+                        .isEmpty());
+}
+
+TEST_F(TracingTest, ChromeTraceOfMultipleThreads) {
+    mixxx::Tracing::enable();
+    mixxx::Tracing::registerCurrentThread("TracingTest");
+    {
+        mixxx::ScopedTrace trace("TracingTest::ChromeTraceOfMultipleThreads outer");
+        mixxx::Tracing::recordInstant("TracingTest::ChromeTraceOfMultipleThreads instant");
+        std::unique_ptr<QThread> pThread(QThread::create([] {
+            mixxx::Tracing::registerCurrentThread("TracingTestThread");
+            mixxx::ScopedTrace trace("TracingTest::ChromeTraceOfMultipleThreads thread");
+            QThread::msleep(1);
+        }));
+        pThread->start();
+        pThread->wait();
+    }
+    const auto traceEvents = writeAndReadTraceEvents();
+
+    const auto outer = findTraceEvent(traceEvents,
+            QStringLiteral("TracingTest::ChromeTraceOfMultipleThreads outer"));
+    ASSERT_FALSE(outer.isEmpty());
+    EXPECT_EQ(QStringLiteral("X"), outer.value(QStringLiteral("ph")).toString());
+
+    const auto instant = findTraceEvent(traceEvents,
+            QStringLiteral("TracingTest::ChromeTraceOfMultipleThreads instant"));
+    ASSERT_FALSE(instant.isEmpty());
+    EXPECT_EQ(QStringLiteral("i"), instant.value(QStringLiteral("ph")).toString());
+    EXPECT_EQ(outer.value(QStringLiteral("tid")), instant.value(QStringLiteral("tid")));
+
+    const auto thread = findTraceEvent(traceEvents,
+            QStringLiteral("TracingTest::ChromeTraceOfMultipleThreads thread"));
+    ASSERT_FALSE(thread.isEmpty());
+    EXPECT_NE(outer.value(QStringLiteral("tid")), thread.value(QStringLiteral("tid")));
+    EXPECT_GE(thread.value(QStringLiteral("dur")).toDouble(), 1000.0);
+    // The span of the thread is nested within the outer span
+    const double outerStart = outer.value(QStringLiteral("ts")).toDouble();
+    const double threadStart = thread.value(QStringLiteral("ts")).toDouble();
+    EXPECT_LE(outerStart, threadStart);
+    EXPECT_LE(threadStart + thread.value(QStringLiteral("dur")).toDouble(),
+            outerStart + outer.value(QStringLiteral("dur")).toDouble());
+
+    // The thread is named by a metadata event
+    bool threadNamed = false;
+    for (const auto& traceEvent : traceEvents) {
+        const auto object = traceEvent.toObject();
+        if (object.value(QStringLiteral("ph")).toString() == QStringLiteral("M") &&
+                object.value(QStringLiteral("tid")) == thread.value(QStringLiteral("tid"))) {
+            EXPECT_EQ(QStringLiteral("TracingTestThread"),
+                    object.value(QStringLiteral("args"))
+                            .toObject()
+                            .value(QStringLiteral("name"))
+                            .toString());
+            threadNamed = true;
+        }
+    }
+    EXPECT_TRUE(threadNamed);
+}
+
+TEST_F(TracingTest, UnregisteredThreadsAreNotTraced) {
+    mixxx::Tracing::enable();
+    std::unique_ptr<QThread> pThread(QThread::create([] {
+        mixxx::ScopedTrace trace("TracingTest::UnregisteredThreadsAreNotTraced span");
+        mixxx::Tracing::recordInstant("TracingTest::UnregisteredThreadsAreNotTraced instant");
+    }));
+    pThread->start();
+    pThread->wait();
+    const auto traceEvents = writeAndReadTraceEvents();
+    EXPECT_TRUE(findTraceEvent(traceEvents,
+            QStringLiteral("TracingTest::UnregisteredThreadsAreNotTraced span"))
+                        .isEmpty());
+    EXPECT_TRUE(findTraceEvent(traceEvents,
+            QStringLiteral("TracingTest::UnregisteredThreadsAreNotTraced instant"))
+                        .isEmpty());
+}
+
+} // namespace
@@ -0,0 +1,322 @@
+#include "library/trackcolumntable.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QHash>
+#include <QVector>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+enum BenchmarkColumn {
+    kArtistColumn,
+    kTitleColumn,
+    kAlbumColumn,
+    kGenreColumn,
+    kYearColumn,
+    kLocationColumn,
+    kDurationColumn,
+    kBpmColumn,
+    kRatingColumn,
+    kTimesPlayedColumn,
+    kDateAddedColumn,
+    kNumBenchmarkColumns,
+};
+
+class TrackColumnTableTest : public testing::Test {
+  protected:
+    TrackColumnTableTest()
+            : m_table(3) {
+        m_table.setDictionaryEncoded(0);
+    }
+
+    TrackColumnTable m_table;
+};
+
+TEST_F(TrackColumnTableTest, ValueRoundtrip) {
+    const int row = m_table.insertRow(TrackId(1));
+    ASSERT_LE(0, row);
+
+    const QList<QVariant> values = {
+            QVariant(),
+            QVariant(QStringLiteral("Artist")),
+            QVariant(QString()),
+            QVariant(true),
+            QVariant(42),
+            QVariant(Q_INT64_C(1) << 40),
+            QVariant(123.25),
+            QVariant(QDateTime::fromSecsSinceEpoch(1000000000, Qt::UTC)),
+    };
+    for (int column = 0; column < m_table.columnCount(); ++column) {
+        for (const auto& value : values) {
+            m_table.setValue(row, column, value);
+            const QVariant actual = m_table.value(row, column);
+            EXPECT_EQ(value.isValid(), actual.isValid());
+            EXPECT_EQ(value.isNull(), actual.isNull());
+            EXPECT_EQ(value.userType(), actual.userType());
+            EXPECT_EQ(value, actual);
+        }
+    }
+}
+
+TEST_F(TrackColumnTableTest, TypedAccess) {
+    const int row = m_table.insertRow(TrackId(1));
+    m_table.setValue(row, 0, QStringLiteral("2021"));
+    m_table.setValue(row, 1, 7);
+    m_table.setValue(row, 2, 128.5);
+    EXPECT_EQ(QStringLiteral("2021"), m_table.stringValue(row, 0));
+    EXPECT_EQ(2021.0, m_table.doubleValue(row, 0));
+    EXPECT_TRUE(m_table.stringValue(row, 1).isNull());
+    EXPECT_EQ(7.0, m_table.doubleValue(row, 1));
+    EXPECT_EQ(128.5, m_table.doubleValue(row, 2));
+}
+
+TEST_F(TrackColumnTableTest, InsertAndRemoveRows) {
+    const TrackId trackId1(1);
+    const TrackId trackId2(2);
+    // Far beyond the dense row index
+    const TrackId trackId3(100000000);
+
+    const int row1 = m_table.insertRow(trackId1);
+    const int row2 = m_table.insertRow(trackId2);
+    const int row3 = m_table.insertRow(trackId3);
+    EXPECT_NE(row1, row2);
+    EXPECT_NE(row2, row3);
+    EXPECT_EQ(3, m_table.rowCount());
+    EXPECT_EQ(row2, m_table.insertRow(trackId2));
+    EXPECT_EQ(3, m_table.rowCount());
+    EXPECT_EQ(row3, m_table.findRow(trackId3));
+    EXPECT_EQ(trackId3, m_table.trackIdOfRow(row3));
+    EXPECT_EQ(-1, m_table.insertRow(TrackId()));
+
+    m_table.setValue(row2, 0, QStringLiteral("Artist"));
+    EXPECT_TRUE(m_table.removeRow(trackId2));
+    EXPECT_FALSE(m_table.removeRow(trackId2));
+    EXPECT_FALSE(m_table.contains(trackId2));
+    EXPECT_EQ(2, m_table.rowCount());
+
+    // Removed rows are recycled and empty
+    const TrackId trackId4(4);
+    const int row4 = m_table.insertRow(trackId4);
+    EXPECT_EQ(row2, row4);
+    EXPECT_FALSE(m_table.value(row4, 0).isValid());
+    EXPECT_EQ(row1, m_table.findRow(trackId1));
+    EXPECT_EQ(row3, m_table.findRow(trackId3));
+
+    EXPECT_TRUE(m_table.removeRow(trackId3));
+    EXPECT_FALSE(m_table.contains(trackId3));
+
+    m_table.clear();
+    EXPECT_TRUE(m_table.isEmpty());
+    EXPECT_FALSE(m_table.contains(trackId1));
+}
+
+TEST_F(TrackColumnTableTest, DictionaryEncodedStrings) {
+    const int row1 = m_table.insertRow(TrackId(1));
+    const int row2 = m_table.insertRow(TrackId(2));
+    m_table.setValue(row1, 0, QStringLiteral("Artist"));
+    m_table.setValue(row2, 0, QStringLiteral("Artist"));
+    // Releasing one reference must not affect other rows
+    m_table.setValue(row1, 0, QStringLiteral("Other Artist"));
+    EXPECT_EQ(QStringLiteral("Other Artist"), m_table.stringValue(row1, 0));
+    EXPECT_EQ(QStringLiteral("Artist"), m_table.stringValue(row2, 0));
+    m_table.removeRow(TrackId(2));
+    const int row3 = m_table.insertRow(TrackId(3));
+    m_table.setValue(row3, 0, QStringLiteral("Artist"));
+    EXPECT_EQ(QStringLiteral("Artist"), m_table.stringValue(row3, 0));
+    EXPECT_EQ(QStringLiteral("Other Artist"), m_table.stringValue(row1, 0));
+}
+
+// Synthetic library with the value types returned by SQLite
+QVariant syntheticValue(int trackIndex, int column) {
+    switch (column) {
+    case kArtistColumn:
+        return QStringLiteral("Artist %1").arg(trackIndex % 5000);
+    case kTitleColumn:
+        return QStringLiteral("Title %1").arg(trackIndex);
+    case kAlbumColumn:
+        return QStringLiteral("Album %1").arg(trackIndex % 20000);
+    case kGenreColumn:
+        return QStringLiteral("Genre %1").arg(trackIndex % 50);
+    case kYearColumn:
+        return QString::number(1960 + trackIndex % 60);
+    case kLocationColumn:
+        return QStringLiteral("/home/user/Music/Artist %1/Album %2/%3.mp3")
+                .arg(QString::number(trackIndex % 5000),
+                        QString::number(trackIndex % 20000),
+                        QString::number(trackIndex));
+    case kDurationColumn:
+        return 120.0 + trackIndex % 300;
+    case kBpmColumn:
+        return 80.0 + (trackIndex % 900) / 10.0;
+    case kRatingColumn:
+        return static_cast<qlonglong>(trackIndex % 6);
+    case kTimesPlayedColumn:
+        return static_cast<qlonglong>(trackIndex % 17);
+    case kDateAddedColumn:
+        return QDateTime::fromSecsSinceEpoch(1577836800 + trackIndex * 60, Qt::UTC)
+                .toString(Qt::ISODateWithMs);
+    default:
+        return QVariant();
+    }
+}
+
+std::size_t allocatedBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+typedef QHash<TrackId, QVector<QVariant>> VariantTrackInfo;
+
+void buildVariantTrackInfo(VariantTrackInfo* pTrackInfo, int numTracks) {
+    for (int i = 0; i < numTracks; ++i) {
+        QVector<QVariant>& record = (*pTrackInfo)[TrackId(i + 1)];
+        record.resize(kNumBenchmarkColumns);
+        for (int column = 0; column < kNumBenchmarkColumns; ++column) {
+            record[column] = syntheticValue(i, column);
+        }
+    }
+}
+
+void buildTrackColumnTable(TrackColumnTable* pTable, int numTracks) {
+    pTable->setDictionaryEncoded(kArtistColumn);
+    pTable->setDictionaryEncoded(kAlbumColumn);
+    pTable->setDictionaryEncoded(kGenreColumn);
+    pTable->setDictionaryEncoded(kYearColumn);
+    for (int i = 0; i < numTracks; ++i) {
+        const int row = pTable->insertRow(TrackId(i + 1));
+        for (int column = 0; column < kNumBenchmarkColumns; ++column) {
+            pTable->setValue(row, column, syntheticValue(i, column));
+        }
+    }
+}
+
+static void BM_VariantTrackInfoMemory(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        const std::size_t bytesBefore = allocatedBytes();
+        VariantTrackInfo trackInfo;
+        buildVariantTrackInfo(&trackInfo, numTracks);
+        bytes = allocatedBytes() - bytesBefore;
+        benchmark::DoNotOptimize(trackInfo);
+    }
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_VariantTrackInfoMemory)->Arg(10000)->Arg(300000)->Unit(benchmark::kMillisecond);
+
+static void BM_TrackColumnTableMemory(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        const std::size_t bytesBefore = allocatedBytes();
+        TrackColumnTable table(kNumBenchmarkColumns);
+        buildTrackColumnTable(&table, numTracks);
+        bytes = allocatedBytes() - bytesBefore;
+        benchmark::DoNotOptimize(table);
+    }
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_TrackColumnTableMemory)->Arg(10000)->Arg(300000)->Unit(benchmark::kMillisecond);
+
+// Sorts all tracks by artist, then by bpm, like BaseTrackCache does for
+// the results of a search
+static void BM_VariantTrackInfoSort(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    VariantTrackInfo trackInfo;
+    buildVariantTrackInfo(&trackInfo, numTracks);
+    const QList<TrackId> keys = trackInfo.keys();
+    std::vector<TrackId> trackIds(keys.begin(), keys.end());
+    for (auto _ : state) {
+        std::sort(trackIds.begin(),
+                trackIds.end(),
+                [&trackInfo](TrackId lhs, TrackId rhs) {
+                    const QVector<QVariant>& lhsRecord = trackInfo[lhs];
+                    const QVector<QVariant>& rhsRecord = trackInfo[rhs];
+                    const int cmp = lhsRecord[kArtistColumn].toString().compare(
+                            rhsRecord[kArtistColumn].toString());
+                    if (cmp != 0) {
+                        return cmp < 0;
+                    }
+                    return lhsRecord[kBpmColumn].toDouble() <
+                            rhsRecord[kBpmColumn].toDouble();
+                });
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_VariantTrackInfoSort)->Arg(10000)->Arg(300000)->Unit(benchmark::kMillisecond);
+
+static void BM_TrackColumnTableSort(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    TrackColumnTable table(kNumBenchmarkColumns);
+    buildTrackColumnTable(&table, numTracks);
+    std::vector<int> rows(table.rowCapacity());
+    std::iota(rows.begin(), rows.end(), 0);
+    for (auto _ : state) {
+        std::sort(rows.begin(),
+                rows.end(),
+                [&table](int lhs, int rhs) {
+                    const int cmp = table.stringValue(lhs, kArtistColumn)
+                                            .compare(table.stringValue(
+                                                    rhs, kArtistColumn));
+                    if (cmp != 0) {
+                        return cmp < 0;
+                    }
+                    return table.doubleValue(lhs, kBpmColumn) <
+                            table.doubleValue(rhs, kBpmColumn);
+                });
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TrackColumnTableSort)->Arg(10000)->Arg(300000)->Unit(benchmark::kMillisecond);
+
+// Case-insensitive substring match in a single column, i.e. the
+// typical search term entered into the search box
+static void BM_VariantTrackInfoFilter(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    VariantTrackInfo trackInfo;
+    buildVariantTrackInfo(&trackInfo, numTracks);
+    const QString searchTerm = QStringLiteral("artist 42");
+    for (auto _ : state) {
+        int matches = 0;
+        for (auto it = trackInfo.constBegin(); it != trackInfo.constEnd(); ++it) {
+            if (it.value()[kArtistColumn].toString().contains(
+                        searchTerm, Qt::CaseInsensitive)) {
+                ++matches;
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+}
+BENCHMARK(BM_VariantTrackInfoFilter)->Arg(10000)->Arg(300000)->Unit(benchmark::kMillisecond);
+
+static void BM_TrackColumnTableFilter(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    TrackColumnTable table(kNumBenchmarkColumns);
+    buildTrackColumnTable(&table, numTracks);
+    const QString searchTerm = QStringLiteral("artist 42");
+    for (auto _ : state) {
+        int matches = 0;
+        for (int row = 0; row < table.rowCapacity(); ++row) {
+            if (table.stringValue(row, kArtistColumn)
+                            .contains(searchTerm, Qt::CaseInsensitive)) {
+                ++matches;
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+}
+BENCHMARK(BM_TrackColumnTableFilter)->Arg(10000)->Arg(300000)->Unit(benchmark::kMillisecond);
+
+} // namespace
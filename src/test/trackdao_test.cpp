@@ -1,8 +1,10 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "test/librarytest.h"
 #include "track/track.h"
+#include "util/db/sqltransaction.h"
 
 using ::testing::UnorderedElementsAre;
 
@@ -56,3 +58,125 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, getTracksByIds) {
+    QList<TrackId> trackIds;
+    for (int i = 0; i < 3; ++i) {
+        const mixxx::FileInfo fileInfo(
+                QDir(QDir::tempPath()), QStringLiteral("track%1.mp3").arg(i));
+        TrackPointer pTrack = Track::newTemporary(mixxx::FileAccess(fileInfo));
+        pTrack->setArtist(QStringLiteral("Artist %1").arg(i));
+        pTrack->createAndAddCue(mixxx::CueType::HotCue,
+                i,
+                mixxx::audio::FramePos(1000 * (i + 1)),
+                mixxx::audio::kInvalidFramePos);
+        trackIds.append(internalCollection()->addTrack(pTrack, false));
+        ASSERT_TRUE(trackIds.last().isValid());
+    }
+
+    // A cached track is reused
+    const TrackPointer pCachedTrack = trackCollectionManager()->getTrackById(trackIds[1]);
+    ASSERT_NE(nullptr, pCachedTrack);
+
+    const auto tracks = trackCollectionManager()->getTracksByIds(QList<TrackId>{
+            trackIds[2],
+            TrackId(),
+            trackIds[1],
+            TrackId(QVariant(12345)),
+            trackIds[0],
+            trackIds[2]});
+    ASSERT_EQ(4, tracks.size());
+    EXPECT_EQ(trackIds[2], tracks[0]->getId());
+    EXPECT_EQ(pCachedTrack, tracks[1]);
+    EXPECT_EQ(trackIds[0], tracks[2]->getId());
+    EXPECT_EQ(tracks[0], tracks[3]);
+    for (int i = 0; i < 3; ++i) {
+        const auto pTrack = tracks[i];
+        EXPECT_EQ(QStringLiteral("Artist %1").arg(2 - i), pTrack->getArtist());
+        const auto cuePoints = pTrack->getCuePoints();
+        ASSERT_EQ(1, cuePoints.size());
+        EXPECT_EQ(2 - i, cuePoints.first()->getHotCue());
+    }
+}
+
+namespace {
+
+constexpr int kBenchmarkTrackCount = 10000;
+
+// Google Benchmark does not run gtest fixtures, so the fixture is
+// instantiated manually.
+class TrackDAOBenchmark : public LibraryTest {
+  public:
+    TrackDAOBenchmark() {
+        QSqlDatabase database = dbConnection();
+        SqlTransaction transaction(database);
+        QSqlQuery locationQuery(database);
+        locationQuery.prepare(
+                "INSERT INTO track_locations "
+                "(location,filename,directory,filesize,fs_deleted,needs_verification) "
+                "VALUES (:location,:filename,:directory,0,0,0)");
+        QSqlQuery libraryQuery(database);
+        libraryQuery.prepare(
+                "INSERT INTO library "
+                "(artist,title,location,samplerate,channels,duration,bpm,"
+                "mixxx_deleted,header_parsed) "
+                "VALUES (:artist,:title,:location,44100,2,240.0,128.0,0,1)");
+        for (int i = 0; i < kBenchmarkTrackCount; ++i) {
+            const QString fileName = QStringLiteral("track%1.mp3").arg(i);
+            const QString directory = QStringLiteral("/music/artist%1").arg(i % 100);
+            locationQuery.bindValue(":location", directory + QChar('/') + fileName);
+            locationQuery.bindValue(":filename", fileName);
+            locationQuery.bindValue(":directory", directory);
+            locationQuery.exec();
+            libraryQuery.bindValue(":artist", QStringLiteral("Artist %1").arg(i % 100));
+            libraryQuery.bindValue(":title", QStringLiteral("Title %1").arg(i));
+            libraryQuery.bindValue(":location", locationQuery.lastInsertId());
+            libraryQuery.exec();
+            m_trackIds.append(TrackId(libraryQuery.lastInsertId()));
+        }
+        transaction.commit();
+    }
+
+    const QList<TrackId>& trackIds() const {
+        return m_trackIds;
+    }
+
+    TrackPointer getTrackById(TrackId trackId) const {
+        return trackCollectionManager()->getTrackById(trackId);
+    }
+
+    QList<TrackPointer> getTracksByIds(const QList<TrackId>& trackIds) const {
+        return trackCollectionManager()->getTracksByIds(trackIds);
+    }
+
+  private:
+    void TestBody() override {
+    }
+
+    QList<TrackId> m_trackIds;
+};
+
+// All tracks are evicted from the cache after each iteration
+static void BM_GetTrackByIdLoop(benchmark::State& state) {
+    TrackDAOBenchmark fixture;
+    for (auto _ : state) {
+        QList<TrackPointer> tracks;
+        tracks.reserve(fixture.trackIds().size());
+        for (const auto& trackId : fixture.trackIds()) {
+            tracks.append(fixture.getTrackById(trackId));
+        }
+        benchmark::DoNotOptimize(tracks);
+    }
+}
+BENCHMARK(BM_GetTrackByIdLoop)->Unit(benchmark::kMillisecond);
+
+static void BM_GetTracksByIds(benchmark::State& state) {
+    TrackDAOBenchmark fixture;
+    for (auto _ : state) {
+        const auto tracks = fixture.getTracksByIds(fixture.trackIds());
+        benchmark::DoNotOptimize(tracks);
+    }
+}
+BENCHMARK(BM_GetTracksByIds)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,257 @@
+#include "library/tracksearchindex.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QStringList>
+#include <algorithm>
+#include <vector>
+
+#include "util/db/dbconnection.h"
+
+namespace {
+
+const QStringList kColumns = {
+        QStringLiteral("artist"),
+        QStringLiteral("title"),
+        QStringLiteral("album"),
+};
+
+std::vector<TrackId> trackIds(std::initializer_list<int> values) {
+    std::vector<TrackId> result;
+    for (const auto value : values) {
+        result.emplace_back(value);
+    }
+    return result;
+}
+
+class TrackSearchIndexTest : public testing::Test {
+  protected:
+    TrackSearchIndexTest()
+            : m_index(QStringLiteral("id"), kColumns) {
+    }
+
+    TrackSearchIndex m_index;
+};
+
+TEST_F(TrackSearchIndexTest, CoversColumns) {
+    EXPECT_TRUE(m_index.coversColumns({QStringLiteral("artist")}));
+    EXPECT_TRUE(m_index.coversColumns(kColumns));
+    EXPECT_FALSE(m_index.coversColumns(
+            {QStringLiteral("artist"), QStringLiteral("datetime_added")}));
+}
+
+TEST_F(TrackSearchIndexTest, FindCandidates) {
+    // Added in random order
+    m_index.addText(TrackId(3), QStringLiteral("Sven Väth"));
+    m_index.addText(TrackId(1), QStringLiteral("Richie Hawtin"));
+    m_index.addText(TrackId(2), QStringLiteral("Plastikman"));
+    m_index.addText(TrackId(2), QStringLiteral("Sheet One"));
+    m_index.addText(TrackId(4), QStringLiteral("Acid"));
+    m_index.addText(TrackId(4), QStringLiteral("Cider"));
+    for (int i = 5; i < 40; ++i) {
+        m_index.addText(TrackId(i), QStringLiteral("Unrelated"));
+    }
+    m_index.commit();
+
+    EXPECT_EQ(trackIds({1}), m_index.findCandidates(QStringLiteral("hawtin")));
+    EXPECT_EQ(trackIds({2}), m_index.findCandidates(QStringLiteral("sheet")));
+    // Case and diacritics are folded like by the LIKE operator
+    EXPECT_EQ(trackIds({3}), m_index.findCandidates(QStringLiteral("vath")));
+    // The candidates might contain false positives
+    EXPECT_EQ(trackIds({4}), m_index.findCandidates(QStringLiteral("acider")));
+    EXPECT_EQ(trackIds({}), m_index.findCandidates(QStringLiteral("techno")));
+}
+
+TEST_F(TrackSearchIndexTest, UnsupportedTerms) {
+    m_index.addText(TrackId(1), QStringLiteral("Richie Hawtin"));
+    m_index.commit();
+
+    EXPECT_FALSE(m_index.findCandidates(QStringLiteral("ha")));
+    EXPECT_FALSE(m_index.findCandidates(QStringLiteral("haw%in")));
+    EXPECT_FALSE(m_index.findCandidates(QStringLiteral("haw_in")));
+    // Terms that occur in too many tracks are not worth it
+    EXPECT_FALSE(m_index.findCandidates(QStringLiteral("hawtin")));
+}
+
+TEST_F(TrackSearchIndexTest, IncrementalUpdates) {
+    for (int i = 1; i <= 40; ++i) {
+        m_index.addText(TrackId(i), QStringLiteral("Unrelated"));
+    }
+    m_index.addText(TrackId(10), QStringLiteral("Techno"));
+    m_index.commit();
+    m_index.addText(TrackId(5), QStringLiteral("Techno"));
+    m_index.addText(TrackId(15), QStringLiteral("Techno"));
+    m_index.addText(TrackId(10), QStringLiteral("Techno"));
+    m_index.commit();
+
+    EXPECT_EQ(trackIds({5, 10, 15}), m_index.findCandidates(QStringLiteral("techno")));
+
+    m_index.clear();
+    EXPECT_EQ(trackIds({}), m_index.findCandidates(QStringLiteral("techno")));
+}
+
+TEST_F(TrackSearchIndexTest, AppendInAscendingOrderWithoutCommit) {
+    for (int i = 1; i <= 40; ++i) {
+        m_index.addText(TrackId(i), QStringLiteral("Unrelated"));
+    }
+    m_index.addText(TrackId(41), QStringLiteral("Techno"));
+    m_index.addText(TrackId(42), QStringLiteral("Techno"));
+    EXPECT_TRUE(m_index.isCommitted());
+    EXPECT_EQ(trackIds({41, 42}), m_index.findCandidates(QStringLiteral("techno")));
+
+    // Updating a track with a lower id requires a commit
+    m_index.addText(TrackId(7), QStringLiteral("Techno"));
+    EXPECT_FALSE(m_index.isCommitted());
+    m_index.commit();
+    EXPECT_TRUE(m_index.isCommitted());
+    EXPECT_EQ(trackIds({7, 41, 42}), m_index.findCandidates(QStringLiteral("techno")));
+}
+
+// A deterministic library with a realistic distribution of words
+class SyntheticLibrary {
+  public:
+    explicit SyntheticLibrary(int numTracks) {
+        const QStringList words = {
+                QStringLiteral("Love"),
+                QStringLiteral("Night"),
+                QStringLiteral("Dance"),
+                QStringLiteral("Deep"),
+                QStringLiteral("House"),
+                QStringLiteral("Remix"),
+                QStringLiteral("Original"),
+                QStringLiteral("Mix"),
+                QStringLiteral("Feat."),
+                QStringLiteral("Süden"),
+                QStringLiteral("Techno"),
+                QStringLiteral("Dub"),
+                QStringLiteral("Edit"),
+                QStringLiteral("Club"),
+                QStringLiteral("Summer"),
+                QStringLiteral("Café"),
+        };
+        quint32 seed = 1;
+        const auto nextRandom = [&seed] {
+            seed = seed * 1103515245 + 12345;
+            return (seed >> 16) & 0x7fff;
+        };
+        m_texts.reserve(numTracks * kColumns.size());
+        for (int i = 0; i < numTracks; ++i) {
+            for (int column = 0; column < kColumns.size(); ++column) {
+                QString text = words[nextRandom() % words.size()];
+                text += QChar(' ');
+                text += words[nextRandom() % words.size()];
+                // Unique names of artists and albums
+                text += QStringLiteral(" %1").arg(nextRandom() % (numTracks / 4 + 1));
+                m_texts.push_back(text);
+            }
+        }
+    }
+
+    int numTracks() const {
+        return static_cast<int>(m_texts.size()) / kColumns.size();
+    }
+
+    const QString& text(int track, int column) const {
+        return m_texts[track * kColumns.size() + column];
+    }
+
+    void buildIndex(TrackSearchIndex* pIndex) const {
+        for (int track = 0; track < numTracks(); ++track) {
+            for (int column = 0; column < kColumns.size(); ++column) {
+                pIndex->addText(TrackId(track + 1), text(track, column));
+            }
+        }
+        pIndex->commit();
+    }
+
+    /// Evaluates the LIKE clause of TextFilterNode like SQLite does
+    bool matches(int track, const QString& term) const {
+        for (int column = 0; column < kColumns.size(); ++column) {
+            QString pattern = QChar('%') + term + QChar('%');
+            QString string = text(track, column);
+            if (mixxx::DbConnection::likeCompareLatinLow(&pattern, &string, '\0')) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    std::vector<QString> m_texts;
+};
+
+TEST_F(TrackSearchIndexTest, CandidatesContainAllMatches) {
+    const SyntheticLibrary library(2000);
+    library.buildIndex(&m_index);
+
+    for (const auto& term : {
+                 QStringLiteral("dub 12"),
+                 QStringLiteral("café 22"),
+                 QStringLiteral("süden 1"),
+                 QStringLiteral("e 333"),
+                 QStringLiteral("remix 4"),
+         }) {
+        QString foldedTerm = term;
+        mixxx::DbConnection::makeStringLatinLow(&foldedTerm);
+        const auto candidates = m_index.findCandidates(foldedTerm);
+        ASSERT_TRUE(candidates) << term.toStdString();
+        int numMatches = 0;
+        for (int track = 0; track < library.numTracks(); ++track) {
+            if (!library.matches(track, foldedTerm)) {
+                continue;
+            }
+            ++numMatches;
+            EXPECT_TRUE(std::binary_search(
+                    candidates->begin(), candidates->end(), TrackId(track + 1)))
+                    << term.toStdString() << " " << track;
+        }
+        EXPECT_LE(numMatches, static_cast<int>(candidates->size()));
+    }
+}
+
+const QString kBenchmarkTerm = QStringLiteral("club 4711");
+
+static void BM_LinearScanSearch(benchmark::State& state) {
+    const SyntheticLibrary library(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        int numMatches = 0;
+        for (int track = 0; track < library.numTracks(); ++track) {
+            if (library.matches(track, kBenchmarkTerm)) {
+                ++numMatches;
+            }
+        }
+        benchmark::DoNotOptimize(numMatches);
+    }
+}
+BENCHMARK(BM_LinearScanSearch)->Arg(500000)->Unit(benchmark::kMillisecond);
+
+static void BM_TrackSearchIndexSearch(benchmark::State& state) {
+    const SyntheticLibrary library(static_cast<int>(state.range(0)));
+    TrackSearchIndex index(QStringLiteral("id"), kColumns);
+    library.buildIndex(&index);
+    for (auto _ : state) {
+        // The candidates are verified like by SQLite
+        int numMatches = 0;
+        const auto candidates = index.findCandidates(kBenchmarkTerm);
+        for (const auto& trackId : *candidates) {
+            if (library.matches(trackId.value() - 1, kBenchmarkTerm)) {
+                ++numMatches;
+            }
+        }
+        benchmark::DoNotOptimize(numMatches);
+    }
+}
+BENCHMARK(BM_TrackSearchIndexSearch)->Arg(500000)->Unit(benchmark::kMillisecond);
+
+static void BM_TrackSearchIndexBuild(benchmark::State& state) {
+    const SyntheticLibrary library(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        TrackSearchIndex index(QStringLiteral("id"), kColumns);
+        library.buildIndex(&index);
+        benchmark::DoNotOptimize(index);
+    }
+}
+BENCHMARK(BM_TrackSearchIndexBuild)->Arg(500000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,189 @@
+#include "waveform/waveform.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QByteArray>
+#include <string>
+
+#include "proto/waveform.pb.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr int kVisualSampleRate = 441;
+
+// A waveform of a 5 minute track with a smooth but non-trivial envelope
+WaveformPointer createWaveform(int durationSeconds = 300) {
+    auto pWaveform = WaveformPointer::create(kSampleRate,
+            kSampleRate * 2 * durationSeconds,
+            kVisualSampleRate,
+            -1);
+    WaveformData* pData = pWaveform->data();
+    for (int i = 0; i < pWaveform->getDataSize(); ++i) {
+        pData[i].filtered.low = static_cast<unsigned char>((i / 7) % 200);
+        pData[i].filtered.mid = static_cast<unsigned char>((i * 13) % 97 + (i % 2) * 50);
+        pData[i].filtered.high = static_cast<unsigned char>((i / 3) % 64);
+        pData[i].filtered.all = static_cast<unsigned char>(
+                math_max3(pData[i].filtered.low, pData[i].filtered.mid, pData[i].filtered.high));
+    }
+    pWaveform->setCompletion(pWaveform->getDataSize());
+    return pWaveform;
+}
+
+// The format that has been written by previous versions
+QByteArray toLegacyByteArray(const Waveform& waveform) {
+    mixxx::track::io::Waveform proto;
+    proto.set_visual_sample_rate(kVisualSampleRate);
+    proto.set_audio_visual_ratio(waveform.getAudioVisualRatio());
+    auto* pAll = proto.mutable_signal_all();
+    auto* pLow = proto.mutable_signal_filtered()->mutable_low();
+    auto* pMid = proto.mutable_signal_filtered()->mutable_mid();
+    auto* pHigh = proto.mutable_signal_filtered()->mutable_high();
+    for (int i = 0; i < waveform.getDataSize(); ++i) {
+        pAll->add_value(waveform.getAll(i));
+        pLow->add_value(waveform.getLow(i));
+        pMid->add_value(waveform.getMid(i));
+        pHigh->add_value(waveform.getHigh(i));
+    }
+    std::string output;
+    proto.SerializeToString(&output);
+    return QByteArray(output.data(), static_cast<int>(output.length()));
+}
+
+void expectEqualLevels(const Waveform& expected, const Waveform& actual) {
+    ASSERT_EQ(expected.getDataSize(), actual.getDataSize());
+    ASSERT_EQ(expected.getLevelCount(), actual.getLevelCount());
+    for (int level = 0; level < expected.getLevelCount(); ++level) {
+        const WaveformData* pExpected = expected.getLevelData(level);
+        const WaveformData* pActual = actual.getLevelData(level);
+        ASSERT_NE(nullptr, pExpected);
+        ASSERT_NE(nullptr, pActual);
+        for (int i = 0; i < expected.getLevelDataSize(level); ++i) {
+            ASSERT_EQ(pExpected[i].m_i, pActual[i].m_i) << level << " " << i;
+        }
+    }
+}
+
+class WaveformTest : public testing::Test {
+};
+
+TEST_F(WaveformTest, Levels) {
+    const auto pWaveform = createWaveform();
+    ASSERT_LT(2, pWaveform->getLevelCount());
+    EXPECT_EQ(pWaveform->data(), pWaveform->getLevelData(0));
+
+    const WaveformData* pLevel0 = pWaveform->getLevelData(0);
+    const WaveformData* pLevel1 = pWaveform->getLevelData(1);
+    ASSERT_NE(nullptr, pLevel1);
+    const int frames = pWaveform->getDataSize() / 2;
+    EXPECT_EQ((frames + Waveform::kLevelReductionFactor - 1) /
+                    Waveform::kLevelReductionFactor * 2,
+            pWaveform->getLevelDataSize(1));
+    for (int i = 0; i < pWaveform->getLevelDataSize(1); ++i) {
+        unsigned char maxLow = 0;
+        const int channel = i % 2;
+        for (int j = 0; j < Waveform::kLevelReductionFactor; ++j) {
+            const int index = ((i / 2) * Waveform::kLevelReductionFactor + j) * 2 + channel;
+            if (index < pWaveform->getDataSize()) {
+                maxLow = math_max(maxLow, pLevel0[index].filtered.low);
+            }
+        }
+        ASSERT_EQ(maxLow, pLevel1[i].filtered.low) << i;
+    }
+
+    EXPECT_EQ(0, pWaveform->getLevelForVisualFrames(1.0));
+    EXPECT_EQ(0, pWaveform->getLevelForVisualFrames(3.9));
+    EXPECT_EQ(1, pWaveform->getLevelForVisualFrames(4.0));
+    EXPECT_EQ(2, pWaveform->getLevelForVisualFrames(20.0));
+    EXPECT_EQ(pWaveform->getLevelCount() - 1, pWaveform->getLevelForVisualFrames(1e9));
+}
+
+TEST_F(WaveformTest, LevelsUnavailableDuringAnalysis) {
+    const auto pWaveform = createWaveform();
+    pWaveform->setCompletion(pWaveform->getDataSize() / 2);
+    EXPECT_NE(nullptr, pWaveform->getLevelData(0));
+    EXPECT_EQ(nullptr, pWaveform->getLevelData(1));
+}
+
+// The rows that GLSL renderers upload to the signal texture
+TEST_F(WaveformTest, TextureRowCount) {
+    const auto pWaveform = createWaveform();
+    const int stride = pWaveform->getTextureStride();
+    const int height = pWaveform->getTextureSize() / stride;
+    ASSERT_LT(0, stride);
+    ASSERT_LE(pWaveform->getDataSize(), pWaveform->getTextureSize());
+
+    EXPECT_EQ(0, pWaveform->getTextureRowCount(0));
+    EXPECT_EQ(1, pWaveform->getTextureRowCount(1));
+    EXPECT_EQ(1, pWaveform->getTextureRowCount(stride));
+    EXPECT_EQ(2, pWaveform->getTextureRowCount(stride + 1));
+    EXPECT_EQ((pWaveform->getDataSize() + stride - 1) / stride,
+            pWaveform->getTextureRowCount(pWaveform->getDataSize()));
+    EXPECT_EQ(height, pWaveform->getTextureRowCount(pWaveform->getTextureSize()));
+    EXPECT_EQ(height, pWaveform->getTextureRowCount(pWaveform->getTextureSize() + stride));
+}
+
+TEST_F(WaveformTest, CompactFormatRoundtrip) {
+    const auto pWaveform = createWaveform();
+    const QByteArray data = pWaveform->toByteArray();
+    EXPECT_TRUE(mixxx::CompactWaveformFormat::hasMagic(data));
+
+    const Waveform waveform(data);
+    EXPECT_TRUE(waveform.isValid());
+    EXPECT_EQ(Waveform::SaveState::Saved, waveform.saveState());
+    EXPECT_EQ(waveform.getDataSize(), waveform.getCompletion());
+    EXPECT_DOUBLE_EQ(pWaveform->getAudioVisualRatio(), waveform.getAudioVisualRatio());
+    expectEqualLevels(*pWaveform, waveform);
+}
+
+TEST_F(WaveformTest, ReadLegacyFormat) {
+    const auto pWaveform = createWaveform();
+    const Waveform waveform(toLegacyByteArray(*pWaveform));
+    EXPECT_TRUE(waveform.isValid());
+    expectEqualLevels(*pWaveform, waveform);
+}
+
+TEST_F(WaveformTest, CorruptCompactFormat) {
+    const auto pWaveform = createWaveform();
+    QByteArray data = pWaveform->toByteArray();
+    mixxx::CompactWaveformFormat::Header header;
+    ASSERT_TRUE(mixxx::CompactWaveformFormat::readHeader(data, &header));
+
+    // A corrupt lower level of detail is recomputed
+    QByteArray corruptLevel1 = data;
+    corruptLevel1[header.levels[1].offset + 10] =
+            static_cast<char>(~data.at(header.levels[1].offset + 10));
+    expectEqualLevels(*pWaveform, Waveform(corruptLevel1));
+
+    // Level 0 is required
+    QByteArray corruptLevel0 = data;
+    corruptLevel0[header.levels[0].offset + 10] =
+            static_cast<char>(~data.at(header.levels[0].offset + 10));
+    EXPECT_FALSE(Waveform(corruptLevel0).isValid());
+
+    EXPECT_FALSE(Waveform(data.left(header.size - 1)).isValid());
+}
+
+static void BM_ReadLegacyWaveform(benchmark::State& state) {
+    const QByteArray data = qCompress(toLegacyByteArray(*createWaveform()));
+    state.counters["bytes"] = data.size();
+    for (auto _ : state) {
+        Waveform waveform(qUncompress(data));
+        benchmark::DoNotOptimize(waveform.getDataSize());
+    }
+}
+BENCHMARK(BM_ReadLegacyWaveform)->Unit(benchmark::kMillisecond);
+
+static void BM_ReadCompactWaveform(benchmark::State& state) {
+    const QByteArray data = createWaveform()->toByteArray();
+    state.counters["bytes"] = data.size();
+    for (auto _ : state) {
+        Waveform waveform(data);
+        benchmark::DoNotOptimize(waveform.getDataSize());
+    }
+}
+BENCHMARK(BM_ReadCompactWaveform)->Unit(benchmark::kMillisecond);
+
+} // namespace
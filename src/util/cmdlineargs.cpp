@@ -161,7 +161,7 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
 
     const QCommandLineOption timelinePath(QStringLiteral("timeline-path"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
-                                      "Path the debug statistics time line is written to")
+                                      "Path the timeline of traced threads is written to in Chrome Trace Event format")
                             : QString(),
             QStringLiteral("path"));
     QCommandLineOption timelinePathDeprecated(
@@ -0,0 +1,77 @@
+#include "util/cpufeatures.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace mixxx {
+
+namespace {
+
+struct X86Features {
+    bool sse41 = false;
+    bool avx2 = false;
+    bool avx512f = false;
+};
+
+X86Features detectX86Features() {
+    X86Features features;
+#if defined(__x86_64__) || defined(__i386__)
+    // Also checks if the OS saves the extended registers
+    __builtin_cpu_init();
+    features.sse41 = __builtin_cpu_supports("sse4.1");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    features.sse41 = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    // The OS must save the YMM (bits 1-2) and ZMM (bits 5-7) registers
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool ymmEnabled = (xcr0 & 0x06) == 0x06;
+    const bool zmmEnabled = (xcr0 & 0xe6) == 0xe6;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        features.avx2 = ymmEnabled && (info[1] & (1 << 5)) != 0;
+        features.avx512f = zmmEnabled && (info[1] & (1 << 16)) != 0;
+    }
+#endif
+    return features;
+}
+
+const X86Features& x86Features() {
+    static const X86Features s_features = detectX86Features();
+    return s_features;
+}
+
+} // anonymous namespace
+
+// static
+bool CpuFeatures::hasSse41() {
+    return x86Features().sse41;
+}
+
+// static
+bool CpuFeatures::hasAvx2() {
+    return x86Features().avx2;
+}
+
+// static
+bool CpuFeatures::hasAvx512f() {
+    return x86Features().avx512f;
+}
+
+// static
+bool CpuFeatures::hasNeon() {
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace mixxx
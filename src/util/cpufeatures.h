@@ -0,0 +1,19 @@
+#pragma once
+
+namespace mixxx {
+
+/// Instruction set extensions of the CPU that are detected at runtime.
+/// Code that is compiled for a specific extension must only be executed
+/// if the corresponding function returns true.
+class CpuFeatures {
+  public:
+    static bool hasSse41();
+    static bool hasAvx2();
+    /// AVX-512 Foundation
+    static bool hasAvx512f();
+    /// NEON is part of the baseline on 64-bit ARM and detected at compile
+    /// time on 32-bit ARM.
+    static bool hasNeon();
+};
+
+} // namespace mixxx
@@ -231,9 +231,66 @@ void sqliteLikeUtf8(sqlite3_context* context,
     return;
 }
 
+// Negative values are interpreted as KiB instead of pages
+constexpr int kCacheSizeKiB = 16 * 1024;
+
+// Memory-mapped I/O avoids copying pages from the file system
+// cache into the page cache of each connection
+constexpr qint64 kMmapSizeBytes = 256 * 1024 * 1024;
+
+void execPragma(sqlite3* handle, const QString& pragma) {
+    char* errmsg = nullptr;
+    const int result = sqlite3_exec(
+            handle,
+            pragma.toUtf8().constData(),
+            nullptr,
+            nullptr,
+            &errmsg);
+    if (result != SQLITE_OK) {
+        kLogger.warning()
+                << "Failed to execute"
+                << pragma
+                << result
+                << errmsg;
+    }
+    sqlite3_free(errmsg);
+}
+
+void configureDatabase(sqlite3* handle, bool writeAheadLog) {
+    const bool readOnly = sqlite3_db_readonly(handle, "main") > 0;
+    const char* fileName = sqlite3_db_filename(handle, "main");
+    const bool inMemory = !fileName || !*fileName;
+    if (!inMemory) {
+        // The journal mode is persistent and only needs to be changed
+        // once, but it cannot be changed if the file is not writable.
+        if (!readOnly) {
+            if (writeAheadLog) {
+                // In WAL mode readers do not block the writer and the writer
+                // does not block readers. Long-running transactions of the
+                // library scanner would otherwise freeze the library views.
+                execPragma(handle, QStringLiteral("PRAGMA journal_mode=WAL"));
+                // Transactions remain durable unless the system crashes or
+                // loses power, which is sufficient for a WAL database.
+                execPragma(handle, QStringLiteral("PRAGMA synchronous=NORMAL"));
+            } else {
+                // Revert to the default journal if the write-ahead log
+                // has been enabled before
+                execPragma(handle, QStringLiteral("PRAGMA journal_mode=DELETE"));
+            }
+        }
+        execPragma(handle,
+                QStringLiteral("PRAGMA mmap_size=%1").arg(kMmapSizeBytes));
+    }
+    execPragma(handle,
+            QStringLiteral("PRAGMA cache_size=%1").arg(-kCacheSizeKiB));
+    execPragma(handle, QStringLiteral("PRAGMA temp_store=MEMORY"));
+}
+
 #endif // __SQLITE3__
 
-bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator) {
+bool initDatabase(const QSqlDatabase& database,
+        mixxx::StringCollator* pCollator,
+        bool writeAheadLog) {
     DEBUG_ASSERT(database.isOpen());
 #ifdef __SQLITE3__
     QVariant v = database.driver()->handle();
@@ -305,9 +362,12 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
                 << "Failed to install custom 3-arg LIKE function for SQLite3:"
                 << result;
     }
+
+    configureDatabase(handle, writeAheadLog);
 #else
     Q_UNUSED(database);
     Q_UNUSED(pCollator);
+    Q_UNUSED(writeAheadLog);
 #endif // __SQLITE3__
     return true;
 }
@@ -317,13 +377,15 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
 DbConnection::DbConnection(
         const Params& params,
         const QString& connectionName)
-    : m_sqlDatabase(createDatabase(params, connectionName)) {
+    : m_sqlDatabase(createDatabase(params, connectionName)),
+      m_writeAheadLog(params.writeAheadLog) {
 }
 
 DbConnection::DbConnection(
         const DbConnection& prototype,
         const QString& connectionName)
-    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)),
+      m_writeAheadLog(prototype.m_writeAheadLog) {
 }
 
 DbConnection::~DbConnection() {
@@ -344,7 +406,7 @@ bool DbConnection::open() {
                 << m_sqlDatabase.lastError();
         return false; // abort
     }
-    if (!initDatabase(m_sqlDatabase, &m_collator)) {
+    if (!initDatabase(m_sqlDatabase, &m_collator, m_writeAheadLog)) {
         kLogger.warning()
                 << "Failed to initialize database connection"
                 << *this;
@@ -29,6 +29,9 @@ class DbConnection final {
         QString filePath;
         QString userName;
         QString password;
+        // Use a write-ahead log instead of a rollback journal. Must
+        // not be enabled for databases on network file systems.
+        bool writeAheadLog = false;
     };
 
     // All constructors are reserved for DbConnectionPool!!
@@ -62,6 +65,7 @@ class DbConnection final {
     DbConnection(const DbConnection&&) = delete;
 
     QSqlDatabase m_sqlDatabase;
+    const bool m_writeAheadLog;
     mixxx::StringCollator m_collator;
 };
 
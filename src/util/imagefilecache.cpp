@@ -0,0 +1,167 @@
+#include "util/imagefilecache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cstring>
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("ImageFileCache");
+
+const QString kFileSuffix = QStringLiteral(".img");
+
+constexpr char kFileMagic[4] = {'M', 'X', 'I', 'C'};
+
+// Increment the version if the file format changes
+constexpr quint32 kFileVersion = 2;
+
+// The pixels start at a 32-byte aligned offset, so that the mapped
+// file can be read with aligned loads. All numbers are stored in the
+// native byte order, because the cache is not shared between machines.
+struct FileHeader {
+    char magic[4];
+    quint32 version;
+    quint32 format;
+    quint32 width;
+    quint32 height;
+    quint32 bytesPerLine;
+    quint32 reserved[2];
+};
+static_assert(sizeof(FileHeader) == 32, "unexpected padding of FileHeader");
+
+} // anonymous namespace
+
+ImageFileCache::ImageFileCache(const QString& directory)
+        : m_directory(directory),
+          m_valid(QDir().mkpath(directory)) {
+    if (!m_valid) {
+        kLogger.warning() << "Failed to create directory" << directory;
+    }
+}
+
+QString ImageFileCache::filePath(const QString& key) const {
+    DEBUG_ASSERT(!key.contains('/'));
+    return QDir(m_directory).filePath(key + kFileSuffix);
+}
+
+QImage ImageFileCache::load(const QString& key) const {
+    if (!m_valid) {
+        return QImage();
+    }
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QImage();
+    }
+    const qint64 fileSize = file.size();
+    if (fileSize < static_cast<qint64>(sizeof(FileHeader))) {
+        return QImage();
+    }
+    uchar* pData = file.map(0, fileSize);
+    if (!pData) {
+        return QImage();
+    }
+    FileHeader header;
+    std::memcpy(&header, pData, sizeof(header));
+    QImage image;
+    if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) == 0 &&
+            header.version == kFileVersion &&
+            header.format > QImage::Format_Invalid &&
+            header.format < QImage::NImageFormats &&
+            header.width > 0 && header.height > 0 &&
+            fileSize == static_cast<qint64>(sizeof(header)) +
+                            static_cast<qint64>(header.bytesPerLine) * header.height) {
+        // Wraps the mapped pixels without copying them
+        const QImage mappedImage(pData + sizeof(header),
+                static_cast<int>(header.width),
+                static_cast<int>(header.height),
+                static_cast<int>(header.bytesPerLine),
+                static_cast<QImage::Format>(header.format));
+        // Detach before the file is unmapped
+        image = mappedImage.copy();
+    } else {
+        kLogger.warning() << "Ignoring invalid file" << file.fileName();
+    }
+    file.unmap(pData);
+    file.close();
+    // The modification time tracks the last use for prune(). Setting it
+    // requires write access on Windows. The file might have been removed
+    // in the meantime, which must not create an empty file.
+    if (!image.isNull() &&
+            file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly)) {
+        file.setFileTime(QDateTime::currentDateTimeUtc(),
+                QFileDevice::FileModificationTime);
+    }
+    return image;
+}
+
+bool ImageFileCache::store(const QString& key, const QImage& image) const {
+    VERIFY_OR_DEBUG_ASSERT(!image.isNull() && image.colorCount() == 0) {
+        return false;
+    }
+    if (!m_valid) {
+        return false;
+    }
+    FileHeader header = {};
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kFileVersion;
+    header.format = image.format();
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = image.bytesPerLine();
+
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning() << "Failed to create file" << file.fileName();
+        return false;
+    }
+    const auto size = image.sizeInBytes();
+    if (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) !=
+                    static_cast<qint64>(sizeof(header)) ||
+            file.write(reinterpret_cast<const char*>(image.constBits()), size) != size ||
+            !file.commit()) {
+        kLogger.warning() << "Failed to write file" << file.fileName();
+        return false;
+    }
+    return true;
+}
+
+void ImageFileCache::retain(const QSet<QString>& keys) const {
+    if (!m_valid) {
+        return;
+    }
+    QDir dir(m_directory);
+    const QFileInfoList fileInfos = dir.entryInfoList(
+            QStringList{QStringLiteral("*") + kFileSuffix}, QDir::Files);
+    for (const auto& fileInfo : fileInfos) {
+        if (!keys.contains(fileInfo.completeBaseName())) {
+            dir.remove(fileInfo.fileName());
+        }
+    }
+}
+
+void ImageFileCache::prune(qint64 maxTotalBytes) const {
+    if (!m_valid) {
+        return;
+    }
+    QDir dir(m_directory);
+    // Most recently used first
+    const QFileInfoList fileInfos = dir.entryInfoList(
+            QStringList{QStringLiteral("*") + kFileSuffix}, QDir::Files, QDir::Time);
+    qint64 totalBytes = 0;
+    for (const auto& fileInfo : fileInfos) {
+        totalBytes += fileInfo.size();
+        if (totalBytes > maxTotalBytes) {
+            dir.remove(fileInfo.fileName());
+        }
+    }
+}
+
+} // namespace mixxx
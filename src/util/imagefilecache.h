@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QImage>
+#include <QSet>
+#include <QString>
+
+namespace mixxx {
+
+/// A persistent cache of decoded images on disk.
+///
+/// Each entry is stored in its own file, named after a key that is
+/// derived from the contents of the original image, e.g. a digest of the
+/// file and the requested size. The pixels are stored uncompressed in the
+/// memory layout of QImage behind a small fixed-size header, so loading an
+/// entry only needs to map the file and copy the pixels. Neither JPEG nor
+/// PNG decoding nor SVG rendering is required.
+///
+/// All member functions are thread-safe. Entries are replaced atomically
+/// and concurrent writers of the same key store identical images.
+class ImageFileCache {
+  public:
+    /// Entries are stored in the directory, which is created if needed.
+    explicit ImageFileCache(const QString& directory);
+
+    /// Returns false if the directory could not be created.
+    bool isValid() const {
+        return m_valid;
+    }
+
+    const QString& directory() const {
+        return m_directory;
+    }
+
+    QString filePath(const QString& key) const;
+
+    /// Returns the cached image or a null image if there is no valid entry.
+    QImage load(const QString& key) const;
+
+    /// Stores the image. Indexed images with a color table are not
+    /// supported.
+    bool store(const QString& key, const QImage& image) const;
+
+    /// Removes all entries except those with the given keys.
+    void retain(const QSet<QString>& keys) const;
+
+    /// Removes the least recently used entries until the total size of all
+    /// remaining entries does not exceed the limit.
+    void prune(qint64 maxTotalBytes) const;
+
+  private:
+    QString m_directory;
+    bool m_valid;
+};
+
+} // namespace mixxx
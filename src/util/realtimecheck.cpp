@@ -0,0 +1,127 @@
+#include "util/realtimecheck.h"
+
+#include <algorithm>
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+
+#include <cstdlib>
+#define MIXXX_REALTIME_CHECK_STACKS
+#endif
+
+namespace mixxx {
+
+namespace {
+
+QString violationName(RealtimeCheck::Violation violation) {
+    switch (violation) {
+    case RealtimeCheck::Violation::Allocation:
+        return QStringLiteral("Allocation");
+    case RealtimeCheck::Violation::Deallocation:
+        return QStringLiteral("Deallocation");
+    case RealtimeCheck::Violation::Lock:
+        return QStringLiteral("Mutex lock");
+    }
+    return QString();
+}
+
+constexpr int kMaxRecordedViolations = 8;
+constexpr int kMaxStackDepth = 32;
+
+struct ViolationRecord {
+    std::atomic<bool> complete;
+    RealtimeCheck::Violation violation;
+    std::size_t size;
+    int stackDepth;
+    void* stack[kMaxStackDepth];
+};
+
+ViolationRecord s_records[kMaxRecordedViolations];
+std::atomic<int> s_recordCount(0);
+
+// Suppresses violations caused by capturing the stack of a violation
+thread_local bool s_reporting = false;
+
+} // anonymous namespace
+
+// static
+thread_local int RealtimeCheck::s_scopeDepth = 0;
+
+// static
+std::atomic<bool> RealtimeCheck::s_enabled(false);
+
+// static
+std::atomic<int> RealtimeCheck::s_violationCount(0);
+
+// static
+void RealtimeCheck::enable() {
+#ifdef MIXXX_REALTIME_CHECK_STACKS
+    // The first call of backtrace() loads libgcc_s, which allocates memory
+    // and locks a mutex. This must not happen on a realtime thread.
+    void* stack[1];
+    backtrace(stack, 1);
+#endif
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+// static
+void RealtimeCheck::reportViolation(Violation violation, std::size_t size) {
+    if (s_reporting) {
+        return;
+    }
+    s_reporting = true;
+    s_violationCount.fetch_add(1);
+    const int index = s_recordCount.fetch_add(1);
+    if (index < kMaxRecordedViolations) {
+        ViolationRecord& record = s_records[index];
+        record.violation = violation;
+        record.size = size;
+#ifdef MIXXX_REALTIME_CHECK_STACKS
+        record.stackDepth = backtrace(record.stack, kMaxStackDepth);
+#else
+        record.stackDepth = 0;
+#endif
+        record.complete.store(true, std::memory_order_release);
+    }
+    s_reporting = false;
+}
+
+// static
+QString RealtimeCheck::takeViolationReport() {
+    const int violationCount = takeViolationCount();
+    const int recordCount = std::min(s_recordCount.exchange(0), kMaxRecordedViolations);
+    if (violationCount == 0) {
+        return QString();
+    }
+    QString report = QStringLiteral("%1 violation(s) on realtime threads")
+                             .arg(violationCount);
+    for (int i = 0; i < recordCount; ++i) {
+        ViolationRecord& record = s_records[i];
+        if (!record.complete.exchange(false, std::memory_order_acquire)) {
+            continue;
+        }
+        report += QStringLiteral("\n%1").arg(violationName(record.violation));
+        if (record.size > 0) {
+            report += QStringLiteral(" of %1 bytes").arg(record.size);
+        }
+#ifdef MIXXX_REALTIME_CHECK_STACKS
+        report += QStringLiteral(" at:");
+        char** symbols = backtrace_symbols(record.stack, record.stackDepth);
+        if (!symbols) {
+            continue;
+        }
+        // Skip reportViolation()
+        for (int j = 1; j < record.stackDepth; ++j) {
+            report += QStringLiteral("\n    ") + QString::fromLocal8Bit(symbols[j]);
+        }
+        std::free(symbols);
+#endif
+    }
+    if (violationCount > recordCount) {
+        report += QStringLiteral("\n%1 more violation(s) without stack")
+                          .arg(violationCount - recordCount);
+    }
+    return report;
+}
+
+} // namespace mixxx
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <cstddef>
+
+namespace mixxx {
+
+/// Detects heap allocations and mutex locks on realtime threads, i.e.
+/// within EngineMaster::process().
+///
+/// Realtime code is marked with a Scope on the stack, which only counts
+/// the nesting depth of the current thread. With the REALTIME_CHECK CMake
+/// option, mixxx-test interposes malloc/free, pthread_mutex_lock and the
+/// futex system call, which is used by QMutex, to report all calls within
+/// a Scope together with the stack of the caller. The engine tests fail if
+/// any violation has been reported while processing a buffer. Mixxx itself
+/// is built the same with and without the option.
+class RealtimeCheck final {
+  public:
+    enum class Violation {
+        Allocation,
+        Deallocation,
+        Lock,
+    };
+
+    /// Checks if the hooks are linked, which enable() the check
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Invoked by the hooks before main()
+    static void enable();
+
+    class Scope final {
+      public:
+        Scope() {
+            ++s_scopeDepth;
+        }
+        ~Scope() {
+            --s_scopeDepth;
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /// Excludes code that is invoked within a Scope from the check, e.g.
+    /// mocks of the engine tests that allocate while recording calls
+    class Suspension final {
+      public:
+        Suspension()
+                : m_scopeDepth(s_scopeDepth) {
+            s_scopeDepth = 0;
+        }
+        ~Suspension() {
+            s_scopeDepth = m_scopeDepth;
+        }
+        Suspension(const Suspension&) = delete;
+        Suspension& operator=(const Suspension&) = delete;
+
+      private:
+        const int m_scopeDepth;
+    };
+
+    /// Checks if the current thread is within a Scope
+    static bool isRealtime() {
+        return s_scopeDepth > 0;
+    }
+
+    /// Invoked by the hooks. Neither allocates nor locks. Only the
+    /// first few violations are recorded with their stack.
+    static void reportViolation(Violation violation, std::size_t size = 0);
+
+    /// Returns and resets the number of violations within a Scope
+    /// on any thread
+    static int takeViolationCount() {
+        return s_violationCount.exchange(0);
+    }
+
+    /// Returns a description of all recorded violations including
+    /// their symbolized stacks and resets them. The result is empty
+    /// if no violation has been reported.
+    ///
+    /// Must not be called while a realtime thread is running.
+    static QString takeViolationReport();
+
+  private:
+    static thread_local int s_scopeDepth;
+    static std::atomic<bool> s_enabled;
+    static std::atomic<int> s_violationCount;
+};
+
+} // namespace mixxx
@@ -1,10 +1,13 @@
 #include "util/sample.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 
 #include "engine/engine.h"
+#include "util/cpufeatures.h"
 #include "util/math.h"
+#include "util/sample_kernels.h"
 
 #ifdef __WINDOWS__
 #include <QtGlobal>
@@ -38,6 +41,168 @@ constexpr bool useAlignedAlloc() {
             sizeof(CSAMPLE*) == sizeof(size_t);
 }
 
+// The scalar reference implementations of the kernels. The results
+// of the vectorized kernels must match them exactly, see sample_kernels.h.
+
+void applyGainScalar(CSAMPLE* pBuffer, CSAMPLE_GAIN gain, SINT numSamples) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples; ++i) {
+        pBuffer[i] *= gain;
+    }
+}
+
+void copyWithRampingGainScalar(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN start_gain,
+        CSAMPLE_GAIN gain_delta,
+        SINT numFrames) {
+    // note: LOOP VECTORIZED only with "int i" (not SINT i)
+    for (int i = 0; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void addWithRampingGainScalar(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN start_gain,
+        CSAMPLE_GAIN gain_delta,
+        SINT numFrames) {
+    // note: LOOP VECTORIZED.
+    for (int i = 0; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
+        pDest[i * 2] += pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void sumAbsPerChannelScalar(CSAMPLE* pSumAbsL,
+        CSAMPLE* pSumAbsR,
+        bool* pClippedL,
+        bool* pClippedR,
+        const CSAMPLE* pBuffer,
+        SINT numFrames) {
+    constexpr SINT kBlockSamples = SampleUtilKernels::kSumAbsBlockSamples;
+    // The samples of each block are summed up in separate lanes, even
+    // lanes are left and odd lanes are right.
+    CSAMPLE sums[kBlockSamples] = {};
+    CSAMPLE clipped[kBlockSamples] = {};
+    const SINT numBlocks = numFrames / SampleUtilKernels::kSumAbsBlockFrames;
+    for (SINT b = 0; b < numBlocks; ++b) {
+        const CSAMPLE* pBlock = pBuffer + b * kBlockSamples;
+        // note: LOOP VECTORIZED.
+        for (SINT j = 0; j < kBlockSamples; ++j) {
+            const CSAMPLE absValue = fabs(pBlock[j]);
+            sums[j] += absValue;
+            // Replacing the code with a bool clipped will prevent vetorizing
+            clipped[j] += absValue > CSAMPLE_PEAK ? 1 : 0;
+        }
+    }
+    // Pairwise reduction until a single frame is left
+    for (SINT width = kBlockSamples / 2; width >= 2; width /= 2) {
+        for (SINT j = 0; j < width; ++j) {
+            sums[j] += sums[j + width];
+            clipped[j] += clipped[j + width];
+        }
+    }
+    CSAMPLE sumAbsL = sums[0];
+    CSAMPLE sumAbsR = sums[1];
+    bool clippedL = clipped[0] > 0;
+    bool clippedR = clipped[1] > 0;
+    for (SINT i = numBlocks * SampleUtilKernels::kSumAbsBlockFrames; i < numFrames; ++i) {
+        const CSAMPLE absL = fabs(pBuffer[i * 2]);
+        const CSAMPLE absR = fabs(pBuffer[i * 2 + 1]);
+        sumAbsL += absL;
+        sumAbsR += absR;
+        clippedL |= absL > CSAMPLE_PEAK;
+        clippedR |= absR > CSAMPLE_PEAK;
+    }
+    *pSumAbsL = sumAbsL;
+    *pSumAbsR = sumAbsR;
+    *pClippedL = clippedL;
+    *pClippedR = clippedR;
+}
+
+void interleaveBufferScalar(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc1,
+        const CSAMPLE* M_RESTRICT pSrc2,
+        SINT numFrames) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numFrames; ++i) {
+        pDest[2 * i] = pSrc1[i];
+        pDest[2 * i + 1] = pSrc2[i];
+    }
+}
+
+void deinterleaveBufferScalar(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE* M_RESTRICT pDest2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numFrames; ++i) {
+        pDest1[i] = pSrc[i * 2];
+        pDest2[i] = pSrc[i * 2 + 1];
+    }
+}
+
+void convertS16ToFloat32Scalar(CSAMPLE* M_RESTRICT pDest,
+        const SAMPLE* M_RESTRICT pSrc,
+        SINT numSamples) {
+    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples; ++i) {
+        pDest[i] = CSAMPLE(pSrc[i]) / kConversionFactor;
+    }
+}
+
+} // anonymous namespace
+
+const SampleUtilKernels kSampleUtilKernelsScalar = {
+        applyGainScalar,
+        copyWithRampingGainScalar,
+        addWithRampingGainScalar,
+        sumAbsPerChannelScalar,
+        interleaveBufferScalar,
+        deinterleaveBufferScalar,
+        convertS16ToFloat32Scalar,
+};
+
+namespace {
+
+const SampleUtilKernels* kernelsForSimdLevel(SampleUtil::SimdLevel level) {
+    switch (level) {
+    case SampleUtil::SimdLevel::Scalar:
+        return &kSampleUtilKernelsScalar;
+#if defined(MIXXX_SAMPLE_KERNELS_X86)
+    case SampleUtil::SimdLevel::Sse41:
+        return mixxx::CpuFeatures::hasSse41() ? &kSampleUtilKernelsSse41 : nullptr;
+    case SampleUtil::SimdLevel::Avx2:
+        return mixxx::CpuFeatures::hasAvx2() ? &kSampleUtilKernelsAvx2 : nullptr;
+    case SampleUtil::SimdLevel::Avx512:
+        return mixxx::CpuFeatures::hasAvx512f() ? &kSampleUtilKernelsAvx512 : nullptr;
+#elif defined(MIXXX_SAMPLE_KERNELS_NEON)
+    case SampleUtil::SimdLevel::Neon:
+        return mixxx::CpuFeatures::hasNeon() ? &kSampleUtilKernelsNeon : nullptr;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+// The scalar kernels are constant-initialized and can be used
+// by static initializers in other files.
+std::atomic<const SampleUtilKernels*> s_pKernels(&kSampleUtilKernelsScalar);
+std::atomic<SampleUtil::SimdLevel> s_simdLevel(SampleUtil::SimdLevel::Scalar);
+
+// Selects the best kernels during static initialization
+[[maybe_unused]] const bool s_simdLevelSelected =
+        SampleUtil::setSimdLevel(SampleUtil::bestSupportedSimdLevel());
+
+inline const SampleUtilKernels& kernels() {
+    return *s_pKernels.load(std::memory_order_relaxed);
+}
+
 } // anonymous namespace
 
 // static
@@ -91,6 +256,43 @@ CSAMPLE* SampleUtil::alloc(SINT size) {
     }
 }
 
+// static
+bool SampleUtil::isSimdLevelSupported(SimdLevel level) {
+    return kernelsForSimdLevel(level) != nullptr;
+}
+
+// static
+SampleUtil::SimdLevel SampleUtil::bestSupportedSimdLevel() {
+    constexpr SimdLevel kLevels[] = {
+            SimdLevel::Avx512,
+            SimdLevel::Avx2,
+            SimdLevel::Sse41,
+            SimdLevel::Neon,
+    };
+    for (const auto level : kLevels) {
+        if (isSimdLevelSupported(level)) {
+            return level;
+        }
+    }
+    return SimdLevel::Scalar;
+}
+
+// static
+SampleUtil::SimdLevel SampleUtil::simdLevel() {
+    return s_simdLevel.load(std::memory_order_relaxed);
+}
+
+// static
+bool SampleUtil::setSimdLevel(SimdLevel level) {
+    const SampleUtilKernels* pKernels = kernelsForSimdLevel(level);
+    if (!pKernels) {
+        return false;
+    }
+    s_pKernels.store(pKernels, std::memory_order_relaxed);
+    s_simdLevel.store(level, std::memory_order_relaxed);
+    return true;
+}
+
 void SampleUtil::free(CSAMPLE* pBuffer) {
     // See SampleUtil::alloc() for details
     if (useAlignedAlloc()) {
@@ -121,10 +323,7 @@ void SampleUtil::applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain,
         return;
     }
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples; ++i) {
-        pBuffer[i] *= gain;
-    }
+    kernels().applyGain(pBuffer, gain, numSamples);
 }
 
 // static
@@ -268,12 +467,7 @@ void SampleUtil::addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
             / CSAMPLE_GAIN(numSamples / 2);
     if (gain_delta != 0) {
         const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            pDest[i * 2] += pSrc[i * 2] * gain;
-            pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
-        }
+        kernels().addWithRampingGain(pDest, pSrc, start_gain, gain_delta, numSamples / 2);
     } else {
         // note: LOOP VECTORIZED.
         for (int i = 0; i < numSamples; ++i) {
@@ -366,12 +560,7 @@ void SampleUtil::copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
             / CSAMPLE_GAIN(numSamples / 2);
     if (gain_delta != 0) {
         const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED only with "int i" (not SINT i)
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            pDest[i * 2] = pSrc[i * 2] * gain;
-            pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
-        }
+        kernels().copyWithRampingGain(pDest, pSrc, start_gain, gain_delta, numSamples / 2);
     } else {
         // note: LOOP VECTORIZED.
         for (SINT i = 0; i < numSamples; ++i) {
@@ -391,11 +580,7 @@ void SampleUtil::convertS16ToFloat32(CSAMPLE* M_RESTRICT pDest,
     // is the highest valid sample. Note that this means that although some
     // sample values convert to -1.0, none will convert to +1.0.
     DEBUG_ASSERT(-SAMPLE_MINIMUM >= SAMPLE_MAXIMUM);
-    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples; ++i) {
-        pDest[i] = CSAMPLE(pSrc[i]) / kConversionFactor;
-    }
+    kernels().convertS16ToFloat32(pDest, pSrc, numSamples);
 }
 
 //static
@@ -416,29 +601,15 @@ void SampleUtil::convertFloat32ToS16(SAMPLE* pDest, const CSAMPLE* pSrc,
 // static
 SampleUtil::CLIP_STATUS SampleUtil::sumAbsPerChannel(CSAMPLE* pfAbsL,
         CSAMPLE* pfAbsR, const CSAMPLE* pBuffer, SINT numSamples) {
-    CSAMPLE fAbsL = CSAMPLE_ZERO;
-    CSAMPLE fAbsR = CSAMPLE_ZERO;
-    CSAMPLE clippedL = 0;
-    CSAMPLE clippedR = 0;
+    bool clippedL = false;
+    bool clippedR = false;
+    kernels().sumAbsPerChannel(pfAbsL, pfAbsR, &clippedL, &clippedR, pBuffer, numSamples / 2);
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples / 2; ++i) {
-        CSAMPLE absl = fabs(pBuffer[i * 2]);
-        fAbsL += absl;
-        clippedL += absl > CSAMPLE_PEAK ? 1 : 0;
-        CSAMPLE absr = fabs(pBuffer[i * 2 + 1]);
-        fAbsR += absr;
-        // Replacing the code with a bool clipped will prevent vetorizing
-        clippedR += absr > CSAMPLE_PEAK ? 1 : 0;
-    }
-
-    *pfAbsL = fAbsL;
-    *pfAbsR = fAbsR;
     SampleUtil::CLIP_STATUS clipping = SampleUtil::NO_CLIPPING;
-    if (clippedL > 0) {
+    if (clippedL) {
         clipping |= SampleUtil::CLIPPING_LEFT;
     }
-    if (clippedR > 0) {
+    if (clippedR) {
         clipping |= SampleUtil::CLIPPING_RIGHT;
     }
     return clipping;
@@ -485,11 +656,7 @@ void SampleUtil::interleaveBuffer(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc1,
         const CSAMPLE* M_RESTRICT pSrc2,
         SINT numFrames) {
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numFrames; ++i) {
-        pDest[2 * i] = pSrc1[i];
-        pDest[2 * i + 1] = pSrc2[i];
-    }
+    kernels().interleaveBuffer(pDest, pSrc1, pSrc2, numFrames);
 }
 
 // static
@@ -497,11 +664,7 @@ void SampleUtil::deinterleaveBuffer(CSAMPLE* M_RESTRICT pDest1,
         CSAMPLE* M_RESTRICT pDest2,
         const CSAMPLE* M_RESTRICT pSrc,
         SINT numFrames) {
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numFrames; ++i) {
-        pDest1[i] = pSrc[i * 2];
-        pDest2[i] = pSrc[i * 2 + 1];
-    }
+    kernels().deinterleaveBuffer(pDest1, pDest2, pSrc, numFrames);
 }
 
 // static
@@ -25,6 +25,24 @@ class SampleUtil {
     // This is some legacy, we cannot easily revert.
     static constexpr double kPlayPositionChannels = 2.0;
 
+    /// The instruction set extensions of the explicitly vectorized
+    /// kernels behind some of the functions below. The best level that
+    /// is supported by the CPU is selected on startup.
+    enum class SimdLevel {
+        Scalar,
+        Sse41,
+        Avx2,
+        Avx512,
+        Neon,
+    };
+
+    static SimdLevel simdLevel();
+    static bool isSimdLevelSupported(SimdLevel level);
+    static SimdLevel bestSupportedSimdLevel();
+    /// Switches the kernels, e.g. for comparing them in tests and
+    /// benchmarks. Returns false if the level is not supported.
+    static bool setSimdLevel(SimdLevel level);
+
     // Allocated a buffer of CSAMPLE's with length size. Ensures that the buffer
     // is 16-byte aligned for SSE enhancement.
     static CSAMPLE* alloc(SINT size);
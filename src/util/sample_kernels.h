@@ -0,0 +1,66 @@
+#pragma once
+
+#include "util/platform.h"
+#include "util/types.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MIXXX_SAMPLE_KERNELS_X86
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define MIXXX_SAMPLE_KERNELS_NEON
+#endif
+
+/// The inner loops of the SampleUtil functions that are explicitly
+/// vectorized for different instruction set extensions. SampleUtil
+/// handles special cases like a gain of 0 or 1 and dispatches to the
+/// table that matches SampleUtil::simdLevel().
+///
+/// All implementations must produce bit-exact results of the scalar
+/// reference implementation in sample.cpp. The source files of the
+/// kernels are compiled without reassociating floating-point operations
+/// or contracting them into fused multiply-adds for this reason.
+struct SampleUtilKernels {
+    /// The number of frames that are summed up in separate lanes by
+    /// sumAbsPerChannel() before the lanes are reduced pairwise.
+    static constexpr SINT kSumAbsBlockFrames = 8;
+    static constexpr SINT kSumAbsBlockSamples = 2 * kSumAbsBlockFrames;
+
+    void (*applyGain)(CSAMPLE* pBuffer, CSAMPLE_GAIN gain, SINT numSamples);
+    /// The stereo frame i is multiplied by startGain + gainDelta * i
+    void (*copyWithRampingGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            CSAMPLE_GAIN startGain,
+            CSAMPLE_GAIN gainDelta,
+            SINT numFrames);
+    /// The stereo frame i is multiplied by startGain + gainDelta * i
+    void (*addWithRampingGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            CSAMPLE_GAIN startGain,
+            CSAMPLE_GAIN gainDelta,
+            SINT numFrames);
+    void (*sumAbsPerChannel)(CSAMPLE* pSumAbsL,
+            CSAMPLE* pSumAbsR,
+            bool* pClippedL,
+            bool* pClippedR,
+            const CSAMPLE* pBuffer,
+            SINT numFrames);
+    void (*interleaveBuffer)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc1,
+            const CSAMPLE* pSrc2,
+            SINT numFrames);
+    void (*deinterleaveBuffer)(CSAMPLE* pDest1,
+            CSAMPLE* pDest2,
+            const CSAMPLE* pSrc,
+            SINT numFrames);
+    void (*convertS16ToFloat32)(CSAMPLE* pDest,
+            const SAMPLE* pSrc,
+            SINT numSamples);
+};
+
+extern const SampleUtilKernels kSampleUtilKernelsScalar;
+#if defined(MIXXX_SAMPLE_KERNELS_X86)
+extern const SampleUtilKernels kSampleUtilKernelsSse41;
+extern const SampleUtilKernels kSampleUtilKernelsAvx2;
+extern const SampleUtilKernels kSampleUtilKernelsAvx512;
+#elif defined(MIXXX_SAMPLE_KERNELS_NEON)
+extern const SampleUtilKernels kSampleUtilKernelsNeon;
+#endif
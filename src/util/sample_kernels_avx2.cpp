@@ -0,0 +1,199 @@
+#include "util/sample_kernels.h"
+
+#if defined(MIXXX_SAMPLE_KERNELS_X86)
+
+#include <immintrin.h>
+
+// This file is compiled with AVX2 enabled. The kernels must only be
+// called if the CPU supports AVX2, see mixxx::CpuFeatures. Inline functions
+// with external linkage from other headers must not be called here, because
+// the linker might pick the AVX2 version for the callers in other files.
+
+namespace {
+
+inline CSAMPLE absSample(CSAMPLE value) {
+    return value < CSAMPLE_ZERO ? -value : value;
+}
+
+void applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain, SINT numSamples) {
+    const __m256 gainVec = _mm256_set1_ps(gain);
+    SINT i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        _mm256_storeu_ps(pBuffer + i, _mm256_mul_ps(_mm256_loadu_ps(pBuffer + i), gainVec));
+    }
+    for (; i < numSamples; ++i) {
+        pBuffer[i] *= gain;
+    }
+}
+
+void copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const __m256 startGainVec = _mm256_set1_ps(startGain);
+    const __m256 gainDeltaVec = _mm256_set1_ps(gainDelta);
+    // The frame indices are exact up to 2^24 frames
+    __m256 frameIndex = _mm256_setr_ps(0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f);
+    const __m256 frameIndexStep = _mm256_set1_ps(4.0f);
+    SINT i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m256 gain = _mm256_add_ps(startGainVec, _mm256_mul_ps(gainDeltaVec, frameIndex));
+        _mm256_storeu_ps(pDest + i * 2, _mm256_mul_ps(_mm256_loadu_ps(pSrc + i * 2), gain));
+        frameIndex = _mm256_add_ps(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const __m256 startGainVec = _mm256_set1_ps(startGain);
+    const __m256 gainDeltaVec = _mm256_set1_ps(gainDelta);
+    __m256 frameIndex = _mm256_setr_ps(0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f);
+    const __m256 frameIndexStep = _mm256_set1_ps(4.0f);
+    SINT i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m256 gain = _mm256_add_ps(startGainVec, _mm256_mul_ps(gainDeltaVec, frameIndex));
+        _mm256_storeu_ps(pDest + i * 2,
+                _mm256_add_ps(_mm256_loadu_ps(pDest + i * 2),
+                        _mm256_mul_ps(_mm256_loadu_ps(pSrc + i * 2), gain)));
+        frameIndex = _mm256_add_ps(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] += pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void sumAbsPerChannel(CSAMPLE* pSumAbsL,
+        CSAMPLE* pSumAbsR,
+        bool* pClippedL,
+        bool* pClippedR,
+        const CSAMPLE* pBuffer,
+        SINT numFrames) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 peak = _mm256_set1_ps(CSAMPLE_PEAK);
+    // The partial sums of the samples 0-7 and 8-15 of each block
+    __m256 sums0 = _mm256_setzero_ps();
+    __m256 sums1 = _mm256_setzero_ps();
+    // Even lanes are left, odd lanes are right
+    __m256 clipped = _mm256_setzero_ps();
+    const SINT numBlocks = numFrames / SampleUtilKernels::kSumAbsBlockFrames;
+    for (SINT b = 0; b < numBlocks; ++b) {
+        const CSAMPLE* pBlock = pBuffer + b * SampleUtilKernels::kSumAbsBlockSamples;
+        const __m256 abs0 = _mm256_and_ps(_mm256_loadu_ps(pBlock), absMask);
+        const __m256 abs1 = _mm256_and_ps(_mm256_loadu_ps(pBlock + 8), absMask);
+        sums0 = _mm256_add_ps(sums0, abs0);
+        sums1 = _mm256_add_ps(sums1, abs1);
+        clipped = _mm256_or_ps(clipped,
+                _mm256_or_ps(_mm256_cmp_ps(abs0, peak, _CMP_GT_OQ),
+                        _mm256_cmp_ps(abs1, peak, _CMP_GT_OQ)));
+    }
+    // Pairwise reduction: 16 -> 8 -> 4 -> 2 lanes
+    const __m256 sums8 = _mm256_add_ps(sums0, sums1);
+    const __m128 sums4 = _mm_add_ps(_mm256_castps256_ps128(sums8), _mm256_extractf128_ps(sums8, 1));
+    const __m128 sumsLR = _mm_add_ps(sums4, _mm_movehl_ps(sums4, sums4));
+    CSAMPLE sumAbsL = _mm_cvtss_f32(sumsLR);
+    CSAMPLE sumAbsR = _mm_cvtss_f32(_mm_shuffle_ps(sumsLR, sumsLR, _MM_SHUFFLE(1, 1, 1, 1)));
+    const int clippedMask = _mm256_movemask_ps(clipped);
+    bool clippedL = (clippedMask & 0x55) != 0;
+    bool clippedR = (clippedMask & 0xaa) != 0;
+    for (SINT i = numBlocks * SampleUtilKernels::kSumAbsBlockFrames; i < numFrames; ++i) {
+        const CSAMPLE absL = absSample(pBuffer[i * 2]);
+        const CSAMPLE absR = absSample(pBuffer[i * 2 + 1]);
+        sumAbsL += absL;
+        sumAbsR += absR;
+        clippedL |= absL > CSAMPLE_PEAK;
+        clippedR |= absR > CSAMPLE_PEAK;
+    }
+    *pSumAbsL = sumAbsL;
+    *pSumAbsR = sumAbsR;
+    *pClippedL = clippedL;
+    *pClippedR = clippedR;
+}
+
+void interleaveBuffer(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc1,
+        const CSAMPLE* M_RESTRICT pSrc2,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        const __m256 src1 = _mm256_loadu_ps(pSrc1 + i);
+        const __m256 src2 = _mm256_loadu_ps(pSrc2 + i);
+        // Frames 0, 1, 4, 5 and 2, 3, 6, 7
+        const __m256 lo = _mm256_unpacklo_ps(src1, src2);
+        const __m256 hi = _mm256_unpackhi_ps(src1, src2);
+        _mm256_storeu_ps(pDest + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(pDest + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    for (; i < numFrames; ++i) {
+        pDest[2 * i] = pSrc1[i];
+        pDest[2 * i + 1] = pSrc2[i];
+    }
+}
+
+void deinterleaveBuffer(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE* M_RESTRICT pDest2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        const __m256 src0 = _mm256_loadu_ps(pSrc + i * 2);
+        const __m256 src1 = _mm256_loadu_ps(pSrc + i * 2 + 8);
+        // Frames 0, 1, 4, 5, 2, 3, 6, 7
+        const __m256 dest1 = _mm256_shuffle_ps(src0, src1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 dest2 = _mm256_shuffle_ps(src0, src1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm256_storeu_ps(pDest1 + i,
+                _mm256_castpd_ps(_mm256_permute4x64_pd(
+                        _mm256_castps_pd(dest1), _MM_SHUFFLE(3, 1, 2, 0))));
+        _mm256_storeu_ps(pDest2 + i,
+                _mm256_castpd_ps(_mm256_permute4x64_pd(
+                        _mm256_castps_pd(dest2), _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+    for (; i < numFrames; ++i) {
+        pDest1[i] = pSrc[i * 2];
+        pDest2[i] = pSrc[i * 2 + 1];
+    }
+}
+
+void convertS16ToFloat32(CSAMPLE* M_RESTRICT pDest,
+        const SAMPLE* M_RESTRICT pSrc,
+        SINT numSamples) {
+    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
+    // Multiplying with the reciprocal of a power of 2 is exact
+    const __m256 scale = _mm256_set1_ps(1.0f / kConversionFactor);
+    SINT i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        const __m128i src0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+        const __m128i src1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i + 8));
+        _mm256_storeu_ps(pDest + i,
+                _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(src0)), scale));
+        _mm256_storeu_ps(pDest + i + 8,
+                _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(src1)), scale));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] = CSAMPLE(pSrc[i]) / kConversionFactor;
+    }
+}
+
+} // anonymous namespace
+
+const SampleUtilKernels kSampleUtilKernelsAvx2 = {
+        applyGain,
+        copyWithRampingGain,
+        addWithRampingGain,
+        sumAbsPerChannel,
+        interleaveBuffer,
+        deinterleaveBuffer,
+        convertS16ToFloat32,
+};
+
+#endif // MIXXX_SAMPLE_KERNELS_X86
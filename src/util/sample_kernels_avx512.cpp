@@ -0,0 +1,196 @@
+#include "util/sample_kernels.h"
+
+#if defined(MIXXX_SAMPLE_KERNELS_X86)
+
+#include <immintrin.h>
+
+// This file is compiled with AVX-512F enabled. The kernels must only be
+// called if the CPU supports AVX-512F, see mixxx::CpuFeatures. Inline
+// functions with external linkage from other headers must not be called
+// here, because the linker might pick the AVX-512 version for the callers
+// in other files.
+
+namespace {
+
+inline CSAMPLE absSample(CSAMPLE value) {
+    return value < CSAMPLE_ZERO ? -value : value;
+}
+
+void applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain, SINT numSamples) {
+    const __m512 gainVec = _mm512_set1_ps(gain);
+    SINT i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        _mm512_storeu_ps(pBuffer + i, _mm512_mul_ps(_mm512_loadu_ps(pBuffer + i), gainVec));
+    }
+    for (; i < numSamples; ++i) {
+        pBuffer[i] *= gain;
+    }
+}
+
+// The frame indices of the 8 stereo frames in a vector
+inline __m512 initialFrameIndex() {
+    return _mm512_setr_ps(0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f,
+            4.0f, 4.0f, 5.0f, 5.0f, 6.0f, 6.0f, 7.0f, 7.0f);
+}
+
+void copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const __m512 startGainVec = _mm512_set1_ps(startGain);
+    const __m512 gainDeltaVec = _mm512_set1_ps(gainDelta);
+    // The frame indices are exact up to 2^24 frames
+    __m512 frameIndex = initialFrameIndex();
+    const __m512 frameIndexStep = _mm512_set1_ps(8.0f);
+    SINT i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        const __m512 gain = _mm512_add_ps(startGainVec, _mm512_mul_ps(gainDeltaVec, frameIndex));
+        _mm512_storeu_ps(pDest + i * 2, _mm512_mul_ps(_mm512_loadu_ps(pSrc + i * 2), gain));
+        frameIndex = _mm512_add_ps(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const __m512 startGainVec = _mm512_set1_ps(startGain);
+    const __m512 gainDeltaVec = _mm512_set1_ps(gainDelta);
+    __m512 frameIndex = initialFrameIndex();
+    const __m512 frameIndexStep = _mm512_set1_ps(8.0f);
+    SINT i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        const __m512 gain = _mm512_add_ps(startGainVec, _mm512_mul_ps(gainDeltaVec, frameIndex));
+        _mm512_storeu_ps(pDest + i * 2,
+                _mm512_add_ps(_mm512_loadu_ps(pDest + i * 2),
+                        _mm512_mul_ps(_mm512_loadu_ps(pSrc + i * 2), gain)));
+        frameIndex = _mm512_add_ps(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] += pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void sumAbsPerChannel(CSAMPLE* pSumAbsL,
+        CSAMPLE* pSumAbsR,
+        bool* pClippedL,
+        bool* pClippedR,
+        const CSAMPLE* pBuffer,
+        SINT numFrames) {
+    const __m512 peak = _mm512_set1_ps(CSAMPLE_PEAK);
+    // The partial sums of the samples 0-15 of each block
+    __m512 sums = _mm512_setzero_ps();
+    // Even bits are left, odd bits are right
+    __mmask16 clipped = 0;
+    const SINT numBlocks = numFrames / SampleUtilKernels::kSumAbsBlockFrames;
+    for (SINT b = 0; b < numBlocks; ++b) {
+        const CSAMPLE* pBlock = pBuffer + b * SampleUtilKernels::kSumAbsBlockSamples;
+        const __m512 absValues = _mm512_abs_ps(_mm512_loadu_ps(pBlock));
+        sums = _mm512_add_ps(sums, absValues);
+        clipped = _mm512_kor(clipped, _mm512_cmp_ps_mask(absValues, peak, _CMP_GT_OQ));
+    }
+    // Pairwise reduction: 16 -> 8 -> 4 -> 2 lanes
+    const __m256 sums8 = _mm256_add_ps(_mm512_castps512_ps256(sums),
+            _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(sums), 1)));
+    const __m128 sums4 = _mm_add_ps(_mm256_castps256_ps128(sums8), _mm256_extractf128_ps(sums8, 1));
+    const __m128 sumsLR = _mm_add_ps(sums4, _mm_movehl_ps(sums4, sums4));
+    CSAMPLE sumAbsL = _mm_cvtss_f32(sumsLR);
+    CSAMPLE sumAbsR = _mm_cvtss_f32(_mm_shuffle_ps(sumsLR, sumsLR, _MM_SHUFFLE(1, 1, 1, 1)));
+    bool clippedL = (clipped & 0x5555) != 0;
+    bool clippedR = (clipped & 0xaaaa) != 0;
+    for (SINT i = numBlocks * SampleUtilKernels::kSumAbsBlockFrames; i < numFrames; ++i) {
+        const CSAMPLE absL = absSample(pBuffer[i * 2]);
+        const CSAMPLE absR = absSample(pBuffer[i * 2 + 1]);
+        sumAbsL += absL;
+        sumAbsR += absR;
+        clippedL |= absL > CSAMPLE_PEAK;
+        clippedR |= absR > CSAMPLE_PEAK;
+    }
+    *pSumAbsL = sumAbsL;
+    *pSumAbsR = sumAbsR;
+    *pClippedL = clippedL;
+    *pClippedR = clippedR;
+}
+
+void interleaveBuffer(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc1,
+        const CSAMPLE* M_RESTRICT pSrc2,
+        SINT numFrames) {
+    // Indices 0-15 select from the first and 16-31 from the second source
+    const __m512i indices0 = _mm512_setr_epi32(
+            0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    const __m512i indices1 = _mm512_setr_epi32(
+            8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    SINT i = 0;
+    for (; i + 16 <= numFrames; i += 16) {
+        const __m512 src1 = _mm512_loadu_ps(pSrc1 + i);
+        const __m512 src2 = _mm512_loadu_ps(pSrc2 + i);
+        _mm512_storeu_ps(pDest + i * 2, _mm512_permutex2var_ps(src1, indices0, src2));
+        _mm512_storeu_ps(pDest + i * 2 + 16, _mm512_permutex2var_ps(src1, indices1, src2));
+    }
+    for (; i < numFrames; ++i) {
+        pDest[2 * i] = pSrc1[i];
+        pDest[2 * i + 1] = pSrc2[i];
+    }
+}
+
+void deinterleaveBuffer(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE* M_RESTRICT pDest2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames) {
+    const __m512i evenIndices = _mm512_setr_epi32(
+            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i oddIndices = _mm512_setr_epi32(
+            1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    SINT i = 0;
+    for (; i + 16 <= numFrames; i += 16) {
+        const __m512 src0 = _mm512_loadu_ps(pSrc + i * 2);
+        const __m512 src1 = _mm512_loadu_ps(pSrc + i * 2 + 16);
+        _mm512_storeu_ps(pDest1 + i, _mm512_permutex2var_ps(src0, evenIndices, src1));
+        _mm512_storeu_ps(pDest2 + i, _mm512_permutex2var_ps(src0, oddIndices, src1));
+    }
+    for (; i < numFrames; ++i) {
+        pDest1[i] = pSrc[i * 2];
+        pDest2[i] = pSrc[i * 2 + 1];
+    }
+}
+
+void convertS16ToFloat32(CSAMPLE* M_RESTRICT pDest,
+        const SAMPLE* M_RESTRICT pSrc,
+        SINT numSamples) {
+    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
+    // Multiplying with the reciprocal of a power of 2 is exact
+    const __m512 scale = _mm512_set1_ps(1.0f / kConversionFactor);
+    SINT i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        const __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+        _mm512_storeu_ps(pDest + i,
+                _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(src)), scale));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] = CSAMPLE(pSrc[i]) / kConversionFactor;
+    }
+}
+
+} // anonymous namespace
+
+const SampleUtilKernels kSampleUtilKernelsAvx512 = {
+        applyGain,
+        copyWithRampingGain,
+        addWithRampingGain,
+        sumAbsPerChannel,
+        interleaveBuffer,
+        deinterleaveBuffer,
+        convertS16ToFloat32,
+};
+
+#endif // MIXXX_SAMPLE_KERNELS_X86
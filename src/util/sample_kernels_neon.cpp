@@ -0,0 +1,191 @@
+#include "util/sample_kernels.h"
+
+#if defined(MIXXX_SAMPLE_KERNELS_NEON)
+
+#include <arm_neon.h>
+
+// NEON is part of the baseline of all ARM builds that define
+// MIXXX_SAMPLE_KERNELS_NEON, so unlike the x86 kernels this file
+// does not need any additional instruction set flags.
+
+namespace {
+
+inline CSAMPLE absSample(CSAMPLE value) {
+    return value < CSAMPLE_ZERO ? -value : value;
+}
+
+void applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain, SINT numSamples) {
+    SINT i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        vst1q_f32(pBuffer + i, vmulq_n_f32(vld1q_f32(pBuffer + i), gain));
+    }
+    for (; i < numSamples; ++i) {
+        pBuffer[i] *= gain;
+    }
+}
+
+void copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const float32x4_t startGainVec = vdupq_n_f32(startGain);
+    // The frame indices are exact up to 2^24 frames
+    const float kInitialFrameIndex[4] = {0.0f, 0.0f, 1.0f, 1.0f};
+    float32x4_t frameIndex = vld1q_f32(kInitialFrameIndex);
+    const float32x4_t frameIndexStep = vdupq_n_f32(2.0f);
+    SINT i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        // No multiply-accumulate, which would round differently on ARMv8
+        const float32x4_t gain = vaddq_f32(startGainVec, vmulq_n_f32(frameIndex, gainDelta));
+        vst1q_f32(pDest + i * 2, vmulq_f32(vld1q_f32(pSrc + i * 2), gain));
+        frameIndex = vaddq_f32(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const float32x4_t startGainVec = vdupq_n_f32(startGain);
+    const float kInitialFrameIndex[4] = {0.0f, 0.0f, 1.0f, 1.0f};
+    float32x4_t frameIndex = vld1q_f32(kInitialFrameIndex);
+    const float32x4_t frameIndexStep = vdupq_n_f32(2.0f);
+    SINT i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        const float32x4_t gain = vaddq_f32(startGainVec, vmulq_n_f32(frameIndex, gainDelta));
+        vst1q_f32(pDest + i * 2,
+                vaddq_f32(vld1q_f32(pDest + i * 2),
+                        vmulq_f32(vld1q_f32(pSrc + i * 2), gain)));
+        frameIndex = vaddq_f32(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] += pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void sumAbsPerChannel(CSAMPLE* pSumAbsL,
+        CSAMPLE* pSumAbsR,
+        bool* pClippedL,
+        bool* pClippedR,
+        const CSAMPLE* pBuffer,
+        SINT numFrames) {
+    const float32x4_t peak = vdupq_n_f32(CSAMPLE_PEAK);
+    // The partial sums of the samples 0-3, 4-7, 8-11, 12-15 of each block
+    float32x4_t sums0 = vdupq_n_f32(0.0f);
+    float32x4_t sums1 = vdupq_n_f32(0.0f);
+    float32x4_t sums2 = vdupq_n_f32(0.0f);
+    float32x4_t sums3 = vdupq_n_f32(0.0f);
+    // Even lanes are left, odd lanes are right
+    uint32x4_t clipped = vdupq_n_u32(0);
+    const SINT numBlocks = numFrames / SampleUtilKernels::kSumAbsBlockFrames;
+    for (SINT b = 0; b < numBlocks; ++b) {
+        const CSAMPLE* pBlock = pBuffer + b * SampleUtilKernels::kSumAbsBlockSamples;
+        const float32x4_t abs0 = vabsq_f32(vld1q_f32(pBlock));
+        const float32x4_t abs1 = vabsq_f32(vld1q_f32(pBlock + 4));
+        const float32x4_t abs2 = vabsq_f32(vld1q_f32(pBlock + 8));
+        const float32x4_t abs3 = vabsq_f32(vld1q_f32(pBlock + 12));
+        sums0 = vaddq_f32(sums0, abs0);
+        sums1 = vaddq_f32(sums1, abs1);
+        sums2 = vaddq_f32(sums2, abs2);
+        sums3 = vaddq_f32(sums3, abs3);
+        clipped = vorrq_u32(clipped,
+                vorrq_u32(vorrq_u32(vcgtq_f32(abs0, peak), vcgtq_f32(abs1, peak)),
+                        vorrq_u32(vcgtq_f32(abs2, peak), vcgtq_f32(abs3, peak))));
+    }
+    // Pairwise reduction: 16 -> 8 -> 4 -> 2 lanes
+    const float32x4_t sums = vaddq_f32(vaddq_f32(sums0, sums2), vaddq_f32(sums1, sums3));
+    const float32x2_t sumsLR = vadd_f32(vget_low_f32(sums), vget_high_f32(sums));
+    CSAMPLE sumAbsL = vget_lane_f32(sumsLR, 0);
+    CSAMPLE sumAbsR = vget_lane_f32(sumsLR, 1);
+    const uint32x2_t clippedLR = vorr_u32(vget_low_u32(clipped), vget_high_u32(clipped));
+    bool clippedL = vget_lane_u32(clippedLR, 0) != 0;
+    bool clippedR = vget_lane_u32(clippedLR, 1) != 0;
+    for (SINT i = numBlocks * SampleUtilKernels::kSumAbsBlockFrames; i < numFrames; ++i) {
+        const CSAMPLE absL = absSample(pBuffer[i * 2]);
+        const CSAMPLE absR = absSample(pBuffer[i * 2 + 1]);
+        sumAbsL += absL;
+        sumAbsR += absR;
+        clippedL |= absL > CSAMPLE_PEAK;
+        clippedR |= absR > CSAMPLE_PEAK;
+    }
+    *pSumAbsL = sumAbsL;
+    *pSumAbsR = sumAbsR;
+    *pClippedL = clippedL;
+    *pClippedR = clippedR;
+}
+
+void interleaveBuffer(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc1,
+        const CSAMPLE* M_RESTRICT pSrc2,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        float32x4x2_t frames;
+        frames.val[0] = vld1q_f32(pSrc1 + i);
+        frames.val[1] = vld1q_f32(pSrc2 + i);
+        vst2q_f32(pDest + i * 2, frames);
+    }
+    for (; i < numFrames; ++i) {
+        pDest[2 * i] = pSrc1[i];
+        pDest[2 * i + 1] = pSrc2[i];
+    }
+}
+
+void deinterleaveBuffer(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE* M_RESTRICT pDest2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const float32x4x2_t frames = vld2q_f32(pSrc + i * 2);
+        vst1q_f32(pDest1 + i, frames.val[0]);
+        vst1q_f32(pDest2 + i, frames.val[1]);
+    }
+    for (; i < numFrames; ++i) {
+        pDest1[i] = pSrc[i * 2];
+        pDest2[i] = pSrc[i * 2 + 1];
+    }
+}
+
+void convertS16ToFloat32(CSAMPLE* M_RESTRICT pDest,
+        const SAMPLE* M_RESTRICT pSrc,
+        SINT numSamples) {
+    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
+    // Multiplying with the reciprocal of a power of 2 is exact. 32-bit
+    // ARM does not support vectorized divisions.
+    const float scale = 1.0f / kConversionFactor;
+    SINT i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const int16x8_t src = vld1q_s16(pSrc + i);
+        vst1q_f32(pDest + i,
+                vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(src))), scale));
+        vst1q_f32(pDest + i + 4,
+                vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(src))), scale));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] = CSAMPLE(pSrc[i]) / kConversionFactor;
+    }
+}
+
+} // anonymous namespace
+
+const SampleUtilKernels kSampleUtilKernelsNeon = {
+        applyGain,
+        copyWithRampingGain,
+        addWithRampingGain,
+        sumAbsPerChannel,
+        interleaveBuffer,
+        deinterleaveBuffer,
+        convertS16ToFloat32,
+};
+
+#endif // MIXXX_SAMPLE_KERNELS_NEON
@@ -0,0 +1,193 @@
+#include "util/sample_kernels.h"
+
+#if defined(MIXXX_SAMPLE_KERNELS_X86)
+
+#include <smmintrin.h>
+
+// This file is compiled with SSE4.1 enabled. The kernels must only be
+// called if the CPU supports SSE4.1, see mixxx::CpuFeatures. Inline functions
+// with external linkage from other headers must not be called here, because
+// the linker might pick the SSE4.1 version for the callers in other files.
+
+namespace {
+
+inline CSAMPLE absSample(CSAMPLE value) {
+    return value < CSAMPLE_ZERO ? -value : value;
+}
+
+void applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain, SINT numSamples) {
+    const __m128 gainVec = _mm_set1_ps(gain);
+    SINT i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        _mm_storeu_ps(pBuffer + i, _mm_mul_ps(_mm_loadu_ps(pBuffer + i), gainVec));
+    }
+    for (; i < numSamples; ++i) {
+        pBuffer[i] *= gain;
+    }
+}
+
+void copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const __m128 startGainVec = _mm_set1_ps(startGain);
+    const __m128 gainDeltaVec = _mm_set1_ps(gainDelta);
+    // The frame indices are exact up to 2^24 frames
+    __m128 frameIndex = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+    const __m128 frameIndexStep = _mm_set1_ps(2.0f);
+    SINT i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        const __m128 gain = _mm_add_ps(startGainVec, _mm_mul_ps(gainDeltaVec, frameIndex));
+        _mm_storeu_ps(pDest + i * 2, _mm_mul_ps(_mm_loadu_ps(pSrc + i * 2), gain));
+        frameIndex = _mm_add_ps(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const __m128 startGainVec = _mm_set1_ps(startGain);
+    const __m128 gainDeltaVec = _mm_set1_ps(gainDelta);
+    __m128 frameIndex = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+    const __m128 frameIndexStep = _mm_set1_ps(2.0f);
+    SINT i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        const __m128 gain = _mm_add_ps(startGainVec, _mm_mul_ps(gainDeltaVec, frameIndex));
+        _mm_storeu_ps(pDest + i * 2,
+                _mm_add_ps(_mm_loadu_ps(pDest + i * 2),
+                        _mm_mul_ps(_mm_loadu_ps(pSrc + i * 2), gain)));
+        frameIndex = _mm_add_ps(frameIndex, frameIndexStep);
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] += pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+    }
+}
+
+void sumAbsPerChannel(CSAMPLE* pSumAbsL,
+        CSAMPLE* pSumAbsR,
+        bool* pClippedL,
+        bool* pClippedR,
+        const CSAMPLE* pBuffer,
+        SINT numFrames) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 peak = _mm_set1_ps(CSAMPLE_PEAK);
+    // The partial sums of the samples 0-3, 4-7, 8-11, 12-15 of each block
+    __m128 sums0 = _mm_setzero_ps();
+    __m128 sums1 = _mm_setzero_ps();
+    __m128 sums2 = _mm_setzero_ps();
+    __m128 sums3 = _mm_setzero_ps();
+    // Even lanes are left, odd lanes are right
+    __m128 clipped = _mm_setzero_ps();
+    const SINT numBlocks = numFrames / SampleUtilKernels::kSumAbsBlockFrames;
+    for (SINT b = 0; b < numBlocks; ++b) {
+        const CSAMPLE* pBlock = pBuffer + b * SampleUtilKernels::kSumAbsBlockSamples;
+        const __m128 abs0 = _mm_and_ps(_mm_loadu_ps(pBlock), absMask);
+        const __m128 abs1 = _mm_and_ps(_mm_loadu_ps(pBlock + 4), absMask);
+        const __m128 abs2 = _mm_and_ps(_mm_loadu_ps(pBlock + 8), absMask);
+        const __m128 abs3 = _mm_and_ps(_mm_loadu_ps(pBlock + 12), absMask);
+        sums0 = _mm_add_ps(sums0, abs0);
+        sums1 = _mm_add_ps(sums1, abs1);
+        sums2 = _mm_add_ps(sums2, abs2);
+        sums3 = _mm_add_ps(sums3, abs3);
+        clipped = _mm_or_ps(clipped,
+                _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(abs0, peak), _mm_cmpgt_ps(abs1, peak)),
+                        _mm_or_ps(_mm_cmpgt_ps(abs2, peak), _mm_cmpgt_ps(abs3, peak))));
+    }
+    // Pairwise reduction: 16 -> 8 -> 4 -> 2 lanes
+    const __m128 sums = _mm_add_ps(_mm_add_ps(sums0, sums2), _mm_add_ps(sums1, sums3));
+    const __m128 sumsLR = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+    CSAMPLE sumAbsL = _mm_cvtss_f32(sumsLR);
+    CSAMPLE sumAbsR = _mm_cvtss_f32(_mm_shuffle_ps(sumsLR, sumsLR, _MM_SHUFFLE(1, 1, 1, 1)));
+    const int clippedMask = _mm_movemask_ps(clipped);
+    bool clippedL = (clippedMask & 0x5) != 0;
+    bool clippedR = (clippedMask & 0xa) != 0;
+    for (SINT i = numBlocks * SampleUtilKernels::kSumAbsBlockFrames; i < numFrames; ++i) {
+        const CSAMPLE absL = absSample(pBuffer[i * 2]);
+        const CSAMPLE absR = absSample(pBuffer[i * 2 + 1]);
+        sumAbsL += absL;
+        sumAbsR += absR;
+        clippedL |= absL > CSAMPLE_PEAK;
+        clippedR |= absR > CSAMPLE_PEAK;
+    }
+    *pSumAbsL = sumAbsL;
+    *pSumAbsR = sumAbsR;
+    *pClippedL = clippedL;
+    *pClippedR = clippedR;
+}
+
+void interleaveBuffer(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc1,
+        const CSAMPLE* M_RESTRICT pSrc2,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m128 src1 = _mm_loadu_ps(pSrc1 + i);
+        const __m128 src2 = _mm_loadu_ps(pSrc2 + i);
+        _mm_storeu_ps(pDest + i * 2, _mm_unpacklo_ps(src1, src2));
+        _mm_storeu_ps(pDest + i * 2 + 4, _mm_unpackhi_ps(src1, src2));
+    }
+    for (; i < numFrames; ++i) {
+        pDest[2 * i] = pSrc1[i];
+        pDest[2 * i + 1] = pSrc2[i];
+    }
+}
+
+void deinterleaveBuffer(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE* M_RESTRICT pDest2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m128 src0 = _mm_loadu_ps(pSrc + i * 2);
+        const __m128 src1 = _mm_loadu_ps(pSrc + i * 2 + 4);
+        _mm_storeu_ps(pDest1 + i, _mm_shuffle_ps(src0, src1, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(pDest2 + i, _mm_shuffle_ps(src0, src1, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    for (; i < numFrames; ++i) {
+        pDest1[i] = pSrc[i * 2];
+        pDest2[i] = pSrc[i * 2 + 1];
+    }
+}
+
+void convertS16ToFloat32(CSAMPLE* M_RESTRICT pDest,
+        const SAMPLE* M_RESTRICT pSrc,
+        SINT numSamples) {
+    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
+    // Multiplying with the reciprocal of a power of 2 is exact
+    const __m128 scale = _mm_set1_ps(1.0f / kConversionFactor);
+    SINT i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+        const __m128i lo = _mm_cvtepi16_epi32(src);
+        const __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(src, 8));
+        _mm_storeu_ps(pDest + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(pDest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] = CSAMPLE(pSrc[i]) / kConversionFactor;
+    }
+}
+
+} // anonymous namespace
+
+const SampleUtilKernels kSampleUtilKernelsSse41 = {
+        applyGain,
+        copyWithRampingGain,
+        addWithRampingGain,
+        sumAbsPerChannel,
+        interleaveBuffer,
+        deinterleaveBuffer,
+        convertS16ToFloat32,
+};
+
+#endif // MIXXX_SAMPLE_KERNELS_X86
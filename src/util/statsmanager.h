@@ -15,7 +15,6 @@
 
 #include "util/singleton.h"
 #include "util/stat.h"
-#include "util/event.h"
 
 class StatsManager;
 
@@ -77,14 +76,12 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     void processIncomingStatReports();
     StatsPipe* getStatsPipeForThread();
     void onStatsPipeDestroyed(StatsPipe* pPipe);
-    void writeTimeline(const QString& filename);
 
     QAtomicInt m_emitAllStats;
     QAtomicInt m_quit;
     QMap<QString, Stat> m_stats;
     QMap<QString, Stat> m_baseStats;
     QMap<QString, Stat> m_experimentStats;
-    QList<Event> m_events;
 
     QWaitCondition m_statsPipeCondition;
     QMutex m_statsPipeLock;
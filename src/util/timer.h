@@ -8,6 +8,7 @@
 #include "util/parented_ptr.h"
 #include "util/performancetimer.h"
 #include "util/stat.h"
+#include "util/tracing.h"
 
 const Stat::ComputeFlags kDefaultComputeFlags = Stat::COUNT | Stat::SUM | Stat::AVERAGE |
         Stat::MAX | Stat::MIN | Stat::SAMPLE_VARIANCE;
@@ -55,7 +56,8 @@ class ScopedTimer {
     ScopedTimer(const char* key, int i,
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
-              m_cancel(false) {
+              m_cancel(false),
+              m_scopedTrace(key) {
         if (CmdlineArgs::Instance().getDeveloper()) {
             initialize(QString(key), QString::number(i), compute);
         }
@@ -64,7 +66,8 @@ class ScopedTimer {
     ScopedTimer(const char* key, const char *arg = NULL,
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
-              m_cancel(false) {
+              m_cancel(false),
+              m_scopedTrace(key) {
         if (CmdlineArgs::Instance().getDeveloper()) {
             initialize(QString(key), arg ? QString(arg) : QString(), compute);
         }
@@ -73,7 +76,8 @@ class ScopedTimer {
     ScopedTimer(const char* key, const QString& arg,
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
-              m_cancel(false) {
+              m_cancel(false),
+              m_scopedTrace(key) {
         if (CmdlineArgs::Instance().getDeveloper()) {
             initialize(QString(key), arg, compute);
         }
@@ -107,6 +111,7 @@ class ScopedTimer {
     Timer* m_pTimer;
     char m_timerMem[sizeof(Timer)];
     bool m_cancel;
+    const mixxx::ScopedTrace m_scopedTrace;
 };
 
 // A timer that provides a similar API to QTimer but uses render events from the
@@ -5,16 +5,17 @@
 
 #include "util/cmdlineargs.h"
 #include "util/duration.h"
-#include "util/event.h"
 #include "util/performancetimer.h"
 #include "util/stat.h"
+#include "util/tracing.h"
 
 class Trace {
   public:
     Trace(const char* tag, const char* arg=NULL,
           bool writeToStdout=false, bool time=true)
             : m_writeToStdout(writeToStdout),
-              m_time(time) {
+              m_time(time),
+              m_scopedTrace(tag) {
         if (writeToStdout || CmdlineArgs::Instance().getDeveloper()) {
             initialize(tag, arg);
         }
@@ -23,7 +24,8 @@ class Trace {
     Trace(const char* tag, int arg,
           bool writeToStdout=false, bool time=true)
             : m_writeToStdout(writeToStdout),
-              m_time(time) {
+              m_time(time),
+              m_scopedTrace(tag) {
         if (writeToStdout || CmdlineArgs::Instance().getDeveloper()) {
             initialize(tag, QString::number(arg));
         }
@@ -32,7 +34,8 @@ class Trace {
     Trace(const char* tag, const QString& arg,
           bool writeToStdout=false, bool time=true)
             : m_writeToStdout(writeToStdout),
-              m_time(time) {
+              m_time(time),
+              m_scopedTrace(tag) {
         if (writeToStdout || CmdlineArgs::Instance().getDeveloper()) {
             initialize(tag, arg);
         }
@@ -44,8 +47,6 @@ class Trace {
             return;
         }
 
-        Event::end(m_tag);
-
         if (m_time) {
             mixxx::Duration elapsed = m_timer.elapsed();
             if (m_writeToStdout) {
@@ -76,7 +77,6 @@ class Trace {
             m_tag = key.arg(arg);
         }
 
-        Event::start(m_tag);
         if (m_time) {
             m_timer.start();
         }
@@ -88,6 +88,9 @@ class Trace {
     QString m_tag;
     const bool m_writeToStdout, m_time;
     PerformanceTimer m_timer;
+    // Recorded independent of the developer mode with the
+    // unformatted tag
+    const mixxx::ScopedTrace m_scopedTrace;
 
 };
 
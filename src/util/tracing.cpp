@@ -0,0 +1,263 @@
+#include "util/tracing.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("Tracing");
+
+// 24 bytes per record, i.e. 384 KiB per thread
+constexpr std::uint64_t kRecordsPerThread = 1 << 14;
+
+// 24 MiB for all threads, allocated when enabling tracing
+constexpr int kMaxThreads = 64;
+
+constexpr qint64 kInstant = -1;
+
+struct TraceRecord {
+    const char* name;
+    qint64 startNanos;
+    // kInstant for instant events
+    qint64 durationNanos;
+};
+
+/// Single producer ring buffer that is only written by its thread
+class ThreadTraceBuffer final {
+  public:
+    explicit ThreadTraceBuffer(int threadId)
+            : m_threadId(threadId),
+              m_threadName(nullptr),
+              m_records(std::make_unique<TraceRecord[]>(kRecordsPerThread)),
+              m_writeCount(0) {
+    }
+
+    int threadId() const {
+        return m_threadId;
+    }
+
+    /// Published by the registration of the buffer
+    const char* threadName() const {
+        return m_threadName;
+    }
+
+    void setThreadName(const char* threadName) {
+        m_threadName = threadName;
+    }
+
+    void write(const char* name, qint64 startNanos, qint64 durationNanos) {
+        const auto writeCount = m_writeCount.load(std::memory_order_relaxed);
+        m_records[writeCount % kRecordsPerThread] =
+                TraceRecord{name, startNanos, durationNanos};
+        m_writeCount.store(writeCount + 1, std::memory_order_release);
+    }
+
+    std::vector<TraceRecord> read() const {
+        const auto writeCount = m_writeCount.load(std::memory_order_acquire);
+        auto readCount = writeCount > kRecordsPerThread
+                ? writeCount - kRecordsPerThread
+                : 0;
+        std::vector<TraceRecord> records;
+        records.reserve(writeCount - readCount);
+        for (auto i = readCount; i < writeCount; ++i) {
+            records.push_back(m_records[i % kRecordsPerThread]);
+        }
+        // Discard all records that might have been overwritten
+        // by the thread while reading
+        const auto overwrittenCount =
+                m_writeCount.load(std::memory_order_acquire) - writeCount;
+        records.erase(records.begin(),
+                records.begin() +
+                        std::min<std::uint64_t>(overwrittenCount, records.size()));
+        return records;
+    }
+
+  private:
+    const int m_threadId;
+    const char* m_threadName;
+    const std::unique_ptr<TraceRecord[]> m_records;
+    std::atomic<std::uint64_t> m_writeCount;
+};
+
+/// The buffers are allocated once and kept after their threads have
+/// finished. The first registeredCount buffers have been assigned to
+/// threads.
+struct TraceBufferRegistry {
+    QMutex mutex;
+    std::vector<std::unique_ptr<ThreadTraceBuffer>> buffers;
+    std::atomic<int> registeredCount{0};
+};
+
+TraceBufferRegistry& traceBufferRegistry() {
+    // Intentionally leaked, threads might still record while
+    // static objects are destroyed
+    static auto* pRegistry = new TraceBufferRegistry;
+    return *pRegistry;
+}
+
+thread_local ThreadTraceBuffer* t_pTraceBuffer = nullptr;
+thread_local bool t_registered = false;
+
+double toMicros(qint64 nanos) {
+    return static_cast<double>(nanos) / 1000.0;
+}
+
+} // anonymous namespace
+
+// static
+std::atomic<bool> Tracing::s_enabled(false);
+
+// static
+void Tracing::enable() {
+    kLogger.info() << "Enabling tracing";
+    auto& registry = traceBufferRegistry();
+    {
+        const auto locker = lockMutex(&registry.mutex);
+        if (registry.buffers.empty()) {
+            registry.buffers.reserve(kMaxThreads);
+            for (int i = 0; i < kMaxThreads; ++i) {
+                registry.buffers.push_back(std::make_unique<ThreadTraceBuffer>(i + 1));
+            }
+        }
+    }
+    s_enabled.store(true);
+}
+
+// static
+void Tracing::registerCurrentThread(const char* threadName) {
+    if (!isEnabled() || t_registered) {
+        return;
+    }
+    t_registered = true;
+    auto& registry = traceBufferRegistry();
+    // The buffers have been allocated before enabling tracing
+    const int index = registry.registeredCount.fetch_add(1, std::memory_order_acq_rel);
+    if (index >= kMaxThreads) {
+        // Dropped, nobody to tell on a realtime thread
+        return;
+    }
+    ThreadTraceBuffer* pBuffer = registry.buffers[index].get();
+    pBuffer->setThreadName(threadName);
+    t_pTraceBuffer = pBuffer;
+}
+
+// static
+void Tracing::disable() {
+    s_enabled.store(false);
+}
+
+// static
+qint64 Tracing::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+// static
+void Tracing::recordSpan(const char* name, qint64 startNanos) {
+    record(name, startNanos, now() - startNanos);
+}
+
+// static
+void Tracing::recordInstant(const char* name) {
+    if (!isEnabled()) {
+        return;
+    }
+    record(name, now(), kInstant);
+}
+
+// static
+void Tracing::record(const char* name, qint64 startNanos, qint64 durationNanos) {
+    if (!t_pTraceBuffer) {
+        // Unregistered threads are not traced
+        return;
+    }
+    t_pTraceBuffer->write(name, startNanos, durationNanos);
+}
+
+// static
+bool Tracing::writeChromeTrace(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        kLogger.warning()
+                << "Could not open trace file for writing:"
+                << file.fileName();
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    auto& registry = traceBufferRegistry();
+    const auto locker = lockMutex(&registry.mutex);
+    const std::size_t numRegistered = std::min<std::size_t>(
+            registry.registeredCount.load(std::memory_order_acquire),
+            registry.buffers.size());
+    std::vector<std::vector<TraceRecord>> threadRecords;
+    threadRecords.reserve(numRegistered);
+    qint64 firstStartNanos = std::numeric_limits<qint64>::max();
+    for (std::size_t i = 0; i < numRegistered; ++i) {
+        threadRecords.push_back(registry.buffers[i]->read());
+        for (const auto& record : threadRecords.back()) {
+            firstStartNanos = std::min(firstStartNanos, record.startNanos);
+        }
+    }
+    for (std::size_t i = 0; i < numRegistered; ++i) {
+        const auto& pBuffer = registry.buffers[i];
+        // The name is published by the first record of the thread
+        if (threadRecords[i].empty() || !pBuffer->threadName()) {
+            continue;
+        }
+        traceEvents.append(QJsonObject{
+                {QStringLiteral("name"), QStringLiteral("thread_name")},
+                {QStringLiteral("ph"), QStringLiteral("M")},
+                {QStringLiteral("pid"), pid},
+                {QStringLiteral("tid"), pBuffer->threadId()},
+                {QStringLiteral("args"),
+                        QJsonObject{{QStringLiteral("name"),
+                                QString::fromUtf8(pBuffer->threadName())}}},
+        });
+        for (const auto& record : threadRecords[i]) {
+            QJsonObject traceEvent{
+                    {QStringLiteral("name"), QString::fromUtf8(record.name)},
+                    {QStringLiteral("pid"), pid},
+                    {QStringLiteral("tid"), pBuffer->threadId()},
+                    {QStringLiteral("ts"), toMicros(record.startNanos - firstStartNanos)},
+            };
+            if (record.durationNanos == kInstant) {
+                traceEvent.insert(QStringLiteral("ph"), QStringLiteral("i"));
+                traceEvent.insert(QStringLiteral("s"), QStringLiteral("t"));
+            } else {
+                traceEvent.insert(QStringLiteral("ph"), QStringLiteral("X"));
+                traceEvent.insert(QStringLiteral("dur"), toMicros(record.durationNanos));
+            }
+            traceEvents.append(traceEvent);
+        }
+    }
+
+    const QJsonObject trace{
+            {QStringLiteral("traceEvents"), traceEvents},
+            {QStringLiteral("displayTimeUnit"), QStringLiteral("ns")},
+    };
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    kLogger.info()
+            << "Wrote" << traceEvents.size()
+            << "trace events to" << file.fileName();
+    return true;
+}
+
+} // namespace mixxx
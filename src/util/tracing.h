@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+namespace mixxx {
+
+/// Tracing records spans of time that are spent in named sections of code,
+/// e.g. the engine callback, the CachingReaderWorker, the analyzers or
+/// rendering the GUI. The records of all threads can be exported as a
+/// Chrome Trace Event JSON file, which can be viewed with chrome://tracing
+/// or https://ui.perfetto.dev.
+///
+/// Tracing is disabled by default. If disabled, recording costs a single
+/// relaxed atomic load. If enabled, each record is written to a ring
+/// buffer that is owned by the recording thread, i.e. recording neither
+/// locks nor allocates and is safe on the audio callback. If a ring
+/// buffer is full the oldest records of this thread are overwritten.
+///
+/// Only threads that have called registerCurrentThread() are traced, the
+/// records of all other threads are dropped. The buffers are allocated
+/// up front by enable(), so registering a thread is safe on the audio
+/// callback, too.
+///
+/// Names are interned by their address and not copied. They must have
+/// static storage duration, i.e. only string literals should be used.
+class Tracing final {
+  public:
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Allocates the buffers for all threads. Threads must register
+    /// after tracing has been enabled.
+    static void enable();
+    static void disable();
+
+    /// Assigns a buffer to the calling thread, which is named threadName
+    /// in the trace. Does nothing if tracing is disabled, if the thread
+    /// has already been registered or if all buffers are in use. Neither
+    /// locks nor allocates.
+    static void registerCurrentThread(const char* threadName);
+
+    /// Returns the current timestamp for recording spans
+    static qint64 now();
+
+    /// Records a span from startNanos until now
+    static void recordSpan(const char* name, qint64 startNanos);
+
+    /// Records a single point in time
+    static void recordInstant(const char* name);
+
+    /// Writes the records of all threads in Chrome Trace Event format.
+    /// Should be called after all traced threads have finished. Records
+    /// that are written concurrently are discarded.
+    static bool writeChromeTrace(const QString& filePath);
+
+  private:
+    static void record(const char* name, qint64 startNanos, qint64 durationNanos);
+
+    static std::atomic<bool> s_enabled;
+};
+
+/// Records the lifetime of this object as a span
+class ScopedTrace final {
+  public:
+    explicit ScopedTrace(const char* name)
+            : m_name(Tracing::isEnabled() ? name : nullptr),
+              m_startNanos(m_name ? Tracing::now() : 0) {
+    }
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+    ~ScopedTrace() {
+        if (m_name) {
+            Tracing::recordSpan(m_name, m_startNanos);
+        }
+    }
+
+  private:
+    const char* const m_name;
+    const qint64 m_startNanos;
+};
+
+} // namespace mixxx
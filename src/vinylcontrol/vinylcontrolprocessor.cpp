@@ -3,7 +3,6 @@
 #include "control/controlpushbutton.h"
 #include "moc_vinylcontrolprocessor.cpp"
 #include "util/defs.h"
-#include "util/event.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
@@ -79,6 +78,7 @@ void VinylControlProcessor::requestReloadConfig() {
 void VinylControlProcessor::run() {
     unsigned static id = 0; //the id of this thread, for debugging purposes //XXX copypasta (should factor this out somehow), -kousu 2/2009
     QThread::currentThread()->setObjectName(QString("VinylControlProcessor %1").arg(++id));
+    mixxx::Tracing::registerCurrentThread("VinylControlProcessor");
 
     while (!m_bQuit) {
         if (m_bReloadConfig) {
@@ -0,0 +1,204 @@
+#include "waveform/compactwaveformformat.h"
+
+#include <QtDebug>
+#include <QtEndian>
+#include <cstring>
+
+#include "util/assert.h"
+#include "waveform/waveform.h"
+
+namespace mixxx {
+
+namespace {
+
+const char kMagic[] = {'M', 'X', 'W', 'F'};
+constexpr int kMagicSize = sizeof(kMagic);
+
+constexpr quint16 kFormatVersion = 1;
+
+// magic, version, level count, visual sample rate, audio visual ratio
+constexpr int kFixedHeaderSize = kMagicSize + 2 + 2 + 8 + 8;
+// data size, offset, length, checksum, reserved
+constexpr int kLevelEntrySize = 4 + 4 + 4 + 2 + 2;
+
+// The bands of WaveformData are stored as separate planes
+constexpr int kPlaneCount = 4;
+
+// The values of both channels are interleaved
+constexpr int kDeltaDistance = 2;
+
+constexpr int kCompressionLevel = -1;
+
+quint16 checksum(const char* data, int length) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return qChecksum(QByteArrayView(data, length));
+#else
+    return qChecksum(data, static_cast<uint>(length));
+#endif
+}
+
+unsigned char bandValue(const WaveformData& datum, int plane) {
+    switch (plane) {
+    case 0:
+        return datum.filtered.all;
+    case 1:
+        return datum.filtered.low;
+    case 2:
+        return datum.filtered.mid;
+    default:
+        return datum.filtered.high;
+    }
+}
+
+unsigned char& bandValue(WaveformData* pDatum, int plane) {
+    switch (plane) {
+    case 0:
+        return pDatum->filtered.all;
+    case 1:
+        return pDatum->filtered.low;
+    case 2:
+        return pDatum->filtered.mid;
+    default:
+        return pDatum->filtered.high;
+    }
+}
+
+void writeDouble(double value, char* pDest) {
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    qToLittleEndian<quint64>(bits, pDest);
+}
+
+double readDouble(const char* pSrc) {
+    const quint64 bits = qFromLittleEndian<quint64>(pSrc);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+QByteArray encodeLevel(const CompactWaveformFormat::LevelData& level) {
+    QByteArray planes(kPlaneCount * level.dataSize, Qt::Uninitialized);
+    char* pPlane = planes.data();
+    for (int plane = 0; plane < kPlaneCount; ++plane) {
+        for (int i = 0; i < level.dataSize; ++i) {
+            unsigned char value = bandValue(level.pData[i], plane);
+            if (i >= kDeltaDistance) {
+                value -= bandValue(level.pData[i - kDeltaDistance], plane);
+            }
+            pPlane[i] = static_cast<char>(value);
+        }
+        pPlane += level.dataSize;
+    }
+    return qCompress(planes, kCompressionLevel);
+}
+
+} // anonymous namespace
+
+// static
+bool CompactWaveformFormat::hasMagic(const QByteArray& data) {
+    return data.size() >= kMagicSize &&
+            std::memcmp(data.constData(), kMagic, kMagicSize) == 0;
+}
+
+// static
+bool CompactWaveformFormat::readHeader(const QByteArray& data, Header* pHeader) {
+    DEBUG_ASSERT(pHeader);
+    if (!hasMagic(data) || data.size() < kFixedHeaderSize) {
+        return false;
+    }
+    const char* pData = data.constData();
+    const quint16 version = qFromLittleEndian<quint16>(pData + kMagicSize);
+    if (version != kFormatVersion) {
+        qWarning() << "Unsupported waveform format version" << version;
+        return false;
+    }
+    const int levelCount = qFromLittleEndian<quint16>(pData + kMagicSize + 2);
+    const int headerSize = kFixedHeaderSize + levelCount * kLevelEntrySize;
+    if (levelCount == 0 || data.size() < headerSize) {
+        return false;
+    }
+    pHeader->visualSampleRate = readDouble(pData + kMagicSize + 4);
+    pHeader->audioVisualRatio = readDouble(pData + kMagicSize + 12);
+    pHeader->levels.resize(levelCount);
+    const char* pEntry = pData + kFixedHeaderSize;
+    for (auto& level : pHeader->levels) {
+        level.dataSize = qFromLittleEndian<qint32>(pEntry);
+        level.offset = qFromLittleEndian<qint32>(pEntry + 4);
+        level.length = qFromLittleEndian<qint32>(pEntry + 8);
+        level.checksum = qFromLittleEndian<quint16>(pEntry + 12);
+        if (level.dataSize < 0 ||
+                level.offset < headerSize ||
+                level.length < 0 ||
+                level.length > data.size() - level.offset) {
+            qWarning() << "Invalid level in waveform header";
+            return false;
+        }
+        pEntry += kLevelEntrySize;
+    }
+    pHeader->size = headerSize;
+    return true;
+}
+
+// static
+bool CompactWaveformFormat::readLevel(const QByteArray& data,
+        const Level& level,
+        WaveformData* pData) {
+    DEBUG_ASSERT(level.offset + level.length <= data.size());
+    const char* pCompressed = data.constData() + level.offset;
+    if (checksum(pCompressed, level.length) != level.checksum) {
+        qWarning() << "Corrupt level in waveform data";
+        return false;
+    }
+    const QByteArray planes = qUncompress(
+            reinterpret_cast<const uchar*>(pCompressed), level.length);
+    if (planes.size() != kPlaneCount * level.dataSize) {
+        qWarning() << "Failed to uncompress level of waveform data";
+        return false;
+    }
+    const char* pPlane = planes.constData();
+    for (int plane = 0; plane < kPlaneCount; ++plane) {
+        for (int i = 0; i < level.dataSize; ++i) {
+            unsigned char value = static_cast<unsigned char>(pPlane[i]);
+            if (i >= kDeltaDistance) {
+                value += bandValue(pData[i - kDeltaDistance], plane);
+            }
+            bandValue(&pData[i], plane) = value;
+        }
+        pPlane += level.dataSize;
+    }
+    return true;
+}
+
+// static
+QByteArray CompactWaveformFormat::write(double visualSampleRate,
+        double audioVisualRatio,
+        const std::vector<LevelData>& levels) {
+    const int headerSize = kFixedHeaderSize +
+            static_cast<int>(levels.size()) * kLevelEntrySize;
+    QByteArray result(headerSize, '\0');
+    std::memcpy(result.data(), kMagic, kMagicSize);
+    qToLittleEndian<quint16>(kFormatVersion, result.data() + kMagicSize);
+    qToLittleEndian<quint16>(static_cast<quint16>(levels.size()),
+            result.data() + kMagicSize + 2);
+    writeDouble(visualSampleRate, result.data() + kMagicSize + 4);
+    writeDouble(audioVisualRatio, result.data() + kMagicSize + 12);
+
+    int entryOffset = kFixedHeaderSize;
+    for (const auto& level : levels) {
+        const QByteArray compressed = encodeLevel(level);
+        const int offset = result.size();
+        result.append(compressed);
+        // The data pointer may have changed while appending
+        char* pEntry = result.data() + entryOffset;
+        qToLittleEndian<qint32>(level.dataSize, pEntry);
+        qToLittleEndian<qint32>(offset, pEntry + 4);
+        qToLittleEndian<qint32>(compressed.size(), pEntry + 8);
+        qToLittleEndian<quint16>(
+                checksum(compressed.constData(), compressed.size()),
+                pEntry + 12);
+        entryOffset += kLevelEntrySize;
+    }
+    return result;
+}
+
+} // namespace mixxx
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <vector>
+
+union WaveformData;
+
+namespace mixxx {
+
+/// CompactWaveformFormat is the versioned on-disk format of waveform
+/// analyses. It replaces the serialized protobuf message that has been
+/// compressed as a whole.
+///
+/// The file starts with a small header that contains a table of levels of
+/// detail (see Waveform::getLevelData()). Each level is compressed
+/// separately, i.e. a reader only needs to access the header and the levels
+/// that are actually needed, which allows to memory-map the file.
+///
+/// The bands of a level are stored as separate planes. Each value is stored
+/// as the difference to the previous value of the same channel before the
+/// planes are compressed with zlib, which exploits the correlation of
+/// subsequent values that deflate alone is not able to find.
+///
+/// All integers are stored in little endian byte order.
+class CompactWaveformFormat final {
+  public:
+    struct Level {
+        /// The number of WaveformData elements
+        int dataSize = 0;
+        /// The position of the compressed data within the file
+        int offset = 0;
+        int length = 0;
+        quint16 checksum = 0;
+    };
+
+    struct Header {
+        double visualSampleRate = 0.0;
+        double audioVisualRatio = 0.0;
+        std::vector<Level> levels;
+        /// The size of the header including the level table in bytes
+        int size = 0;
+    };
+
+    struct LevelData {
+        const WaveformData* pData;
+        int dataSize;
+    };
+
+    /// Checks if the data starts with the magic bytes of this format.
+    /// Data that has been written by qCompress() is never mistaken for
+    /// this format, because it starts with its uncompressed size in
+    /// big endian byte order.
+    static bool hasMagic(const QByteArray& data);
+
+    /// Only parses and validates the header without accessing
+    /// the data of the levels.
+    static bool readHeader(const QByteArray& data, Header* pHeader);
+
+    /// Decodes a single level into pData, which must provide room
+    /// for level.dataSize elements.
+    static bool readLevel(const QByteArray& data,
+            const Level& level,
+            WaveformData* pData);
+
+    static QByteArray write(double visualSampleRate,
+            double audioVisualRatio,
+            const std::vector<LevelData>& levels);
+};
+
+} // namespace mixxx
@@ -10,11 +10,27 @@
 #include "waveform/waveform.h"
 #include "waveform/waveformwidgetfactory.h"
 
+namespace {
+
+// x, y, s, t of a textured quad that fills the viewport, drawn
+// as a triangle strip
+// clang-format off
+constexpr GLfloat kUnitQuadVertices[] = {
+    -1.0f, -1.0f, 0.0f, 0.0f,
+     1.0f, -1.0f, 1.0f, 0.0f,
+    -1.0f,  1.0f, 0.0f, 1.0f,
+     1.0f,  1.0f, 1.0f, 1.0f,
+};
+// clang-format on
+constexpr GLsizei kUnitQuadVertexStride = 4 * sizeof(GLfloat);
+
+} // anonymous namespace
+
 GLSLWaveformRendererSignal::GLSLWaveformRendererSignal(WaveformWidgetRenderer* waveformWidgetRenderer,
         ColorType colorType,
         const QString& fragShader)
         : GLWaveformRenderer(waveformWidgetRenderer),
-          m_unitQuadListId(-1),
+          m_unitQuadBufferId(0),
           m_textureId(0),
           m_textureRenderedWaveformCompletion(0),
           m_bDumpPng(false),
@@ -28,6 +44,10 @@ GLSLWaveformRendererSignal::~GLSLWaveformRendererSignal() {
         glDeleteTextures(1,&m_textureId);
     }
 
+    if (m_unitQuadBufferId) {
+        glDeleteBuffers(1, &m_unitQuadBufferId);
+    }
+
     if (m_frameShaderProgram) {
         m_frameShaderProgram->removeAllShaders();
     }
@@ -120,6 +140,9 @@ bool GLSLWaveformRendererSignal::loadTexture() {
         int textureWidth = waveform->getTextureStride();
         int textureHeight = waveform->getTextureSize() / waveform->getTextureStride();
 
+        // The completion might change while uploading. The remaining data
+        // elements are uploaded by updateTexture() on the next draw.
+        m_textureRenderedWaveformCompletion = waveform->getCompletion();
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureHeight, 0,
                      GL_RGBA, GL_UNSIGNED_BYTE, data);
         int error = glGetError();
@@ -129,6 +152,7 @@ bool GLSLWaveformRendererSignal::loadTexture() {
     } else {
         glDeleteTextures(1, &m_textureId);
         m_textureId = 0;
+        m_textureRenderedWaveformCompletion = 0;
     }
 
     glDisable(GL_TEXTURE_2D);
@@ -136,39 +160,65 @@ bool GLSLWaveformRendererSignal::loadTexture() {
     return true;
 }
 
-void GLSLWaveformRendererSignal::createGeometry() {
-
-    if (m_unitQuadListId != -1) {
+void GLSLWaveformRendererSignal::updateTexture(
+        const Waveform& waveform, int currentCompletion) {
+    const WaveformData* data = waveform.data();
+    if (data == nullptr) {
         return;
     }
 
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(-1.0, 1.0, -1.0, 1.0, -10.0, 10.0);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-
-    m_unitQuadListId = glGenLists(1);
-    glNewList(m_unitQuadListId, GL_COMPILE);
-    {
-        glBegin(GL_QUADS);
-        {
-            glTexCoord2f(0.0,0.0);
-            glVertex3f(-1.0f,-1.0f,0.0f);
-
-            glTexCoord2f(1.0, 0.0);
-            glVertex3f(1.0f,-1.0f,0.0f);
+    // Only the rows of the texture that contain new data elements are
+    // uploaded instead of the whole texture. The partially filled last row
+    // of the previous upload is uploaded again.
+    const int textureWidth = waveform.getTextureStride();
+    const int firstRow = m_textureRenderedWaveformCompletion / textureWidth;
+    const int lastRow = waveform.getTextureRowCount(currentCompletion);
+    m_textureRenderedWaveformCompletion = currentCompletion;
+    if (firstRow >= lastRow) {
+        return;
+    }
 
-            glTexCoord2f(1.0,1.0);
-            glVertex3f(1.0f,1.0f, 0.0f);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, m_textureId);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, textureWidth, lastRow - firstRow,
+            GL_RGBA, GL_UNSIGNED_BYTE, data + firstRow * textureWidth);
+    int error = glGetError();
+    if (error) {
+        qDebug() << "GLSLWaveformRendererSignal::updateTexture - glTexSubImage2D error" << error;
+    }
+    glDisable(GL_TEXTURE_2D);
+}
 
-            glTexCoord2f(0.0,1.0);
-            glVertex3f(-1.0f,1.0f,0.0f);
-        }
-        glEnd();
+void GLSLWaveformRendererSignal::createGeometry() {
+    if (m_unitQuadBufferId) {
+        return;
     }
-    glEndList();
 
+    glGenBuffers(1, &m_unitQuadBufferId);
+    glBindBuffer(GL_ARRAY_BUFFER, m_unitQuadBufferId);
+    glBufferData(GL_ARRAY_BUFFER,
+            sizeof(kUnitQuadVertices),
+            kUnitQuadVertices,
+            GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GLSLWaveformRendererSignal::drawUnitQuad() {
+    glBindBuffer(GL_ARRAY_BUFFER, m_unitQuadBufferId);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, kUnitQuadVertexStride, nullptr);
+    glTexCoordPointer(2,
+            GL_FLOAT,
+            kUnitQuadVertexStride,
+            reinterpret_cast<const void*>(2 * sizeof(GLfloat)));
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    // Restore the state expected by QPainter
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void GLSLWaveformRendererSignal::createFrameBuffers() {
@@ -285,8 +335,11 @@ void GLSLWaveformRendererSignal::draw(QPainter* painter, QPaintEvent* /*event*/)
     // do not remove currenCompletion temp variable !
     const int currentCompletion = waveform->getCompletion();
     if (m_textureRenderedWaveformCompletion < currentCompletion) {
-        loadTexture();
-        m_textureRenderedWaveformCompletion = currentCompletion;
+        if (m_textureId == 0) {
+            loadTexture();
+        } else {
+            updateTexture(*waveform, currentCompletion);
+        }
     }
 
     // Per-band gain from the EQ knobs.
@@ -315,12 +368,13 @@ void GLSLWaveformRendererSignal::draw(QPainter* painter, QPaintEvent* /*event*/)
             glRotatef(90.0f, 0.0f, 0.0f, 1.0f);
             glScalef(-1.0f, 1.0f, 1.0f);
         }
-        glOrtho(firstVisualIndex, lastVisualIndex, -1.0, 1.0, -10.0, 10.0);
+        // The visible range is selected by the shader, so the quad
+        // always fills the frame buffer regardless of the zoom.
+        glOrtho(-1.0, 1.0, -1.0, 1.0, -10.0, 10.0);
 
         glMatrixMode(GL_MODELVIEW);
         glPushMatrix();
         glLoadIdentity();
-        glTranslatef(.0f,.0f,.0f);
 
         m_frameShaderProgram->bind();
 
@@ -363,7 +417,13 @@ void GLSLWaveformRendererSignal::draw(QPainter* painter, QPaintEvent* /*event*/)
                             static_cast<GLfloat>(m_rgbHighFilteredColor_b),
                             1.0));
         }
-        if (m_colorType == ColorType::RGB || m_colorType == ColorType::RGBFiltered) {
+        if (m_colorType == ColorType::Simple) {
+            m_frameShaderProgram->setUniformValue("signalColor",
+                    QVector4D(static_cast<GLfloat>(m_signalColor_r),
+                            static_cast<GLfloat>(m_signalColor_g),
+                            static_cast<GLfloat>(m_signalColor_b),
+                            1.0));
+        } else if (m_colorType == ColorType::RGB || m_colorType == ColorType::RGBFiltered) {
             m_frameShaderProgram->setUniformValue("lowColor",
                     QVector4D(static_cast<GLfloat>(m_rgbLowColor_r),
                             static_cast<GLfloat>(m_rgbLowColor_g),
@@ -404,23 +464,7 @@ void GLSLWaveformRendererSignal::draw(QPainter* painter, QPaintEvent* /*event*/)
 
         m_framebuffer->bind();
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        //glCallList(m_unitQuadListId);
-
-        glBegin(GL_QUADS);
-        {
-            glTexCoord2f(0.0,0.0);
-            glVertex3f(firstVisualIndex, -1.0f, 0.0f);
-
-            glTexCoord2f(1.0, 0.0);
-            glVertex3f(lastVisualIndex, -1.0f, 0.0f);
-
-            glTexCoord2f(1.0,1.0);
-            glVertex3f(lastVisualIndex, 1.0f, 0.0f);
-
-            glTexCoord2f(0.0,1.0);
-            glVertex3f(firstVisualIndex, 1.0f, 0.0f);
-        }
-        glEnd();
+        drawUnitQuad();
 
         m_framebuffer->release();
 
@@ -466,23 +510,7 @@ void GLSLWaveformRendererSignal::draw(QPainter* painter, QPaintEvent* /*event*/)
         glBindTexture(GL_TEXTURE_2D, m_framebuffer->texture());
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        glBegin(GL_QUADS);
-        {
-            glTexCoord2f(0.0, 0.0);
-            glVertex3f(-1.0f, -1.0f, 0.0f);
-
-            glTexCoord2f(1.0, 0.0);
-            glVertex3f(1.0f, -1.0f, 0.0f);
-
-            glTexCoord2f(1.0, 1.0);
-            glVertex3f(1.0f, 1.0f, 0.0f);
-
-            glTexCoord2f(0.0, 1.0);
-            glVertex3f(-1.0f, 1.0f, 0.0f);
-        }
-        glEnd();
-
+        drawUnitQuad();
     }
 
     glDisable(GL_TEXTURE_2D);
@@ -10,11 +10,14 @@
 QT_FORWARD_DECLARE_CLASS(QGLFramebufferObject)
 QT_FORWARD_DECLARE_CLASS(QGLShaderProgram)
 
+class Waveform;
+
 class GLSLWaveformRendererSignal : public QObject,
                                    public GLWaveformRenderer {
     Q_OBJECT
   public:
     enum class ColorType {
+        Simple,
         Filtered,
         RGB,
         RGBFiltered,
@@ -35,6 +38,9 @@ class GLSLWaveformRendererSignal : public QObject,
     void debugClick();
     bool loadShaders();
     bool loadTexture();
+    /// Uploads the data elements of the waveform from the rendered
+    /// completion up to the current completion.
+    void updateTexture(const Waveform& waveform, int currentCompletion);
 
   public slots:
     void slotWaveformUpdated();
@@ -42,8 +48,11 @@ class GLSLWaveformRendererSignal : public QObject,
   private:
     void createGeometry();
     void createFrameBuffers();
+    void drawUnitQuad();
 
-    GLint m_unitQuadListId;
+    // Vertex buffer of a textured quad that fills the viewport. The
+    // waveform is drawn by the shader, so the geometry never changes.
+    GLuint m_unitQuadBufferId;
     GLuint m_textureId;
 
     TrackPointer m_loadedTrack;
@@ -61,6 +70,18 @@ class GLSLWaveformRendererSignal : public QObject,
     std::unique_ptr<QGLShaderProgram> m_frameShaderProgram;
 };
 
+class GLSLWaveformRendererSimpleSignal : public GLSLWaveformRendererSignal {
+  public:
+    GLSLWaveformRendererSimpleSignal(
+            WaveformWidgetRenderer* waveformWidgetRenderer)
+            : GLSLWaveformRendererSignal(waveformWidgetRenderer,
+                      ColorType::Simple,
+                      QLatin1String(":/shaders/simplesignal.frag")) {
+    }
+    ~GLSLWaveformRendererSimpleSignal() override {
+    }
+};
+
 class GLSLWaveformRendererFilteredSignal: public GLSLWaveformRendererSignal {
 public:
   GLSLWaveformRendererFilteredSignal(
@@ -40,15 +40,26 @@ void WaveformRendererFilteredSignal::draw(QPainter* painter,
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
-    if (dataSize <= 1) {
+    if (waveform->getDataSize() <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    // Many visual frames are combined into a single pixel when zoomed out.
+    // Use the lowest level of detail that still provides this resolution.
+    const double visualFramesPerPixel = (m_waveformRenderer->getLastDisplayedPosition() -
+                                                m_waveformRenderer->getFirstDisplayedPosition()) *
+            waveform->getDataSize() / 2.0 / m_waveformRenderer->getLength();
+    int level = waveform->getLevelForVisualFrames(visualFramesPerPixel);
+    const WaveformData* data = waveform->getLevelData(level);
+    if (data == nullptr && level > 0) {
+        // Not available until the analysis has finished
+        level = 0;
+        data = waveform->data();
+    }
     if (data == nullptr) {
         return;
     }
+    const int dataSize = waveform->getLevelDataSize(level);
 
     PainterScope PainterScope(painter);
 
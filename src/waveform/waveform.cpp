@@ -2,11 +2,18 @@
 
 #include "waveform/waveform.h"
 #include "proto/waveform.pb.h"
+#include "util/assert.h"
+#include "util/math.h"
 
 using namespace mixxx::track;
 
 constexpr int kNumChannels = 2;
 
+// The lowest level of detail still contains more than this number of
+// visual frames, i.e. about as many as pixels of a zoomed out waveform.
+constexpr int kMinLevelFrames = 1024;
+constexpr int kMaxLevelCount = 8;
+
 // Return the smallest power of 2 which is greater than the desired size when
 // squared.
 int computeTextureStride(int size) {
@@ -17,15 +24,20 @@ int computeTextureStride(int size) {
     return stride;
 }
 
-Waveform::Waveform(const QByteArray& data)
+Waveform::Waveform(const QByteArray& data, std::shared_ptr<QFile> pMappedFile)
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
           m_dataSize(0),
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(computeTextureStride(0)),
-          m_completion(-1) {
+          m_completion(-1),
+          m_pMappedFile(std::move(pMappedFile)) {
     readByteArray(data);
+    if (m_compactData.isNull()) {
+        // Nothing is decoded on demand
+        m_pMappedFile.reset();
+    }
 }
 
 Waveform::Waveform(int audioSampleRate, int audioSamples,
@@ -68,62 +80,26 @@ Waveform::~Waveform() {
 }
 
 QByteArray Waveform::toByteArray() const {
-    io::Waveform waveform;
-    waveform.set_visual_sample_rate(m_visualSampleRate);
-    waveform.set_audio_visual_ratio(m_audioVisualRatio);
-
-    io::Waveform::Signal* all = waveform.mutable_signal_all();
-    io::Waveform::FilteredSignal* filtered = waveform.mutable_signal_filtered();
-    // TODO(rryan) get the actual cutoff values from analyzerwaveform.cpp so
-    // that if they change we don't have to remember to update these.
-
-    // Frequency cutoffs for butterworth filters:
-    // filtered->set_low_cutoff_frequency(200);
-    // filtered->set_mid_low_cutoff_frequency(200);
-    // filtered->set_mid_high_cutoff_frequency(2000);
-    // filtered->set_high_cutoff_frequency(2000);
-
-    // Frequency cutoff for bessel_lowpass4
-    filtered->set_low_cutoff_frequency(600);
-    // Frequency cutoff for bessel_bandpass
-    filtered->set_mid_low_cutoff_frequency(600);
-    filtered->set_mid_high_cutoff_frequency(4000);
-    // Frequency cutoff for bessel_highpass4
-    filtered->set_high_cutoff_frequency(4000);
-
-    io::Waveform::Signal* low = filtered->mutable_low();
-    io::Waveform::Signal* mid = filtered->mutable_mid();
-    io::Waveform::Signal* high = filtered->mutable_high();
-
-    // TODO(vrince) set max/min for each signal
-    int numChannels = kNumChannels;
-    all->set_units(io::Waveform::RMS);
-    all->set_channels(numChannels);
-    low->set_units(io::Waveform::RMS);
-    low->set_channels(numChannels);
-    mid->set_units(io::Waveform::RMS);
-    mid->set_channels(numChannels);
-    high->set_units(io::Waveform::RMS);
-    high->set_channels(numChannels);
-
-    int dataSize = getDataSize();
-    for (int i = 0; i < dataSize; ++i) {
-        const WaveformData& datum = m_data.at(i);
-        all->add_value(datum.filtered.all);
-        low->add_value(datum.filtered.low);
-        mid->add_value(datum.filtered.mid);
-        high->add_value(datum.filtered.high);
+    std::vector<mixxx::CompactWaveformFormat::LevelData> levels;
+    levels.reserve(getLevelCount());
+    for (int level = 0; level < getLevelCount(); ++level) {
+        const WaveformData* pData = getLevelData(level);
+        if (!pData) {
+            // The lower levels are only available after the analysis
+            // has finished and are recomputed when reading the data.
+            break;
+        }
+        levels.push_back({pData, getLevelDataSize(level)});
     }
 
-    qDebug() << "Writing waveform from byte array:"
-             << "dataSize" << dataSize
-             << "allSignalSize" << all->value_size()
-             << "visualSampleRate" << waveform.visual_sample_rate()
-             << "audioVisualRatio" << waveform.audio_visual_ratio();
+    qDebug() << "Writing waveform to byte array:"
+             << "dataSize" << getDataSize()
+             << "levels" << levels.size()
+             << "visualSampleRate" << m_visualSampleRate
+             << "audioVisualRatio" << m_audioVisualRatio;
 
-    std::string output;
-    waveform.SerializeToString(&output);
-    return QByteArray(output.data(), static_cast<int>(output.length()));
+    return mixxx::CompactWaveformFormat::write(
+            m_visualSampleRate, m_audioVisualRatio, levels);
 }
 
 void Waveform::readByteArray(const QByteArray& data) {
@@ -131,6 +107,15 @@ void Waveform::readByteArray(const QByteArray& data) {
         return;
     }
 
+    if (mixxx::CompactWaveformFormat::hasMagic(data)) {
+        if (!readCompactByteArray(data)) {
+            resize(0);
+            m_saveState = SaveState::NotSaved;
+        }
+        return;
+    }
+
+    // Legacy format that has been written by previous versions
     io::Waveform waveform;
 
     if (!waveform.ParseFromArray(data.constData(), data.size())) {
@@ -197,6 +182,141 @@ void Waveform::readByteArray(const QByteArray& data) {
     m_saveState = SaveState::Saved;
 }
 
+bool Waveform::readCompactByteArray(const QByteArray& data) {
+    mixxx::CompactWaveformFormat::Header header;
+    if (!mixxx::CompactWaveformFormat::readHeader(data, &header)) {
+        qWarning() << "ERROR: Could not parse Waveform header from QByteArray of size"
+                   << data.size();
+        return false;
+    }
+    const auto& fullLevel = header.levels.front();
+    if (fullLevel.dataSize % kNumChannels != 0) {
+        qWarning() << "ERROR: Invalid Waveform data size" << fullLevel.dataSize;
+        return false;
+    }
+
+    qDebug() << "Reading waveform from byte array:"
+             << "dataSize" << fullLevel.dataSize
+             << "levels" << header.levels.size()
+             << "visualSampleRate" << header.visualSampleRate
+             << "audioVisualRatio" << header.audioVisualRatio;
+
+    resize(fullLevel.dataSize);
+    if (!mixxx::CompactWaveformFormat::readLevel(data, fullLevel, m_data.data())) {
+        return false;
+    }
+    m_visualSampleRate = header.visualSampleRate;
+    m_audioVisualRatio = header.audioVisualRatio;
+    m_completion = m_dataSize;
+    m_saveState = SaveState::Saved;
+
+    // The remaining levels are decoded on demand. Levels with an unexpected
+    // size are ignored and computed from level 0 instead.
+    for (int level = 1; level < static_cast<int>(header.levels.size()) &&
+            level < getLevelCount() &&
+            header.levels[level].dataSize == getLevelDataSize(level);
+            ++level) {
+        m_compactLevels.resize(level + 1);
+        m_compactLevels[level] = header.levels[level];
+    }
+    if (!m_compactLevels.empty()) {
+        m_compactData = data;
+    }
+    return true;
+}
+
+// static
+int Waveform::levelCountForDataSize(int dataSize) {
+    int levelCount = 1;
+    int frames = dataSize / kNumChannels;
+    while (frames > kMinLevelFrames && levelCount < kMaxLevelCount) {
+        frames = (frames + kLevelReductionFactor - 1) / kLevelReductionFactor;
+        ++levelCount;
+    }
+    return levelCount;
+}
+
+// static
+int Waveform::levelDataSize(int dataSize, int level) {
+    int frames = dataSize / kNumChannels;
+    for (int i = 0; i < level; ++i) {
+        frames = (frames + kLevelReductionFactor - 1) / kLevelReductionFactor;
+    }
+    return level == 0 ? dataSize : frames * kNumChannels;
+}
+
+int Waveform::getLevelForVisualFrames(double visualFramesOfLevel0) const {
+    int level = 0;
+    double framesPerLevelFrame = kLevelReductionFactor;
+    while (level + 1 < getLevelCount() && framesPerLevelFrame <= visualFramesOfLevel0) {
+        ++level;
+        framesPerLevelFrame *= kLevelReductionFactor;
+    }
+    return level;
+}
+
+const WaveformData* Waveform::getLevelData(int level) const {
+    if (level == 0) {
+        return data();
+    }
+    VERIFY_OR_DEBUG_ASSERT(level > 0 && level < getLevelCount()) {
+        return nullptr;
+    }
+    const auto locker = lockMutex(&m_mutex);
+    return getLevelDataLocked(level);
+}
+
+const WaveformData* Waveform::getLevelDataLocked(int level) const {
+    if (level == 0) {
+        return data();
+    }
+    if (m_levels.empty()) {
+        m_levels.resize(getLevelCount());
+    }
+    std::vector<WaveformData>& levelData = m_levels[level];
+    if (!levelData.empty()) {
+        return levelData.data();
+    }
+
+    const int dataSize = getLevelDataSize(level);
+    if (level < static_cast<int>(m_compactLevels.size())) {
+        levelData.resize(dataSize);
+        if (mixxx::CompactWaveformFormat::readLevel(
+                    m_compactData, m_compactLevels[level], levelData.data())) {
+            return levelData.data();
+        }
+        // Fall back to computing the level
+        levelData.clear();
+    }
+
+    // Computing a level requires the complete data of the previous level
+    if (getCompletion() < getDataSize()) {
+        return nullptr;
+    }
+    const WaveformData* pPrevData = getLevelDataLocked(level - 1);
+    if (!pPrevData) {
+        return nullptr;
+    }
+    const int prevFrames = getLevelDataSize(level - 1) / kNumChannels;
+    levelData.resize(dataSize);
+    for (int frame = 0; frame < dataSize / kNumChannels; ++frame) {
+        const int prevFrameStart = frame * kLevelReductionFactor;
+        const int prevFrameEnd = math_min(prevFrameStart + kLevelReductionFactor, prevFrames);
+        for (int channel = 0; channel < kNumChannels; ++channel) {
+            WaveformData maximum(0);
+            for (int prevFrame = prevFrameStart; prevFrame < prevFrameEnd; ++prevFrame) {
+                const WaveformData& prev = pPrevData[prevFrame * kNumChannels + channel];
+                maximum.filtered.low = math_max(maximum.filtered.low, prev.filtered.low);
+                maximum.filtered.mid = math_max(maximum.filtered.mid, prev.filtered.mid);
+                maximum.filtered.high = math_max(maximum.filtered.high, prev.filtered.high);
+                maximum.filtered.all = math_max(maximum.filtered.all, prev.filtered.all);
+            }
+            levelData[frame * kNumChannels + channel] = maximum;
+        }
+    }
+    return levelData.data();
+}
+
 void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
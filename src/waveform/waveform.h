@@ -5,10 +5,15 @@
 #include <QMutex>
 #include <QSharedPointer>
 #include <QString>
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "util/class.h"
 #include "util/compatibility/qmutex.h"
+#include "waveform/compactwaveformformat.h"
+
+class QFile;
 
 enum FilterIndex { Low = 0, Mid = 1, High = 2, FilterCount = 3};
 enum ChannelIndex { Left = 0, Right = 1, ChannelCount = 2};
@@ -34,7 +39,10 @@ class Waveform {
         Saved
     };
 
-    explicit Waveform(const QByteArray& pData = QByteArray());
+    /// The data might refer to a memory mapped file that needs to be kept
+    /// open until all levels of detail have been decoded.
+    explicit Waveform(const QByteArray& pData = QByteArray(),
+            std::shared_ptr<QFile> pMappedFile = nullptr);
     Waveform(int audioSampleRate, int audioSamples,
              int desiredVisualSampleRate, int maxVisualSamples);
 
@@ -111,6 +119,14 @@ class Waveform {
     // constructor runs.
     inline int getTextureSize() const { return static_cast<int>(m_data.size()); }
 
+    // The number of rows of the texture that contain the first numElements
+    // data elements, including a partially filled last row.
+    int getTextureRowCount(int numElements) const {
+        const int textureHeight = getTextureSize() / m_textureStride;
+        return std::min((numElements + m_textureStride - 1) / m_textureStride,
+                textureHeight);
+    }
+
     // Atomically get the number of data elements in this Waveform. We do not
     // lock the mutex since m_dataSize is not changed after the constructor
     // runs.
@@ -130,10 +146,39 @@ class Waveform {
     // constructor runs.
     const WaveformData* data() const { return &m_data[0];}
 
+    /// The waveform data is provided in multiple levels of detail. Each
+    /// level reduces the number of visual frames of the previous level by
+    /// kLevelReductionFactor, using the maximum value of each channel and
+    /// band. Level 0 contains the full resolution data().
+    static constexpr int kLevelReductionFactor = 4;
+
+    static int levelCountForDataSize(int dataSize);
+    static int levelDataSize(int dataSize, int level);
+
+    // We do not lock the mutex since the number of levels is not
+    // changed after the constructor runs.
+    int getLevelCount() const {
+        return levelCountForDataSize(m_dataSize);
+    }
+    int getLevelDataSize(int level) const {
+        return levelDataSize(m_dataSize, level);
+    }
+
+    /// Returns the lowest level of detail that still provides at least
+    /// one visual frame for the given number of visual frames of level 0.
+    int getLevelForVisualFrames(double visualFramesOfLevel0) const;
+
+    /// Returns nullptr if the level is not available, i.e. while the
+    /// waveform is still being analyzed. The lower levels are decoded or
+    /// computed on first access.
+    const WaveformData* getLevelData(int level) const;
+
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    bool readCompactByteArray(const QByteArray& data);
+    const WaveformData* getLevelDataLocked(int level) const;
     void resize(int size);
     void assign(int size, int value = 0);
 
@@ -175,6 +220,16 @@ class Waveform {
     // the mutex. The completion of the waveform calculation.
     QAtomicInt m_completion;
 
+    // The lower levels of detail, indexed by level. The vector of level 0
+    // is unused. Filled on demand.
+    mutable std::vector<std::vector<WaveformData>> m_levels;
+
+    // The serialized data from which the lower levels of detail are
+    // decoded. Might refer to a memory mapped file.
+    QByteArray m_compactData;
+    std::vector<mixxx::CompactWaveformFormat::Level> m_compactLevels;
+    std::shared_ptr<QFile> m_pMappedFile;
+
     mutable QMutex m_mutex;
 
     DISALLOW_COPY_AND_ASSIGN(Waveform);
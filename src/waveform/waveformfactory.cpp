@@ -6,7 +6,7 @@
 // static
 Waveform* WaveformFactory::loadWaveformFromAnalysis(
         const AnalysisDao::AnalysisInfo& analysis) {
-    Waveform* pWaveform = new Waveform(analysis.data);
+    Waveform* pWaveform = new Waveform(analysis.data, analysis.pMappedFile);
     pWaveform->setId(analysis.analysisId);
     pWaveform->setVersion(analysis.version);
     pWaveform->setDescription(analysis.description);
@@ -869,6 +869,13 @@ void WaveformWidgetFactory::evaluateWidgets() {
             useOpenGLShaders = GLSLRGBStackedWaveformWidget::useOpenGLShaders();
             developerOnly = GLSLRGBStackedWaveformWidget::developerOnly();
             break;
+        case WaveformWidgetType::GLSLSimpleWaveform:
+            widgetName = GLSLSimpleWaveformWidget::getWaveformWidgetName();
+            useOpenGl = GLSLSimpleWaveformWidget::useOpenGl();
+            useOpenGles = GLSLSimpleWaveformWidget::useOpenGles();
+            useOpenGLShaders = GLSLSimpleWaveformWidget::useOpenGLShaders();
+            developerOnly = GLSLSimpleWaveformWidget::developerOnly();
+            break;
         case WaveformWidgetType::GLVSyncTest:
             widgetName = GLVSyncTestWidget::getWaveformWidgetName();
             useOpenGl = GLVSyncTestWidget::useOpenGl();
@@ -998,6 +1005,9 @@ WaveformWidgetAbstract* WaveformWidgetFactory::createWaveformWidget(
         case WaveformWidgetType::GLSLRGBStackedWaveform:
             widget = new GLSLRGBStackedWaveformWidget(viewer->getGroup(), viewer);
             break;
+        case WaveformWidgetType::GLSLSimpleWaveform:
+            widget = new GLSLSimpleWaveformWidget(viewer->getGroup(), viewer);
+            break;
         case WaveformWidgetType::GLVSyncTest:
             widget = new GLVSyncTestWidget(viewer->getGroup(), viewer);
             break;
@@ -15,6 +15,12 @@
 #include "waveform/renderers/waveformwidgetrenderer.h"
 #include "waveform/sharedglcontext.h"
 
+GLSLSimpleWaveformWidget::GLSLSimpleWaveformWidget(
+        const QString& group,
+        QWidget* parent)
+        : GLSLWaveformWidget(group, parent, GLSLWaveformWidget::GlslType::Simple) {
+}
+
 GLSLFilteredWaveformWidget::GLSLFilteredWaveformWidget(
         const QString& group,
         QWidget* parent)
@@ -50,7 +56,9 @@ GLSLWaveformWidget::GLSLWaveformWidget(
     addRenderer<WaveformRendererPreroll>();
     addRenderer<WaveformRenderMarkRange>();
 #if !defined(QT_NO_OPENGL) && !defined(QT_OPENGL_ES_2)
-    if (type == GlslType::Filtered) {
+    if (type == GlslType::Simple) {
+        m_pGlRenderer = addRenderer<GLSLWaveformRendererSimpleSignal>();
+    } else if (type == GlslType::Filtered) {
         m_pGlRenderer = addRenderer<GLSLWaveformRendererFilteredSignal>();
     } else if (type == GlslType::RGB) {
         m_pGlRenderer = addRenderer<GLSLWaveformRendererRGBSignal>();
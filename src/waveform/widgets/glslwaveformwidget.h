@@ -8,6 +8,7 @@ class GLSLWaveformWidget : public GLWaveformWidgetAbstract {
     Q_OBJECT
   public:
     enum class GlslType {
+        Simple,
         Filtered,
         RGB,
         RGBStacked,
@@ -32,6 +33,33 @@ class GLSLWaveformWidget : public GLWaveformWidgetAbstract {
     friend class WaveformWidgetFactory;
 };
 
+class GLSLSimpleWaveformWidget : public GLSLWaveformWidget {
+    Q_OBJECT
+  public:
+    GLSLSimpleWaveformWidget(const QString& group, QWidget* parent);
+    ~GLSLSimpleWaveformWidget() override = default;
+
+    WaveformWidgetType::Type getType() const override {
+        return WaveformWidgetType::GLSLSimpleWaveform;
+    }
+
+    static inline QString getWaveformWidgetName() {
+        return tr("Simple");
+    }
+    static inline bool useOpenGl() {
+        return true;
+    }
+    static inline bool useOpenGles() {
+        return false;
+    }
+    static inline bool useOpenGLShaders() {
+        return true;
+    }
+    static inline bool developerOnly() {
+        return false;
+    }
+};
+
 class GLSLFilteredWaveformWidget : public GLSLWaveformWidget {
     Q_OBJECT
   public:
@@ -5,6 +5,7 @@
 #include <QtDebug>
 
 #include "skin/legacy/imgloader.h"
+#include "skin/legacy/skinimagecache.h"
 
 #include "util/math.h"
 #include "util/memory.h"
@@ -52,6 +53,27 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
     if (!source.isSVG()) {
         m_pPixmap.reset(WPixmapStore::getPixmapNoCache(source.getPath(), scaleFactor));
     } else {
+        // Apple does Retina scaling behind the scenes, so we also pass a
+        // Paintable::FIXED image. On the other targets, it is better to
+        // cache the pixmap. We do not do this for TILE and color schemas.
+        // which can result in a correct but possibly blurry picture at a
+        // Retina display. This can be fixed when switching to QT5
+#ifdef __APPLE__
+        const bool rasterize = mode == TILE || WPixmapStore::willCorrectColors();
+#else
+        const bool rasterize = mode == TILE || mode == Paintable::FIXED ||
+                WPixmapStore::willCorrectColors();
+#endif
+        if (rasterize && source.getSvgSourceData().isEmpty()) {
+            // The SVG renderer is not needed if the skin parser has
+            // already rasterized the file
+            QImage image = SkinImageCache::image(source.getPath(), scaleFactor);
+            if (!image.isNull()) {
+                WPixmapStore::correctImageColors(&image);
+                m_pPixmap.reset(new QPixmap(QPixmap::fromImage(image)));
+                return;
+            }
+        }
         auto pSvg = std::make_unique<QSvgRenderer>();
         if (!source.getSvgSourceData().isEmpty()) {
             // Call here the different overload for svg content
@@ -68,16 +90,7 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
             return;
         }
         m_pSvg.reset(pSvg.release());
-#ifdef __APPLE__
-        // Apple does Retina scaling behind the scenes, so we also pass a
-        // Paintable::FIXED image. On the other targets, it is better to
-        // cache the pixmap. We do not do this for TILE and color schemas.
-        // which can result in a correct but possibly blurry picture at a
-        // Retina display. This can be fixed when switching to QT5
-        if (mode == TILE || WPixmapStore::willCorrectColors()) {
-#else
-        if (mode == TILE || mode == Paintable::FIXED || WPixmapStore::willCorrectColors()) {
-#endif
+        if (rasterize) {
             // The SVG renderer doesn't directly support tiling, so we render
             // it to a pixmap which will then get tiled.
             QImage copy_buffer(m_pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
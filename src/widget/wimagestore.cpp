@@ -5,6 +5,7 @@
 #include <QPainter>
 
 #include "skin/legacy/imgloader.h"
+#include "skin/legacy/skinimagecache.h"
 #include "util/assert.h"
 
 
@@ -67,6 +68,11 @@ QImage* WImageStore::getImageNoCache(const PixmapSource& source, double scaleFac
                 return nullptr;
             }
         } else if (!source.getPath().isEmpty()) {
+            const QImage preloadedImage =
+                    SkinImageCache::image(source.getPath(), scaleFactor);
+            if (!preloadedImage.isNull()) {
+                return new QImage(preloadedImage);
+            }
             if (!renderer.load(source.getPath())) {
                 // The above line already logs a warning
                 return nullptr;
@@ -57,6 +57,7 @@ class WLibraryTableView : public QTableView, public virtual LibraryView {
     void loadTrackToPlayer(TrackPointer pTrack, const QString& group, bool play = false);
     void trackSelected(TrackPointer pTrack);
     void onlyCachedCoverArt(bool);
+    void prefetchCoverArt(const QList<int>& rows);
     void scrollValueChanged(int);
 
   public slots:
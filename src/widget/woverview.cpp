@@ -45,6 +45,7 @@ WOverview::WOverview(
         UserSettingsPointer pConfig,
         QWidget* parent)
         : WWidget(parent),
+          m_waveformLevel(0),
           m_actualCompletion(0),
           m_pixmapDone(false),
           m_waveformPeak(-1.0),
@@ -86,6 +87,10 @@ WOverview::WOverview(
             new ControlProxy(m_group, "passthrough", this, ControlFlag::NoAssertIfMissing);
     m_pPassthroughControl->connectValueChanged(this, &WOverview::onPassthroughChange);
     m_bPassthroughEnabled = m_pPassthroughControl->toBool();
+    m_pPreloadProgressControl = new ControlProxy(
+            m_group, "preload_progress", this, ControlFlag::NoAssertIfMissing);
+    m_pPreloadProgressControl->connectValueChanged(
+            this, &WOverview::onPreloadProgressChange);
 
     m_pPassthroughLabel = new QLabel(this);
 
@@ -300,6 +305,37 @@ void WOverview::slotWaveformSummaryUpdated() {
     }
 }
 
+int WOverview::selectWaveformLevel(const Waveform& waveform) {
+    // The coarse levels of detail are only available for complete
+    // waveforms. The image has one line per visual frame and is scaled
+    // down to the widget, so a visual frame per pixel is sufficient.
+    const int pixels = static_cast<int>(length() * m_devicePixelRatio);
+    if (pixels <= 0 || waveform.getCompletion() < waveform.getDataSize()) {
+        return 0;
+    }
+    const double visualFramesPerPixel =
+            static_cast<double>(waveform.getDataSize() / 2) / pixels;
+    return waveform.getLevelForVisualFrames(visualFramesPerPixel);
+}
+
+const WaveformData* WOverview::getWaveformLevelData(const Waveform& waveform) {
+    if (m_waveformSourceImage.isNull()) {
+        m_waveformLevel = selectWaveformLevel(waveform);
+    }
+    const WaveformData* pData = waveform.getLevelData(m_waveformLevel);
+    if (!pData) {
+        // The level could not be decoded or the track is analyzed again.
+        // The image is drawn again from the full resolution data.
+        m_waveformSourceImage = QImage();
+        m_waveformLevel = 0;
+        m_actualCompletion = 0;
+        m_waveformPeak = -1.0;
+        m_pixmapDone = false;
+        pData = waveform.data();
+    }
+    return pData;
+}
+
 void WOverview::onTrackAnalyzerProgress(TrackId trackId, AnalyzerProgress analyzerProgress) {
     if (!m_pCurrentTrack || (m_pCurrentTrack->getId() != trackId)) {
         return;
@@ -380,6 +416,11 @@ void WOverview::onMarkRangeChange(double v) {
     update();
 }
 
+void WOverview::onPreloadProgressChange(double v) {
+    Q_UNUSED(v);
+    update();
+}
+
 void WOverview::onRateRatioChange(double v) {
     Q_UNUSED(v);
     update();
@@ -626,6 +667,7 @@ void WOverview::paintEvent(QPaintEvent* pEvent) {
         drawPlayPosition(&painter);
         drawEndOfTrackFrame(&painter);
         drawAnalyzerProgress(&painter);
+        drawPreloadProgress(&painter);
 
         double trackSamples = m_trackSamplesControl->get();
         if (m_trackLoaded && trackSamples > 0) {
@@ -790,6 +832,25 @@ void WOverview::drawAnalyzerProgress(QPainter* pPainter) {
     }
 }
 
+void WOverview::drawPreloadProgress(QPainter* pPainter) {
+    const double preloadProgress = m_pPreloadProgressControl->get();
+    if (preloadProgress <= 0.0 || preloadProgress >= 1.0) {
+        return;
+    }
+    // A thin bar along the edge that grows while the track is decoded
+    // into memory, the waveform itself is left untouched.
+    PainterScope painterScope(pPainter);
+    pPainter->setOpacity(0.5);
+    pPainter->setPen(QPen(m_playPosColor, 2 * m_scaleFactor));
+    if (m_orientation == Qt::Horizontal) {
+        const qreal y = height() - m_scaleFactor;
+        pPainter->drawLine(QLineF(0, y, width() * preloadProgress, y));
+    } else {
+        const qreal x = width() - m_scaleFactor;
+        pPainter->drawLine(QLineF(x, 0, x, height() * preloadProgress));
+    }
+}
+
 void WOverview::drawRangeMarks(QPainter* pPainter, const float& offset, const float& gain) {
     for (auto&& markRange : m_markRanges) {
         if (!markRange.active() || !markRange.visible()) {
@@ -1289,6 +1350,18 @@ void WOverview::resizeEvent(QResizeEvent* pEvent) {
 
     m_waveformImageScaled = QImage();
     m_diffGain = 0;
+
+    // The image is redrawn if its level of detail is too coarse for the
+    // new size
+    if (m_pWaveform && !m_waveformSourceImage.isNull() &&
+            m_waveformLevel > selectWaveformLevel(*m_pWaveform)) {
+        m_waveformSourceImage = QImage();
+        m_actualCompletion = 0;
+        m_waveformPeak = -1.0;
+        m_pixmapDone = false;
+        drawNextPixmapPart();
+    }
+
     Init();
 }
 
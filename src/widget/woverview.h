@@ -78,11 +78,18 @@ class WOverview : public WWidget, public TrackDropTarget {
         return m_pWaveform;
     }
 
+    // Returns the data of the level of detail of the waveform summary that
+    // is drawn into m_waveformSourceImage. The level is selected when
+    // drawing a new image starts.
+    const WaveformData* getWaveformLevelData(const Waveform& waveform);
+
     QImage m_waveformSourceImage;
     QImage m_waveformImageScaled;
 
     WaveformSignalColors m_signalColors;
 
+    // The level of detail of the waveform summary in m_waveformSourceImage
+    int m_waveformLevel;
     // Hold the last visual sample processed to generate the pixmap
     int m_actualCompletion;
 
@@ -99,6 +106,7 @@ class WOverview : public WWidget, public TrackDropTarget {
     void onMarkRangeChange(double v);
     void onRateRatioChange(double v);
     void onPassthroughChange(double v);
+    void onPreloadProgressChange(double v);
     void receiveCuesUpdated();
 
     void slotWaveformSummaryUpdated();
@@ -108,6 +116,7 @@ class WOverview : public WWidget, public TrackDropTarget {
     // Append the waveform overview pixmap according to available data
     // in waveform
     virtual bool drawNextPixmapPart() = 0;
+    int selectWaveformLevel(const Waveform& waveform);
     void drawEndOfTrackBackground(QPainter* pPainter);
     void drawAxis(QPainter* pPainter);
     void drawWaveformPixmap(QPainter* pPainter);
@@ -115,6 +124,7 @@ class WOverview : public WWidget, public TrackDropTarget {
     void drawPlayPosition(QPainter* pPainter);
     void drawEndOfTrackFrame(QPainter* pPainter);
     void drawAnalyzerProgress(QPainter* pPainter);
+    void drawPreloadProgress(QPainter* pPainter);
     void drawRangeMarks(QPainter* pPainter, const float& offset, const float& gain);
     void drawMarks(QPainter* pPainter, const float offset, const float gain);
     void drawPickupPosition(QPainter* pPainter);
@@ -142,6 +152,7 @@ class WOverview : public WWidget, public TrackDropTarget {
     ControlProxy* m_trackSamplesControl;
     ControlProxy* m_playpositionControl;
     ControlProxy* m_pPassthroughControl;
+    ControlProxy* m_pPreloadProgressControl;
 
     // Current active track
     TrackPointer m_pCurrentTrack;
@@ -27,11 +27,13 @@ bool WOverviewHSV::drawNextPixmapPart() {
         return false;
     }
 
-    const int dataSize = pWaveform->getDataSize();
-    if (dataSize == 0) {
+    if (pWaveform->getDataSize() == 0) {
         return false;
     }
 
+    const WaveformData* const pData = getWaveformLevelData(*pWaveform);
+    const int dataSize = pWaveform->getLevelDataSize(m_waveformLevel);
+
     if (m_waveformSourceImage.isNull()) {
         // Waveform pixmap twice the height of the viewport to be scalable
         // by total_gain
@@ -41,8 +43,10 @@ bool WOverviewHSV::drawNextPixmapPart() {
         m_waveformSourceImage.fill(QColor(0, 0, 0, 0).value());
     }
 
-    // Always multiple of 2
-    const int waveformCompletion = pWaveform->getCompletion();
+    // Always multiple of 2. The coarse levels of detail are only drawn
+    // for complete waveforms.
+    const int waveformCompletion =
+            m_waveformLevel == 0 ? pWaveform->getCompletion() : dataSize;
     // Test if there is some new to draw (at least of pixel width)
     const int completionIncrement = waveformCompletion - m_actualCompletion;
 
@@ -80,15 +84,15 @@ bool WOverviewHSV::drawNextPixmapPart() {
 
     for (currentCompletion = m_actualCompletion;
             currentCompletion < nextCompletion; currentCompletion += 2) {
-        maxAll[0] = pWaveform->getAll(currentCompletion);
-        maxAll[1] = pWaveform->getAll(currentCompletion+1);
+        maxAll[0] = pData[currentCompletion].filtered.all;
+        maxAll[1] = pData[currentCompletion+1].filtered.all;
         if (maxAll[0] || maxAll[1]) {
-            maxLow[0] = pWaveform->getLow(currentCompletion);
-            maxLow[1] = pWaveform->getLow(currentCompletion+1);
-            maxMid[0] = pWaveform->getMid(currentCompletion);
-            maxMid[1] = pWaveform->getMid(currentCompletion+1);
-            maxHigh[0] = pWaveform->getHigh(currentCompletion);
-            maxHigh[1] = pWaveform->getHigh(currentCompletion+1);
+            maxLow[0] = pData[currentCompletion].filtered.low;
+            maxLow[1] = pData[currentCompletion+1].filtered.low;
+            maxMid[0] = pData[currentCompletion].filtered.mid;
+            maxMid[1] = pData[currentCompletion+1].filtered.mid;
+            maxHigh[0] = pData[currentCompletion].filtered.high;
+            maxHigh[1] = pData[currentCompletion+1].filtered.high;
 
             total = (maxLow[0] + maxLow[1] + maxMid[0] + maxMid[1] +
                             maxHigh[0] + maxHigh[1]) *
@@ -119,8 +123,8 @@ bool WOverviewHSV::drawNextPixmapPart() {
             currentCompletion < nextCompletion; currentCompletion += 2) {
         m_waveformPeak = math_max3(
                 m_waveformPeak,
-                static_cast<float>(pWaveform->getAll(currentCompletion)),
-                static_cast<float>(pWaveform->getAll(currentCompletion + 1)));
+                static_cast<float>(pData[currentCompletion].filtered.all),
+                static_cast<float>(pData[currentCompletion + 1].filtered.all));
     }
 
     m_actualCompletion = nextCompletion;
@@ -28,11 +28,13 @@ bool WOverviewLMH::drawNextPixmapPart() {
         return false;
     }
 
-    const int dataSize = pWaveform->getDataSize();
-    if (dataSize == 0) {
+    if (pWaveform->getDataSize() == 0) {
         return false;
     }
 
+    const WaveformData* const pData = getWaveformLevelData(*pWaveform);
+    const int dataSize = pWaveform->getLevelDataSize(m_waveformLevel);
+
     if (m_waveformSourceImage.isNull()) {
         // Waveform pixmap twice the height of the viewport to be scalable
         // by total_gain
@@ -42,8 +44,10 @@ bool WOverviewLMH::drawNextPixmapPart() {
         m_waveformSourceImage.fill(QColor(0, 0, 0, 0).value());
     }
 
-    // Always multiple of 2
-    const int waveformCompletion = pWaveform->getCompletion();
+    // Always multiple of 2. The coarse levels of detail are only drawn
+    // for complete waveforms.
+    const int waveformCompletion =
+            m_waveformLevel == 0 ? pWaveform->getCompletion() : dataSize;
     // Test if there is some new to draw (at least of pixel width)
     const int completionIncrement = waveformCompletion - m_actualCompletion;
 
@@ -76,8 +80,8 @@ bool WOverviewLMH::drawNextPixmapPart() {
 
     for (currentCompletion = m_actualCompletion;
             currentCompletion < nextCompletion; currentCompletion += 2) {
-        unsigned char lowNeg = pWaveform->getLow(currentCompletion);
-        unsigned char lowPos = pWaveform->getLow(currentCompletion+1);
+        unsigned char lowNeg = pData[currentCompletion].filtered.low;
+        unsigned char lowPos = pData[currentCompletion+1].filtered.low;
         if (lowPos || lowNeg) {
             painter.setPen(lowColorPen);
             painter.drawLine(QPoint(currentCompletion / 2, -lowNeg),
@@ -89,18 +93,18 @@ bool WOverviewLMH::drawNextPixmapPart() {
             currentCompletion < nextCompletion; currentCompletion += 2) {
         painter.setPen(midColorPen);
         painter.drawLine(QPoint(currentCompletion / 2,
-                -pWaveform->getMid(currentCompletion)),
+                -pData[currentCompletion].filtered.mid),
                 QPoint(currentCompletion / 2,
-                pWaveform->getMid(currentCompletion+1)));
+                pData[currentCompletion+1].filtered.mid));
     }
 
     for (currentCompletion = m_actualCompletion;
             currentCompletion < nextCompletion; currentCompletion += 2) {
         painter.setPen(highColorPen);
         painter.drawLine(QPoint(currentCompletion / 2,
-                -pWaveform->getHigh(currentCompletion)),
+                -pData[currentCompletion].filtered.high),
                 QPoint(currentCompletion / 2,
-                pWaveform->getHigh(currentCompletion+1)));
+                pData[currentCompletion+1].filtered.high));
     }
 
     // Evaluate waveform ratio peak
@@ -109,8 +113,8 @@ bool WOverviewLMH::drawNextPixmapPart() {
             currentCompletion < nextCompletion; currentCompletion += 2) {
         m_waveformPeak = math_max3(
                 m_waveformPeak,
-                static_cast<float>(pWaveform->getAll(currentCompletion)),
-                static_cast<float>(pWaveform->getAll(currentCompletion + 1)));
+                static_cast<float>(pData[currentCompletion].filtered.all),
+                static_cast<float>(pData[currentCompletion + 1].filtered.all));
     }
 
     m_actualCompletion = nextCompletion;
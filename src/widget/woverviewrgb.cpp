@@ -26,11 +26,13 @@ bool WOverviewRGB::drawNextPixmapPart() {
         return false;
     }
 
-    const int dataSize = pWaveform->getDataSize();
-    if (dataSize == 0) {
+    if (pWaveform->getDataSize() == 0) {
         return false;
     }
 
+    const WaveformData* const pData = getWaveformLevelData(*pWaveform);
+    const int dataSize = pWaveform->getLevelDataSize(m_waveformLevel);
+
     if (m_waveformSourceImage.isNull()) {
         // Waveform pixmap twice the height of the viewport to be scalable
         // by total_gain
@@ -42,8 +44,10 @@ bool WOverviewRGB::drawNextPixmapPart() {
         m_waveformSourceImage.fill(QColor(0, 0, 0, 0).value());
     }
 
-    // Always multiple of 2
-    const int waveformCompletion = pWaveform->getCompletion();
+    // Always multiple of 2. The coarse levels of detail are only drawn
+    // for complete waveforms.
+    const int waveformCompletion =
+            m_waveformLevel == 0 ? pWaveform->getCompletion() : dataSize;
     // Test if there is some new to draw (at least of pixel width)
     const int completionIncrement = waveformCompletion - m_actualCompletion;
 
@@ -78,13 +82,13 @@ bool WOverviewRGB::drawNextPixmapPart() {
     for (currentCompletion = m_actualCompletion;
             currentCompletion < nextCompletion; currentCompletion += 2) {
 
-        unsigned char left = pWaveform->getAll(currentCompletion);
-        unsigned char right = pWaveform->getAll(currentCompletion + 1);
+        unsigned char left = pData[currentCompletion].filtered.all;
+        unsigned char right = pData[currentCompletion + 1].filtered.all;
 
         // Retrieve "raw" LMH values from waveform
-        qreal low = static_cast<qreal>(pWaveform->getLow(currentCompletion));
-        qreal mid = static_cast<qreal>(pWaveform->getMid(currentCompletion));
-        qreal high = static_cast<qreal>(pWaveform->getHigh(currentCompletion));
+        qreal low = static_cast<qreal>(pData[currentCompletion].filtered.low);
+        qreal mid = static_cast<qreal>(pData[currentCompletion].filtered.mid);
+        qreal high = static_cast<qreal>(pData[currentCompletion].filtered.high);
 
         // Do matrix multiplication
         qreal red = low * lowColor_r + mid * midColor_r + high * highColor_r;
@@ -101,9 +105,9 @@ bool WOverviewRGB::drawNextPixmapPart() {
         }
 
         // Retrieve "raw" LMH values from waveform
-        low = static_cast<qreal>(pWaveform->getLow(currentCompletion + 1));
-        mid = static_cast<qreal>(pWaveform->getMid(currentCompletion + 1));
-        high = static_cast<qreal>(pWaveform->getHigh(currentCompletion + 1));
+        low = static_cast<qreal>(pData[currentCompletion + 1].filtered.low);
+        mid = static_cast<qreal>(pData[currentCompletion + 1].filtered.mid);
+        high = static_cast<qreal>(pData[currentCompletion + 1].filtered.high);
 
         // Do matrix multiplication
         red = low * lowColor_r + mid * midColor_r + high * highColor_r;
@@ -125,8 +129,8 @@ bool WOverviewRGB::drawNextPixmapPart() {
             currentCompletion < nextCompletion; currentCompletion += 2) {
         m_waveformPeak = math_max3(
                 m_waveformPeak,
-                static_cast<float>(pWaveform->getAll(currentCompletion)),
-                static_cast<float>(pWaveform->getAll(currentCompletion + 1)));
+                static_cast<float>(pData[currentCompletion].filtered.all),
+                static_cast<float>(pData[currentCompletion + 1].filtered.all));
     }
 
     m_actualCompletion = nextCompletion;
@@ -25,6 +25,7 @@
 #include "util/assert.h"
 #include "util/defs.h"
 #include "util/dnd.h"
+#include "util/math.h"
 #include "util/time.h"
 #include "widget/wtrackmenu.h"
 #include "widget/wtracktableviewheader.h"
@@ -41,6 +42,13 @@ const ConfigKey kVScrollBarPosConfigKey{
 // Default color for the focus border of TableItemDelegates
 const QColor kDefaultFocusBorderColor = Qt::white;
 
+// Cover art is prefetched for the rows that are expected to be scrolled
+// into view within this number of GUI ticks (50 ms)
+constexpr int kCoverArtPrefetchTicks = 10;
+
+// Limits the number of prefetched rows when scrolling very fast
+constexpr int kMaxCoverArtPrefetchPages = 3;
+
 } // anonymous namespace
 
 WTrackTableView::WTrackTableView(QWidget* parent,
@@ -55,7 +63,8 @@ WTrackTableView::WTrackTableView(QWidget* parent,
           m_pFocusBorderColor(kDefaultFocusBorderColor),
           m_sorting(sorting),
           m_selectionChangedSinceLastGuiTick(true),
-          m_loadCachedOnly(false) {
+          m_loadCachedOnly(false),
+          m_prefetchFirstVisibleRow(-1) {
     // Connect slots and signals to make the world go 'round.
     connect(this, &WTrackTableView::doubleClicked, this, &WTrackTableView::slotMouseDoubleClicked);
 
@@ -105,7 +114,56 @@ void WTrackTableView::selectionChanged(
     QTableView::selectionChanged(selected, deselected);
 }
 
+void WTrackTableView::updateCoverArtPrefetch() {
+    const QAbstractItemModel* pModel = model();
+    const int firstVisibleRow = rowAt(0);
+    if (!pModel || !isVisible() || firstVisibleRow < 0) {
+        m_prefetchFirstVisibleRow = -1;
+        return;
+    }
+    const int rowCount = pModel->rowCount();
+    int lastVisibleRow = rowAt(viewport()->height() - 1);
+    if (lastVisibleRow < 0) {
+        lastVisibleRow = rowCount - 1;
+    }
+    const int pageRows = lastVisibleRow - firstVisibleRow + 1;
+
+    // The scroll velocity since the last tick in rows
+    const int rowsPerTick = m_prefetchFirstVisibleRow >= 0
+            ? firstVisibleRow - m_prefetchFirstVisibleRow
+            : 0;
+    m_prefetchFirstVisibleRow = firstVisibleRow;
+    const int aheadRows = math_clamp(
+            std::abs(rowsPerTick) * kCoverArtPrefetchTicks,
+            pageRows,
+            kMaxCoverArtPrefetchPages * pageRows);
+    // When not scrolling the next page in both directions is prefetched
+    const int rowsBelow = rowsPerTick >= 0 ? aheadRows : 0;
+    const int rowsAbove = rowsPerTick <= 0 ? aheadRows : 0;
+
+    // Visible rows first, then by distance from the visible rows
+    QList<int> rows;
+    rows.reserve(pageRows + rowsBelow + rowsAbove);
+    for (int row = firstVisibleRow; row <= lastVisibleRow; ++row) {
+        rows.append(row);
+    }
+    for (int distance = 1; distance <= aheadRows; ++distance) {
+        if (distance <= rowsBelow && lastVisibleRow + distance < rowCount) {
+            rows.append(lastVisibleRow + distance);
+        }
+        if (distance <= rowsAbove && firstVisibleRow - distance >= 0) {
+            rows.append(firstVisibleRow - distance);
+        }
+    }
+    if (rows != m_prefetchRows) {
+        m_prefetchRows = rows;
+        emit prefetchCoverArt(m_prefetchRows);
+    }
+}
+
 void WTrackTableView::slotGuiTick50ms(double /*unused*/) {
+    updateCoverArtPrefetch();
+
     // if the user is stopped in the same row for more than 0.1 s,
     // we load un-cached cover arts as well.
     mixxx::Duration timeDelta = mixxx::Time::elapsed() - m_lastUserAction;
@@ -168,6 +226,10 @@ void WTrackTableView::loadTrackModel(QAbstractItemModel* model, bool restoreStat
 
     setVisible(false);
 
+    // The delegates of the new model have not received any rows yet
+    m_prefetchFirstVisibleRow = -1;
+    m_prefetchRows.clear();
+
     // Save the previous track model's header state
     WTrackTableViewHeader* oldHeader =
             qobject_cast<WTrackTableViewHeader*>(horizontalHeader());
@@ -102,6 +102,9 @@ class WTrackTableView : public WLibraryTableView {
     void dropEvent(QDropEvent * event) override;
 
     void enableCachedOnly();
+    // Predicts the rows that will become visible from the scroll
+    // velocity and requests prefetching of their cover art.
+    void updateCoverArtPrefetch();
     void selectionChanged(const QItemSelection &selected,
                           const QItemSelection &deselected) override;
 
@@ -131,6 +134,9 @@ class WTrackTableView : public WLibraryTableView {
     bool m_selectionChangedSinceLastGuiTick;
     bool m_loadCachedOnly;
 
+    int m_prefetchFirstVisibleRow;
+    QList<int> m_prefetchRows;
+
     ControlProxy* m_pCOTGuiTick;
     ControlProxy* m_pKeyNotation;
     ControlProxy* m_pSortColumn;